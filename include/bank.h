@@ -0,0 +1,34 @@
+/*
+ * bank switching for __banked functions (--model-large)
+ *
+ * the banked call helpers switch banks by writing one output port. the
+ * program names it with two absolute symbols in any of its assembly
+ * modules:
+ *
+ *     __bank_port == 0x00FE    ; port address
+ *     __bank_mask == 0x07      ; port bits that select the bank
+ *
+ * a bank number (#pragma bank, --codeseg) is the port value with the
+ * bank bits in place. the helpers keep the last value written in a
+ * shadow byte and skip the port write when the target bank is already
+ * mapped. without the two symbols banked calls are plain calls.
+ *
+ * a library built with BANK_PROFILE=on also counts the banked calls
+ * per call site and target; test/sim/bankplan turns the counts into a
+ * bank placement.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __BANK_H__
+#define __BANK_H__
+
+/* write value to the bank port and the shadow, call once at startup;
+   with BANK_PROFILE=on it also empties the call counts */
+extern void bank_init(unsigned char value);
+
+/* rewrite the port from the shadow, for interrupt handlers that call
+   banked code */
+extern void bank_sync(void);
+
+#endif /* __BANK_H__ */
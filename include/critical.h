@@ -0,0 +1,32 @@
+/*
+ * nesting critical sections
+ *
+ * critical_enter() and critical_exit() pair up and nest. the outermost
+ * enter disables interrupts and remembers whether they were on, the
+ * matching exit enables them again only then; inner levels only
+ * count. the previous state is sampled safely on NMOS z80s, and in an
+ * interrupt handler the sections keep interrupts off.
+ *
+ * with a library built with CRITICAL_PROFILE=on the outermost sections
+ * are timed from the z80sim T-state counter.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __CRITICAL_H__
+#define __CRITICAL_H__
+
+/* outermost critical sections since the last critical_stats() */
+typedef struct critical_stats_s {
+    unsigned long count;
+    unsigned long total;            /* T-states with interrupts held off */
+    unsigned long max;              /* longest section */
+} critical_stats_t;
+
+extern void critical_enter(void);
+extern void critical_exit(void);
+
+/* copy and clear the counts, all zero without CRITICAL_PROFILE=on */
+extern void critical_stats(critical_stats_t *s);
+
+#endif /* __CRITICAL_H__ */
@@ -0,0 +1,17 @@
+/*
+ * combined 32-bit division and remainder (one pass for both results)
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __DIVMOD_H__
+#define __DIVMOD_H__
+
+/* returns x / y and stores x % y to *rem */
+extern unsigned long uldivmod(unsigned long x, unsigned long y,
+                              unsigned long *rem);
+
+/* returns trunc(x / y) and stores x % y (sign of x) to *rem */
+extern long ldivmod(long x, long y, long *rem);
+
+#endif /* __DIVMOD_H__ */
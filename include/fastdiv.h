@@ -0,0 +1,44 @@
+/*
+ * division by a run-time invariant divisor (multiply-high and shift)
+ *
+ * *_prepare(s, d) turns d into a magic multiplier and a shift once,
+ * after which *_apply(s, x) returns x / d with one multiply-high, an
+ * optional add and a shift instead of a shift-subtract division. the
+ * *_array forms divide a whole buffer in place and load s once.
+ *
+ * quotients are the same as the C / operator, signed ones round toward
+ * zero. a zero divisor is taken as 1.
+ *
+ * only long is covered. for int a 16-bit multiply-high costs as much as
+ * the shift-subtract loop of __divuint, so there is nothing to gain.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __FASTDIV_H__
+#define __FASTDIV_H__
+
+/*
+ * magic == 0 means d is a power of two and only the shift is used.
+ * more: bits 0-4 shift, bit 6 add step, bit 7 negative divisor
+ */
+typedef struct udiv32 {
+    unsigned long magic;
+    unsigned char more;
+} udiv32_t;
+
+typedef struct sdiv32 {
+    long magic;
+    unsigned char more;
+} sdiv32_t;
+
+extern void udiv32_prepare(udiv32_t *s, unsigned long d);
+extern unsigned long udiv32_apply(const udiv32_t *s, unsigned long x);
+/* x[i] = x[i] / d for i < n */
+extern void udiv32_array(const udiv32_t *s, unsigned long *x, unsigned int n);
+
+extern void sdiv32_prepare(sdiv32_t *s, long d);
+extern long sdiv32_apply(const sdiv32_t *s, long x);
+extern void sdiv32_array(const sdiv32_t *s, long *x, unsigned int n);
+
+#endif /* __FASTDIV_H__ */
@@ -0,0 +1,23 @@
+/*
+ * float to and from decimal text
+ *
+ * both directions work on an unpacked 32-bit mantissa and scale it by a
+ * power of ten with at most two table multiplies, so there is no loop of
+ * float multiplies or divides by 10.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __FCONV_H__
+#define __FCONV_H__
+
+/* writes x to buf as [-]d.ddde+dd with digits significant digits (1..9)
+   and returns a pointer to the terminating 0. buf needs digits + 8 bytes.
+   9 digits read back with strtof give the same float (FLOAT_ROUND=nearest) */
+extern char *ftoa(float x, char *buf, unsigned char digits);
+
+/* parses [ws][+-]digits[.digits][e[+-]digits] (and inf, infinity, nan
+   with FLOAT_PROFILE=ieee), sets *end past it unless end is 0 */
+extern float strtof(const char *s, char **end);
+
+#endif /* __FCONV_H__ */
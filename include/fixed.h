@@ -0,0 +1,59 @@
+/*
+ * signed fixed point arithmetic, 16.16 in a long and 8.8 in an int
+ *
+ * add, subtract and compare are the plain integer operators. multiply
+ * and divide keep the binary point in place: fx16_mul(a, b) is
+ * a * b >> 16 on the full 64-bit product, fx16_div(a, b) is
+ * (a << 16) / b on a 48-bit dividend, so no bits are lost in between.
+ * products round toward -inf (an arithmetic shift), quotients toward
+ * zero like the C / operator.
+ *
+ * the plain forms wrap like integer overflow, the _sat forms clamp to
+ * FX16_MIN..FX16_MAX (FX8_MIN..FX8_MAX). dividing by 0 gives the limit
+ * with the sign of a in both.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __FIXED_H__
+#define __FIXED_H__
+
+/* value = x / 2^16 */
+typedef long fx16_t;
+
+/* value = x / 2^8 */
+typedef int fx8_t;
+
+#define FX16_ONE  0x00010000L
+#define FX16_MAX  0x7FFFFFFFL
+#define FX16_MIN  (-FX16_MAX - 1)
+
+#define FX8_ONE   0x0100
+#define FX8_MAX   0x7FFF
+#define FX8_MIN   (-FX8_MAX - 1)
+
+/* integer n to fixed point, n must be in range */
+#define FX16_INT(n)  ((fx16_t)(n) << 16)
+#define FX8_INT(n)   ((fx8_t)((n) << 8))
+
+extern fx16_t fx16_mul(fx16_t a, fx16_t b);
+extern fx16_t fx16_mul_sat(fx16_t a, fx16_t b);
+extern fx16_t fx16_div(fx16_t a, fx16_t b);
+extern fx16_t fx16_div_sat(fx16_t a, fx16_t b);
+
+extern fx8_t fx8_mul(fx8_t a, fx8_t b);
+extern fx8_t fx8_mul_sat(fx8_t a, fx8_t b);
+extern fx8_t fx8_div(fx8_t a, fx8_t b);
+extern fx8_t fx8_div_sat(fx8_t a, fx8_t b);
+
+/*
+ * from float rounds to nearest (ties away from zero) and saturates,
+ * NaN gives 0 in both FLOAT_PROFILEs. to float is exact for fx8_t and rounded to nearest for
+ * fx16_t values of more than 24 significant bits.
+ */
+extern fx16_t fx16_from_float(float x);
+extern float fx16_to_float(fx16_t x);
+extern fx8_t fx8_from_float(float x);
+extern float fx8_to_float(fx8_t x);
+
+#endif /* __FIXED_H__ */
@@ -0,0 +1,13 @@
+/*
+ * fused float multiply-add (one rounding for a * b + c)
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __FMA_H__
+#define __FMA_H__
+
+/* returns a * b + c, rounded once per FLOAT_ROUND */
+extern float __fsfma(float a, float b, float c);
+
+#endif /* __FMA_H__ */
@@ -0,0 +1,29 @@
+/*
+ * elementary float functions
+ *
+ * sin, cos and atan2 are 16 CORDIC steps on 32-bit fixed point, exp and
+ * log the same digit by digit idea with factors 1 + 2^-i. all of them
+ * use small ROM tables, no float multiplies or divides, and are within
+ * 1 ulp with FLOAT_ROUND=nearest.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __FMATH_H__
+#define __FMATH_H__
+
+/* return sin(x) and cos(x), x in radians, reduced exactly for any |x| */
+extern float sinf(float x);
+extern float cosf(float x);
+
+/* stores sin(x) to *s and cos(x) to *c, for the cost of one of them */
+extern void sincosf(float x, float *s, float *c);
+
+/* returns the angle of (x, y) in [-pi, pi] */
+extern float atan2f(float y, float x);
+
+/* return e^x and the natural logarithm of x */
+extern float expf(float x);
+extern float logf(float x);
+
+#endif /* __FMATH_H__ */
@@ -0,0 +1,31 @@
+/*
+ * unpacked float accumulator (running sums and dot products)
+ *
+ * the sum is kept with a 32-bit mantissa and a 16-bit exponent and is
+ * rounded to a float only by fpacc_result.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __FPACC_H__
+#define __FPACC_H__
+
+typedef struct fpacc_s {
+    unsigned long mant;     /* bit 31 set, 0 while the sum is zero */
+    int exp;                /* biased exponent of bit 31 */
+    unsigned char sign;     /* 0x00 or 0x80 */
+} fpacc_t;
+
+/* acc = 0 */
+extern void fpacc_init(fpacc_t *acc);
+
+/* acc += x */
+extern void fpacc_add(fpacc_t *acc, float x);
+
+/* acc += a * b, the product is not rounded */
+extern void fpacc_mul_add(fpacc_t *acc, float a, float b);
+
+/* returns the sum rounded to a float per FLOAT_ROUND */
+extern float fpacc_result(const fpacc_t *acc);
+
+#endif /* __FPACC_H__ */
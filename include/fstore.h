@@ -0,0 +1,34 @@
+/*
+ * compact float storage: ieee-754 binary16 and a 24-bit float
+ *
+ * both are storage formats only, convert to float to compute. a half_t
+ * has 11 significant bits and covers 2^-14..65504 (2^-24 with
+ * denormals, FLOAT_PROFILE=ieee), an f24_t is a float without its low
+ * mantissa byte: 16 significant bits over the whole float range.
+ *
+ * converting to the compact form rounds per FLOAT_ROUND and overflows
+ * to +-Inf, converting back is exact. fs2f24_array converts n elements
+ * from src to dst, the buffers must not overlap.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __FSTORE_H__
+#define __FSTORE_H__
+
+/* ieee-754 binary16 bits */
+typedef unsigned int half_t;
+
+/* bytes 1..3 of a float, lsb first */
+typedef struct f24_s {
+    unsigned char b[3];
+} f24_t;
+
+extern half_t fs2half(float x);
+extern float half2fs(half_t h);
+
+extern void fs2f24(f24_t *dst, float x);
+extern float f242fs(const f24_t *src);
+extern void fs2f24_array(f24_t *dst, const float *src, unsigned int n);
+
+#endif /* __FSTORE_H__ */
@@ -0,0 +1,26 @@
+/*
+ * float array kernels
+ *
+ * each kernel builds one stack frame for the whole array and walks the
+ * buffers with pointers. fs_dot and fs_sum add into an unpacked
+ * accumulator (see fpacc.h) and round once at the end.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __FSVEC_H__
+#define __FSVEC_H__
+
+/* returns x[0] * y[0] + ... + x[n-1] * y[n-1], rounded once */
+extern float fs_dot(const float *x, const float *y, unsigned int n);
+
+/* returns x[0] + ... + x[n-1], rounded once */
+extern float fs_sum(const float *x, unsigned int n);
+
+/* x[i] = a * x[i] for i < n */
+extern void fs_scale(float a, float *x, unsigned int n);
+
+/* y[i] = a * x[i] + y[i] for i < n, each rounded once as by __fsfma */
+extern void fs_axpy(float a, const float *x, float *y, unsigned int n);
+
+#endif /* __FSVEC_H__ */
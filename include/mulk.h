@@ -0,0 +1,26 @@
+/*
+ * 16-bit multiply by small constants (unrolled shift/add)
+ *
+ * each returns the low 16 bits of x * k, the same as x * k in C for
+ * both unsigned int and int. use them where sdcc would call __mulint.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __MULK_H__
+#define __MULK_H__
+
+extern unsigned int mul16_3(unsigned int x);
+extern unsigned int mul16_5(unsigned int x);
+extern unsigned int mul16_6(unsigned int x);
+extern unsigned int mul16_10(unsigned int x);
+extern unsigned int mul16_12(unsigned int x);
+extern unsigned int mul16_24(unsigned int x);
+extern unsigned int mul16_40(unsigned int x);
+extern unsigned int mul16_80(unsigned int x);
+extern unsigned int mul16_100(unsigned int x);
+extern unsigned int mul16_160(unsigned int x);
+extern unsigned int mul16_320(unsigned int x);
+extern unsigned int mul16_1000(unsigned int x);
+
+#endif /* __MULK_H__ */
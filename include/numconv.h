@@ -0,0 +1,29 @@
+/*
+ * integer to and from decimal text without division
+ *
+ * the formatting side subtracts powers of ten instead of calling
+ * __divuint / __divulong twice per digit, the parsing side multiplies by
+ * 10 with shifts and adds.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __NUMCONV_H__
+#define __NUMCONV_H__
+
+/* write x in decimal to buf (6 bytes for 16 bits, 11 for 32, one more
+   for itoa's sign) and return a pointer to the terminating 0 */
+extern char *utoa16(unsigned int x, char *buf);
+extern char *itoa(int x, char *buf);
+extern char *utoa32(unsigned long x, char *buf);
+
+/* [ws][+-]digits, wraps modulo 2^16 */
+extern int atoi16(const char *s);
+
+/* [ws][+-]digits in base 10 or 16, base 0 takes 16 after 0x and 10
+   otherwise. 0xFFFFFFFF on overflow, *end past the digits unless end
+   is 0 */
+extern unsigned long strtoul32(const char *s, char **end,
+                               unsigned char base);
+
+#endif /* __NUMCONV_H__ */
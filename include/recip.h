@@ -0,0 +1,18 @@
+/*
+ * float reciprocal (table seed and one Newton-Raphson step)
+ *
+ * for a loop dividing by the same value, take its reciprocal once and
+ * multiply: x * __fsinv(d) is within 1.5 ulp of x / d with
+ * FLOAT_ROUND=nearest (3 ulp with trunc), for the price of ___fsmul.
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __RECIP_H__
+#define __RECIP_H__
+
+/* returns 1 / x, rounded once per FLOAT_ROUND, special values per
+   FLOAT_PROFILE */
+extern float __fsinv(float x);
+
+#endif /* __RECIP_H__ */
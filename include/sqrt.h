@@ -0,0 +1,18 @@
+/*
+ * square roots (bitwise, shift-subtract)
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __SQRT_H__
+#define __SQRT_H__
+
+/* returns sqrt(x), rounded once per FLOAT_ROUND, special values per
+   FLOAT_PROFILE */
+extern float __fssqrt(float x);
+
+/* return floor(sqrt(x)) */
+extern unsigned char isqrt16(unsigned int x);
+extern unsigned int isqrt32(unsigned long x);
+
+#endif /* __SQRT_H__ */
@@ -0,0 +1,227 @@
+        ;; signed 16.16 fixed point divide
+        ;; provides fx16_div (wraps) and fx16_div_sat (saturates)
+        ;;
+        ;; (a << 16) / b is a 48 by 32-bit division. __divu32 takes the
+        ;; first 32 quotient bits, |a| / |b|, and leaves the remainder in
+        ;; hl':hl (when |a| < |b| those bits are 0 and the remainder is
+        ;; |a|, so the call is skipped). 16 more steps of its
+        ;; non-restoring loop then run on the remainder, with zeros
+        ;; brought down, for the bits below the binary point. that loop
+        ;; needs |b| < 2^31, b = 0x80000000 is a shift.
+        ;;
+        ;; the quotient rounds toward zero like the C / operator. fx16_div
+        ;; keeps its low 32 bits, fx16_div_sat clamps it. both return
+        ;; 0x7FFFFFFF for b = 0, 0x80000000 when a < 0.
+        ;;
+        ;; C entry points (see include/fixed.h), sdcccall(1):
+        ;;   fx16_t fx16_div(fx16_t a, fx16_t b);
+        ;;   fx16_t fx16_div_sat(fx16_t a, fx16_t b);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fx16div
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fx16_div
+        .globl  _fx16_div_sat
+        .globl  __divu32
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+4..7: b, then |b| (lsb first, caller pops)
+;;   ix+2,3: return address
+;;   ix+0,1: saved ix
+;;   ix-1 : bit 7 sign of the quotient, bit 0 saturate
+;; ============================================================
+
+        ;; _fx16_div
+        ;; inputs:  a in HL:DE (HL=high16, DE=low16), b at 2(sp)..5(sp)
+        ;; outputs: HL:DE = (a << 16) / b, modulo 2^32
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+_fx16_div:
+        ld      c, #0
+        jr      .div
+
+        ;; _fx16_div_sat
+        ;; inputs:  a in HL:DE (HL=high16, DE=low16), b at 2(sp)..5(sp)
+        ;; outputs: HL:DE = (a << 16) / b, clamped to 0x80000000..0x7FFFFFFF
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+_fx16_div_sat:
+        ld      c, #1
+.div:
+        push    ix
+        ld      ix, #0
+        add     ix, sp
+        ld      a, h
+        xor     a, 7(ix)
+        and     a, #0x80
+        or      a, c
+        push    af                                 ; -1(ix) = sign, saturate
+        bit     7, h
+        call    nz, .neg_hlde                      ; |a|
+        bit     7, 7(ix)
+        jr      z, .b_pos
+        xor     a, a
+        sub     a, 4(ix)
+        ld      4(ix), a
+        ld      a, #0
+        sbc     a, 5(ix)
+        ld      5(ix), a
+        ld      a, #0
+        sbc     a, 6(ix)
+        ld      6(ix), a
+        ld      a, #0
+        sbc     a, 7(ix)
+        ld      7(ix), a                           ; |b|
+.b_pos:
+        ld      c, 6(ix)
+        ld      b, 7(ix)
+        push    bc
+        pop     iy
+        ld      c, 4(ix)
+        ld      b, 5(ix)
+        ld      a, b
+        or      a, c
+        or      a, 6(ix)
+        or      a, 7(ix)
+        jp      z, .clamp                          ; b = 0
+        bit     7, 7(ix)
+        jp      nz, .half                          ; |b| = 2^31
+        ld      a, e
+        sub     a, 4(ix)
+        ld      a, d
+        sbc     a, 5(ix)
+        ld      a, l
+        sbc     a, 6(ix)
+        ld      a, h
+        sbc     a, 7(ix)
+        jr      nc, .long                          ; |a| >= |b|
+        push    hl
+        ex      de, hl
+        exx
+        pop     hl                                 ; remainder = |a|
+        exx
+        ld      de, #0
+        jr      .low16
+.long:
+        call    __divu32                           ; de':de = |a| / |b|
+        bit     0, -1(ix)
+        jr      z, .low16
+        exx
+        ld      a, d
+        or      a, e
+        exx
+        jp      nz, .clamp                         ; quotient >= 2^32
+.low16:
+        push    de                                 ; quotient bits 16..31
+        ld      c, 4(ix)
+        ld      b, 5(ix)
+        exx
+        ld      c, 6(ix)
+        ld      b, 7(ix)
+        exx
+        ld      de, #0
+        ld      a, #16
+        or      a, a
+
+        ;; remainder >= 0: shift a zero in and subtract |b|
+.pos:
+        rl      e
+        rl      d                                  ; shift in the quotient bit
+        add     hl, hl
+        exx
+        adc     hl, hl                             ; cf = 0, rem < |b| < 2^31
+        exx
+        sbc     hl, bc
+        exx
+        sbc     hl, bc
+        exx
+        ccf                                        ; cf = quotient bit
+        jr      nc, .pos_to_neg
+        dec     a
+        jp      nz, .pos
+        jr      .last
+.pos_to_neg:
+        dec     a
+        jr      z, .last
+
+        ;; remainder < 0: shift a zero in and add |b|
+.neg:
+        rl      e
+        rl      d
+        add     hl, hl
+        exx
+        adc     hl, hl
+        exx
+        add     hl, bc
+        exx
+        adc     hl, bc
+        exx                                        ; cf = quotient bit
+        jr      c, .neg_to_pos
+        dec     a
+        jp      nz, .neg
+        jr      .last
+.neg_to_pos:
+        dec     a
+        jp      nz, .pos
+.last:
+        rl      e
+        rl      d
+        pop     hl                                 ; HL:DE = |quotient|
+.check:
+        bit     0, -1(ix)
+        jr      z, .sign
+        bit     7, h
+        jr      z, .sign                           ; below 2^31
+        bit     7, -1(ix)
+        jr      z, .clamp
+        ld      a, h
+        sub     a, #0x80
+        or      a, l
+        or      a, d
+        or      a, e
+        jr      nz, .clamp                         ; only -2^31 fits
+.sign:
+        bit     7, -1(ix)
+        call    nz, .neg_hlde
+        jr      .done
+.half:
+        sla     e
+        rl      d
+        rl      l
+        rl      h                                  ; |a| / 2^15 = cf:hl
+        ex      de, hl
+        ld      hl, #0
+        rl      l
+        jr      .check
+.clamp:
+        ld      de, #0
+        ld      hl, #0x8000
+        bit     7, -1(ix)
+        jr      nz, .done
+        dec     de
+        dec     hl
+.done:
+        ld      sp, ix
+        pop     ix
+        ret
+
+        ;; HL:DE = -HL:DE
+.neg_hlde:
+        xor     a, a
+        sub     a, e
+        ld      e, a
+        ld      a, #0
+        sbc     a, d
+        ld      d, a
+        ld      a, #0
+        sbc     a, l
+        ld      l, a
+        ld      a, #0
+        sbc     a, h
+        ld      h, a
+        ret
@@ -0,0 +1,239 @@
+        ;; signed 16.16 fixed point multiply
+        ;; provides fx16_mul (wraps) and fx16_mul_sat (saturates)
+        ;;
+        ;; a b >> 16 needs bits 16..47 of the 64-bit product. |a| and
+        ;; |b| are multiplied as unsigned 16-bit halves with
+        ;; ___muluint2ulong (high halves as the multiplier, which is
+        ;; quicker below 2^8) and summed in columns of 16 bits: bits
+        ;; 16..31 in hl', 32..47 in de' and the carries out of them in
+        ;; c, which ___muluint2ulong leaves alone. bits 0..15 only
+        ;; matter as a sticky flag: a negative result is -ceil(|a b| /
+        ;; 2^16), so it rounds toward -inf like an arithmetic shift.
+        ;;
+        ;; fx16_mul only keeps bits 16..47, so a high times b high needs
+        ;; its low 16 bits only (__mul16). fx16_mul_sat takes all of it
+        ;; and clamps when the magnitude does not fit.
+        ;;
+        ;; C entry points (see include/fixed.h), sdcccall(1):
+        ;;   fx16_t fx16_mul(fx16_t a, fx16_t b);
+        ;;   fx16_t fx16_mul_sat(fx16_t a, fx16_t b);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fx16mul
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fx16_mul
+        .globl  _fx16_mul_sat
+        .globl  ___muluint2ulong
+        .globl  __mul16
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+4..7: b, then |b| (lsb first, caller pops)
+;;   ix+2,3: return address
+;;   ix+0,1: saved ix
+;;   ix-1..-4 : |a| (ix-1 msb)
+;;   ix-5 : bit 7 sign of the product
+;;   ix-6 : sticky, nonzero when bits 0..15 are
+;; ============================================================
+
+        ;; _fx16_mul
+        ;; inputs:  a in HL:DE (HL=high16, DE=low16), b at 2(sp)..5(sp)
+        ;; outputs: HL:DE = a b >> 16, modulo 2^32
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+_fx16_mul:
+        call    .cols
+        ld      c, -2(ix)
+        ld      b, -1(ix)
+        ld      e, 6(ix)
+        ld      d, 7(ix)
+        call    __mul16                            ; de = low16(a high b high)
+        push    de
+        exx
+        pop     bc
+        ex      de, hl
+        add     hl, bc                             ; hl' = bits 32..47
+        push    hl
+        push    de
+        exx
+        pop     de
+        pop     hl                                 ; HL:DE = |a b| >> 16
+        bit     7, -5(ix)
+        call    nz, .neg_ceil
+        jr      .done
+
+        ;; _fx16_mul_sat
+        ;; inputs:  a in HL:DE (HL=high16, DE=low16), b at 2(sp)..5(sp)
+        ;; outputs: HL:DE = a b >> 16, clamped to 0x80000000..0x7FFFFFFF
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+_fx16_mul_sat:
+        call    .cols
+        ld      l, -2(ix)
+        ld      h, -1(ix)
+        ld      e, 6(ix)
+        ld      d, 7(ix)
+        call    ___muluint2ulong                   ; de:hl = a high b high
+        ld      b, #0
+        add     hl, bc                             ; bits 48..63 + carries
+        push    hl
+        push    de
+        exx
+        pop     bc
+        ex      de, hl
+        add     hl, bc                             ; hl' = bits 32..47
+        exx
+        pop     hl
+        jr      c, .clamp                          ; bits 48..63 not 0
+        ld      a, h
+        or      a, l
+        jr      nz, .clamp
+        exx
+        bit     7, h
+        exx
+        jr      z, .fits                           ; below 2^31
+        bit     7, -5(ix)
+        jr      z, .clamp
+        exx
+        ld      a, h
+        xor     a, #0x80
+        or      a, l
+        or      a, d
+        or      a, e
+        exx
+        or      a, -6(ix)
+        jr      nz, .clamp                         ; only -2^31 fits
+.fits:
+        exx
+        push    hl
+        push    de
+        exx
+        pop     de
+        pop     hl
+        bit     7, -5(ix)
+        call    nz, .neg_ceil
+        jr      .done
+.clamp:
+        ld      de, #0
+        ld      hl, #0x8000
+        bit     7, -5(ix)
+        jr      nz, .done
+        dec     de
+        dec     hl
+.done:
+        ld      sp, ix
+        pop     ix
+        ret
+
+        ;; HL:DE = -(HL:DE + sticky), which is ~HL:DE when sticky
+.neg_ceil:
+        ld      a, -6(ix)
+        or      a, a
+        jr      z, .neg_hlde
+        ld      a, e
+        cpl
+        ld      e, a
+        ld      a, d
+        cpl
+        ld      d, a
+        ld      a, l
+        cpl
+        ld      l, a
+        ld      a, h
+        cpl
+        ld      h, a
+        ret
+
+        ;; HL:DE = -HL:DE
+.neg_hlde:
+        xor     a, a
+        sub     a, e
+        ld      e, a
+        ld      a, #0
+        sbc     a, d
+        ld      d, a
+        ld      a, #0
+        sbc     a, l
+        ld      l, a
+        ld      a, #0
+        sbc     a, h
+        ld      h, a
+        ret
+
+        ;; sets up the frame, then sums |a| low |b| low >> 16, |b| high
+        ;; |a| low and |a| high |b| low: hl' = bits 16..31, de' = bits
+        ;; 32..47, c = carries out of bit 47
+.cols:
+        pop     iy                                 ; return to the caller
+        push    ix
+        ld      ix, #0
+        add     ix, sp
+        ld      a, h
+        xor     a, 7(ix)
+        ld      b, a                               ; b = sign of the product
+        bit     7, h
+        call    nz, .neg_hlde
+        push    hl
+        push    de                                 ; |a|
+        push    bc
+        push    iy
+        bit     7, 7(ix)
+        jr      z, .b_pos
+        xor     a, a
+        sub     a, 4(ix)
+        ld      4(ix), a
+        ld      a, #0
+        sbc     a, 5(ix)
+        ld      5(ix), a
+        ld      a, #0
+        sbc     a, 6(ix)
+        ld      6(ix), a
+        ld      a, #0
+        sbc     a, 7(ix)
+        ld      7(ix), a                           ; |b|
+.b_pos:
+        ex      de, hl                             ; hl = |a| low
+        ld      e, 4(ix)
+        ld      d, 5(ix)
+        call    ___muluint2ulong                   ; |a| low |b| low
+        ld      a, d
+        or      a, e
+        ld      -6(ix), a                          ; sticky
+        push    hl
+        exx
+        pop     hl
+        ld      de, #0
+        exx
+        ld      c, #0
+        ld      l, 6(ix)
+        ld      h, 7(ix)
+        ld      e, -4(ix)
+        ld      d, -3(ix)
+        call    ___muluint2ulong                   ; |b| high |a| low
+        call    .acc
+        ld      l, -2(ix)
+        ld      h, -1(ix)
+        ld      e, 4(ix)
+        ld      d, 5(ix)
+        call    ___muluint2ulong                   ; |a| high |b| low
+        ;; fall through
+
+        ;; de' += hl, hl' += de, carry out counted in c
+.acc:
+        push    hl
+        push    de
+        exx
+        pop     bc
+        add     hl, bc
+        pop     bc
+        ex      de, hl
+        adc     hl, bc
+        ex      de, hl
+        exx
+        ret     nc
+        inc     c
+        ret
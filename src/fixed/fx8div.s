@@ -0,0 +1,119 @@
+        ;; signed 8.8 fixed point divide
+        ;; provides fx8_div (wraps) and fx8_div_sat (saturates)
+        ;;
+        ;; (a << 8) / b is a 24 by 16-bit division: __divu16 takes the
+        ;; first 16 quotient bits, |a| / |b|, and 8 more shift-subtract
+        ;; steps on its remainder give the bits below the binary point.
+        ;; the remainder stays below |b| <= 2^15, so those steps fit in
+        ;; 16 bits.
+        ;;
+        ;; the quotient rounds toward zero like the C / operator. fx8_div
+        ;; keeps its low 16 bits, fx8_div_sat clamps it. both return
+        ;; 0x7FFF for b = 0, 0x8000 when a < 0.
+        ;;
+        ;; C entry points (see include/fixed.h), sdcccall(1):
+        ;;   fx8_t fx8_div(fx8_t a, fx8_t b);
+        ;;   fx8_t fx8_div_sat(fx8_t a, fx8_t b);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fx8div
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fx8_div
+        .globl  _fx8_div_sat
+        .globl  __divu16
+
+        ;; _fx8_div
+        ;; inputs:  hl = a, de = b
+        ;; outputs: de = (a << 8) / b, modulo 2^16
+        ;; clobbers: af, bc, de, hl
+_fx8_div:
+        ld      c, #0
+        jr      .div
+
+        ;; _fx8_div_sat
+        ;; inputs:  hl = a, de = b
+        ;; outputs: de = (a << 8) / b, clamped to 0x8000..0x7FFF
+        ;; clobbers: af, bc, de, hl
+_fx8_div_sat:
+        ld      c, #1
+.div:
+        ld      a, h
+        xor     a, d
+        and     a, #0x80
+        or      a, c
+        ld      c, a                               ; c = sign, saturate
+        bit     7, h
+        call    nz, .neg_hl                        ; |a|
+        bit     7, d
+        jr      z, .b_pos
+        ex      de, hl
+        call    .neg_hl
+        ex      de, hl                             ; |b|
+.b_pos:
+        ld      a, d
+        or      a, e
+        jr      z, .clamp                          ; b = 0
+        push    de
+        call    __divu16                           ; de = |a| / |b|, keeps c
+        bit     0, c
+        jr      z, .low8
+        ld      a, d
+        or      a, a
+        jr      nz, .clamp_pop                     ; quotient >= 2^16
+.low8:
+        ld      a, e
+        pop     de                                 ; de = |b|
+        push    af                                 ; quotient bits 8..15
+        ld      b, #8
+.loop:
+        add     hl, hl                             ; rem < 2^15, no carry
+        sbc     hl, de
+        jr      nc, .one
+        add     hl, de                             ; restore, cf = 1
+.one:
+        ccf                                        ; cf = quotient bit
+        rla
+        djnz    .loop
+        ld      e, a
+        pop     af
+        ld      d, a                               ; de = |quotient|
+        bit     0, c
+        jr      z, .sign
+        bit     7, d
+        jr      z, .sign                           ; below 2^15
+        bit     7, c
+        jr      z, .clamp
+        ld      a, d
+        sub     a, #0x80
+        or      a, e
+        jr      nz, .clamp                         ; only -2^15 fits
+.sign:
+        bit     7, c
+        ret     z
+        ex      de, hl
+        call    .neg_hl
+        ex      de, hl
+        ret
+.clamp_pop:
+        pop     de
+.clamp:
+        ld      de, #0x8000
+        bit     7, c
+        ret     nz
+        dec     de
+        ret
+
+        ;; hl = -hl
+.neg_hl:
+        xor     a, a
+        sub     a, l
+        ld      l, a
+        sbc     a, a
+        sub     a, h
+        ld      h, a
+        ret
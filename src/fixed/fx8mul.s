@@ -0,0 +1,77 @@
+        ;; signed 8.8 fixed point multiply
+        ;; provides fx8_mul (wraps) and fx8_mul_sat (saturates)
+        ;;
+        ;; a b >> 8 is bits 8..23 of the 32-bit product. ___muluint2ulong
+        ;; multiplies a and b as unsigned, then b is subtracted from the
+        ;; high word when a < 0 and a when b < 0, which leaves the two's
+        ;; complement product. the shift drops the low byte, so the
+        ;; result rounds toward -inf like an arithmetic shift.
+        ;; fx8_mul_sat clamps unless bits 23..31 are all equal.
+        ;;
+        ;; C entry points (see include/fixed.h), sdcccall(1):
+        ;;   fx8_t fx8_mul(fx8_t a, fx8_t b);
+        ;;   fx8_t fx8_mul_sat(fx8_t a, fx8_t b);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fx8mul
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fx8_mul
+        .globl  _fx8_mul_sat
+        .globl  ___muluint2ulong
+
+        ;; _fx8_mul
+        ;; inputs:  hl = a, de = b
+        ;; outputs: de = a b >> 8, modulo 2^16
+        ;; clobbers: af, bc, de, hl, iy
+_fx8_mul:
+        call    .prod
+        ld      e, d
+        ld      d, l
+        ret
+
+        ;; _fx8_mul_sat
+        ;; inputs:  hl = a, de = b
+        ;; outputs: de = a b >> 8, clamped to 0x8000..0x7FFF
+        ;; clobbers: af, bc, de, hl, iy
+_fx8_mul_sat:
+        call    .prod
+        ld      a, l
+        rla                                        ; cf = bit 23
+        ld      a, h
+        adc     a, #0                              ; 0 when bits 23..31 agree
+        jr      nz, .clamp
+        ld      e, d
+        ld      d, l
+        ret
+.clamp:
+        bit     7, h                               ; sign of the product
+        ld      de, #0x8000
+        ret     nz
+        dec     de
+        ret
+
+        ;; hl:de = a b, signed (hl = high16)
+.prod:
+        push    hl
+        push    de
+        call    ___muluint2ulong                   ; hl:de = a b, unsigned
+        pop     bc                                 ; bc = b
+        ex      (sp), hl                           ; hl = a
+        ld      a, b
+        bit     7, h
+        ex      (sp), hl
+        jr      z, .a_pos
+        or      a, a
+        sbc     hl, bc                             ; a < 0: -= b << 16
+.a_pos:
+        pop     bc                                 ; bc = a
+        rla                                        ; cf = sign of b
+        ret     nc
+        or      a, a
+        sbc     hl, bc                             ; b < 0: -= a << 16
+        ret
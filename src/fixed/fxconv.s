@@ -0,0 +1,179 @@
+        ;; conversions between float and 16.16 / 8.8 fixed point
+        ;;
+        ;; to float: the value is converted as an integer (___slong2fs,
+        ;; ___sint2fs) and 16 or 8 taken off the exponent, which is exact
+        ;; because any nonzero result is at least 1.
+        ;;
+        ;; from float: the 24-bit mantissa is shifted into place and
+        ;; rounded to nearest, ties away from zero. values out of range
+        ;; and +-Inf saturate, NaN gives 0, so do 0 and denormals. NaN is
+        ;; caught on the saturating path, in either FLOAT_PROFILE.
+        ;;
+        ;; C entry points (see include/fixed.h), sdcccall(1):
+        ;;   fx16_t fx16_from_float(float x);
+        ;;   float fx16_to_float(fx16_t x);
+        ;;   fx8_t fx8_from_float(float x);
+        ;;   float fx8_to_float(fx8_t x);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fxconv
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fx16_from_float
+        .globl  _fx16_to_float
+        .globl  _fx8_from_float
+        .globl  _fx8_to_float
+        .globl  ___slong2fs
+        .globl  ___sint2fs
+
+        ;; _fx16_to_float
+        ;; inputs:  x in HL:DE (HL=high16, DE=low16)
+        ;; outputs: HLDE = x / 2^16
+        ;; clobbers: af, bc, de, hl
+_fx16_to_float:
+        call    ___slong2fs
+        ld      bc, #16 << 7
+        jr      .scale
+
+        ;; _fx8_to_float
+        ;; inputs:  hl = x
+        ;; outputs: HLDE = x / 2^8
+        ;; clobbers: af, bc, de, hl
+_fx8_to_float:
+        call    ___sint2fs
+        ld      bc, #8 << 7
+.scale:
+        ld      a, h
+        or      a, l
+        ret     z                                  ; 0 stays 0
+        sbc     hl, bc                             ; exponent -= 16 or 8
+        ret
+
+        ;; _fx16_from_float
+        ;; inputs:  x in HLDE (H=x3, L=x2, D=x1, E=x0)
+        ;; outputs: HL:DE = x 2^16, rounded, clamped to 0x80000000..0x7FFFFFFF
+        ;; clobbers: af, bc, de, hl
+_fx16_from_float:
+        ld      c, #127 + 31 - 16
+        ;; fall through
+
+        ;; x 2^(158 - c) as a signed 32-bit integer, b bit 7 = sign of x
+.from:
+        ld      b, h
+        ld      a, l
+        rla
+        ld      a, h
+        rla                                        ; a = biased exponent
+        or      a, a
+        jr      z, .zero                           ; 0 and denormals
+        cp      a, c
+        jr      nc, .sat                           ; |x| 2^(158 - c) >= 2^31
+        neg
+        add     a, c                               ; a = c - exponent
+        set     7, l
+        ld      h, #0                              ; hl:de = mantissa
+        sub     a, #8
+        jr      z, .sign
+        jr      c, .left
+        cp      a, #26
+        jr      nc, .zero                          ; below 1/2
+        dec     a
+.bytes:
+        cp      a, #8
+        jr      c, .bits
+        ld      e, d
+        ld      d, l
+        ld      l, h
+        sub     a, #8
+        jr      .bytes
+.bits:
+        or      a, a
+        jr      z, .round
+.bits_loop:
+        srl     l
+        rr      d
+        rr      e
+        dec     a
+        jr      nz, .bits_loop
+.round:
+        srl     l
+        rr      d
+        rr      e                                  ; cf = half
+        jr      nc, .sign
+        inc     de
+        ld      a, d
+        or      a, e
+        jr      nz, .sign
+        inc     l
+        jr      .sign
+.left:
+        neg
+.left_loop:
+        sla     e
+        rl      d
+        rl      l
+        rl      h
+        dec     a
+        jr      nz, .left_loop
+.sign:
+        bit     7, b
+        ret     z
+        xor     a, a
+        sub     a, e
+        ld      e, a
+        ld      a, #0
+        sbc     a, d
+        ld      d, a
+        ld      a, #0
+        sbc     a, l
+        ld      l, a
+        ld      a, #0
+        sbc     a, h
+        ld      h, a
+        ret
+.sat:
+        inc     a
+        jr      nz, .sat_inf
+        ld      a, l
+        add     a, a                               ; drop the exponent bit
+        or      a, d
+        or      a, e
+        jr      nz, .zero                          ; NaN
+.sat_inf:
+        ld      de, #0
+        ld      hl, #0x8000
+        bit     7, b
+        ret     nz
+        dec     de
+        dec     hl
+        ret
+.zero:
+        ld      hl, #0
+        ld      d, h
+        ld      e, l
+        ret
+
+        ;; _fx8_from_float
+        ;; inputs:  x in HLDE (H=x3, L=x2, D=x1, E=x0)
+        ;; outputs: de = x 2^8, rounded, clamped to 0x8000..0x7FFF
+        ;; clobbers: af, bc, de, hl
+_fx8_from_float:
+        ld      c, #127 + 31 - 8
+        call    .from
+        ld      a, d
+        rla
+        sbc     a, a                               ; sign extension of de
+        cp      a, l
+        jr      nz, .sat8
+        cp      a, h
+        ret     z
+.sat8:
+        bit     7, b
+        ld      de, #0x8000
+        ret     nz
+        dec     de
+        ret
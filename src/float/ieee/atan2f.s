@@ -0,0 +1,650 @@
+        ;; two-argument arc tangent (ieee-754 single) for sdcc z80
+        ;;
+        ;; float atan2f(float y, float x);
+        ;;
+        ;; the smaller of |y| and |x| over the larger gives an angle phi
+        ;; in [0, pi/4], the result is phi, pi/2 - phi, pi - phi or
+        ;; pi/2 + phi by the swap and the sign of x, with the sign of y.
+        ;;
+        ;; exponents within 3: CORDIC vectoring (see fpcordic.s) of
+        ;; (big, small) drives the small side to 0 in 16 steps, the
+        ;; angles taken give phi and the y left over adds y / x (17
+        ;; quotient bits) as one linear step.
+        ;; small / big < 2^-3: the ratio t (32-bit restoring division)
+        ;; and atan t = t - t s (1/3 - s (1/5 - s / 7)), s = t^2, on
+        ;; Q0.32 fractions with __mulhu32.
+        ;; results are within 1 ulp.
+        ;;
+        ;; atan2f(+-0, x) is +-0 for x > 0 or +0, +-pi for x < 0 or -0.
+        ;; fast profile: denormals are 0.
+        ;; FLOAT_PROFILE=ieee: a NaN operand is returned quiet, infinite
+        ;; operands give +-pi/2, +-pi/4, +-3 pi/4, +-0 or +-pi as C99.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   y in regs: HLDE  (H=y3, L=y2, D=y1, E=y0)
+        ;;   x on stack: 4 bytes pushed by caller (low word first)
+        ;;   result in HLDE
+        ;;   callee cleans x from stack
+        ;;
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module atan2f
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _atan2f
+        .globl  __fp_unpack_norm
+        .globl  __fp_norm32
+        .globl  __fp_norm_pack
+        .globl  __fp_shr32
+        .globl  __fp_cordic
+        .globl  __fp_cordic_d2z
+        .globl  __fp_retpop4
+        .globl  __mulhu32
+
+        .include "config.inc"
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+7 : x3  (sign+exp high)
+;;   ix+6 : x2  (exp low + mant high)
+;;   ix+5 : x1
+;;   ix+4 : x0
+;;   ix+2,3: return address
+;;   ix+0,1: saved ix
+;;   ix-1 : H = y3        \  push hl
+;;   ix-2 : L = y2        /
+;;   ix-3 : D = y1        \  push de
+;;   ix-4 : E = y0        /
+;;   ix-5 : result sign (sign of y)
+;;   ix-6 : CORDIC step (see __fp_cordic)
+;;   ix-7 : bit 0 swapped (|y| > |x|), bit 7 x < 0
+;;   ix-11..-8  : big mantissa (lsb first)
+;;   ix-15..-12 : small mantissa
+;;   ix-17,-16  : small exponent
+;;   ix-21..-18 : x after the CORDIC, then t
+;;   ix-25..-22 : y after the CORDIC, then s = t^2
+;;   ix-27,-26  : exponent of t
+;;
+;; mantissa m and exponent e hold m / 2^31 * 2^e (see fpnorm.s)
+;; ============================================================
+
+        ;; _atan2f
+        ;; inputs:  y in HLDE, x on caller stack (4 bytes)
+        ;; outputs: HLDE = atan2(y, x)
+_atan2f:
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+        push    hl
+        push    de
+        ld      hl,#-23
+        add     hl,sp
+        ld      sp,hl
+        ld      a,-1(ix)
+        and     #0x80
+        ld      -5(ix),a
+        ld      a,7(ix)
+        and     #0x80
+        ld      -7(ix),a
+
+.if FLOAT_IEEE
+        ;; ---- NaN and Inf operands ----
+        ld      a,6(ix)
+        rla
+        ld      a,7(ix)
+        rla
+        inc     a
+        ld      c,a                     ; c = 0: x is Inf or NaN
+        ld      a,-2(ix)
+        rla
+        ld      a,-1(ix)
+        rla
+        inc     a
+        jr      nz,.y_finite
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        jr      nz,.nan_y
+        ld      a,c
+        or      a
+        jp      nz,.half_pi             ; atan2(+-Inf, x) = +-pi/2
+        ld      a,6(ix)
+        and     #0x7F
+        or      5(ix)
+        or      4(ix)
+        jr      nz,.nan_x
+        bit     7,-7(ix)
+        jp      z,.quarter_pi
+        ld      hl,#0x4016              ; 3 pi/4
+        ld      de,#0xCBE4
+        jp      .const
+.y_finite:
+        ld      a,c
+        or      a
+        jr      nz,.finite
+        ld      a,6(ix)
+        and     #0x7F
+        or      5(ix)
+        or      4(ix)
+        jr      nz,.nan_x
+        bit     7,-7(ix)
+        jp      z,.zero                 ; atan2(y, +Inf) = +-0
+        jp      .pi
+.nan_y:
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        jr      .nan
+.nan_x:
+        ld      h,7(ix)
+        ld      l,6(ix)
+        ld      d,5(ix)
+        ld      e,4(ix)
+.nan:
+        set     6,l
+        jp      .done
+.finite:
+.endif
+
+        ;; ---- swap when |y| > |x|, the small one first ----
+        ld      a,-1(ix)
+        and     #0x7F
+        ld      c,a
+        ld      a,7(ix)
+        and     #0x7F
+        ld      b,a
+        ld      a,4(ix)
+        sub     -4(ix)
+        ld      a,5(ix)
+        sbc     a,-3(ix)
+        ld      a,6(ix)
+        sbc     a,-2(ix)
+        ld      a,b
+        sbc     a,c                     ; |x| - |y|
+        jr      nc,.y_small
+        set     0,-7(ix)
+        ld      h,7(ix)
+        ld      l,6(ix)
+        ld      d,5(ix)
+        ld      e,4(ix)
+        jr      .small
+.y_small:
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+.small:
+.if FLOAT_IEEE
+        ld      a,h
+        and     #0x7F
+        or      l
+        or      d
+        or      e
+.else
+        ld      a,l
+        rla
+        ld      a,h
+        rla
+        or      a                       ; 0 and denormals
+.endif
+        jp      z,.small_zero
+        call    __fp_unpack_norm
+        ld      -12(ix),h
+        ld      -13(ix),l
+        exx
+        ld      -14(ix),h
+        ld      -15(ix),l
+        exx
+        ld      -16(ix),e
+        ld      -17(ix),d
+        bit     0,-7(ix)
+        jr      nz,.y_big
+        ld      h,7(ix)
+        ld      l,6(ix)
+        ld      d,5(ix)
+        ld      e,4(ix)
+        jr      .big
+.y_big:
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+.big:
+        call    __fp_unpack_norm
+        ld      -8(ix),h
+        ld      -9(ix),l
+        exx
+        ld      -10(ix),h
+        ld      -11(ix),l
+        exx
+        ld      a,e
+        sub     -16(ix)
+        ld      e,a
+        ld      a,d
+        sbc     a,-17(ix)
+        ld      d,a                     ; d = big e - small e
+        or      a
+        jp      nz,.ratio
+        ld      a,e
+        cp      #4
+        jp      nc,.ratio
+
+        ;; ---- CORDIC vectoring of (big / 4, small / 4 / 2^d) ----
+        add     a,#2
+        push    af
+        ld      a,#2
+        call    __fp_shr32
+        ex      de,hl
+        exx
+        ex      de,hl
+        exx
+        call    .small_hl
+        pop     af
+        call    __fp_shr32
+        ex      de,hl
+        exx
+        ex      de,hl
+        exx
+        ld      -6(ix),#0x80
+        call    __fp_cordic
+        ld      -18(ix),h
+        ld      -19(ix),l
+        ld      -22(ix),d
+        ld      -23(ix),e
+        exx
+        ld      -20(ix),h
+        ld      -21(ix),l
+        ld      -24(ix),d
+        ld      -25(ix),e
+        exx
+        call    __fp_cordic_d2z
+        push    hl
+        exx
+        push    hl
+        exx                             ; angles taken
+        ld      h,-22(ix)
+        ld      l,-23(ix)
+        exx
+        ld      h,-24(ix)
+        ld      l,-25(ix)
+        exx
+        bit     7,h
+        call    nz,.neg_hl              ; |y| < 2^17
+        ld      a,l
+        exx
+        rra
+        rr      h
+        rr      l
+        ld      a,#0
+        rra
+        push    hl
+        ld      h,a
+        ld      l,#0
+        exx
+        pop     hl                      ; |y| << 15
+        ld      d,-18(ix)
+        ld      e,-19(ix)
+        exx
+        ld      d,-20(ix)
+        ld      e,-21(ix)
+        exx
+        ld      a,#17
+        call    .div                    ; y / x, Q1.31
+        exx
+        pop     hl
+        exx
+        pop     hl
+        bit     7,-22(ix)
+        jr      nz,.q_sub
+        exx
+        add     hl,bc
+        exx
+        adc     hl,bc
+        jr      .phi_z
+.q_sub:
+        exx
+        or      a
+        sbc     hl,bc
+        exx
+        sbc     hl,bc
+.phi_z:
+        ld      de,#0
+        jr      .result
+
+        ;; ---- small / big < 2^-3: t = small / big, atan t ----
+.ratio:
+        push    de
+        call    .small_hl
+        ld      d,-8(ix)
+        ld      e,-9(ix)
+        exx
+        ld      d,-10(ix)
+        ld      e,-11(ix)
+        exx
+        ld      a,#32
+        call    .div                    ; t, Q1.31
+        ld      h,b
+        ld      l,c
+        exx
+        ld      h,b
+        ld      l,c
+        exx
+        pop     de
+        xor     a
+        sub     e
+        ld      e,a
+        sbc     a,a
+        sub     d
+        ld      d,a                     ; -d
+        call    __fp_norm32
+        call    .atan_small
+
+        ;; ---- HL:HL' = phi, DE = e: place it by the swap and x < 0 ----
+.result:
+        ld      a,-7(ix)
+        or      a
+        jr      z,.pack                 ; phi itself
+        ld      a,d
+        or      a
+        ld      a,#1
+        jr      z,.f_shift              ; e = 0
+        inc     d
+        ld      a,#255
+        jr      nz,.f_shift             ; e < -256: 0
+        ld      a,e
+        cp      #226
+        ld      a,#255
+        jr      c,.f_shift              ; below 2^-30: 0
+        ld      a,#1
+        sub     e
+.f_shift:
+        call    __fp_shr32              ; Q2.30
+        bit     0,-7(ix)
+        jr      z,.no_swap
+        ld      bc,#0x6487
+        exx
+        ld      bc,#0xED51              ; pi/2 - phi
+        call    .rsub
+.no_swap:
+        bit     7,-7(ix)
+        jr      z,.no_flip
+        ld      bc,#0xC90F
+        exx
+        ld      bc,#0xDAA2              ; pi - phi
+        call    .rsub
+.no_flip:
+        ld      de,#1
+.pack:
+        call    __fp_norm_pack
+        jr      .done
+
+        ;; ---- the small one is 0: 0, pi or pi/2 ----
+.small_zero:
+        bit     0,-7(ix)
+        jr      z,.y_zero
+.if FLOAT_IEEE
+        jr      .half_pi
+.else
+        ld      a,-2(ix)
+        rla
+        ld      a,-1(ix)
+        rla
+        or      a
+        jr      nz,.half_pi             ; x = 0, y denormal: y = 0 too
+.endif
+.y_zero:
+        bit     7,-7(ix)
+        jr      nz,.pi
+.zero:
+        ld      hl,#0
+        ld      de,#0
+        jr      .const
+.pi:
+        ld      hl,#0x4049
+        ld      de,#0x0FDB
+        jr      .const
+.half_pi:
+        ld      hl,#0x3FC9
+        ld      de,#0x0FDB
+        jr      .const
+.quarter_pi:
+        ld      hl,#0x3F49
+        ld      de,#0x0FDB
+.const:
+        ld      a,h
+        or      -5(ix)
+        ld      h,a
+.done:
+        ld      sp,ix
+        pop     ix
+        jp      __fp_retpop4
+
+        ;; HL:HL' = small mantissa
+.small_hl:
+        ld      h,-12(ix)
+        ld      l,-13(ix)
+        exx
+        ld      h,-14(ix)
+        ld      l,-15(ix)
+        exx
+        ret
+
+        ;; HL:HL' = BC:BC' - HL:HL', entered in the alternate set
+.rsub:
+        ld      a,c
+        sub     l
+        ld      l,a
+        ld      a,b
+        sbc     a,h
+        ld      h,a
+        exx
+        ld      a,c
+        sbc     a,l
+        ld      l,a
+        ld      a,b
+        sbc     a,h
+        ld      h,a
+        ret
+
+        ;; HL:HL' = -HL:HL'
+.neg_hl:
+        xor     a
+        exx
+        sub     l
+        ld      l,a
+        ld      a,#0
+        sbc     a,h
+        ld      h,a
+        exx
+        ld      a,#0
+        sbc     a,l
+        ld      l,a
+        ld      a,#0
+        sbc     a,h
+        ld      h,a
+        ret
+
+        ;; restoring division, A quotient bits
+        ;; inputs:  HL:HL' = n, DE:DE' = d, n < 2 d
+        ;; outputs: BC:BC' = floor(n * 2^(A - 1) / d)
+        ;; clobbers: af, hl, hl'
+.div:
+        ld      bc,#0
+        exx
+        ld      bc,#0
+        exx
+        or      a
+.div_step:
+        jr      c,.div_force            ; n >= 2^32
+        exx
+        sbc     hl,de
+        exx
+        sbc     hl,de
+        jr      nc,.div_one
+        exx
+        add     hl,de
+        exx
+        adc     hl,de                   ; restore
+        or      a
+        jr      .div_shift
+.div_force:
+        exx
+        or      a
+        sbc     hl,de
+        exx
+        sbc     hl,de
+.div_one:
+        scf
+.div_shift:
+        exx
+        rl      c
+        rl      b
+        exx
+        rl      c
+        rl      b                       ; q = 2 q + bit
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl                   ; n = 2 n, cf = bit 32
+        dec     a
+        jr      nz,.div_step
+        ret
+
+        ;; atan t = t - t s (1/3 - s (1/5 - s / 7)), s = t^2
+        ;; inputs:  HL:HL' = t (bit 31 set), DE = e <= -4
+        ;; outputs: HL:HL' = atan t mantissa, DE = e
+.atan_small:
+        ld      -18(ix),h
+        ld      -19(ix),l
+        ld      -26(ix),d
+        ld      -27(ix),e
+        ld      b,h
+        ld      c,l
+        ld      d,h
+        ld      e,l
+        exx
+        ld      -20(ix),h
+        ld      -21(ix),l
+        ld      b,h
+        ld      c,#0
+        ld      d,h
+        ld      e,l
+        exx
+        call    __mulhu32               ; t^2 / 2^(2 e + 2)
+        ld      a,-26(ix)
+        inc     a
+        jp      nz,.as_t                ; e < -256: s = 0
+        ld      a,-27(ix)
+        cp      #0x80
+        jp      c,.as_t                 ; e < -128: s = 0
+        add     a,a
+        add     a,#2
+        neg
+        call    __fp_shr32              ; s, Q0.32
+        ld      a,h
+        or      l
+        exx
+        or      h
+        or      l
+        exx
+        jp      z,.as_t
+        ld      -22(ix),h
+        ld      -23(ix),l
+        exx
+        ld      -24(ix),h
+        ld      -25(ix),l
+        exx
+        ld      b,h
+        ld      c,l
+        ld      de,#0x2492
+        exx
+        ld      bc,#0
+        ld      de,#0x4925
+        exx
+        call    __mulhu32               ; s / 7
+        exx
+        ld      a,#0x33
+        sub     l
+        ld      a,#0x33
+        sbc     a,h
+        ld      bc,#0
+        exx
+        ld      a,#0x33
+        sbc     a,l
+        ld      c,a
+        ld      a,#0x33
+        sbc     a,h
+        ld      b,a                     ; 1/5 - s / 7
+        call    .s_de
+        call    __mulhu32
+        exx
+        ld      a,#0x55
+        sub     l
+        ld      a,#0x55
+        sbc     a,h
+        ld      b,a
+        ld      c,#0
+        exx
+        ld      a,#0x55
+        sbc     a,l
+        ld      c,a
+        ld      a,#0x55
+        sbc     a,h
+        ld      b,a                     ; 1/3 - s (1/5 - s / 7)
+        call    .s_de
+        call    __mulhu32
+        ld      b,h
+        ld      c,l
+        exx
+        ld      b,h
+        ld      c,l
+        ld      d,-20(ix)
+        ld      e,-21(ix)
+        exx
+        ld      d,-18(ix)
+        ld      e,-19(ix)
+        call    __mulhu32               ; t s (...)
+        exx
+        ld      a,-21(ix)
+        sub     l
+        ld      l,a
+        ld      a,-20(ix)
+        sbc     a,h
+        ld      h,a
+        exx
+        ld      a,-19(ix)
+        sbc     a,l
+        ld      l,a
+        ld      a,-18(ix)
+        sbc     a,h
+        ld      h,a
+        jr      .as_e
+.as_t:
+        ld      h,-18(ix)
+        ld      l,-19(ix)
+        exx
+        ld      h,-20(ix)
+        ld      l,-21(ix)
+        exx
+.as_e:
+        ld      d,-26(ix)
+        ld      e,-27(ix)
+        ret
+
+        ;; DE:DE' = s
+.s_de:
+        ld      d,-22(ix)
+        ld      e,-23(ix)
+        exx
+        ld      d,-24(ix)
+        ld      e,-25(ix)
+        exx
+        ret
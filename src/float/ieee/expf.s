@@ -0,0 +1,366 @@
+        ;; exponential (ieee-754 single) for sdcc z80
+        ;;
+        ;; float expf(float x);
+        ;;
+        ;; |x| = k ln 2 + r, 0 <= r < ln 2: k from |x| times log2(e)
+        ;; (16 x 16 bits), then r = |x| - k ln 2 with ln 2 split into
+        ;; a 24-bit head (k times it is exact in Q8.24) and a 32-bit
+        ;; tail, which puts r in Q0.32 within a unit. x < 0 takes
+        ;; -k - 1 and ln 2 - r. |x| < 1/2 skips all of it (k = 0 or -1).
+        ;;
+        ;; exp r is a shift-and-add product, digit by digit like the
+        ;; CORDIC rotation (see fpcordic.s): for i = 1..16, when
+        ;; r >= ln(1 + 2^-i) it is subtracted and v += v >> i, from
+        ;; v = 1. the r left over (below 2^-16) is one linear step,
+        ;; v += v r. the result is v 2^k, within 1 ulp.
+        ;;
+        ;; |x| < 2^-25 gives 1, |x| >= 128 gives +Inf or +0, past that
+        ;; the pack overflows to +Inf or underflows.
+        ;; fast profile: denormals give 1.
+        ;; FLOAT_PROFILE=ieee: NaN is returned quiet, exp(+Inf) = +Inf,
+        ;; exp(-Inf) = +0, small results are denormals.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in regs: HLDE  (H=x3, L=x2, D=x1, E=x0)
+        ;;   result in HLDE
+        ;;
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module expf
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _expf
+        .globl  __fp_unpack_norm
+        .globl  __fp_norm_pack
+        .globl  __fp_shr32
+        .globl  __fp_srl_bc
+        .globl  __fp_ln_tab
+        .globl  __fp_mul8x32
+        .globl  __mulhu32
+        .globl  ___muluint2ulong
+
+        .include "config.inc"
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+2,3: return address
+;;   ix+0,1: saved ix
+;;   ix-1 : H = x3        \  push hl
+;;   ix-2 : L = x2        /
+;;   ix-3 : D = x1        \  push de
+;;   ix-4 : E = x0        /
+;;   ix-5 : sign mask for __fp_norm_pack (0)
+;;   ix-6 : step i
+;;   ix-8,-7   : k
+;;   ix-12..-9 : |x| in Q8.24, then d << 8 (lsb first)
+;; ============================================================
+
+        ;; _expf
+        ;; inputs:  x in HLDE
+        ;; outputs: HLDE = exp(x)
+_expf:
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+        push    hl
+        push    de
+        ld      hl,#-8
+        add     hl,sp
+        ld      sp,hl
+        xor     a
+        ld      -5(ix),a
+        ld      -7(ix),a
+        ld      -8(ix),a                ; k = 0
+
+        ld      a,-2(ix)
+        rla
+        ld      a,-1(ix)
+        rla                             ; a = biased exponent
+.if FLOAT_IEEE
+        cp      #0xFF
+        jp      z,.special
+.endif
+        cp      #127-25
+        jp      c,.one                  ; |x| < 2^-25
+        cp      #127+7
+        jp      nc,.huge                ; |x| >= 128
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        call    __fp_unpack_norm        ; |x| = m / 2^31 * 2^e
+        bit     7,d
+        jr      z,.reduce
+        ld      a,e
+        inc     a
+        jr      z,.reduce               ; e = -1
+
+        ;; ---- |x| < 1/2: r = x, or k = -1 and r = ln 2 + x ----
+        neg
+        call    __fp_shr32              ; |x|, Q0.32
+        bit     7,-1(ix)
+        jp      z,.kernel
+        dec     -7(ix)
+        dec     -8(ix)
+        call    .ln2_sub
+        jp      .kernel
+
+        ;; ---- k = |x| log2(e), r = |x| - k ln 2 ----
+.reduce:
+        ld      a,#7
+        sub     e
+        call    __fp_shr32              ; |x|, Q8.24
+        ld      -9(ix),h
+        ld      -10(ix),l
+        exx
+        ld      -11(ix),h
+        ld      -12(ix),l
+        exx
+        ld      a,#15
+        call    __fp_shr32
+        exx
+        push    hl
+        exx
+        pop     hl                      ; |x| / 2^-9
+        ld      de,#0xB8AA              ; log2(e), Q1.15
+        call    ___muluint2ulong        ; h = k
+        ld      -8(ix),h                ; k, at most 1 short
+        ld      e,h
+        ld      bc,#0x00B1
+        exx
+        ld      bc,#0x7217              ; ln 2 head, Q8.24
+        exx
+        call    __fp_mul8x32            ; k ln 2 head, exact
+        exx
+        ld      a,-12(ix)
+        sub     l
+        ld      l,a
+        ld      a,-11(ix)
+        sbc     a,h
+        ld      h,a
+        exx
+        ld      a,-10(ix)
+        sbc     a,l
+        ld      l,a
+        ld      a,-9(ix)
+        sbc     a,h
+        ld      h,a                     ; d = |x| - k ln 2 head, Q8.24
+.d_fix:
+        exx
+        ld      a,l
+        sub     #0x17
+        ld      c,a
+        ld      a,h
+        sbc     a,#0x72
+        ld      b,a
+        exx
+        ld      a,l
+        sbc     a,#0xB1
+        ld      c,a
+        ld      a,h
+        sbc     a,#0x00
+        jr      c,.d_ok
+        ld      h,a
+        ld      l,c
+        exx
+        ld      h,b
+        ld      l,c
+        exx
+        inc     -8(ix)                  ; d >= ln 2 head: k + 1
+        jr      .d_fix
+.d_ok:
+        ld      a,l                     ; d < 2^24
+        exx
+        ld      -9(ix),a
+        ld      -10(ix),h
+        ld      -11(ix),l
+        ld      -12(ix),#0
+        exx                             ; d << 8, Q0.32
+        ld      e,-8(ix)
+        ld      bc,#0xF7D1
+        exx
+        ld      bc,#0xCF7A              ; ln 2 tail, 2^-56 units
+        exx
+        call    __fp_mul8x32            ; a:h = k ln 2 tail, Q0.32
+        ld      c,h
+        ld      b,a
+        push    bc
+        ld      h,-9(ix)
+        ld      l,-10(ix)
+        exx
+        ld      h,-11(ix)
+        ld      l,-12(ix)
+        pop     bc
+        or      a
+        sbc     hl,bc
+        exx
+        ld      bc,#0
+        sbc     hl,bc                   ; r = d - k ln 2 tail
+        jr      nc,.r_ok
+        exx
+        ld      bc,#0x17F8
+        add     hl,bc
+        exx
+        ld      bc,#0xB172              ; ln 2, Q0.32
+        adc     hl,bc
+        dec     -8(ix)                  ; r < 0: k - 1
+.r_ok:
+        bit     7,-1(ix)
+        jr      z,.kernel
+
+        ;; ---- x < 0: exp(-k ln 2 - r) = 2^(-k-1) exp(ln 2 - r) ----
+        ld      a,h
+        or      l
+        exx
+        or      h
+        or      l
+        exx
+        jr      z,.r_zero
+        call    .ln2_sub
+        ld      a,-8(ix)
+        cpl
+        ld      -8(ix),a
+        ld      -7(ix),#0xFF            ; -k - 1
+        jr      .kernel
+.r_zero:
+        xor     a
+        sub     -8(ix)
+        ld      -8(ix),a
+        sbc     a,a
+        ld      -7(ix),a                ; -k
+
+        ;; ---- v = exp(r), r in Q0.32, v in Q1.31 ----
+.kernel:
+        ex      de,hl
+        exx
+        ex      de,hl
+        ld      hl,#0
+        exx
+        ld      hl,#0x8000              ; v = 1
+        ld      iy,#__fp_ln_tab
+        ld      -6(ix),#1
+.step:
+        exx
+        ld      a,e
+        sub     0(iy)
+        ld      c,a
+        ld      a,d
+        sbc     a,1(iy)
+        ld      b,a
+        exx
+        ld      a,e
+        sbc     a,2(iy)
+        ld      c,a
+        ld      a,d
+        sbc     a,3(iy)
+        jr      c,.next                 ; r < ln(1 + 2^-i)
+        ld      d,a
+        ld      e,c
+        exx
+        ld      d,b
+        ld      e,c
+        exx                             ; r -= ln(1 + 2^-i)
+        ld      b,h
+        ld      c,l
+        exx
+        ld      b,h
+        ld      c,l
+        exx
+        ld      a,-6(ix)
+        call    __fp_srl_bc             ; bc = v >> i, cf = round
+        exx
+        adc     hl,bc
+        exx
+        adc     hl,bc                   ; v += v >> i
+        jr      nc,.next
+        call    .v_max
+.next:
+        ld      bc,#4
+        add     iy,bc
+        inc     -6(ix)
+        ld      a,-6(ix)
+        cp      #17
+        jr      nz,.step
+        push    hl
+        ld      b,h
+        ld      c,l
+        exx
+        push    hl
+        ld      b,h
+        ld      c,l
+        exx
+        call    __mulhu32               ; v r
+        exx
+        pop     bc
+        add     hl,bc
+        exx
+        pop     bc
+        adc     hl,bc                   ; v += v r
+        call    c,.v_max
+        ld      e,-8(ix)
+        ld      d,-7(ix)
+        call    __fp_norm_pack          ; v 2^k
+        jr      .done
+
+.if FLOAT_IEEE
+        ;; ---- exponent 255: NaN quiet, +-Inf as |x| >= 128 ----
+.special:
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        jr      z,.huge
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        set     6,l
+        jr      .done
+.endif
+.huge:
+        ld      de,#0
+        ld      h,d
+        ld      l,d                     ; x < 0: +0
+        bit     7,-1(ix)
+        jr      nz,.done
+        ld      hl,#0x7F80              ; +Inf
+        jr      .done
+.one:
+        ld      hl,#0x3F80
+        ld      de,#0
+.done:
+        ld      sp,ix
+        pop     ix
+        ret
+
+        ;; HL:HL' = ln 2 - HL:HL' (ln 2 = 0xB17217F8, Q0.32)
+.ln2_sub:
+        exx
+        ld      a,#0xF8
+        sub     l
+        ld      l,a
+        ld      a,#0x17
+        sbc     a,h
+        ld      h,a
+        exx
+        ld      a,#0x72
+        sbc     a,l
+        ld      l,a
+        ld      a,#0xB1
+        sbc     a,h
+        ld      h,a
+        ret
+
+        ;; HL:HL' = 2^32 - 1 (v saturates just below 2)
+.v_max:
+        ld      hl,#0xFFFF
+        exx
+        ld      hl,#0xFFFF
+        exx
+        ret
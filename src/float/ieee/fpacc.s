@@ -0,0 +1,412 @@
+        ;; unpacked float accumulator for sdcc z80
+        ;;
+        ;; a running sum kept in a caller-provided fpacc_t (include/fpacc.h)
+        ;; instead of a packed float: 32-bit mantissa, 16-bit exponent and
+        ;; a sign byte. adding to it skips the pack/unpack round trip of
+        ;; ___fsadd, and the 8 extra mantissa bits make the sum of a long
+        ;; series more accurate than chained float adds. the sum is rounded
+        ;; to a float once, by fpacc_result.
+        ;;
+        ;; fpacc_t layout (7 bytes):
+        ;;   0..3 : mantissa m0..m3, bit 31 set, 0 while the sum is zero
+        ;;   4..5 : biased exponent of bit 31 (signed 16-bit)
+        ;;   6    : sign (0x00 or 0x80)
+        ;;
+        ;; FLOAT_PROFILE=ieee keeps Inf and NaN sums as exponent 0x7FFF
+        ;; with mantissa 0x80000000 (Inf) or 0xC0000000 (NaN); finite sums
+        ;; never get there.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   acc pointer in HL, float argument on stack
+        ;;   callee cleans the float from stack
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fpacc
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fpacc_init
+        .globl  _fpacc_add
+        .globl  __fpacc_addf
+        .globl  __fpacc_add32
+        .globl  __fp_retpop4
+
+        .include "config.inc"
+
+        ;; _fpacc_init
+        ;; inputs:  HL = acc
+        ;; outputs: acc = +0
+        ;; clobbers: af, b, hl
+_fpacc_init:
+        xor     a
+        ld      b,#7
+.init_loop:
+        ld      (hl),a
+        inc     hl
+        djnz    .init_loop
+        ret
+
+        ;; _fpacc_add
+        ;; inputs:  HL = acc, x at 2(sp)..5(sp) (lsb..msb)
+        ;; outputs: acc += x
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl', iy
+_fpacc_add:
+        push    hl
+        pop     iy
+        ld      hl,#2
+        add     hl,sp
+        ld      e,(hl)          ; bcde = x
+        inc     hl
+        ld      d,(hl)
+        inc     hl
+        ld      c,(hl)
+        inc     hl
+        ld      b,(hl)
+        call    __fpacc_addf
+        jp      __fp_retpop4
+
+        ;; __fpacc_addf
+        ;; inputs:  IY = acc, BCDE = x (B = x3)
+        ;; outputs: acc += x
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl'
+__fpacc_addf:
+        ;; mantissa to d'e':de, implicit 1 at bit 31
+        ld      a,c
+        or      #0x80
+        exx
+        ld      d,a
+        exx
+        ld      a,d
+        exx
+        ld      e,a
+        exx
+        ld      d,e
+        ld      e,#0
+
+        ld      a,c             ; biased exponent
+        rla
+        ld      a,b
+        rla
+        ld      c,a
+        ld      a,b
+        and     #0x80           ; sign
+        ld      b,#0
+
+.if FLOAT_IEEE
+        inc     c
+        jr      z,.add_special
+        dec     c
+        jr      nz,.add_finite
+
+        ;; zero or denormal: exponent 1 and no implicit 1
+        ld      l,a
+        exx
+        res     7,d
+        ld      a,d
+        or      e
+        exx
+        or      d
+        ld      a,l
+        ret     z               ; +-0 leaves the sum alone
+        ld      c,#1
+.add_denorm:
+        exx
+        bit     7,d
+        exx
+        jr      nz,.add_finite
+        sla     e
+        rl      d
+        exx
+        rl      e
+        rl      d
+        exx
+        dec     bc
+        jr      .add_denorm
+
+.add_special:
+        ld      bc,#0x7FFF      ; Inf keeps 0x80000000, NaN becomes quiet
+        ld      l,a
+        exx
+        ld      a,d
+        and     #0x7F
+        or      e
+        exx
+        or      d
+        ld      a,l
+        jr      z,.add_finite
+        exx
+        ld      d,#0xC0
+        exx
+.add_finite:
+.else
+        inc     c               ; denormals and zero are flushed
+        dec     c
+        ret     z
+.endif
+                                ; falls into __fpacc_add32
+
+        ;; __fpacc_add32
+        ;; inputs:  IY = acc, d'e':de = mantissa with bit 31 set,
+        ;;          BC = biased exponent, A = sign (0x00 or 0x80)
+        ;; outputs: acc += operand
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl'
+        ;; notes: the smaller operand is shifted right with the bits that
+        ;;        fall off jammed into bit 0, so the 8 bits below the
+        ;;        float mantissa round correctly in fpacc_result.
+__fpacc_add32:
+.if FLOAT_IEEE
+        ld      l,a
+        ld      a,5(iy)
+        cp      #0x7F
+        jp      z,.acc_special
+        ld      a,b
+        cp      #0x7F
+        ld      a,l
+        jp      z,.store        ; Inf/NaN operand replaces a finite sum
+.endif
+        bit     7,3(iy)
+        jp      z,.store        ; zero sum: take the operand
+
+        xor     6(iy)
+        ex      af,af'          ; a' = 0x80 when the signs differ
+
+        ld      l,4(iy)
+        ld      h,5(iy)
+        or      a
+        sbc     hl,bc           ; hl = exp acc - exp operand
+        bit     7,h
+        jr      nz,.op_larger
+
+        ;; acc is larger: h'l':hl = acc, shift the operand by hl
+        ld      b,h
+        ld      c,l
+        ld      l,0(iy)
+        ld      h,1(iy)
+        exx
+        ld      l,2(iy)
+        ld      h,3(iy)
+        exx
+        jr      .align
+
+.op_larger:
+        ;; operand is larger: it takes over exponent and sign
+        ld      4(iy),c
+        ld      5(iy),b
+        xor     a
+        sub     l
+        ld      c,a
+        sbc     a,a
+        sub     h
+        ld      b,a             ; bc = exp operand - exp acc
+        ex      af,af'
+        ld      l,a
+        ex      af,af'
+        ld      a,6(iy)
+        xor     l
+        ld      6(iy),a
+        ex      de,hl           ; h'l':hl = operand
+        ld      e,0(iy)
+        ld      d,1(iy)
+        exx
+        ex      de,hl
+        ld      e,2(iy)
+        ld      d,3(iy)
+        exx
+
+.align:
+        ;; shift d'e':de right by bc, lost bits jammed into bit 0
+        ld      a,b
+        or      a
+        jr      nz,.align_all
+        ld      a,c
+        cp      #32
+        jr      nc,.align_all
+        ld      b,a
+        ld      c,#0            ; c != 0: a whole byte fell off
+.align_bytes:
+        ld      a,b
+        cp      #8
+        jr      c,.align_bits
+        sub     #8
+        ld      b,a
+        ld      a,c
+        or      e
+        ld      c,a
+        ld      e,d
+        exx
+        ld      a,e
+        ld      e,d
+        ld      d,#0
+        exx
+        ld      d,a
+        jr      .align_bytes
+.align_bits:
+        or      a
+        jr      z,.align_jam
+.align_bit:
+        exx
+        srl     d
+        rr      e
+        exx
+        rr      d
+        rr      e
+        jr      nc,.align_next
+        set     0,e
+.align_next:
+        djnz    .align_bit
+.align_jam:
+        ld      a,c
+        or      a
+        jr      z,.op
+        set     0,e
+        jr      .op
+
+.align_all:
+        ld      de,#1           ; far below: only its sticky bit
+        exx
+        ld      de,#0
+        exx
+
+.op:
+        ex      af,af'
+        or      a
+        jr      nz,.sub
+
+        add     hl,de
+        exx
+        adc     hl,de
+        exx
+        jr      nc,.store_hl
+        exx                     ; carry out: shift right, exponent + 1
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        jr      nc,.add_inc
+        set     0,l
+.add_inc:
+        inc     4(iy)
+        jr      nz,.store_hl
+        inc     5(iy)
+        jr      .store_hl
+
+.sub:
+        or      a
+        sbc     hl,de
+        exx
+        sbc     hl,de
+        exx
+        jr      nc,.sub_norm
+        xor     a               ; operand was the larger: negate, flip sign
+        sub     l
+        ld      l,a
+        ld      a,#0
+        sbc     a,h
+        ld      h,a
+        exx
+        ld      a,#0
+        sbc     a,l
+        ld      l,a
+        ld      a,#0
+        sbc     a,h
+        ld      h,a
+        exx
+        ld      a,6(iy)
+        xor     #0x80
+        ld      6(iy),a
+.sub_norm:
+        ld      a,h
+        or      l
+        exx
+        or      h
+        or      l
+        exx
+        jr      z,.zero
+
+        ;; normalize: shift left until bit 31 is set
+        ld      c,4(iy)
+        ld      b,5(iy)
+.norm_loop:
+        exx
+        ld      a,h
+        exx
+        bit     7,a
+        jr      nz,.norm_done
+        or      a
+        jr      nz,.norm_bit
+        exx                     ; zero top byte: move up 8 bits
+        ld      h,l
+        exx
+        ld      a,h
+        exx
+        ld      l,a
+        exx
+        ld      h,l
+        ld      l,#0
+        ld      a,c
+        sub     #8
+        ld      c,a
+        jr      nc,.norm_loop
+        dec     b
+        jr      .norm_loop
+.norm_bit:
+        add     hl,hl
+        exx
+        adc     hl,hl
+        exx
+        dec     bc
+        jr      .norm_loop
+.norm_done:
+        ld      4(iy),c
+        ld      5(iy),b
+
+.store_hl:
+        ld      0(iy),l
+        ld      1(iy),h
+        exx
+        ld      2(iy),l
+        ld      3(iy),h
+        exx
+        ret
+
+.store:
+        ld      0(iy),e
+        ld      1(iy),d
+        exx
+        ld      2(iy),e
+        ld      3(iy),d
+        exx
+        ld      4(iy),c
+        ld      5(iy),b
+        ld      6(iy),a
+        ret
+
+.zero:
+        xor     a               ; exact cancellation: +0
+        ld      3(iy),a
+        ld      4(iy),a
+        ld      5(iy),a
+        ld      6(iy),a
+        ret
+
+.if FLOAT_IEEE
+.acc_special:
+        bit     6,3(iy)
+        ret     nz              ; NaN stays NaN
+        ld      a,b
+        cp      #0x7F
+        ret     nz              ; Inf + finite
+        exx
+        bit     6,d
+        exx
+        ld      a,l
+        jr      nz,.store       ; Inf + NaN
+        xor     6(iy)
+        ret     z               ; Inf + Inf
+        ld      3(iy),#0xC0     ; Inf - Inf
+        ret
+.endif
@@ -0,0 +1,205 @@
+        ;; unpacked float accumulator: multiply-add
+        ;;
+        ;; acc += a * b without packing the product: the 48-bit mantissa
+        ;; product is cut to 32 bits (lower bits jammed into bit 0) and
+        ;; handed to __fpacc_add32 with its 16-bit exponent. see fpacc.s
+        ;; for the accumulator layout.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   acc pointer in HL
+        ;;   a, b on stack: 4 bytes each, a nearest to the return address
+        ;;   callee cleans a and b from stack
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fpaccmul
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fpacc_mul_add
+        .globl  __fpacc_mul_frame
+        .globl  __fpacc_add32
+        .globl  __fp_retpop4
+        .globl  __fp_unpack_sign_exps
+        .globl  __fp_unpack_mant24_ab
+        .globl  __fp_mul48_ab
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_nan_ab
+        .globl  __fp_class_ab
+        .globl  __fp_ieee_norm_ab
+.endif
+
+;; ============================================================
+;; Frame layout (same as ___fsmul):
+;;
+;;   ix+4..7  : b0..b3
+;;   ix+2,3   : return address
+;;   ix+0,1   : saved ix
+;;   ix-1..-4 : a3..a0
+;;   ix-5     : sign of a*b
+;;   ix-7..-12  : mant_a, mant_b (see __fp_unpack_mant24_ab)
+;;   ix-13..-18 : prod[0..5] (see __fp_mul48_ab)
+;; ============================================================
+
+        ;; _fpacc_mul_add
+        ;; inputs:  HL = acc, a at 2(sp)..5(sp), b at 6(sp)..9(sp)
+        ;; outputs: acc += a * b
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl', iy
+_fpacc_mul_add:
+        push    hl
+        pop     iy              ; iy = acc
+        pop     bc              ; return address
+        pop     de              ; e = a0, d = a1
+        pop     hl              ; l = a2, h = a3
+        push    bc              ; b is left for __fp_retpop4
+
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+
+        push    hl              ; ix-1=H(a3), ix-2=L(a2)
+        push    de              ; ix-3=D(a1), ix-4=E(a0)
+
+        ;; allocate locals (14 bytes)
+        ld      hl,#-14
+        add     hl,sp
+        ld      sp,hl
+
+        call    __fpacc_mul_frame
+
+        ld      sp,ix
+        pop     ix
+        jp      __fp_retpop4
+
+        ;; __fpacc_mul_frame
+        ;; inputs:  IX frame above: a at -4..-1(ix), b at 4..7(ix),
+        ;;          locals allocated; IY = acc
+        ;; outputs: acc += a * b
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl'
+        ;; notes: fs_dot (fsdot.s) builds this frame once and calls it
+        ;;        per element.
+__fpacc_mul_frame:
+        call    __fp_unpack_sign_exps
+
+.if FLOAT_IEEE
+        ;; ---- zero, denormal, Inf and NaN operands ----
+        ld      a,c
+        dec     a
+        cp      #254
+        jr      nc,.special
+        ld      a,b
+        dec     a
+        cp      #254
+        jr      c,.normal
+
+.special:
+        call    __fp_nan_ab
+        jr      c,.add_nan
+        call    __fp_class_ab
+        ld      a,d
+        or      a
+        jr      z,.zero_prod
+        ld      a,e
+        or      a
+        jr      z,.zero_prod
+        ld      a,d
+        cp      #2
+        jr      z,.add_inf
+        ld      a,e
+        cp      #2
+        jr      z,.add_inf
+
+        ;; only denormals left
+        call    __fp_unpack_mant24_ab
+        call    __fp_ieee_norm_ab
+        jr      .exp_p
+
+.zero_prod:
+        ld      a,d             ; 0 * Inf is NaN, else nothing to add
+        or      e
+        cp      #2
+        jr      nz,.done
+.add_nan:
+        ld      a,#0xC0
+        jr      .add_special
+.add_inf:
+        ld      a,#0x80
+.add_special:
+        exx
+        ld      d,a
+        ld      e,#0
+        exx
+        ld      de,#0
+        ld      bc,#0x7FFF
+        ld      a,-5(ix)
+        call    __fpacc_add32
+        jr      .done
+
+.normal:
+        call    __fp_unpack_mant24_ab
+        ld      h,#0
+        ld      l,c
+        ld      d,h
+        ld      e,b
+.else
+        ;; ---- zero/denormal a or b: nothing to add ----
+        ld      a,c
+        or      a
+        jr      z,.done
+        ld      a,b
+        or      a
+        jr      z,.done
+
+        call    __fp_unpack_mant24_ab
+        ld      h,#0
+        ld      l,c
+        ld      d,h
+        ld      e,b
+.endif
+
+        ;; ---- exponent of the product: EA + EB - 127 ----
+.exp_p:
+        add     hl,de
+        ld      de,#-127
+        add     hl,de
+        push    hl
+
+        ;; ---- 24x24 multiply into prod[5:0] ----
+        call    __fp_mul48_ab
+
+        ;; ---- top 32 bits to d'e':de, bit 31 set ----
+        exx
+        ld      d,-18(ix)
+        ld      e,-17(ix)
+        exx
+        ld      d,-16(ix)
+        ld      e,-15(ix)
+        ld      a,-14(ix)
+        pop     bc
+        bit     7,-18(ix)
+        jr      z,.p_shift
+        inc     bc
+        jr      .p_sticky
+.p_shift:
+        add     a,a             ; one bit up, prod[1] bit 7 comes in
+        rl      e
+        rl      d
+        exx
+        rl      e
+        rl      d
+        exx
+.p_sticky:
+        or      -13(ix)
+        jr      z,.p_add
+        set     0,e
+.p_add:
+        ld      a,-5(ix)
+        call    __fpacc_add32
+
+.done:
+        ret
@@ -0,0 +1,89 @@
+        ;; unpacked float accumulator: result
+        ;;
+        ;; rounds the 32-bit accumulator mantissa to a float once, per
+        ;; FLOAT_ROUND. the low mantissa byte is the guard byte of
+        ;; __fp_round_pack. see fpacc.s for the accumulator layout.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   acc pointer in HL
+        ;;   result in HLDE
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fpaccres
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fpacc_result
+        .globl  __fp_zero32
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_nan32
+        .globl  __fp_ieee_pack
+.else
+        .globl  __fp_round_pack
+.endif
+
+        ;; _fpacc_result
+        ;; inputs:  HL = acc
+        ;; outputs: HLDE = the sum as an IEEE-754 single
+        ;; clobbers: af, bc, de, hl, iy
+_fpacc_result:
+        push    hl
+        pop     iy
+        bit     7,3(iy)
+        jp      z,__fp_zero32   ; empty or cancelled sum: +0
+
+.if FLOAT_IEEE
+        ld      l,4(iy)
+        ld      h,5(iy)
+        ld      a,h
+        cp      #0x7F
+        jr      nz,.pack
+        bit     6,3(iy)
+        jp      nz,__fp_nan32
+        ld      h,6(iy)         ; +-Inf
+        jr      .ret_inf
+.pack:
+        ld      b,6(iy)
+        ld      c,3(iy)
+        ld      d,2(iy)
+        ld      e,1(iy)
+        ld      a,0(iy)         ; guard byte
+        jp      __fp_ieee_pack
+.else
+        ld      a,5(iy)
+        or      a
+        jr      nz,.exp_out
+        ld      a,4(iy)
+        or      a
+        jp      z,__fp_zero32
+        inc     a
+        jr      z,.ret_huge
+        ld      b,6(iy)
+        ld      c,4(iy)
+        ld      a,3(iy)
+        and     #0x7F
+        ld      l,a
+        ld      d,2(iy)
+        ld      e,1(iy)
+        ld      a,0(iy)         ; guard byte
+        jp      __fp_round_pack
+
+.exp_out:
+        bit     7,a
+        jp      nz,__fp_zero32
+.ret_huge:
+        ld      h,6(iy)         ; overflow: +-Inf
+.endif
+.ret_inf:
+        ld      a,h
+        or      #0x7F
+        ld      h,a
+        ld      l,#0x80
+        ld      de,#0
+        ret
@@ -0,0 +1,300 @@
+        ;; CORDIC engine and ROM tables for the float kernels
+        ;;
+        ;; 16 shift-and-add rotations by the angles atan(2^-i):
+        ;;   up:    x -= y >> i, y += x >> i
+        ;;   down:  x += y >> i, y -= x >> i
+        ;; in rotation mode the directions come from a mask made by
+        ;; __fp_cordic_z2d (sign of the angle left over after each
+        ;; step), in vectoring mode from the sign of y, driving y to 0.
+        ;; __fp_cordic_d2z sums the angles of a mask back into z. each
+        ;; shift rounds (the last bit out is added back with adc / sbc),
+        ;; which keeps the 16 steps within a few units of 2^-30.
+        ;;
+        ;; x is unsigned (vectoring can grow it past 2^31), y and z are
+        ;; signed. angles are Q1.31 (2^31 = 1 radian), x and y Q2.30.
+        ;;
+        ;; __fp_ln_tab is ln(1 + 2^-i) for the shift-and-add exp and log
+        ;; kernels (expf.s, logf.s), which are the same digit by digit
+        ;; idea with a multiply by 1 + 2^-i in place of a rotation.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fpcordic
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+        .globl  __fp_cordic
+        .globl  __fp_cordic_z2d
+        .globl  __fp_cordic_d2z
+        .globl  __fp_srl_bc
+        .globl  __fp_ln_tab
+
+        ;; __fp_cordic_z2d
+        ;; inputs:  HL:HL' = z (Q1.31, |z| < 1.74)
+        ;; outputs: IY = directions, bit 15 first, 1 = up (z >= 0),
+        ;;          HL:HL' = z left after the 16 angles
+        ;; clobbers: af, bc, de, de'
+__fp_cordic_z2d:
+        ld      iy,#0
+        ld      bc,#.atan_tab
+.z2d_step:
+        add     iy,iy
+        call    .tab_ld
+        bit     7,h
+        jr      nz,.z2d_add
+        inc     iy
+        exx
+        or      a
+        sbc     hl,de
+        exx
+        sbc     hl,de                   ; z -= atan(2^-i)
+        jr      .z2d_next
+.z2d_add:
+        exx
+        add     hl,de
+        exx
+        adc     hl,de                   ; z += atan(2^-i)
+.z2d_next:
+        ld      a,c
+        cp      #<.atan_end
+        jr      nz,.z2d_step
+        ret
+
+        ;; __fp_cordic_d2z
+        ;; inputs:  IY = directions, bit 15 first, 1 = add the angle
+        ;; outputs: HL:HL' = sum of +-atan(2^-i) (Q1.31)
+        ;; clobbers: af, bc, de, de', iy
+__fp_cordic_d2z:
+        ld      hl,#0
+        exx
+        ld      hl,#0
+        exx
+        ld      bc,#.atan_tab
+.d2z_step:
+        call    .tab_ld
+        add     iy,iy
+        jr      nc,.d2z_sub
+        exx
+        add     hl,de
+        exx
+        adc     hl,de
+        jr      .d2z_next
+.d2z_sub:
+        exx
+        or      a
+        sbc     hl,de
+        exx
+        sbc     hl,de
+.d2z_next:
+        ld      a,c
+        cp      #<.atan_end
+        jr      nz,.d2z_step
+        ret
+
+        ;; DE:DE' = table entry at bc, bc += 4
+.tab_ld:
+        ld      a,(bc)
+        inc     bc
+        exx
+        ld      e,a
+        exx
+        ld      a,(bc)
+        inc     bc
+        exx
+        ld      d,a
+        exx
+        ld      a,(bc)
+        inc     bc
+        ld      e,a
+        ld      a,(bc)
+        inc     bc
+        ld      d,a
+        ret
+
+        ;; __fp_cordic
+        ;; inputs:  HL:HL' = x (unsigned Q2.30), DE:DE' = y (signed Q2.30),
+        ;;          IY = directions (rotation mode, see __fp_cordic_z2d),
+        ;;          -6(ix) = 0x00 rotation or 0x80 vectoring mode
+        ;; outputs: HL:HL' = x, DE:DE' = y after 16 steps,
+        ;;          IY = directions taken (vectoring mode, 1 = y >= 0,
+        ;;          the angle is added)
+        ;; clobbers: af, bc, bc', iy, -6(ix)
+        ;; notes: -6(ix) bits 0..4 count the steps, bit 6 is the
+        ;;        direction of the current one.
+__fp_cordic:
+        add     iy,iy
+        bit     7,-6(ix)
+        jr      z,.rotate
+        bit     7,d
+        jr      nz,.up                  ; y < 0
+        inc     iy
+        jr      .down
+.rotate:
+        jr      c,.up
+.down:
+        res     6,-6(ix)
+        jr      .shift
+.up:
+        set     6,-6(ix)
+.shift:
+        push    hl
+        exx
+        push    hl
+        exx                             ; old x
+        ld      b,d
+        ld      c,e
+        exx
+        ld      b,d
+        ld      c,e
+        exx
+        ld      a,-6(ix)
+        and     #0x1F
+        call    .sra_bc                 ; bc = y >> i, cf = round
+        bit     6,-6(ix)
+        jr      z,.x_add
+        exx
+        sbc     hl,bc
+        exx
+        sbc     hl,bc                   ; x -= y >> i
+        jr      .x_done
+.x_add:
+        exx
+        adc     hl,bc
+        exx
+        adc     hl,bc                   ; x += y >> i
+.x_done:
+        exx
+        pop     bc
+        exx
+        pop     bc                      ; bc = old x
+        ld      a,-6(ix)
+        and     #0x1F
+        call    __fp_srl_bc             ; bc = x >> i, cf = round
+        bit     6,-6(ix)
+        jr      z,.y_sub
+        exx
+        ex      de,hl
+        adc     hl,bc
+        ex      de,hl
+        exx
+        ex      de,hl
+        adc     hl,bc
+        ex      de,hl                   ; y += x >> i
+        jr      .next
+.y_sub:
+        exx
+        ex      de,hl
+        sbc     hl,bc
+        ex      de,hl
+        exx
+        ex      de,hl
+        sbc     hl,bc
+        ex      de,hl                   ; y -= x >> i
+.next:
+        inc     -6(ix)
+        ld      a,-6(ix)
+        and     #0x1F
+        cp      #16
+        jr      nz,__fp_cordic
+        ret
+
+        ;; __fp_srl_bc
+        ;; inputs:  BC:BC' = x, A = count (0..16)
+        ;; outputs: BC:BC' = x >> A (logical), cf = last bit shifted out
+        ;;          (0 for a count of 0), so adc / sbc round the shift
+        ;; clobbers: af
+__fp_srl_bc:
+        or      a
+        ret     z
+        cp      #9
+        jr      c,.srl_bits
+        sub     #8
+        ex      af,af'
+        ld      a,c
+        ld      c,b
+        ld      b,#0
+        exx
+        ld      c,b
+        ld      b,a
+        exx
+        ex      af,af'
+.srl_bits:
+        srl     b
+        rr      c
+        exx
+        rr      b
+        rr      c
+        exx
+        dec     a
+        jr      nz,.srl_bits
+        ret
+
+        ;; BC:BC' >>= A (arithmetic), as __fp_srl_bc
+.sra_bc:
+        or      a
+        ret     z
+        cp      #9
+        jr      c,.sra_bits
+        sub     #8
+        ex      af,af'
+        ld      a,c
+        exx
+        ld      c,b
+        ld      b,a
+        exx
+        ld      c,b
+        ld      a,b
+        rla
+        sbc     a,a
+        ld      b,a
+        ex      af,af'
+.sra_bits:
+        sra     b
+        rr      c
+        exx
+        rr      b
+        rr      c
+        exx
+        dec     a
+        jr      nz,.sra_bits
+        ret
+
+        ;; atan(2^-i), i = 0..15, Q1.31 lsb first
+.atan_tab:
+        .db     0x51, 0xed, 0x87, 0x64      ; atan(2^-0)
+        .db     0x0b, 0xce, 0x58, 0x3b      ; atan(2^-1)
+        .db     0xf9, 0x75, 0x5b, 0x1f      ; atan(2^-2)
+        .db     0x4d, 0xdd, 0xea, 0x0f      ; atan(2^-3)
+        .db     0xee, 0x56, 0xfd, 0x07      ; atan(2^-4)
+        .db     0xb7, 0xaa, 0xff, 0x03      ; atan(2^-5)
+        .db     0x56, 0xf5, 0xff, 0x01      ; atan(2^-6)
+        .db     0xab, 0xfe, 0xff, 0x00      ; atan(2^-7)
+        .db     0xd5, 0xff, 0x7f, 0x00      ; atan(2^-8)
+        .db     0xfb, 0xff, 0x3f, 0x00      ; atan(2^-9)
+        .db     0xff, 0xff, 0x1f, 0x00      ; atan(2^-10)
+        .db     0x00, 0x00, 0x10, 0x00      ; atan(2^-11)
+        .db     0x00, 0x00, 0x08, 0x00      ; atan(2^-12)
+        .db     0x00, 0x00, 0x04, 0x00      ; atan(2^-13)
+        .db     0x00, 0x00, 0x02, 0x00      ; atan(2^-14)
+        .db     0x00, 0x00, 0x01, 0x00      ; atan(2^-15)
+.atan_end:
+
+        ;; ln(1 + 2^-i), i = 1..16, Q0.32 lsb first
+__fp_ln_tab:
+        .db     0xb3, 0x8f, 0xcc, 0x67      ; ln(1 + 2^-1)
+        .db     0x8f, 0xef, 0x1f, 0x39      ; ln(1 + 2^-2)
+        .db     0x6e, 0x07, 0x27, 0x1e      ; ln(1 + 2^-3)
+        .db     0x60, 0x18, 0x85, 0x0f      ; ln(1 + 2^-4)
+        .db     0xc4, 0xa6, 0xe0, 0x07      ; ln(1 + 2^-5)
+        .db     0x16, 0x15, 0xf8, 0x03      ; ln(1 + 2^-6)
+        .db     0xa7, 0x02, 0xfe, 0x01      ; ln(1 + 2^-7)
+        .db     0x55, 0x80, 0xff, 0x00      ; ln(1 + 2^-8)
+        .db     0x0b, 0xe0, 0x7f, 0x00      ; ln(1 + 2^-9)
+        .db     0x01, 0xf8, 0x3f, 0x00      ; ln(1 + 2^-10)
+        .db     0x00, 0xfe, 0x1f, 0x00      ; ln(1 + 2^-11)
+        .db     0x80, 0xff, 0x0f, 0x00      ; ln(1 + 2^-12)
+        .db     0xe0, 0xff, 0x07, 0x00      ; ln(1 + 2^-13)
+        .db     0xf8, 0xff, 0x03, 0x00      ; ln(1 + 2^-14)
+        .db     0xfe, 0xff, 0x01, 0x00      ; ln(1 + 2^-15)
+        .db     0x00, 0x00, 0x01, 0x00      ; ln(1 + 2^-16)
@@ -0,0 +1,138 @@
+        ;; shared decimal scaling for ftoa and strtof
+        ;;
+        ;; a value is kept as a 32-bit mantissa m with bit 31 set and a
+        ;; 16-bit binary exponent e:
+        ;;   value = m / 2^31 * 2^e
+        ;; and multiplied by 10^p with at most two table entries,
+        ;; p = 16 * j + r:
+        ;;   __fp_pow10_tab   10^1 .. 10^15 (exact up to 10^13)
+        ;;   __fp_pow10_big   10^(16 j), j = -4 .. 3 (slot j = 0 unused)
+        ;; every entry is m (lsb first) and e (16-bit), rounded to 32 bits.
+        ;; each step keeps the top 32 bits of the product (__mulhu32), so
+        ;; the result is within a few units of 2^-31, well under the
+        ;; 2^-24 of a float.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fpdec
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+        .globl  __fp_scale10
+        .globl  __mulhu32
+
+        ;; __fp_scale10
+        ;; inputs:  BC:BC' = m (BC high, bit 31 set), HL = e,
+        ;;          A = p (-64..55)
+        ;; outputs: BC:BC' = m', HL = e' with m' / 2^31 * 2^e' about
+        ;;          m / 2^31 * 2^e * 10^p, bit 31 of m' set
+        ;; clobbers: af, de, hl, de', hl', iy
+__fp_scale10:
+        push    hl
+        pop     iy                      ; iy = e
+        ld      h,a                     ; h = p
+        and     #0x0F
+        jr      z,.big
+        dec     a                       ; 10^r at (r - 1) * 6
+        ld      e,a
+        add     a,a
+        add     a,e
+        add     a,a
+        ld      e,a
+        ld      d,#0
+        push    hl
+        ld      hl,#__fp_pow10_tab
+        add     hl,de
+        call    .mul
+        pop     hl
+.big:
+        ld      a,h
+        sra     a
+        sra     a
+        sra     a
+        sra     a                       ; a = j
+        or      a
+        jr      z,.done
+        add     a,#4                    ; 10^(16 j) at (j + 4) * 6
+        ld      e,a
+        add     a,a
+        add     a,e
+        add     a,a
+        ld      e,a
+        ld      d,#0
+        ld      hl,#__fp_pow10_big
+        add     hl,de
+        call    .mul
+.done:
+        push    iy
+        pop     hl
+        ret
+
+        ;; BC:BC' *= entry at HL, IY += its exponent
+.mul:
+        ld      e,(hl)
+        inc     hl
+        ld      d,(hl)
+        inc     hl
+        push    de                      ; entry m low word
+        ld      e,(hl)
+        inc     hl
+        ld      d,(hl)
+        inc     hl                      ; de = entry m high word
+        ld      a,(hl)
+        inc     hl
+        ld      h,(hl)
+        ld      l,a
+        ex      de,hl
+        add     iy,de                   ; e += entry e
+        ex      de,hl
+        exx
+        pop     de
+        exx
+        call    __mulhu32               ; HL:HL' = m * entry / 2^32
+        bit     7,h
+        jr      nz,.top
+        exx                             ; product in [1, 2): one bit up
+        add     hl,hl
+        exx
+        adc     hl,hl
+        jr      .move
+.top:
+        inc     iy                      ; product in [2, 4)
+.move:
+        ld      b,h
+        ld      c,l
+        exx
+        ld      b,h
+        ld      c,l
+        exx
+        ret
+
+        ;; m lsb first, then e
+__fp_pow10_tab:
+        .db     0x00, 0x00, 0x00, 0xa0, 0x03, 0x00      ; 10^1
+        .db     0x00, 0x00, 0x00, 0xc8, 0x06, 0x00      ; 10^2
+        .db     0x00, 0x00, 0x00, 0xfa, 0x09, 0x00      ; 10^3
+        .db     0x00, 0x00, 0x40, 0x9c, 0x0d, 0x00      ; 10^4
+        .db     0x00, 0x00, 0x50, 0xc3, 0x10, 0x00      ; 10^5
+        .db     0x00, 0x00, 0x24, 0xf4, 0x13, 0x00      ; 10^6
+        .db     0x00, 0x80, 0x96, 0x98, 0x17, 0x00      ; 10^7
+        .db     0x00, 0x20, 0xbc, 0xbe, 0x1a, 0x00      ; 10^8
+        .db     0x00, 0x28, 0x6b, 0xee, 0x1d, 0x00      ; 10^9
+        .db     0x00, 0xf9, 0x02, 0x95, 0x21, 0x00      ; 10^10
+        .db     0x40, 0xb7, 0x43, 0xba, 0x24, 0x00      ; 10^11
+        .db     0x10, 0xa5, 0xd4, 0xe8, 0x27, 0x00      ; 10^12
+        .db     0x2a, 0xe7, 0x84, 0x91, 0x2b, 0x00      ; 10^13
+        .db     0xf4, 0x20, 0xe6, 0xb5, 0x2e, 0x00      ; 10^14
+        .db     0x32, 0xa9, 0x5f, 0xe3, 0x31, 0x00      ; 10^15
+
+__fp_pow10_big:
+        .db     0x28, 0xea, 0x7f, 0xa8, 0x2b, 0xff      ; 10^-64
+        .db     0x54, 0x7c, 0x12, 0xbb, 0x60, 0xff      ; 10^-48
+        .db     0xad, 0x1e, 0xb1, 0xcf, 0x95, 0xff      ; 10^-32
+        .db     0xbf, 0x94, 0x95, 0xe6, 0xca, 0xff      ; 10^-16
+        .db     0x00, 0x00, 0x00, 0x80, 0x00, 0x00      ; 10^0 (unused)
+        .db     0xbf, 0xc9, 0x1b, 0x8e, 0x35, 0x00      ; 10^16
+        .db     0xa8, 0xad, 0xc5, 0x9d, 0x6a, 0x00      ; 10^32
+        .db     0x05, 0x8d, 0x29, 0xaf, 0x9f, 0x00      ; 10^48
@@ -8,6 +8,8 @@
         ;;   -7(ix).. -9(ix): mant_a low..high (implicit 1 restored in high)
         ;;  -10(ix)..-12(ix): mant_b low..high (implicit 1 restored in high)
         ;;
+        ;; __fp_unpack_mant24_a is the same for a alone (___fssqrt).
+        ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2026 tomaz stih
 
@@ -16,22 +18,13 @@
 
         .area   _CODE
         .globl  __fp_unpack_mant24_ab
+        .globl  __fp_unpack_mant24_a
 
         ;; __fp_unpack_mant24_ab
         ;; inputs:  IX frame with a at -4..-1(ix), b at 4..7(ix)
         ;; outputs: mant_a to -7..-9(ix), mant_b to -10..-12(ix)
         ;; clobbers: af
 __fp_unpack_mant24_ab:
-        ;; mantissa A (from saved register operand)
-        ld      a,-4(ix)
-        ld      -7(ix),a
-        ld      a,-3(ix)
-        ld      -8(ix),a
-        ld      a,-2(ix)
-        and     #0x7F
-        or      #0x80
-        ld      -9(ix),a
-
         ;; mantissa B (from stack operand)
         ld      a,4(ix)
         ld      -10(ix),a
@@ -41,4 +34,20 @@ __fp_unpack_mant24_ab:
         and     #0x7F
         or      #0x80
         ld      -12(ix),a
+
+        ;; __fp_unpack_mant24_a
+        ;; inputs:  IX frame with a at -4..-1(ix)
+        ;; outputs: mant_a to -7..-9(ix)
+        ;; clobbers: af
+        ;; notes: for single operand helpers, b is not touched
+__fp_unpack_mant24_a:
+        ;; mantissa A (from saved register operand)
+        ld      a,-4(ix)
+        ld      -7(ix),a
+        ld      a,-3(ix)
+        ld      -8(ix),a
+        ld      a,-2(ix)
+        and     #0x7F
+        or      #0x80
+        ld      -9(ix),a
         ret
@@ -0,0 +1,154 @@
+;; shared 24x24 mantissa multiply for sdcc z80
+        ;;
+        ;; expects an IX frame with (see __fp_unpack_mant24_ab):
+        ;;   -7(ix).. -9(ix): mant_a low..high (with implicit 1)
+        ;;  -10(ix)..-12(ix): mant_b low..high (with implicit 1)
+        ;;
+        ;; writes:
+        ;;  -13(ix)..-18(ix): 48-bit product low..high
+        ;;
+        ;; the product is built from nine 8x8 partial products by
+        ;; __mul8x8 (int/mul8.s), which is table-driven when the library
+        ;; is built with FAST_MUL=quarter. used by ___fsmul and ___fsfma.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fpmul48
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+        .globl  __fp_mul48_ab
+        .globl  __mul8x8
+
+        ;; __fp_mul48_ab
+        ;; inputs:  IX frame with mant_a at -7..-9(ix), mant_b at -10..-12(ix)
+        ;; outputs: prod to -13..-18(ix)
+        ;; clobbers: af, b, de, hl
+__fp_mul48_ab:
+        ;; ---- zero 48-bit product ----
+        xor     a
+        ld      -13(ix),a
+        ld      -14(ix),a
+        ld      -15(ix),a
+        ld      -16(ix),a
+        ld      -17(ix),a
+        ld      -18(ix),a
+
+        ;; ---- 24x24 multiply: nine 8x8 partial products ----
+
+        ;; a[0] * b[0] -> prod[1:0]
+        ld      l,-7(ix)
+        ld      h,-10(ix)
+        call    __mul8x8
+        ld      -13(ix),l
+        ld      -14(ix),h
+
+        ;; a[0] * b[1] -> prod[2:1]
+        ld      l,-7(ix)
+        ld      h,-11(ix)
+        call    __mul8x8
+        ld      a,-14(ix)
+        add     a,l
+        ld      -14(ix),a
+        ld      a,-15(ix)
+        adc     a,h
+        ld      -15(ix),a
+        jr      nc,.pp02
+        inc     -16(ix)
+.pp02:
+        ;; a[0] * b[2] -> prod[3:2]
+        ld      l,-7(ix)
+        ld      h,-12(ix)
+        call    __mul8x8
+        ld      a,-15(ix)
+        add     a,l
+        ld      -15(ix),a
+        ld      a,-16(ix)
+        adc     a,h
+        ld      -16(ix),a
+        jr      nc,.pp10
+        inc     -17(ix)
+.pp10:
+        ;; a[1] * b[0] -> prod[2:1]
+        ld      l,-8(ix)
+        ld      h,-10(ix)
+        call    __mul8x8
+        ld      a,-14(ix)
+        add     a,l
+        ld      -14(ix),a
+        ld      a,-15(ix)
+        adc     a,h
+        ld      -15(ix),a
+        jr      nc,.pp11
+        inc     -16(ix)
+        jr      nz,.pp11
+        inc     -17(ix)
+.pp11:
+        ;; a[1] * b[1] -> prod[3:2]
+        ld      l,-8(ix)
+        ld      h,-11(ix)
+        call    __mul8x8
+        ld      a,-15(ix)
+        add     a,l
+        ld      -15(ix),a
+        ld      a,-16(ix)
+        adc     a,h
+        ld      -16(ix),a
+        jr      nc,.pp12
+        inc     -17(ix)
+        jr      nz,.pp12
+        inc     -18(ix)
+.pp12:
+        ;; a[1] * b[2] -> prod[4:3]
+        ld      l,-8(ix)
+        ld      h,-12(ix)
+        call    __mul8x8
+        ld      a,-16(ix)
+        add     a,l
+        ld      -16(ix),a
+        ld      a,-17(ix)
+        adc     a,h
+        ld      -17(ix),a
+        jr      nc,.pp20
+        inc     -18(ix)
+.pp20:
+        ;; a[2] * b[0] -> prod[3:2]
+        ld      l,-9(ix)
+        ld      h,-10(ix)
+        call    __mul8x8
+        ld      a,-15(ix)
+        add     a,l
+        ld      -15(ix),a
+        ld      a,-16(ix)
+        adc     a,h
+        ld      -16(ix),a
+        jr      nc,.pp21
+        inc     -17(ix)
+        jr      nz,.pp21
+        inc     -18(ix)
+.pp21:
+        ;; a[2] * b[1] -> prod[4:3]
+        ld      l,-9(ix)
+        ld      h,-11(ix)
+        call    __mul8x8
+        ld      a,-16(ix)
+        add     a,l
+        ld      -16(ix),a
+        ld      a,-17(ix)
+        adc     a,h
+        ld      -17(ix),a
+        jr      nc,.pp22
+        inc     -18(ix)
+.pp22:
+        ;; a[2] * b[2] -> prod[5:4]
+        ld      l,-9(ix)
+        ld      h,-12(ix)
+        call    __mul8x8
+        ld      a,-17(ix)
+        add     a,l
+        ld      -17(ix),a
+        ld      a,-18(ix)
+        adc     a,h
+        ld      -18(ix),a
+        ret
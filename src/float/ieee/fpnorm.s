@@ -0,0 +1,255 @@
+        ;; shared 32-bit mantissa helpers for the float kernels
+        ;;
+        ;; a value is kept as a 32-bit mantissa m and a 16-bit binary
+        ;; exponent e, as in fpdec.s:
+        ;;   value = m / 2^31 * 2^e
+        ;; with m in HL:HL' (HL high). __fp_unpack_norm turns a float
+        ;; into that form, __fp_norm32 moves the leading 1 of m to bit
+        ;; 31, __fp_norm_pack rounds m to 24 bits (the low byte is the
+        ;; guard byte) and packs it. __fp_shr32 is the plain right shift
+        ;; the kernels use to go from m and e to fixed point, and
+        ;; __fp_mul8x32 scales a constant by a small integer (k ln 2).
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fpnorm
+        .optsdcc -mz80 sdcccall(1)
+
+        .include "config.inc"
+
+        .area   _CODE
+        .globl  __fp_unpack_norm
+        .globl  __fp_norm32
+        .globl  __fp_norm_pack
+        .globl  __fp_shr32
+        .globl  __fp_mul8x32
+.if FLOAT_IEEE
+        .globl  __fp_ieee_pack
+        .globl  __fp_zero_sign
+.else
+        .globl  __fp_round_pack
+.endif
+
+        ;; __fp_unpack_norm
+        ;; inputs:  HLDE = float x, finite and not zero (fast profile:
+        ;;          a normal number)
+        ;; outputs: HL:HL' = m (bit 31 set), DE = e
+        ;; clobbers: af, b
+        ;; notes: the sign is ignored. the low byte of m is 0.
+__fp_unpack_norm:
+        ld      a,l
+        rla
+        ld      a,h
+        rla
+        ld      b,a                     ; b = biased exponent
+        ld      a,e
+        exx
+        ld      h,a
+        ld      l,#0
+        exx
+        ld      a,l
+        or      #0x80
+        ld      h,a
+        ld      l,d                     ; m = 1.f
+        ld      e,b
+        ld      d,#0
+.if FLOAT_IEEE
+        inc     e
+        dec     e
+        jr      nz,.unbias
+        res     7,h                     ; denormal: exponent 1, no implicit 1
+        inc     e
+.endif
+.unbias:
+        push    hl
+        ld      hl,#-127
+        add     hl,de
+        ex      de,hl
+        pop     hl
+.if FLOAT_IEEE
+        bit     7,h
+        ret     nz
+.else
+        ret
+.endif
+
+        ;; __fp_norm32
+        ;; inputs:  HL:HL' = m, not zero, DE = e
+        ;; outputs: HL:HL' = m with bit 31 set, DE = e adjusted
+        ;; clobbers: af
+__fp_norm32:
+        ld      a,h
+        or      a
+        jr      nz,.norm_bits
+        ld      h,l                     ; byte step
+        exx
+        ld      a,h
+        ld      h,l
+        ld      l,#0
+        exx
+        ld      l,a
+        ld      a,e
+        sub     #8
+        ld      e,a
+        jr      nc,__fp_norm32
+        dec     d
+        jr      __fp_norm32
+.norm_bits:
+        ret     m
+.norm_loop:
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl
+        dec     de
+        jp      p,.norm_loop
+        ret
+
+        ;; __fp_norm_pack
+        ;; inputs:  HL:HL' = m, DE = e, frame sign mask at -5(ix)
+        ;; outputs: HLDE = packed IEEE-754 single, rounded
+        ;; clobbers: af, bc, de, hl, hl'
+        ;; notes: m = 0 gives +-0. overflow gives +-Inf, underflow a
+        ;;        denormal (ieee) or +-0 (fast profile).
+__fp_norm_pack:
+        ld      a,h
+        or      l
+        exx
+        or      h
+        or      l
+        exx
+        jr      z,.zero
+        call    __fp_norm32
+        ex      de,hl
+        ld      bc,#127
+        add     hl,bc                   ; HL = biased exponent, DE = m high
+.if FLOAT_IEEE
+        ld      c,d
+        ld      d,e                     ; C:D = mantissa bits 23..8
+        exx
+        ld      a,h
+        exx
+        ld      e,a                     ; E = mantissa bits 7..0
+        exx
+        ld      a,l
+        exx                             ; A = guard byte
+        ld      b,-5(ix)
+        jp      __fp_ieee_pack
+.zero:
+        jp      __fp_zero_sign
+.else
+        bit     7,h
+        jr      nz,.zero
+        ld      a,h
+        or      a
+        jr      nz,.inf
+        ld      c,l                     ; C = biased exponent
+        ld      a,l
+        inc     a
+        jr      z,.inf
+        ld      a,d
+        and     #0x7F
+        ld      l,a
+        ld      d,e                     ; L:D = mantissa bits 22..8
+        exx
+        ld      a,h
+        exx
+        ld      e,a                     ; E = mantissa bits 7..0
+        exx
+        ld      a,l
+        exx                             ; A = guard byte
+        ld      b,-5(ix)
+        call    __fp_round_pack
+        ld      a,l
+        rla
+        ld      a,h
+        rla
+        or      a
+        ret     nz                      ; did not round up to 2^-126: 0
+.zero:
+        ld      h,-5(ix)
+        ld      l,#0
+        ld      d,l
+        ld      e,l
+        ret
+.inf:
+        ld      a,-5(ix)
+        or      #0x7F
+        ld      h,a
+        ld      l,#0x80
+        ld      de,#0
+        ret
+.endif
+
+        ;; __fp_shr32
+        ;; inputs:  HL:HL' = x, A = count (0..255)
+        ;; outputs: HL:HL' = x >> A, truncated, 0 for counts above 31
+        ;; clobbers: af
+__fp_shr32:
+        cp      #32
+        jr      nc,.shr_zero
+.shr_bytes:
+        cp      #8
+        jr      c,.shr_bits
+        sub     #8
+        ex      af,af'
+        ld      a,l
+        ld      l,h
+        ld      h,#0
+        exx
+        ld      l,h
+        ld      h,a
+        exx
+        ex      af,af'
+        jr      .shr_bytes
+.shr_bits:
+        or      a
+        ret     z
+.shr_loop:
+        srl     h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        exx
+        dec     a
+        jr      nz,.shr_loop
+        ret
+.shr_zero:
+        ld      hl,#0
+        exx
+        ld      hl,#0
+        exx
+        ret
+
+        ;; __fp_mul8x32
+        ;; inputs:  E = k, BC:BC' = c
+        ;; outputs: A:HL:HL' = k c (40 bits)
+        ;; clobbers: f, d, e
+__fp_mul8x32:
+        xor     a
+        ld      h,a
+        ld      l,a
+        exx
+        ld      h,a
+        ld      l,a
+        exx
+        ld      d,#8
+.mul8_loop:
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl
+        rla                             ; p <<= 1
+        sla     e
+        jr      nc,.mul8_next
+        exx
+        add     hl,bc
+        exx
+        adc     hl,bc
+        adc     a,#0                    ; p += c
+.mul8_next:
+        dec     d
+        jr      nz,.mul8_loop
+        ret
@@ -1,22 +1,59 @@
-        ;; shared float pack helper for sdcc z80
+        ;; shared float pack helpers for sdcc z80
         ;;
         ;; inputs:
         ;;   B = sign mask (0x00 or 0x80)
         ;;   C = biased exponent (8-bit)
         ;;   L = mantissa high 7 bits (bit7 must be clear)
         ;;   D:E = mantissa low 16 bits
+        ;;   A = guard byte (__fp_round_pack only): bit7 is the round bit,
+        ;;       bits 6..0 are nonzero when anything below it was nonzero
         ;;
         ;; outputs:
         ;;   H:L:D:E packed IEEE-754 single
         ;;
+        ;; rounding is chosen at build time (see config.inc):
+        ;;   FLOAT_ROUND=nearest  __fp_round_pack rounds to nearest, ties
+        ;;                        to even, using the guard byte
+        ;;   FLOAT_ROUND=trunc    __fp_round_pack ignores the guard byte and
+        ;;                        truncates, exactly like __fp_pack_norm
+        ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2026 tomaz stih
 
         .module fppack
         .optsdcc -mz80 sdcccall(1)
 
+        .include "config.inc"
+
         .area   _CODE
         .globl  __fp_pack_norm
+        .globl  __fp_round_pack
+
+        ;; __fp_round_pack
+        ;; inputs:  B=sign mask, C=biased exponent, L=mantissa hi7, DE=mantissa low16,
+        ;;          A=guard byte
+        ;; outputs: HLDE = packed IEEE-754 single, rounded
+        ;; clobbers: af, hl, c
+        ;; notes: a mantissa that rounds up to 2.0 bumps the exponent, so
+        ;;        0x7FFFFF rounding up at exponent 254 packs as infinity.
+__fp_round_pack:
+.if FLOAT_ROUND_NEAREST
+        add     a,a                     ; cf = round bit, z = no sticky bits
+        jr      nc,__fp_pack_norm       ; below half: truncate
+        jr      nz,.round_up            ; above half
+        bit     0,e                     ; exactly half: round to even
+        jr      z,__fp_pack_norm
+.round_up:
+        inc     e
+        jr      nz,__fp_pack_norm
+        inc     d
+        jr      nz,__fp_pack_norm
+        inc     l
+        bit     7,l
+        jr      z,__fp_pack_norm
+        ld      l,#0                    ; mantissa carried into 2.0
+        inc     c
+.endif
 
         ;; __fp_pack_norm
         ;; inputs:  B=sign mask, C=biased exponent, L=mantissa hi7, DE=mantissa low16
@@ -1,5 +1,6 @@
-        ;; shared float helper epilogue for sdcc z80
-        ;; drops one 32-bit stack argument (4 bytes) and returns to caller.
+        ;; shared float helper epilogues for sdcc z80
+        ;; drop one (4 bytes) or two (8 bytes) 32-bit stack arguments and
+        ;; return to caller.
         ;;
         ;; expected stack on entry:
         ;;   [sp+0..1] return address
@@ -13,6 +14,7 @@
 
         .area   _CODE
         .globl  __fp_retpop4
+        .globl  __fp_retpop8
 
         ;; __fp_retpop4
         ;; inputs:  stack = return address + one 32-bit arg to discard
@@ -24,3 +26,16 @@ __fp_retpop4:
         pop     af                              ; drop arg high word
         push    bc                              ; restore return address
         ret
+
+        ;; __fp_retpop8
+        ;; inputs:  stack = return address + two 32-bit args to discard
+        ;; outputs: returns to caller with stack cleaned by 8 bytes
+        ;; clobbers: af, bc
+__fp_retpop8:
+        pop     bc                              ; save return address
+        pop     af                              ; drop first arg
+        pop     af
+        pop     af                              ; drop second arg
+        pop     af
+        push    bc                              ; restore return address
+        ret
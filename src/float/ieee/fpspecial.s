@@ -0,0 +1,284 @@
+        ;; shared special value helpers for the FLOAT_PROFILE=ieee build
+        ;;
+        ;; the fast profile flushes denormals to zero and ignores NaN/Inf;
+        ;; the ieee profile routes zero, denormal, infinite and NaN
+        ;; operands through these helpers and keeps the fast cores for
+        ;; everything else. results that overflow become Inf, results
+        ;; below the normal range become denormals (gradual underflow).
+        ;;
+        ;; NaN results are quiet: a NaN operand is returned with its quiet
+        ;; bit set, invalid operations (0*Inf, Inf-Inf, 0/0, Inf/Inf)
+        ;; return the default NaN 0x7FC00000.
+        ;;
+        ;; the frame helpers expect the layout used by ___fsmul/___fsdiv:
+        ;;   -1(ix)..-4(ix) = a3..a0, 4(ix)..7(ix) = b0..b3,
+        ;;   -5(ix) = result sign, -7..-9 / -10..-12 = mantissas a / b
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fpspecial
+        .optsdcc -mz80 sdcccall(1)
+
+        .include "config.inc"
+
+        .area   _CODE
+
+.if FLOAT_IEEE
+        .globl  __fp_isnan
+        .globl  __fp_nan_ab
+        .globl  __fp_class_ab
+        .globl  __fp_nan32
+        .globl  __fp_inf_sign
+        .globl  __fp_zero_sign
+        .globl  __fp_ieee_norm_ab
+        .globl  __fp_ieee_pack
+        .globl  __fp_round_pack
+
+        ;; __fp_isnan
+        ;; inputs:  HLDE = IEEE-754 single (H=a3, L=a2, D=a1, E=a0)
+        ;; outputs: cf = 1 if NaN
+        ;; clobbers: af
+__fp_isnan:
+        ld      a,l
+        rla
+        ld      a,h
+        rla                             ; a = biased exponent
+        inc     a
+        jr      nz,.not_nan
+        ld      a,l
+        and     #0x7F
+        or      d
+        or      e
+        jr      z,.not_nan              ; Inf
+        scf
+        ret
+.not_nan:
+        or      a
+        ret
+
+        ;; __fp_nan_ab
+        ;; inputs:  frame, C=exp(a), B=exp(b)
+        ;; outputs: cf = 1 and HLDE = quiet NaN if a or b is NaN (a first)
+        ;; clobbers: af, de, hl
+__fp_nan_ab:
+        ld      a,c
+        inc     a
+        jr      nz,.a_not_nan
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        jr      z,.a_not_nan
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        jr      .quiet
+.a_not_nan:
+        ld      a,b
+        inc     a
+        jr      nz,.no_nan
+        ld      a,6(ix)
+        and     #0x7F
+        or      5(ix)
+        or      4(ix)
+        jr      z,.no_nan
+        ld      h,7(ix)
+        ld      l,6(ix)
+        ld      d,5(ix)
+        ld      e,4(ix)
+.quiet:
+        set     6,l
+        scf
+        ret
+.no_nan:
+        or      a
+        ret
+
+        ;; __fp_class_ab
+        ;; inputs:  frame, C=exp(a), B=exp(b); neither operand is NaN
+        ;; outputs: D = class(a), E = class(b): 0 = zero, 1 = finite, 2 = Inf
+        ;; clobbers: af, de
+__fp_class_ab:
+        ld      d,#1
+        ld      a,c
+        inc     a
+        jr      nz,.a_fin
+        ld      d,#2
+.a_fin:
+        ld      a,c
+        or      a
+        jr      nz,.a_done
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        jr      nz,.a_done
+        ld      d,a
+.a_done:
+        ld      e,#1
+        ld      a,b
+        inc     a
+        jr      nz,.b_fin
+        ld      e,#2
+.b_fin:
+        ld      a,b
+        or      a
+        ret     nz
+        ld      a,6(ix)
+        and     #0x7F
+        or      5(ix)
+        or      4(ix)
+        ret     nz
+        ld      e,a
+        ret
+
+        ;; __fp_nan32
+        ;; outputs: HLDE = default quiet NaN 0x7FC00000
+        ;; clobbers: hl, de
+__fp_nan32:
+        ld      hl,#0x7FC0
+        ld      de,#0
+        ret
+
+        ;; __fp_inf_sign
+        ;; inputs:  frame sign at -5(ix)
+        ;; outputs: HLDE = +-Inf
+        ;; clobbers: af, hl, de
+__fp_inf_sign:
+        ld      a,-5(ix)
+        or      #0x7F
+        ld      h,a
+        ld      l,#0x80
+        ld      de,#0
+        ret
+
+        ;; __fp_zero_sign
+        ;; inputs:  frame sign at -5(ix)
+        ;; outputs: HLDE = +-0
+        ;; clobbers: hl, de
+__fp_zero_sign:
+        ld      h,-5(ix)
+        ld      l,#0
+        ld      d,l
+        ld      e,l
+        ret
+
+        ;; __fp_ieee_norm_ab
+        ;; inputs:  frame, C=exp(a), B=exp(b), mantissas unpacked by
+        ;;          __fp_unpack_mant24_ab; neither operand is zero
+        ;; outputs: HL = exponent of a, DE = exponent of b (16-bit),
+        ;;          denormal mantissas shifted up to bit 23
+        ;; clobbers: af, de, hl
+        ;; notes: a denormal has exponent 1 and no implicit 1; every
+        ;;        normalizing shift lowers the exponent below 1
+__fp_ieee_norm_ab:
+        ld      h,#0
+        ld      l,c
+        ld      a,c
+        or      a
+        jr      nz,.a_norm
+        inc     l
+        res     7,-9(ix)
+.a_shift:
+        bit     7,-9(ix)
+        jr      nz,.a_norm
+        sla     -7(ix)
+        rl      -8(ix)
+        rl      -9(ix)
+        dec     hl
+        jr      .a_shift
+.a_norm:
+        ld      d,#0
+        ld      e,b
+        ld      a,b
+        or      a
+        ret     nz
+        inc     e
+        res     7,-12(ix)
+.b_shift:
+        bit     7,-12(ix)
+        ret     nz
+        sla     -10(ix)
+        rl      -11(ix)
+        rl      -12(ix)
+        dec     de
+        jr      .b_shift
+
+        ;; __fp_ieee_pack
+        ;; inputs:  B = sign mask, HL = biased exponent (signed 16-bit),
+        ;;          C:D:E = mantissa with the implicit 1 at bit 23,
+        ;;          A = guard byte (see __fp_round_pack)
+        ;; outputs: HLDE = packed IEEE-754 single, rounded
+        ;; clobbers: af, bc, hl
+        ;; notes: exponents >= 255 give +-Inf. exponents <= 0 shift the
+        ;;        mantissa right into the guard byte first, so denormal
+        ;;        results are rounded once, at their own precision.
+__fp_ieee_pack:
+        bit     7,h
+        jr      nz,.tiny
+        inc     h
+        dec     h
+        jr      nz,.huge
+        inc     l
+        jr      z,.huge
+        dec     l
+        jr      z,.tiny
+        ld      h,a                     ; guard byte
+        ld      a,c
+        and     #0x7F
+        ld      c,l
+        ld      l,a
+        ld      a,h
+        jp      __fp_round_pack
+
+.tiny:
+        push    af
+        ld      a,h
+        or      a
+        ld      a,#1
+        jr      z,.tiny_count           ; exponent 0: one shift
+        inc     h
+        jr      nz,.tiny_flush          ; below -256
+        ld      a,l
+        cp      #0xE7
+        jr      c,.tiny_flush           ; below -25: only sticky is left
+        neg
+        inc     a                       ; a = 1 - exponent
+.tiny_count:
+        ld      l,a
+        pop     af
+        ld      h,a
+.tiny_loop:
+        srl     c
+        rr      d
+        rr      e
+        rr      h
+        jr      nc,.tiny_next
+        set     0,h
+.tiny_next:
+        dec     l
+        jr      nz,.tiny_loop
+        ld      a,h
+        ld      l,c
+        ld      c,#0
+        jp      __fp_round_pack
+
+.tiny_flush:
+        pop     af
+        ld      a,#1
+        ld      c,#0
+        ld      d,c
+        ld      e,c
+        ld      l,c
+        jp      __fp_round_pack
+
+.huge:
+        ld      a,b
+        or      #0x7F
+        ld      h,a
+        ld      l,#0x80
+        ld      de,#0
+        ret
+.endif
@@ -5,6 +5,7 @@
         ;;   |x| < 1        -> 0
         ;;   x >=  32768    ->  32767
         ;;   x <= -32768    -> -32768
+        ;;   NaN            -> 0 (FLOAT_PROFILE=ieee; Inf saturates)
         ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2025 tomaz stih
@@ -16,11 +17,24 @@
         .globl  ___fs2sint
         .globl  __fs2u16mag
 
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_isnan
+.endif
+
         ;; ___fs2sint
         ;; inputs:  DE:HL = IEEE-754 single (E=a0, D=a1, L=a2, H=a3)
         ;; outputs: DE = signed 16-bit integer (trunc toward zero, saturating)
         ;; clobbers: af, bc, de, hl
 ___fs2sint:
+.if FLOAT_IEEE
+        call    __fp_isnan          ; NaN -> 0
+        jr      nc,.not_nan
+        ld      de,#0
+        ret
+.not_nan:
+.endif
         ;; normalize to:
         ;;   B:C = high word bytes (a3:a2)
         ;;   H:L = low word bytes  (a1:a0)
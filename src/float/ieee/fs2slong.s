@@ -4,6 +4,7 @@
         ;;   |x| < 1              -> 0
         ;;   x >=  2^31           ->  0x7FFFFFFF (clamp)
         ;;   x <= -2^31           ->  0x80000000 (clamp)
+        ;;   NaN                  -> 0 (FLOAT_PROFILE=ieee; Inf saturates)
         ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2025 tomaz stih
@@ -16,11 +17,21 @@
         .globl  __fs2u32mag
         .globl  __fp_zero32
 
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_isnan
+.endif
+
         ;; ___fs2slong
         ;; inputs:  DE:HL = IEEE-754 single
         ;; outputs: HL:DE = signed 32-bit integer (trunc toward zero, saturating)
         ;; clobbers: af, bc, de, hl
 ___fs2slong:
+.if FLOAT_IEEE
+        call    __fp_isnan          ; NaN -> 0
+        jp      c,__fp_zero32
+.endif
         ;; arrange: HL = low word, DE = high word
         ex      de,hl
 
@@ -105,7 +116,9 @@ ___fs2slong:
         ld      a,d
         cpl
         ld      d,a
-        inc     hl
+        inc     hl                      ;; inc rr leaves the flags alone
+        ld      a,h
+        or      l
         jr      nz, .ret32
         inc     de
         jr      .ret32
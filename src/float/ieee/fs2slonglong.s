@@ -0,0 +1,122 @@
+        ;; float -> signed long long (ieee-754 single) for sdcc z80
+        ;; converts 32-bit float to 64-bit signed with truncation toward zero.
+        ;; behavior:
+        ;;   |x| < 1    -> 0
+        ;;   |x| < 2^31 -> ___fs2slong, sign extended
+        ;;   x >=  2^63 ->  0x7FFFFFFFFFFFFFFF (clamp)
+        ;;   x <= -2^63 ->  0x8000000000000000 (clamp)
+        ;;   NaN        -> 0 (FLOAT_PROFILE=ieee; Inf saturates)
+        ;;
+        ;; ABI (sdcccall(1), return values wider than 32 bits):
+        ;;   result pointer (hidden first argument) in HL
+        ;;   x on stack: 2(sp)..5(sp), caller pops
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fs2slonglong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+        .globl  ___fs2slonglong
+        .globl  __fs2u64mag
+        .globl  ___fs2slong
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_isnan
+.endif
+
+        ;; ___fs2slonglong
+        ;; inputs:  HL = result pointer, x at 2(sp)..5(sp)
+        ;; outputs: *HL = signed 64-bit integer (trunc toward zero, saturating)
+        ;; clobbers: af, bc, de, hl, iy
+___fs2slonglong:
+        push    hl
+        pop     iy                      ; iy = result
+        ld      hl,#2
+        add     hl,sp
+        ld      e,(hl)
+        inc     hl
+        ld      d,(hl)
+        inc     hl
+        ld      a,(hl)
+        inc     hl
+        ld      h,(hl)
+        ld      l,a                     ; hl:de = x
+.if FLOAT_IEEE
+        call    __fp_isnan              ; NaN -> 0
+        jr      c,.zero
+.endif
+        ;; unbiased e = ((H << 1) | (L >> 7)) - 127, sign dropped
+        ld      a,l
+        rla
+        ld      a,h
+        rla
+        sub     #127
+        jr      c,.zero                 ; |x| < 1
+        cp      #31
+        jr      c,.long
+        cp      #63
+        jr      nc,.clamp
+
+        push    hl                      ; h bit 7 = sign
+        call    __fs2u64mag
+        pop     af
+        rla
+        ret     nc
+        push    iy                      ; negative: result = -result
+        pop     hl
+        ld      b,#8
+        or      a
+.neg_loop:
+        ld      a,#0
+        sbc     a,(hl)
+        ld      (hl),a
+        inc     hl
+        djnz    .neg_loop
+        ret
+
+.long:
+        push    iy
+        call    ___fs2slong
+        pop     iy
+        ld      0(iy),e
+        ld      1(iy),d
+        ld      2(iy),l
+        ld      3(iy),h
+        ld      a,h
+        rla
+        sbc     a,a                     ; sign extension
+        jr      .fill_high
+
+.clamp:
+        ld      a,h
+        rla
+        sbc     a,a
+        cpl                             ; 0x00 if negative, 0xFF if not
+        xor     #0x80
+        ld      7(iy),a                 ; 0x80 or 0x7F
+        xor     #0x80
+        jr      .fill_low
+
+.zero:
+        xor     a
+        ld      7(iy),a
+.fill_low:
+        ld      0(iy),a
+        ld      1(iy),a
+        ld      2(iy),a
+        ld      3(iy),a
+        ld      4(iy),a
+        ld      5(iy),a
+        ld      6(iy),a
+        ret
+
+.fill_high:
+        ld      4(iy),a
+        ld      5(iy),a
+        ld      6(iy),a
+        ld      7(iy),a
+        ret
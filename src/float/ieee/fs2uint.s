@@ -4,6 +4,7 @@
         ;;   negative -> 0
         ;;   |x| < 1  -> 0
         ;;   x >= 65536 -> 65535
+        ;;   NaN        -> 0 (FLOAT_PROFILE=ieee; Inf saturates)
         ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2025 tomaz stih
@@ -15,11 +16,24 @@
         .globl  ___fs2uint
         .globl  __fs2u16mag
 
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_isnan
+.endif
+
         ;; ___fs2uint
         ;; inputs:  DE:HL = IEEE-754 single
         ;; outputs: DE = unsigned 16-bit integer (trunc toward zero, saturating)
         ;; clobbers: af, bc, de, hl
 ___fs2uint:
+.if FLOAT_IEEE
+        call    __fp_isnan          ; NaN -> 0
+        jr      nc,.not_nan
+        ld      de,#0
+        ret
+.not_nan:
+.endif
         ;; normalize to:
         ;;   B:C = high word bytes (a3:a2)
         ;;   H:L = low word bytes  (a1:a0)
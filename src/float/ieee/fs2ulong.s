@@ -4,6 +4,7 @@
         ;;   negative  -> 0
         ;;   |x| < 1   -> 0
         ;;   x >= 2^32 -> 0xFFFFFFFF (clamp)
+        ;;   NaN       -> 0 (FLOAT_PROFILE=ieee; Inf saturates)
         ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2025 tomaz stih
@@ -16,11 +17,21 @@
         .globl  __fs2u32mag
         .globl  __fp_zero32
 
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_isnan
+.endif
+
         ;; ___fs2ulong
         ;; inputs:  DE:HL = IEEE-754 single
         ;; outputs: HL:DE = unsigned 32-bit integer (trunc toward zero, saturating)
         ;; clobbers: af, bc, de, hl
 ___fs2ulong:
+.if FLOAT_IEEE
+        call    __fp_isnan          ; NaN -> 0
+        jp      c,__fp_zero32
+.endif
         ;; arrange: HL = low word, DE = high word
         ex      de,hl
 
@@ -0,0 +1,147 @@
+        ;; float -> unsigned long long (ieee-754 single) for sdcc z80
+        ;; converts 32-bit float to 64-bit unsigned with truncation toward zero.
+        ;; behavior:
+        ;;   negative  -> 0
+        ;;   |x| < 1   -> 0
+        ;;   x < 2^32  -> ___fs2ulong, upper half zero
+        ;;   x >= 2^64 -> 0xFFFFFFFFFFFFFFFF (clamp)
+        ;;   NaN       -> 0 (FLOAT_PROFILE=ieee; Inf saturates)
+        ;;
+        ;; ABI (sdcccall(1), return values wider than 32 bits):
+        ;;   result pointer (hidden first argument) in HL
+        ;;   x on stack: 2(sp)..5(sp), caller pops
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fs2ulonglong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+        .globl  ___fs2ulonglong
+        .globl  __fs2u64mag
+        .globl  ___fs2ulong
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_isnan
+.endif
+
+        ;; ___fs2ulonglong
+        ;; inputs:  HL = result pointer, x at 2(sp)..5(sp)
+        ;; outputs: *HL = unsigned 64-bit integer (trunc toward zero, saturating)
+        ;; clobbers: af, bc, de, hl, iy
+___fs2ulonglong:
+        push    hl
+        pop     iy                      ; iy = result
+        ld      hl,#2
+        add     hl,sp
+        ld      e,(hl)
+        inc     hl
+        ld      d,(hl)
+        inc     hl
+        ld      a,(hl)
+        inc     hl
+        ld      h,(hl)
+        ld      l,a                     ; hl:de = x
+.if FLOAT_IEEE
+        call    __fp_isnan              ; NaN -> 0
+        jr      c,.zero
+.endif
+        bit     7,h                     ; negative -> 0
+        jr      nz,.zero
+
+        ;; unbiased e = ((H << 1) | (L >> 7)) - 127
+        ld      a,l
+        rla
+        ld      a,h
+        rla
+        sub     #127
+        jr      c,.zero                 ; |x| < 1
+        cp      #32
+        jr      c,.long
+        cp      #64
+        jp      c,__fs2u64mag
+        ld      a,#0xFF                 ; clamp
+        jr      .fill
+
+.long:
+        push    iy
+        call    ___fs2ulong
+        pop     iy
+        ld      0(iy),e
+        ld      1(iy),d
+        ld      2(iy),l
+        ld      3(iy),h
+        xor     a
+        jr      .fill_high
+
+.zero:
+        xor     a
+.fill:
+        ld      0(iy),a
+        ld      1(iy),a
+        ld      2(iy),a
+        ld      3(iy),a
+.fill_high:
+        ld      4(iy),a
+        ld      5(iy),a
+        ld      6(iy),a
+        ld      7(iy),a
+        ret
+
+        ;; __fs2u64mag
+        ;; inputs:  HL:DE = float (sign ignored), A = unbiased exponent
+        ;;          (23..63), IY = result
+        ;; outputs: 0(iy)..7(iy) = trunc(|x|)
+        ;; clobbers: af, bc, hl
+        ;; notes: the 24-bit mantissa is stored at byte (e - 23) / 8 and
+        ;;        the whole result shifted by the remaining 0..7 bits
+__fs2u64mag::
+        sub     #23
+        ld      b,a                     ; b = shift
+        xor     a
+        ld      0(iy),a
+        ld      1(iy),a
+        ld      2(iy),a
+        ld      3(iy),a
+        ld      4(iy),a
+        ld      5(iy),a
+        ld      6(iy),a
+        ld      7(iy),a
+        ld      a,l
+        or      #0x80
+        ld      c,a                     ; c = mantissa high, hidden bit
+        push    iy
+        pop     hl
+        ld      a,b
+        rrca
+        rrca
+        rrca
+        and     #0x1F
+        add     a,l
+        ld      l,a
+        jr      nc,.mag_addr
+        inc     h
+.mag_addr:
+        ld      (hl),e
+        inc     hl
+        ld      (hl),d
+        inc     hl
+        ld      (hl),c
+        ld      a,b
+        and     #0x07
+        ret     z
+        ld      b,a
+.mag_shift:
+        sla     0(iy)
+        rl      1(iy)
+        rl      2(iy)
+        rl      3(iy)
+        rl      4(iy)
+        rl      5(iy)
+        rl      6(iy)
+        rl      7(iy)
+        djnz    .mag_shift
+        ret
@@ -10,9 +10,13 @@
         ;;   dehl packed float (same byte order)
         ;;
         ;; behaviour:
-        ;;   - denormals (exp==0) flushed to 0
-        ;;   - no NaN/Inf handling
-        ;;   - truncation (no rounding)
+        ;;   - fast profile: denormals (exp==0) flushed to 0, no NaN/Inf
+        ;;   - FLOAT_PROFILE=ieee: NaN/Inf operands per IEEE-754 (Inf-Inf
+        ;;     is NaN), denormals take part as exponent 1 without the
+        ;;     implicit 1, results that overflow become Inf
+        ;;   - rounding per FLOAT_ROUND (see fppack.s): round to nearest
+        ;;     even, or truncation toward zero. Y keeps a guard byte with a
+        ;;     sticky bit while it is aligned, so both are exact.
         ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; (c) 2025 tomaz stih
@@ -23,9 +27,15 @@
         .area   _CODE
         .globl  ___fsadd
         .globl  __fp_retpop4
-        .globl  __fp_pack_norm
+        .globl  __fp_round_pack
         .globl  __fp_zero32
 
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_nan32
+.endif
+
         ;; locals (negative offsets from ix)
         ;;  -12..-9 : a0..a3
         ;;  -8..-5  : b0..b3
@@ -33,6 +43,7 @@
         ;;  -3      : sy (sign of Y)  0x00/0x80
         ;;  -2      : ex (biased exp of X, 0..255)
         ;;  -1      : diff
+        ;;  -14,-13 : implicit 1 of a / b, 0x80 or 0 (FLOAT_IEEE only)
         ;; ___fsadd
         ;; inputs:  a in DEHL, b on caller stack (4 bytes)
         ;; outputs: DEHL = IEEE-754 single sum
@@ -47,7 +58,11 @@ ___fsadd::
         push    hl
 
         ;; reserve locals
+.if FLOAT_IEEE
+        ld      hl,#-14
+.else
         ld      hl,#-12
+.endif
         add     hl,sp
         ld      sp,hl
 
@@ -96,6 +111,111 @@ ___fsadd::
         set     0,c
 .eb_ok:
 
+.if FLOAT_IEEE
+        ld      -14(ix),#0x80
+        ld      -13(ix),#0x80
+        ld      a,b
+        dec     a
+        cp      #254
+        jr      nc,.special
+        ld      a,c
+        dec     a
+        cp      #254
+        jp      c,.both_nz
+
+.special:
+        ;; NaN and Inf operands
+        ld      a,b
+        inc     a
+        jr      nz,.a_finite
+        ld      a,-10(ix)
+        and     #0x7f
+        or      -11(ix)
+        or      -12(ix)
+        jr      nz,.ret_a_quiet       ; a is NaN
+        ld      a,c
+        inc     a
+        jp      nz,.ret_a             ; Inf + finite
+        ld      a,-6(ix)
+        and     #0x7f
+        or      -7(ix)
+        or      -8(ix)
+        jr      nz,.ret_b_quiet       ; b is NaN
+        ld      a,-9(ix)
+        xor     -5(ix)
+        jp      p,.ret_a              ; Inf + Inf of the same sign
+        call    __fp_nan32            ; Inf - Inf
+        jp      .ret_cleanup
+
+.a_finite:
+        ld      a,c
+        inc     a
+        jr      nz,.zeros
+        ld      a,-6(ix)
+        and     #0x7f
+        or      -7(ix)
+        or      -8(ix)
+        jp      z,.ret_b              ; finite + Inf
+.ret_b_quiet:
+        set     6,-6(ix)
+        jp      .ret_b
+.ret_a_quiet:
+        set     6,-10(ix)
+        jp      .ret_a
+
+.zeros:
+        ;; zero and denormal operands
+        ld      a,b
+        or      a
+        jr      nz,.a_normal
+        ld      a,-10(ix)
+        or      -11(ix)
+        or      -12(ix)
+        jr      nz,.a_denormal
+        ld      a,c
+        or      a
+        jp      nz,.ret_b             ; 0 + x
+        ld      a,-6(ix)
+        or      -7(ix)
+        or      -8(ix)
+        jp      nz,.ret_b             ; 0 + denormal
+        ld      a,-9(ix)              ; 0 + 0: -0 only if both are -0
+        and     -5(ix)
+        and     #0x80
+        ld      h,a
+        ld      l,#0
+        ld      d,l
+        ld      e,l
+        jp      .ret_cleanup
+.a_denormal:
+        ld      b,#1
+        ld      -14(ix),#0
+.a_normal:
+        ld      a,c
+        or      a
+        jr      nz,.both_nz
+        ld      a,-6(ix)
+        or      -7(ix)
+        or      -8(ix)
+        jp      z,.ret_a              ; x + 0
+        ld      c,#1
+        ld      -13(ix),#0
+        jr      .both_nz
+
+.ret_b:
+        ld      e,-8(ix)
+        ld      d,-7(ix)
+        ld      l,-6(ix)
+        ld      h,-5(ix)
+        jp      .ret_cleanup
+
+.ret_a:
+        ld      e,-12(ix)
+        ld      d,-11(ix)
+        ld      l,-10(ix)
+        ld      h,-9(ix)
+        jp      .ret_cleanup
+.else
         ;; flush denormals
         ld      a,b
         or      a
@@ -117,6 +237,7 @@ ___fsadd::
         ld      l,-10(ix)
         ld      h,-9(ix)
         jp      .ret_cleanup
+.endif
 
 .both_nz:
         ;; signs
@@ -137,11 +258,19 @@ ___fsadd::
 .exp_eq:
         ld      a,-10(ix)
         and     #0x7f
+.if FLOAT_IEEE
+        or      -14(ix)
+.else
         or      #0x80
+.endif
         ld      d,a
         ld      a,-6(ix)
         and     #0x7f
+.if FLOAT_IEEE
+        or      -13(ix)
+.else
         or      #0x80
+.endif
         cp      d
         jr      c,.x_is_a
         jr      nz,.x_is_b
@@ -170,7 +299,11 @@ ___fsadd::
         ;; mant X
         ld      a,-10(ix)
         and     #0x7f
+.if FLOAT_IEEE
+        or      -14(ix)
+.else
         or      #0x80
+.endif
         ld      c,a
         ld      b,-11(ix)
         ld      l,-12(ix)
@@ -178,7 +311,11 @@ ___fsadd::
         ;; mant Y
         ld      a,-6(ix)
         and     #0x7f
+.if FLOAT_IEEE
+        or      -13(ix)
+.else
         or      #0x80
+.endif
         ld      h,a
         ld      d,-7(ix)
         ld      e,-8(ix)
@@ -200,7 +337,11 @@ ___fsadd::
         ;; mant X
         ld      a,-6(ix)
         and     #0x7f
+.if FLOAT_IEEE
+        or      -13(ix)
+.else
         or      #0x80
+.endif
         ld      c,a
         ld      b,-7(ix)
         ld      l,-8(ix)
@@ -208,39 +349,80 @@ ___fsadd::
         ;; mant Y
         ld      a,-10(ix)
         and     #0x7f
+.if FLOAT_IEEE
+        or      -14(ix)
+.else
         or      #0x80
+.endif
         ld      h,a
         ld      d,-11(ix)
         ld      e,-12(ix)
 
 .align_y:
+        ;; shift Y right by diff into h:d:e plus a guard byte in l.
+        ;; bits that fall off the guard byte are jammed into its bit 0
+        ;; (sticky), so the guard byte always tells whether Y had
+        ;; anything below the kept bits.
+        push    bc                    ; X mantissa high/mid
+        ld      c,l                   ; c = X mantissa low
+        ld      l,#0
         ld      a,-1(ix)
-        cp      #31
-        jr      c,.sh_ok
-        xor     a
-        ld      h,a
-        ld      d,a
-        ld      e,a
-        jr      .addsub
+        cp      #26
+        jr      c,.sh_bytes
 
-.sh_ok:
+        ;; Y is below a quarter ulp of X: only its sticky bit is left
+        ld      h,l
+        ld      d,l
+        ld      e,l
+        inc     l
+        jr      .sh_done
+
+.sh_bytes:
+        cp      #8
+        jr      c,.sh_bits
+        ld      b,l                   ; whole byte: old guard becomes sticky
+        ld      l,e
+        inc     b
+        dec     b
+        jr      z,.sh_byte_next
+        set     0,l
+.sh_byte_next:
+        ld      e,d
+        ld      d,h
+        ld      h,#0
+        sub     #8
+        jr      .sh_bytes
+
+.sh_bits:
         or      a
-        jr      z,.addsub
+        jr      z,.sh_done
+        ld      b,a
 .sh_loop:
         srl     h
         rr      d
         rr      e
-        dec     a
-        jr      nz,.sh_loop
+        rr      l
+        jr      nc,.sh_next
+        set     0,l
+.sh_next:
+        djnz    .sh_loop
+
+.sh_done:
+        ld      -1(ix),l              ; -1(ix) = guard byte of Y
+        ld      l,c
+        pop     bc
 
 .addsub:
         ld      a,-4(ix)
         xor     -3(ix)
         jr      z,.do_add
 
-        ;; subtract
+        ;; subtract X:00 - Y:guard
+        xor     a
+        sub     -1(ix)
+        ld      -1(ix),a              ; guard = -guard, cf = borrow
         ld      a,l
-        sub     e
+        sbc     a,e
         ld      l,a
         ld      a,b
         sbc     a,d
@@ -252,16 +434,23 @@ ___fsadd::
         ld      a,c
         or      b
         or      l
+        or      -1(ix)                ; the guard byte may hold all of it
         jr      nz,.sub_norm
         call    __fp_zero32
         jr      .ret_cleanup
 
 .sub_norm:
+        ld      e,-1(ix)
         ld      a,-2(ix)
 .sub_loop:
         bit     7,c
         jr      nz,.sub_pack
-        sla     l
+.if FLOAT_IEEE
+        cp      #1
+        jr      z,.sub_pack           ; denormal result
+.endif
+        sla     e
+        rl      l
         rl      b
         rl      c
         dec     a
@@ -283,28 +472,48 @@ ___fsadd::
         ld      a,c
         adc     a,h
         ld      c,a
+        ld      e,-1(ix)
         jr      nc,.pack
-        srl     c
+        rr      c                     ; cf was the carry out: shift it in
         rr      b
         rr      l
+        rr      e
+        jr      nc,.add_inc_exp
+        set     0,e
+.add_inc_exp:
         ld      a,-2(ix)
         inc     a
         ld      -2(ix),a
+.if FLOAT_IEEE
+        inc     a
+        jr      nz,.pack
+        ld      a,-4(ix)              ; overflow: +-Inf
+        or      #0x7f
+        ld      h,a
+        ld      l,#0x80
+        ld      d,#0
+        ld      e,d
+        jr      .ret_cleanup
+.endif
 
 .pack:
-        ld      e,l
-        ld      d,b
+        ;; mantissa c:b:l, guard byte e
+.if FLOAT_IEEE
+        bit     7,c
+        jr      nz,.pack_exp
+        ld      -2(ix),#0             ; denormal: exponent field 0
+.pack_exp:
+.endif
         ld      a,c
         and     #0x7f
+        ld      c,e
+        ld      e,l
+        ld      d,b
         ld      l,a
-        ld      a,-2(ix)
-        and     #0x01
-        jr      z,.p2_ok
-        set     7,l
-.p2_ok:
+        ld      a,c                   ; a = guard byte
         ld      b,-4(ix)
         ld      c,-2(ix)
-        call    __fp_pack_norm
+        call    __fp_round_pack
 
 .ret_cleanup:
         ld      sp,ix
@@ -0,0 +1,233 @@
+        ;; float array kernel: axpy
+        ;;
+        ;; y[i] = a * x[i] + y[i] in one stack frame, each y[i] rounded
+        ;; once. a is unpacked once: its sign, exponent and mantissa stay
+        ;; in the frame, each x[i] is unpacked straight from memory into
+        ;; mant_b and the fused multiply-add runs from __fp_fma_prod.
+        ;; elements that need the special cases of ___fsfma (zero,
+        ;; denormal, Inf or NaN a or x[i], Inf or NaN y[i]) and every
+        ;; element when a itself is one of those go through the whole
+        ;; body (__fp_fma_frame), so the result is always that of
+        ;; ___fsfma.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   a in HLDE, x, y and n on stack (2 bytes each, x nearest to
+        ;;   the return address)
+        ;;   callee cleans x, y and n from stack
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fsaxpy
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fs_axpy
+        .globl  __fp_fma_frame
+        .globl  __fp_fma_prod
+        .globl  __fp_unpack_mant24_a
+
+        .include "config.inc"
+
+;; ============================================================
+;; Frame layout (the __fp_fma_frame part is the ___fsfma one):
+;;
+;;   ix+18,19 : n
+;;   ix+16,17 : y
+;;   ix+14,15 : x
+;;   ix+12,13 : return address
+;;   ix+8..11 : y[i]
+;;   ix+4..7  : x[i], for __fp_fma_frame
+;;   ix+3     : exponent of a, 0 when a takes __fp_fma_frame
+;;   ix+2     : sign of a (bit 7)
+;;   ix+0,1   : saved ix
+;;   ix-1..-4 : a3..a0
+;;   ix-5..-31 : __fp_fma_frame locals
+;; ============================================================
+
+        ;; _fs_axpy
+        ;; inputs:  a in HLDE, x at 2(sp), y at 4(sp), n at 6(sp)
+        ;; outputs: y[0..n-1] += a * x[0..n-1]
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+_fs_axpy:
+        push    af              ; x[i], y[i] slots, sign and exponent of
+        push    af              ; a under the return address, where
+        push    af              ; ___fsfma has b and c
+        push    af
+        push    af
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+
+        push    hl              ; ix-1=H(a3), ix-2=L(a2)
+        push    de              ; ix-3=D(a1), ix-4=E(a0)
+
+        ld      hl,#-27
+        add     hl,sp
+        ld      sp,hl
+
+        ;; ---- a, once ----
+        ld      a,-2(ix)
+        rla
+        ld      a,-1(ix)
+        ld      2(ix),a
+        rla                     ; a = exponent of a
+.if FLOAT_IEEE
+        ld      c,a
+        dec     a
+        cp      #254
+        ld      a,c
+        jr      c,.a_normal
+        xor     a               ; zero, denormal, Inf or NaN
+.a_normal:
+.endif
+        ld      3(ix),a
+        call    __fp_unpack_mant24_a
+
+        ld      l,14(ix)
+        ld      h,15(ix)        ; hl = x
+        ld      e,16(ix)
+        ld      d,17(ix)        ; de = y
+        ld      c,18(ix)
+        ld      b,19(ix)        ; bc = n
+
+.loop:
+        ld      a,b
+        or      c
+        jp      z,.done
+        dec     bc
+        push    bc
+
+        ld      a,(hl)          ; x[i] to mant_b
+        ld      -10(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      -11(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      c,a
+        or      #0x80
+        ld      -12(ix),a
+        inc     hl
+        ld      a,(hl)
+        inc     hl
+        push    hl
+        ld      b,a
+        xor     2(ix)
+        and     #0x80
+        ld      -5(ix),a        ; sign of the product
+        sla     c
+        ld      a,b
+        rla                     ; a = exponent of x[i]
+        ex      de,hl
+        push    hl
+        ld      e,a
+.if FLOAT_IEEE
+        dec     a
+        cp      #254
+        jr      nc,.frame
+.else
+        or      a
+        jr      z,.frame
+.endif
+        ld      a,3(ix)
+        or      a
+        jr      z,.frame
+
+        ld      a,(hl)          ; y[i] to 8..11
+        ld      8(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      9(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      10(ix),a
+        ld      c,a
+        inc     hl
+        ld      a,(hl)
+        ld      11(ix),a
+        ld      b,a
+        and     #0x80
+        ld      -30(ix),a       ; sign of y[i]
+        xor     -5(ix)
+        ld      -31(ix),a
+        sla     c
+        ld      a,b
+        rla                     ; a = exponent of y[i]
+.if FLOAT_IEEE
+        inc     a
+        jr      z,.frame        ; Inf or NaN
+        dec     a
+.endif
+        ld      -28(ix),a
+        ld      d,#0
+        ld      -29(ix),d
+        ld      l,3(ix)
+        ld      h,d             ; hl = EA, de = EB
+        call    __fp_fma_prod
+
+.store:
+        ld      b,h
+        ld      c,l
+        pop     hl
+        ld      (hl),e          ; y[i] = a * x[i] + y[i]
+        inc     hl
+        ld      (hl),d
+        inc     hl
+        ld      (hl),c
+        inc     hl
+        ld      (hl),b
+        inc     hl
+        ex      de,hl
+        pop     hl
+        pop     bc
+        jr      .loop
+
+.frame:
+        pop     hl              ; y[i] to 8..11, x[i] to 4..7, the
+        pop     de              ; whole body
+        push    de
+        push    hl
+        ld      a,(hl)
+        ld      8(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      9(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      10(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      11(ix),a
+        ex      de,hl
+        ld      de,#-4
+        add     hl,de
+        ld      a,(hl)
+        ld      4(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      5(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      6(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      7(ix),a
+        call    __fp_fma_frame
+        jr      .store
+
+.done:
+        ld      sp,ix
+        pop     ix
+        pop     bc              ; drop the slots
+        pop     bc
+        pop     bc
+        pop     bc
+        pop     bc
+        pop     bc              ; return address
+        pop     af              ; drop x, y and n
+        pop     af
+        pop     af
+        push    bc
+        ret
@@ -1,6 +1,16 @@
         ;; float compare (ieee-754 single) for sdcc z80
         ;; returns -1 if a<b, 0 if a==b, +1 if a>b
-        ;; denormals treated as 0; nan/inf unsupported.
+        ;; fast profile: denormals treated as 0; nan/inf unsupported.
+        ;; FLOAT_PROFILE=ieee: denormals and inf compare by value, +0 and
+        ;; -0 are equal, a nan operand returns +1 (unordered) so that
+        ;; both ___fslt and ___fseq report false.
+        ;;
+        ;; sign-magnitude floats order like integers once the sign is
+        ;; taken out, so nothing is unpacked: the raw bytes are compared
+        ;; most significant first and the first that differs decides,
+        ;; reversed when both are negative. when the signs differ the
+        ;; positive one is greater unless both are zero. most operands
+        ;; are decided by the sign and exponent byte.
         ;;
         ;; abi (observed):
         ;;   a in regs: hl:de (h=a3, l=a2, d=a1, e=a0)
@@ -15,173 +25,135 @@
         .area   _CODE                             ; code segment
 
         .globl  ___fscmp                          ; export symbols
-        .globl  __fp_retpop4
+        .globl  __fp_cmp
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_isnan
+.endif
 
         ;; ___fscmp
         ;; inputs:  hl:de = a (float), stack = b (float)
         ;; outputs: de = -1, 0, +1
-        ;; clobbers: a, f, b, c, d, e, h, l, ix
+        ;; clobbers: af, bc, de, hl, bc', de', hl'
 ___fscmp::
-        push    ix
-        ld      ix, #0
-        add     ix, sp
-
-        ;; snapshot a into b,c,d,e so we never lose a1/a0
-        ;; b=a3, c=a2, d=a1, e=a0
-        ld      b, h
-        ld      c, l
-
-        ;; stack layout after push ix:
-        ;;   2(ix),3(ix) = return address
-        ;;   4(ix),5(ix) = b.low  (b0=4(ix), b1=5(ix))
-        ;;   6(ix),7(ix) = b.high (b2=6(ix), b3=7(ix))
-
-        ;; compute biased exponents: ea in h, eb in l
-        ;; ea = ((a3&0x7f)<<1) | (a2>>7)
-        ld      a, b
-        and     #0x7f
-        rla
-        ld      h, a
-        ld      a, c
-        and     #0x80
-        jr      z, .ea_ok
-        inc     h
-.ea_ok:
-        ;; eb = ((b3&0x7f)<<1) | (b2>>7) (b3=7(ix), b2=6(ix))
-        ld      a, 7(ix)
-        and     #0x7f
-        rla
-        ld      l, a
-        ld      a, 6(ix)
-        and     #0x80
-        jr      z, .eb_ok
-        inc     l
-.eb_ok:
-
-        ;; denormals treated as 0 (exp==0)
-        ld      a, h
-        or      a
-        jr      nz, .a_nz
-        ld      a, l
-        or      a
-        jr      nz, .a_zero_b_nz
-        jp      .ret0
-
-.a_zero_b_nz:
-        ;; 0 vs nonzero: sign(b) decides (b3=7(ix))
-        ld      a, 7(ix)
-        and     #0x80
-        jr      z, .retm1
-        jr      .retp1
-
-.a_nz:
-        ld      a, l
-        or      a
-        jr      nz, .both_nz
-        ;; a!=0, b==0: sign(a) decides
-        ld      a, b
-        and     #0x80
-        jr      z, .retp1
-        jr      .retm1
-
-.both_nz:
-        ;; signs differ?
-        ;; (a3 ^ b3) & 0x80
-        ld      a, b
-        xor     7(ix)
-        and     #0x80
-        jr      z, .same_sign
-        ;; different signs: positive is greater
-        ld      a, b
-        and     #0x80
-        jr      z, .retp1
-        jr      .retm1
-
-.same_sign:
-        ;; compare exponents (biased): h vs l
-        ld      a, h
-        cp      l
-        jr      z, .exp_equal
-
-        ;; if negative: reversed
-        bit     7, b
-        jr      z, .pos_exp
-
-        ;; both negative
-        ld      a, h
+        exx
+        pop     bc                        ; return address
+        pop     de
+        pop     hl                        ; hl':de' = b
+        push    bc
+        exx
+        call    __fp_cmp
+        ld      e,a
+        add     a,a
+        sbc     a,a
+        ld      d,a                       ; de = a sign extended
+        ret
+
+        ;; __fp_cmp
+        ;; inputs:  hl:de = a, hl':de' = b
+        ;; outputs: a = 0xFF if a<b, 0 if a==b, 1 if a>b or unordered
+        ;; clobbers: af, and swaps the register banks
+__fp_cmp:
+.if FLOAT_IEEE
+        ld      a,h
+        or      #0x80
+        inc     a                         ; zf = exponent 254 or 255, cf = 0
+        call    z,__fp_isnan
+        jr      c,.unord
+        exx
+        ld      a,h
+        or      #0x80
+        inc     a
+        call    z,__fp_isnan
+        exx
+        jr      c,.unord
+.endif
+        ld      a,h
+        exx                               ; b bank from here on
+        xor     h
+        jp      m,.signs                  ; signs differ
+        jr      z,.byte2
+        xor     h                         ; a = a3 again
+        cp      h
+        ;; fall through
+
+        ;; cf = a byte < b byte (they differ), same sign in h
+.order:
+        sbc     a,a
+        or      #1                        ; -1 or +1 on the magnitudes
+        bit     7,h
+        ret     z
+        neg                               ; both negative: reversed
+        ret
+
+.byte2:
+.if FLOAT_IEEE
+        ;; denormals order like the rest
+.else
+        ld      a,h
+        and     #0x7F
+        jr      nz,.mant
+        ld      a,l
+        exx
+        or      l
+        exx
+        jp      p,.eq                     ; both exponents 0: both zero
+.endif
+.mant:
+        exx
+        ld      a,l
+        exx
         cp      l
-        jr      c, .retp1
-        jr      .retm1
-
-.pos_exp:
-        ld      a, h
-        cp      l
-        jr      c, .retm1
-        jr      .retp1
-
-.exp_equal:
-        ;; same sign, same exponent:
-        ;; compare a2:a1:a0 vs b2:b1:b0
-        ;; (safe because exponent equal => bit7 of a2/b2 equal too)
-        ;;
-        ;; important: preserve carry from cp -> use bit for sign test
-
-        ;; a2 vs b2
-        ld      a, c
-        cp      6(ix)
-        jr      z, .mant_mid
-
-        bit     7, b
-        jr      z, .mant_pos_a2
-        ;; negative reversed
-        jr      c, .retp1
-        jr      .retm1
-.mant_pos_a2:
-        jr      c, .retm1
-        jr      .retp1
-
-.mant_mid:
-        ;; a1 vs b1
-        ld      a, d
-        cp      5(ix)
-        jr      z, .mant_low
-
-        bit     7, b
-        jr      z, .mant_pos_a1
-        ;; negative reversed
-        jr      c, .retp1
-        jr      .retm1
-.mant_pos_a1:
-        jr      c, .retm1
-        jr      .retp1
-
-.mant_low:
-        ;; a0 vs b0
-        ld      a, e
-        cp      4(ix)
-        jr      z, .ret0
-
-        bit     7, b
-        jr      z, .mant_pos_a0
-        ;; negative reversed
-        jr      c, .retp1
-        jr      .retm1
-.mant_pos_a0:
-        jr      c, .retm1
-        jr      .retp1
-
-.retm1:
-        ld      de, #0xffff
-        jr      .ret
-
-.ret0:
-        ld      de, #0x0000
-        jr      .ret
-
-.retp1:
-        ld      de, #0x0001
-        ;; fallthrough
-
-.ret:
-        pop     ix
-        jp      __fp_retpop4
+        jr      nz,.order
+        exx
+        ld      a,d
+        exx
+        cp      d
+        jr      nz,.order
+        exx
+        ld      a,e
+        exx
+        cp      e
+        jr      nz,.order
+.eq:
+        xor     a
+        ret
+
+        ;; the positive one is greater unless both are zero
+.signs:
+        call    .zero
+        jr      nz,.by_b
+        exx
+        call    .zero
+        exx
+        jr      z,.eq                     ; +0 == -0
+.by_b:
+        ld      a,#1
+        bit     7,h
+        ret     nz                        ; b < 0 < a
+        ld      a,#0xFF
+        ret
+
+.unord:
+        ld      a,#1
+        ret
+
+        ;; zf = 1 if hl:de is +-0 (or a denormal in the fast profile)
+        ;; clobbers: af
+.zero:
+.if FLOAT_IEEE
+        ld      a,h
+        add     a,a
+        or      l
+        or      d
+        or      e
+        ret
+.else
+        ld      a,l
+        rla
+        ld      a,h
+        adc     a,a                       ; a = biased exponent
+        ret
+.endif
@@ -1,7 +1,16 @@
 ;; float divide (ieee-754 single) for sdcc z80
         ;; result = a / b
-        ;; denormals treated as 0; division by zero returns max finite.
-        ;; 24-bit mantissa division producing 24 quotient bits.
+        ;; fast profile: denormals treated as 0; division by zero returns
+        ;; max finite. 24-bit mantissa division producing 24 quotient
+        ;; bits, rounded to nearest in every FLOAT_ROUND mode: a quotient
+        ;; of two 24-bit mantissas can never be exactly halfway between
+        ;; two floats, so the round bit alone decides and no tie-to-even
+        ;; case exists.
+        ;; FLOAT_PROFILE=ieee: NaN/Inf/denormal operands and results
+        ;; handled per IEEE-754 (see fpspecial.s), x/0 is +-Inf and 0/0
+        ;; is NaN. the round bit and the remainder form a guard byte for
+        ;; __fp_ieee_pack, so this profile rounds per FLOAT_ROUND and
+        ;; denormal results are rounded at their own precision.
         ;;
         ;; ABI (sdcccall(1)):
         ;;   a in regs: HLDE  (H=a3, L=a2, D=a1, E=a0)
@@ -26,6 +35,18 @@
         .globl  __fp_pack_norm
         .globl  __fp_zero32
 
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_nan_ab
+        .globl  __fp_class_ab
+        .globl  __fp_nan32
+        .globl  __fp_inf_sign
+        .globl  __fp_zero_sign
+        .globl  __fp_ieee_norm_ab
+        .globl  __fp_ieee_pack
+.endif
+
 ;; ============================================================
 ;; Frame layout:
 ;;
@@ -51,6 +72,7 @@
 ;;   ix-14 : quot[1]
 ;;   ix-15 : quot[2]    (MSB)
 ;;   ix-16 : integer bit (0 or 1)
+;;   ix-17 : result exponent high byte (FLOAT_IEEE only)
 ;; ============================================================
 
         ;; ___fsdiv
@@ -65,13 +87,67 @@ ___fsdiv:
         push    hl
         push    de
 
+.if FLOAT_IEEE
+        ld      hl,#-13
+.else
         ld      hl,#-12
+.endif
         add     hl,sp
         ld      sp,hl
 
         ;; ---- extract result sign and exponents ----
         call    __fp_unpack_sign_exps
 
+.if FLOAT_IEEE
+        ;; ---- zero, denormal, Inf and NaN operands ----
+        ld      a,c
+        dec     a
+        cp      #254
+        jr      nc,.special
+        ld      a,b
+        dec     a
+        cp      #254
+        jr      c,.finite
+
+.special:
+        call    __fp_nan_ab
+        jp      c,.cleanup
+        call    __fp_class_ab
+        ld      a,d
+        cp      e
+        jr      nz,.classes_differ
+        cp      #1
+        jr      z,.finite               ; denormal / denormal
+        call    __fp_nan32              ; 0/0, Inf/Inf
+        jp      .cleanup
+.classes_differ:
+        cp      #2
+        jr      z,.ret_inf              ; Inf/x
+        ld      a,e
+        cp      #2
+        jr      z,.ret_signed_zero      ; x/Inf
+        or      a
+        jr      z,.ret_inf              ; x/0
+.ret_signed_zero:                       ; 0/x
+        call    __fp_zero_sign
+        jp      .cleanup
+.ret_inf:
+        call    __fp_inf_sign
+        jp      .cleanup
+
+.finite:
+        ;; ---- build mantissas, denormals normalized ----
+        call    __fp_unpack_mant24_ab
+        call    __fp_ieee_norm_ab
+
+        ;; ---- result exponent: EA - EB + 127 (16-bit) ----
+        or      a
+        sbc     hl,de
+        ld      de,#127
+        add     hl,de
+        ld      -6(ix),l
+        ld      -17(ix),h
+.else
         ;; ---- check zero/denormal ----
         ld      a,c
         or      a
@@ -110,6 +186,7 @@ ___fsdiv:
 
         ;; ---- build mantissas A/B (with implicit 1) ----
         call    __fp_unpack_mant24_ab
+.endif
 
         ;; ---- zero quotient ----
         xor     a
@@ -149,10 +226,18 @@ ___fsdiv:
         jr      .div_start
 
 .int_bit_zero:
+.if FLOAT_IEEE
+        ld      l,-6(ix)
+        ld      h,-17(ix)
+        dec     hl
+        ld      -6(ix),l
+        ld      -17(ix),h
+.else
         ld      a,-6(ix)
         dec     a
         jp      z,.ret_zero
         ld      -6(ix),a
+.endif
         ld      -16(ix),#0
 
 .div_start:
@@ -198,6 +283,69 @@ ___fsdiv:
         rl      -15(ix)
         djnz    .div_loop
 
+.if FLOAT_IEEE
+        ;; ---- guard byte for __fp_ieee_pack ----
+        ;;
+        ;; bit 7 is the 25th quotient bit, bit 0 is set when the
+        ;; remainder is nonzero. the remainder can never be exactly half
+        ;; the divisor, so a set round bit always comes with sticky.
+        ld      a,c
+        or      e
+        or      d
+        ld      h,a                     ; h != 0: remainder nonzero
+
+        ld      a,-16(ix)
+        or      a
+        jr      nz,.guard_shift
+
+        ;; --- int_bit_zero: round bit = (rem << 1) >= divisor ---
+        sla     c
+        rl      e
+        rl      d
+        jr      c,.guard_round
+        ld      a,d
+        cp      -12(ix)
+        jr      c,.guard_none
+        jr      nz,.guard_round
+        ld      a,e
+        cp      -11(ix)
+        jr      c,.guard_none
+        jr      nz,.guard_round
+        ld      a,c
+        cp      -10(ix)
+        jr      c,.guard_none
+.guard_round:
+        ld      a,#0x80
+        jr      .guard_sticky
+.guard_none:
+        xor     a
+        jr      .guard_sticky
+
+        ;; --- int_bit_one: shift quotient right 1, restore the 1 ---
+.guard_shift:
+        srl     -15(ix)
+        rr      -14(ix)
+        rr      -13(ix)
+        set     7,-15(ix)
+        ld      a,#0
+        rra                             ; round bit = shifted-out q0
+
+.guard_sticky:
+        inc     h
+        dec     h
+        jr      z,.guard_done
+        or      #1
+.guard_done:
+        ld      b,-5(ix)
+        ld      l,-6(ix)
+        ld      h,-17(ix)
+        ld      c,-15(ix)
+        ld      d,-14(ix)
+        ld      e,-13(ix)
+        call    __fp_ieee_pack
+
+        jr      .cleanup
+.else
         ;; ---- round-to-nearest ----
         ;;
         ;; DEC holds the 24-bit remainder from the div_loop.
@@ -228,7 +376,7 @@ ___fsdiv:
         ld      a,c
         cp      -10(ix)
         jr      c,.no_round
-        jr      .do_round               ;; rem == divisor/2: round half up
+        jr      .do_round               ;; rem == divisor/2 cannot happen
 
         ;; --- int_bit_one: shift quotient right 1; carry = round bit ---
 .round_shift:
@@ -268,6 +416,7 @@ ___fsdiv:
         call    __fp_pack_norm
 
         jr      .cleanup
+.endif
 
 .ret_zero:
         call    __fp_zero32
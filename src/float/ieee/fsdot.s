@@ -0,0 +1,116 @@
+        ;; float array kernel: dot product
+        ;;
+        ;; sum of x[i] * y[i] in one stack frame. each product goes into an
+        ;; unpacked accumulator (see fpacc.s) through __fpacc_mul_frame, so
+        ;; neither the products nor the partial sums are packed; the result
+        ;; is rounded once at the end.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in HL, y in DE, n on stack (2 bytes)
+        ;;   result in HLDE
+        ;;   callee cleans n from stack
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fsdot
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fs_dot
+        .globl  __fpacc_mul_frame
+        .globl  _fpacc_result
+
+;; ============================================================
+;; Frame layout (the __fpacc_mul_frame part is the ___fsmul one):
+;;
+;;   ix+10,11 : n
+;;   ix+8,9   : return address
+;;   ix+4..7  : y[i]
+;;   ix+2,3   : unused
+;;   ix+0,1   : saved ix
+;;   ix-1..-4 : x[i], msb first
+;;   ix-5..-18  : __fpacc_mul_frame locals
+;;   ix-19..-25 : fpacc_t accumulator, iy points here
+;; ============================================================
+
+        ;; _fs_dot
+        ;; inputs:  HL = x, DE = y, n at 2(sp)
+        ;; outputs: HLDE = x[0] * y[0] + ... + x[n-1] * y[n-1]
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl', iy
+_fs_dot:
+        push    af              ; y[i] slot and a spare word under the
+        push    af              ; return address, where ___fsmul has b
+        push    af
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+
+        ld      iy,#-25         ; locals, the accumulator at the bottom
+        add     iy,sp
+        ld      sp,iy
+        xor     a
+        ld      3(iy),a         ; acc = +0
+        ld      5(iy),a
+
+        ld      c,10(ix)
+        ld      b,11(ix)        ; bc = n
+
+.loop:
+        ld      a,b
+        or      c
+        jr      z,.done
+        dec     bc
+        push    bc
+
+        ld      a,(hl)          ; x[i] to -4..-1
+        ld      -4(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      -3(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      -2(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      -1(ix),a
+        inc     hl
+        push    hl
+
+        ex      de,hl           ; y[i] to 4..7
+        ld      a,(hl)
+        ld      4(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      5(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      6(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      7(ix),a
+        inc     hl
+        push    hl
+
+        call    __fpacc_mul_frame
+
+        pop     de
+        pop     hl
+        pop     bc
+        jr      .loop
+
+.done:
+        push    iy
+        pop     hl
+        call    _fpacc_result
+
+        ld      sp,ix
+        pop     ix
+        pop     bc              ; drop the slots
+        pop     bc
+        pop     bc
+        pop     bc              ; return address
+        pop     af              ; drop n
+        push    bc
+        ret
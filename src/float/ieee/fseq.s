@@ -1,13 +1,19 @@
         ;; float equal (ieee-754 single) for sdcc z80
         ;; returns 1 if a==b else 0
-        ;; denormals treated as 0; NaN/Inf unsupported.
+        ;; denormals treated as 0; NaN/Inf unsupported (fast profile).
+        ;; FLOAT_PROFILE=ieee: false whenever a or b is NaN (see fscmp.s).
+        ;;
+        ;; equal floats have equal bits, except +0 and -0 (and in the
+        ;; fast profile any two denormals), so the bytes are compared
+        ;; most significant first and the zero test only runs when one
+        ;; of them differs.
         ;;
         ;; ABI (observed):
         ;;   a in regs: HL:DE
         ;;   b on stack: ret, b.low, b.high
         ;;   result in A (0/1)
         ;;
-        ;; clobbers: af, bc, de, hl, ix
+        ;; clobbers: af, bc, de, hl, bc', de', hl'
         ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2025 tomaz stih
@@ -18,37 +24,81 @@
         .area   _CODE
 
         .globl  ___fseq
-        .globl  ___fscmp
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_isnan
+.endif
 
         ;; ___fseq
         ;; inputs:  a in HL:DE, b on stack (2 words after return address)
         ;; outputs: A = 1 if a == b else 0
-        ;; clobbers: af, bc, de, hl, ix
+        ;; clobbers: af, bc, de, hl, bc', de', hl'
 ___fseq:
-        ;; Stack on entry: ret_to_caller, b.low, b.high
-        ;; a is in HL:DE (must preserve this!)
-
         exx
-        pop     hl                              ; HL' = return address
+        pop     bc                      ; return address
+        pop     de
+        pop     hl                      ; HL':DE' = b
+        push    bc
         exx
 
-        ;; Now stack is: b.low, b.high (correct for fscmp)
-        call    ___fscmp
-
-        ;; fscmp has cleaned stack and returned result in DE
+        ld      a,h
         exx
-        push    hl                              ; restore return address
+        cp      h
+        jr      nz,.differ
+        exx
+        ld      a,l
+        exx
+        cp      l
+        jr      nz,.differ
         exx
-
-        ;; Check if DE == 0
         ld      a,d
-        or      e
-        jr      nz, .ret_false
+        exx
+        cp      d
+        jr      nz,.differ
+        exx
+        ld      a,e
+        exx
+        cp      e
+        jr      nz,.differ
 
-        ;; result was 0, so a == b
+        ;; same bits
+.if FLOAT_IEEE
+        call    __fp_isnan
+        ld      a,#0
+        ret     c                       ; NaN != NaN
+.endif
         ld      a,#1
         ret
 
-.ret_false:
-        xor     a                               ; A = 0
+        ;; different bits: equal only if both are zero
+.differ:
+        call    .zero
+        jr      nz,.false
+        exx
+        call    .zero
+        jr      nz,.false
+        ld      a,#1
+        ret
+.false:
+        xor     a
+        ret
+
+        ;; zf = 1 if HL:DE is +-0 (or a denormal in the fast profile)
+        ;; clobbers: af
+.zero:
+.if FLOAT_IEEE
+        ld      a,h
+        add     a,a
+        or      l
+        or      d
+        or      e
+        ret
+.else
+        ld      a,l
+        rla
+        ld      a,h
+        adc     a,a                     ; a = biased exponent
         ret
+.endif
@@ -0,0 +1,203 @@
+        ;; float <-> 24-bit float for sdcc z80
+        ;;
+        ;; an f24_t is a float without its low mantissa byte: sign,
+        ;; 8-bit exponent and 15-bit mantissa in 3 bytes, lsb first. the
+        ;; layout and the exponent bias are those of a float, so f242fs
+        ;; only appends a zero byte and fs2f24 rounds the dropped byte
+        ;; into the other three per FLOAT_ROUND. a carry out of the
+        ;; mantissa bumps the exponent, up to +-Inf; with
+        ;; FLOAT_PROFILE=ieee a NaN stays a NaN.
+        ;;
+        ;; fs2f24_array copies the three kept bytes of each value with
+        ;; ldi, which also counts 3n down in bc, and rounds in place.
+        ;;
+        ;; C entry points (see include/fstore.h), sdcccall(1):
+        ;;   void fs2f24(f24_t *dst, float x);
+        ;;   float f242fs(const f24_t *src);
+        ;;   void fs2f24_array(f24_t *dst, const float *src, unsigned int n);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fsf24
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fs2f24
+        .globl  _f242fs
+        .globl  _fs2f24_array
+
+        .include "config.inc"
+
+        ;; _fs2f24
+        ;; inputs:  HL = dst, x at 2(sp)..5(sp)
+        ;; outputs: *dst = x rounded to 24 bits
+        ;; clobbers: af, bc, de, hl, iy
+_fs2f24:
+        push    hl
+        pop     iy                      ; iy = dst
+        pop     bc                      ; return address
+        pop     de
+        pop     hl                      ; HLDE = x
+        push    bc
+        call    .round
+        ld      0(iy),d
+        ld      1(iy),l
+        ld      2(iy),h
+        ret
+
+        ;; HLD = HLDE rounded to 24 bits
+        ;; clobbers: af
+.round:
+.if FLOAT_IEEE
+        ld      a,l
+        rla
+        ld      a,h
+        rla
+        inc     a
+        jr      nz,.finite
+        ld      a,l                     ; exponent 255 never rounds
+        and     #0x7F
+        or      d
+        or      e
+        ret     z                       ; Inf
+        set     6,l                     ; NaN: keep it one, quiet
+        ret
+.finite:
+.endif
+.if FLOAT_ROUND_NEAREST
+        ld      a,e
+        add     a,a                     ; cf = round bit, z = no sticky bits
+        ret     nc
+        jr      nz,.up
+        bit     0,d                     ; exactly half: round to even
+        ret     z
+.up:
+        inc     d
+        ret     nz
+        inc     l
+        ret     nz
+        inc     h                       ; exponent carry, may reach Inf
+.endif
+        ret
+
+        ;; _f242fs
+        ;; inputs:  HL = src
+        ;; outputs: HLDE = *src as a float (exact)
+        ;; clobbers: af, de, hl
+_f242fs:
+        ld      d,(hl)
+        inc     hl
+        ld      a,(hl)
+        inc     hl
+        ld      h,(hl)
+        ld      l,a
+        ld      e,#0
+        ret
+
+        ;; _fs2f24_array
+        ;; inputs:  HL = dst, DE = src, n at 2(sp)
+        ;; outputs: dst[i] = src[i] rounded to 24 bits for i < n
+        ;; clobbers: af, bc, de, hl
+_fs2f24_array:
+        pop     af                      ; return address
+        pop     bc                      ; bc = n
+        push    af
+        ld      a,b
+        or      c
+        ret     z
+        ex      de,hl                   ; hl = src, de = dst
+        push    hl
+        ld      h,b
+        ld      l,c
+        add     hl,hl
+        add     hl,bc
+        ld      b,h
+        ld      c,l                     ; bc = 3n, ldi counts it down
+        pop     hl
+.f2b_loop:
+.if FLOAT_IEEE
+        inc     hl
+        inc     hl
+        ld      a,(hl)
+        add     a,a                     ; cf = exponent bit 0
+        inc     hl
+        ld      a,(hl)
+        rla
+        inc     a
+        jr      z,.f2b_special          ; exponent 255 never rounds
+        dec     hl
+        dec     hl
+        dec     hl
+.endif
+        ld      a,(hl)                  ; the dropped byte
+        inc     hl
+.if FLOAT_ROUND_NEAREST
+        add     a,a                     ; cf = round bit, z = no sticky bits
+.endif
+        ldi
+        ldi
+        ldi                             ; keeps cf and z
+.if FLOAT_ROUND_NEAREST
+        jr      c,.f2b_round
+.endif
+        jp      pe,.f2b_loop
+        ret
+
+.if FLOAT_ROUND_NEAREST
+.f2b_round:
+        ex      de,hl
+        dec     hl
+        dec     hl
+        dec     hl                      ; hl = the value just stored
+        jr      nz,.f2b_up
+        bit     0,(hl)                  ; exactly half: round to even
+        jr      z,.f2b_end3
+.f2b_up:
+        inc     (hl)
+        inc     hl
+        jr      nz,.f2b_end2
+        inc     (hl)
+        inc     hl
+        jr      nz,.f2b_end1
+        inc     (hl)                    ; exponent carry, may reach Inf
+        jr      .f2b_end1
+.f2b_end3:
+        inc     hl
+.f2b_end2:
+        inc     hl
+.f2b_end1:
+        inc     hl
+        ex      de,hl
+        ld      a,b
+        or      c
+        jr      nz,.f2b_loop
+        ret
+.endif
+
+.if FLOAT_IEEE
+.f2b_special:
+        dec     hl
+        ld      a,(hl)
+        and     #0x7F
+        dec     hl
+        or      (hl)
+        dec     hl
+        or      (hl)                    ; z = Inf
+        inc     hl
+        ldi
+        ldi
+        ldi                             ; keeps z, p/v = more to do
+        jr      z,.f2b_inf
+        ex      de,hl
+        dec     hl
+        dec     hl
+        set     6,(hl)                  ; NaN: keep it one, quiet
+        inc     hl
+        inc     hl
+        ex      de,hl
+.f2b_inf:
+        jp      pe,.f2b_loop
+        ret
+.endif
@@ -0,0 +1,800 @@
+;; float fused multiply-add (ieee-754 single) for sdcc z80
+        ;; result = a * b + c, rounded once
+        ;;
+        ;; the 48-bit mantissa product of a and b stays unpacked: it is
+        ;; aligned against the unpacked addend, added, normalized and
+        ;; only then rounded and packed. compared to ___fsmul followed
+        ;; by ___fsadd this saves one pack/unpack round trip and one
+        ;; helper call per term, and the product is not rounded before
+        ;; the add.
+        ;;
+        ;; when the exponents differ by 2 or more at most one leading
+        ;; bit cancels: the add runs in registers on 48 bits, with the
+        ;; bits shifted out of the smaller operand jammed into bit 0.
+        ;; otherwise both operands go to 56-bit buffers so that any
+        ;; amount of cancellation stays exact.
+        ;;
+        ;; special values follow FLOAT_PROFILE like ___fsadd/___fsmul:
+        ;; fast flushes denormal a/b/c to zero, ieee handles NaN, Inf
+        ;; and denormals (0 * Inf + c and Inf - Inf are NaN). rounding
+        ;; follows FLOAT_ROUND.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   a in regs: HLDE  (H=a3, L=a2, D=a1, E=a0)
+        ;;   b, c on stack: 4 bytes each, b nearest to the return address
+        ;;   result in HLDE
+        ;;   callee cleans b and c from stack
+        ;;
+        ;; clobbers: af, bc, de, hl, bc', de', hl', ix, iy
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fsfma
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  ___fsfma
+        .globl  __fp_fma_frame
+        .globl  __fp_fma_prod
+        .globl  __fp_retpop8
+        .globl  __fp_unpack_sign_exps
+        .globl  __fp_unpack_mant24_ab
+        .globl  __fp_mul48_ab
+        .globl  __fp_round_pack
+        .globl  __fp_zero32
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_nan_ab
+        .globl  __fp_class_ab
+        .globl  __fp_nan32
+        .globl  __fp_inf_sign
+        .globl  __fp_ieee_norm_ab
+        .globl  __fp_ieee_pack
+.endif
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+8..11 : c0..c3
+;;   ix+4..7  : b0..b3
+;;   ix+2,3   : return address
+;;   ix+0,1   : saved ix
+;;   ix-1..-4 : a3..a0
+;;   ix-5     : sign of a*b, later sign of the result
+;;   ix-7..-12  : mant_a, mant_b (see __fp_unpack_mant24_ab)
+;;   ix-13..-18 : prod[0..5] (see __fp_mul48_ab)
+;;   ix-12..-18 : P, 56-bit product: prod << 8, MSB at -18
+;;   ix-19..-25 : C, 56-bit addend: mantissa << 32, MSB at -25
+;;   ix-26,-27  : exponent of P, later of the result (16-bit)
+;;   ix-28,-29  : exponent of C (16-bit)
+;;   ix-30      : sign of c
+;;   ix-31      : 0x80 when the signs of P and C differ
+;;
+;; both buffers keep their least significant byte at the highest
+;; address, like prod.
+;; ============================================================
+
+        ;; ___fsfma
+        ;; inputs:  a in HLDE, b and c on caller stack (4 bytes each)
+        ;; outputs: HLDE = IEEE-754 single a * b + c
+        ;; clobbers: af, bc, de, hl, bc', de', hl', ix, iy
+___fsfma:
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+
+        push    hl              ; ix-1=H(a3), ix-2=L(a2)
+        push    de              ; ix-3=D(a1), ix-4=E(a0)
+
+        ;; allocate locals (27 bytes)
+        ld      hl,#-27
+        add     hl,sp
+        ld      sp,hl
+
+        call    __fp_fma_frame
+
+        ld      sp,ix
+        pop     ix
+        jp      __fp_retpop8
+
+        ;; __fp_fma_frame
+        ;; inputs:  IX frame above: a at -4..-1(ix), b at 4..7(ix),
+        ;;          c at 8..11(ix), locals allocated
+        ;; outputs: HLDE = IEEE-754 single a * b + c
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;; notes: fs_axpy (fsaxpy.s) builds this frame once and falls
+        ;;        back to it for elements __fp_fma_prod does not take.
+__fp_fma_frame:
+        ;; ---- signs and exponents ----
+        call    __fp_unpack_sign_exps
+
+        ld      a,11(ix)
+        and     #0x80
+        ld      -30(ix),a
+        xor     -5(ix)
+        ld      -31(ix),a
+
+        ld      a,11(ix)
+        and     #0x7F
+        rlca
+        bit     7,10(ix)
+        jr      z,.ec_done
+        inc     a
+.ec_done:
+        ld      -28(ix),a
+        ld      -29(ix),#0
+
+.if FLOAT_IEEE
+        ;; ---- zero, denormal, Inf and NaN operands ----
+        ld      a,c
+        dec     a
+        cp      #254
+        jr      nc,.special
+        ld      a,b
+        dec     a
+        cp      #254
+        jr      nc,.special
+        ld      a,-28(ix)
+        dec     a
+        cp      #254
+        jp      c,.finite
+
+.special:
+        call    __fp_nan_ab
+        jp      c,.cleanup
+        ld      a,-28(ix)
+        inc     a
+        jr      nz,.c_not_nan
+        ld      a,10(ix)
+        and     #0x7F
+        or      9(ix)
+        or      8(ix)
+        jr      z,.c_not_nan
+        ld      h,11(ix)        ; c is NaN
+        ld      l,10(ix)
+        set     6,l
+        ld      d,9(ix)
+        ld      e,8(ix)
+        jp      .cleanup
+
+.c_not_nan:
+        call    __fp_class_ab
+        ld      a,d
+        cp      #2
+        jr      z,.p_inf
+        ld      a,e
+        cp      #2
+        jr      nz,.p_finite
+.p_inf:
+        ld      a,d
+        or      a
+        jr      z,.ret_nan      ; 0 * Inf
+        ld      a,e
+        or      a
+        jr      z,.ret_nan      ; Inf * 0
+        ld      a,-28(ix)
+        inc     a
+        jr      nz,.ret_inf     ; Inf + finite
+        ld      a,-31(ix)
+        or      a
+        jr      nz,.ret_nan     ; Inf - Inf
+.ret_inf:
+        call    __fp_inf_sign
+        jp      .cleanup
+.ret_nan:
+        call    __fp_nan32
+        jp      .cleanup
+
+.p_finite:
+        ld      a,-28(ix)
+        inc     a
+        jp      z,.ret_c        ; finite + Inf
+        ld      a,d
+        or      a
+        jr      z,.p_zero
+        ld      a,e
+        or      a
+        jr      nz,.finite      ; only denormals left
+.p_zero:
+        ;; zero product: the result is c, but +-0 + +-0 is -0 only
+        ;; when both are -0
+        ld      a,-28(ix)
+        or      a
+        jp      nz,.ret_c
+        ld      a,10(ix)
+        or      9(ix)
+        or      8(ix)
+        jp      nz,.ret_c
+        ld      a,-5(ix)
+        and     -30(ix)
+        ld      h,a
+        ld      l,#0
+        ld      d,l
+        ld      e,l
+        jp      .cleanup
+
+.finite:
+        call    __fp_unpack_mant24_ab
+        call    __fp_ieee_norm_ab
+.else
+        ;; ---- zero/denormal a or b: the product is zero ----
+        ld      a,c
+        or      a
+        jp      z,.ret_c
+        ld      a,b
+        or      a
+        jp      z,.ret_c
+
+        call    __fp_unpack_mant24_ab
+        ld      h,#0
+        ld      l,c
+        ld      d,h
+        ld      e,b
+.endif
+
+        ;; __fp_fma_prod
+        ;; inputs:  IX frame above with c at 8..11(ix), signs at -5,
+        ;;          -30 and -31(ix), exponent of c at -28,-29(ix),
+        ;;          normal mantissas at -7..-12(ix), HL = EA, DE = EB
+        ;; outputs: HLDE = IEEE-754 single a * b + c
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;; notes: fs_axpy unpacks a once and enters here per element.
+__fp_fma_prod:
+        ;; ---- exponent of P: EA + EB - 127 ----
+        add     hl,de
+        ld      de,#-127
+        add     hl,de
+        push    hl
+
+        ;; ---- 24x24 multiply into prod[5:0] ----
+        call    __fp_mul48_ab
+
+        ;; ---- P is normalized to prod bit 47: exponent + 1 ----
+        pop     hl
+        bit     7,-18(ix)
+        jr      z,.p_exp_done
+        inc     hl
+.p_exp_done:
+        ld      -26(ix),l
+        ld      -27(ix),h
+
+        ;; ---- C = mant_c (top three bytes of its buffer) ----
+        ld      a,-28(ix)
+        or      a
+        jp      z,.c_zero
+        ld      a,10(ix)
+        or      #0x80
+.c_fill:
+        ld      -25(ix),a
+        ld      a,9(ix)
+        ld      -24(ix),a
+        ld      a,8(ix)
+        ld      -23(ix),a
+
+.if FLOAT_IEEE
+        ;; a denormal c has exponent 1 and no implicit 1: normalize it
+        ld      l,-28(ix)
+        ld      h,-29(ix)
+.c_norm:
+        bit     7,-25(ix)
+        jr      nz,.c_norm_done
+        sla     -23(ix)
+        rl      -24(ix)
+        rl      -25(ix)
+        dec     hl
+        jr      .c_norm
+.c_norm_done:
+        ld      -28(ix),l
+        ld      -29(ix),h
+.endif
+
+        ;; ---- exponent difference ----
+        ld      l,-26(ix)
+        ld      h,-27(ix)
+        ld      e,-28(ix)
+        ld      d,-29(ix)
+        or      a
+        sbc     hl,de           ; hl = exp P - exp C
+        inc     hl
+        ld      a,h
+        or      a
+        jr      nz,.far
+        ld      a,l
+        cp      #3
+        jp      c,.near         ; exponents within one: exact path
+.far:
+        dec     hl
+
+        ;; ---- far: 48 bits in registers ----
+        ;;
+        ;; the larger operand L is h'l':hl with 16 more bits at
+        ;; -14..-13(ix), the smaller S is d'e':de:b'c'. P is exact in
+        ;; 48 bits so only the shifted operand needs a sticky bit, and
+        ;; with the exponents two or more apart at most one leading
+        ;; bit cancels.
+        bit     7,h
+        jr      nz,.far_c
+
+        push    hl              ; P is larger, S = C
+        call    .load_p
+        exx
+        ld      d,-25(ix)
+        ld      e,-24(ix)
+        ld      bc,#0
+        exx
+        ld      d,-23(ix)
+        ld      e,#0
+        pop     bc
+        ld      a,b
+        or      a
+        ld      a,c
+        jp      nz,.far_all     ; difference >= 256
+        jr      .far_shift
+
+.far_c:
+        xor     a               ; C is larger, S = P
+        sub     l
+        ld      l,a
+        sbc     a,a
+        sub     h
+        ld      h,a
+        push    hl
+        call    .load_p
+        ex      de,hl
+        exx
+        ex      de,hl
+        ld      b,-14(ix)
+        ld      c,-13(ix)
+        ld      h,-25(ix)
+        ld      l,-24(ix)
+        exx
+        ld      h,-23(ix)
+        xor     a
+        ld      l,a
+        ld      -14(ix),a
+        ld      -13(ix),a
+        ld      a,-28(ix)       ; the result takes exponent and sign of c
+        ld      -26(ix),a
+        ld      a,-29(ix)
+        ld      -27(ix),a
+        ld      a,-30(ix)
+        ld      -5(ix),a
+        pop     bc
+        ld      a,b
+        or      a
+        ld      a,c
+        jp      nz,.far_all
+
+.far_shift:
+        ;; shift S right by a (>= 2), lost bits jammed into bit 0
+        cp      #48
+        jr      nc,.far_all
+        ld      b,a
+        ld      c,#0            ; c != 0: a whole byte fell off
+.far_bytes:
+        ld      a,b
+        cp      #8
+        jr      c,.far_bits
+        sub     #8
+        ld      b,a
+        exx
+        ld      a,c
+        ld      c,b
+        exx
+        or      c
+        ld      c,a
+        ld      a,e
+        exx
+        ld      b,a
+        ld      a,e
+        ld      e,d
+        ld      d,#0
+        exx
+        ld      e,d
+        ld      d,a
+        jr      .far_bytes
+.far_bits:
+        or      a
+        jr      z,.far_jam
+.far_bit:
+        exx
+        srl     d
+        rr      e
+        exx
+        rr      d
+        rr      e
+        exx
+        rr      b
+        rr      c
+        jr      nc,.far_next
+        set     0,c
+.far_next:
+        exx
+        djnz    .far_bit
+.far_jam:
+        ld      a,c
+        or      a
+        jr      z,.far_op
+        exx
+        set     0,c
+        exx
+        jr      .far_op
+
+.far_all:
+        ld      de,#0           ; S is far below: only its sticky bit
+        exx
+        ld      de,#0
+        ld      bc,#1
+        exx
+
+.far_op:
+        ld      a,-31(ix)
+        or      a
+        jr      nz,.far_sub
+
+        exx
+        ld      a,c
+        add     a,-13(ix)
+        ld      c,a
+        ld      a,b
+        adc     a,-14(ix)
+        ld      b,a
+        exx
+        adc     hl,de
+        exx
+        adc     hl,de
+        exx
+        jr      nc,.far_sticky
+        exx                     ; carry out: shift right, exponent + 1
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        jr      nc,.far_inc
+        set     0,l
+.far_inc:
+        ld      c,-26(ix)
+        ld      b,-27(ix)
+        inc     bc
+        ld      -26(ix),c
+        ld      -27(ix),b
+        jr      .far_sticky
+
+.far_sub:
+        exx
+        ld      a,-13(ix)
+        sub     c
+        ld      c,a
+        ld      a,-14(ix)
+        sbc     a,b
+        ld      b,a
+        exx
+        sbc     hl,de
+        exx
+        sbc     hl,de
+        bit     7,h
+        exx
+        jr      nz,.far_sticky
+        exx                     ; one bit cancelled: shift left
+        sla     c
+        rl      b
+        exx
+        adc     hl,hl
+        exx
+        adc     hl,hl
+        exx
+        ld      c,-26(ix)
+        ld      b,-27(ix)
+        dec     bc
+        ld      -26(ix),c
+        ld      -27(ix),b
+
+        ;; the 16 bits below the guard byte become its sticky bit
+.far_sticky:
+        exx
+        ld      a,b
+        or      c
+        exx
+        jr      z,.round32
+        set     0,l
+        jr      .round32
+
+.c_zero:
+.if FLOAT_IEEE
+        ld      a,10(ix)
+        or      9(ix)
+        or      8(ix)
+        jr      z,.c_is_zero
+        ld      -28(ix),#1      ; denormal c
+        ld      a,10(ix)
+        jp      .c_fill
+.c_is_zero:
+.endif
+        ;; c is zero: round the product alone
+        call    .load_p
+        ld      a,-14(ix)
+        or      -13(ix)
+        jr      z,.round32
+        set     0,l
+
+        ;; ---- round and pack h'l'h, guard byte l ----
+.round32:
+.if FLOAT_IEEE
+        ld      a,l             ; guard byte
+        ld      e,h
+        exx
+        push    hl
+        exx
+        pop     bc
+        ld      d,c
+        ld      c,b
+        ld      b,-5(ix)
+        ld      l,-26(ix)
+        ld      h,-27(ix)
+        call    __fp_ieee_pack
+        jp      .cleanup
+.else
+        ld      a,-27(ix)
+        or      a
+        jr      nz,.exp_out
+        ld      a,-26(ix)
+        or      a
+        jr      z,.ret_zero
+        inc     a
+        jr      z,.ret_huge
+        ld      a,l             ; guard byte
+        ld      e,h
+        exx
+        push    hl
+        exx
+        pop     hl
+        ld      d,l
+        ld      l,h
+        res     7,l
+        ld      b,-5(ix)
+        ld      c,-26(ix)
+        call    __fp_round_pack
+        jp      .cleanup
+
+.exp_out:
+        bit     7,a
+        jr      z,.ret_huge
+.ret_zero:
+        call    __fp_zero32
+        jp      .cleanup
+
+.ret_huge:
+        ld      a,-5(ix)        ; overflow: +-Inf
+        or      #0x7F
+        ld      h,a
+        ld      l,#0x80
+        ld      d,#0
+        ld      e,d
+        jp      .cleanup
+.endif
+
+        ;; ---- near: exponents within one, exact 56-bit path ----
+        ;;
+        ;; P and C are laid out in full 56-bit buffers so that any
+        ;; amount of cancellation leaves the exact difference.
+.near:
+        ld      -12(ix),#0      ; P = prod << 8
+        bit     7,-18(ix)
+        jr      nz,.near_p_ok
+        sla     -13(ix)
+        rl      -14(ix)
+        rl      -15(ix)
+        rl      -16(ix)
+        rl      -17(ix)
+        rl      -18(ix)
+.near_p_ok:
+        xor     a               ; C = mant_c << 32
+        ld      -22(ix),a
+        ld      -21(ix),a
+        ld      -20(ix),a
+        ld      -19(ix),a
+
+        push    ix
+        pop     iy
+        ld      de,#-25
+        add     iy,de           ; iy = C msb
+        dec     l               ; l = exp P - exp C
+        jr      z,.near_p_big   ; equal: L = P
+        jp      p,.near_c_shift
+        
+        ;; C one above: L = C, shift P right by one
+        srl     -18(ix)
+        rr      -17(ix)
+        rr      -16(ix)
+        rr      -15(ix)
+        rr      -14(ix)
+        rr      -13(ix)
+        rr      -12(ix)
+        ld      a,-28(ix)       ; the result takes exponent and sign of c
+        ld      -26(ix),a
+        ld      a,-29(ix)
+        ld      -27(ix),a
+        ld      a,-30(ix)
+        ld      -5(ix),a
+        push    iy
+        ld      de,#7
+        add     iy,de
+        push    iy
+        pop     de              ; de = P msb
+        pop     iy              ; iy = C msb
+        jr      .near_op
+
+.near_c_shift:
+        ;; P one above: shift C right by one
+        srl     -25(ix)
+        rr      -24(ix)
+        rr      -23(ix)
+        rr      -22(ix)
+.near_p_big:
+        push    iy
+        pop     de              ; de = C msb
+        ld      bc,#7
+        add     iy,bc           ; iy = P msb
+
+.near_op:
+        ;; L (iy) +-= S (de)
+        ld      hl,#6
+        add     hl,de
+        ex      de,hl           ; de = S lsb
+        push    iy
+        pop     hl
+        ld      bc,#6
+        add     hl,bc           ; hl = L lsb
+        ld      b,#7
+        ld      a,-31(ix)
+        or      a
+        jr      nz,.sub
+
+        ;; same signs: add, a carry out shifts the sum right by one
+.add_loop:
+        ld      a,(de)
+        adc     a,(hl)
+        ld      (hl),a
+        dec     de
+        dec     hl
+        djnz    .add_loop
+        jp      nc,.near_round
+        ld      b,#7
+.add_carry:
+        inc     hl              ; carry goes in at the msb
+        rr      (hl)
+        djnz    .add_carry
+        ld      l,-26(ix)
+        ld      h,-27(ix)
+        inc     hl
+        ld      -26(ix),l
+        ld      -27(ix),h
+        jp      .near_round
+
+        ;; signs differ: subtract, negate on borrow (only when the
+        ;; exponents are equal and S was the larger one)
+.sub:
+        ex      de,hl           ; hl = S lsb, de = L lsb
+        or      a
+.sub_loop:
+        ld      a,(de)
+        sbc     a,(hl)
+        ld      (de),a
+        dec     de
+        dec     hl
+        djnz    .sub_loop
+        ex      de,hl
+        jr      nc,.sub_done
+        ld      de,#7
+        add     hl,de           ; hl = L lsb
+        ld      b,#7
+        or      a
+.neg_loop:
+        ld      a,#0
+        sbc     a,(hl)
+        ld      (hl),a
+        dec     hl
+        djnz    .neg_loop
+        ld      a,-5(ix)
+        xor     #0x80
+        ld      -5(ix),a
+.sub_done:
+        ld      a,0(iy)
+        or      1(iy)
+        or      2(iy)
+        or      3(iy)
+        or      4(iy)
+        or      5(iy)
+        or      6(iy)
+        jr      nz,.normalize
+        call    __fp_zero32     ; exact cancellation: +0
+        jp      .cleanup
+
+        ;; ---- normalize: shift L left until bit 55 is set ----
+.normalize:
+        ld      l,-26(ix)
+        ld      h,-27(ix)
+.norm_loop:
+        bit     7,0(iy)
+        jr      nz,.norm_done
+        ld      a,0(iy)
+        or      a
+        jr      nz,.norm_bit
+        push    hl              ; whole zero byte: move up 8 bits
+        push    iy
+        pop     de
+        push    iy
+        pop     hl
+        inc     hl
+        ld      bc,#6
+        ldir
+        xor     a
+        ld      (de),a
+        pop     hl
+        ld      bc,#-8
+        add     hl,bc
+        jr      .norm_loop
+.norm_bit:
+        sla     6(iy)
+        rl      5(iy)
+        rl      4(iy)
+        rl      3(iy)
+        rl      2(iy)
+        rl      1(iy)
+        rl      0(iy)
+        dec     hl
+        jr      .norm_loop
+.norm_done:
+        ld      -26(ix),l
+        ld      -27(ix),h
+
+        ;; top 32 bits plus sticky to h'l':hl
+.near_round:
+        exx
+        ld      h,0(iy)
+        ld      l,1(iy)
+        exx
+        ld      h,2(iy)
+        ld      l,3(iy)
+        ld      a,4(iy)
+        or      5(iy)
+        or      6(iy)
+        jp      z,.round32
+        set     0,l
+        jp      .round32
+
+.ret_c:
+        ld      e,8(ix)
+        ld      d,9(ix)
+        ld      l,10(ix)
+        ld      h,11(ix)
+
+.cleanup:
+        ret
+
+        ;; .load_p
+        ;; inputs:  IX frame with prod at -13..-18(ix)
+        ;; outputs: h'l':hl = top 32 bits of P normalized to bit 31,
+        ;;          -14..-13(ix) = the 16 bits below, shifted along
+        ;; clobbers: af, hl, hl'
+.load_p:
+        exx
+        ld      h,-18(ix)
+        ld      l,-17(ix)
+        exx
+        ld      h,-16(ix)
+        ld      l,-15(ix)
+        bit     7,-18(ix)
+        ret     nz
+        sla     -13(ix)         ; one bit up
+        rl      -14(ix)
+        adc     hl,hl
+        exx
+        adc     hl,hl
+        exx
+        ret
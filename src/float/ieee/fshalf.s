@@ -0,0 +1,233 @@
+        ;; float <-> ieee-754 binary16 (half) for sdcc z80
+        ;;
+        ;; a half is sign, 5-bit exponent (bias 15) and 10-bit mantissa,
+        ;; so its fields sit 13 bits lower than those of a float. fs2half
+        ;; shifts bits 13..28 of the float down into one 16-bit word and
+        ;; rebiases the exponent with a single add, the 13 bits below are
+        ;; the guard byte. half2fs widens the mantissa and packs the float
+        ;; with __fp_pack_norm.
+        ;;
+        ;; fs2half rounds per FLOAT_ROUND, values of 2^16 and up give
+        ;; +-Inf. the fast profile flushes what does not round to 2^-14
+        ;; or more to +-0 and treats a half denormal as 0;
+        ;; FLOAT_PROFILE=ieee makes half denormals (rounded once) and
+        ;; keeps NaN a NaN.
+        ;;
+        ;; C entry points (see include/fstore.h), sdcccall(1):
+        ;;   half_t fs2half(float x);
+        ;;   float half2fs(half_t h);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fshalf
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fs2half
+        .globl  _half2fs
+        .globl  __fp_pack_norm
+
+        .include "config.inc"
+
+        ;; _fs2half
+        ;; inputs:  HLDE = x (H=x3, L=x2, D=x1, E=x0)
+        ;; outputs: DE = x as binary16
+        ;; clobbers: af, bc, hl
+_fs2half:
+        ld      a,h
+        and     #0x80
+        ld      b,a                     ; b = sign
+        ld      a,l
+        rla
+        ld      a,h
+        rla                             ; a = biased exponent
+.if FLOAT_IEEE
+        inc     a
+        jr      z,.f2h_special          ; Inf, NaN
+        dec     a
+.endif
+        cp      #127 - 14
+        jr      c,.f2h_tiny             ; below 2^-14
+        cp      #127 + 16
+        jr      nc,.f2h_inf
+        ld      a,d
+        add     a,a
+        rl      l
+        rl      h
+        add     a,a
+        rl      l
+        rl      h
+        add     a,a
+        rl      l
+        rl      h                       ; hl = x bits 13..28
+        inc     e
+        dec     e
+        jr      z,.f2h_rebias
+        or      #1                      ; sticky
+.f2h_rebias:
+        ld      de,#0x4000
+        add     hl,de                   ; exponent -= 112 (mod 2^16)
+
+        ;; hl = half without its sign, a = guard byte
+.f2h_round:
+.if FLOAT_ROUND_NEAREST
+        add     a,a                     ; cf = round bit, z = no sticky bits
+        jr      nc,.f2h_sign
+        jr      nz,.f2h_up
+        bit     0,l                     ; exactly half: round to even
+        jr      z,.f2h_sign
+.f2h_up:
+        inc     hl                      ; may carry into Inf
+.endif
+.f2h_sign:
+        ld      a,h
+        or      b
+        ld      d,a
+        ld      e,l
+        ret
+
+.f2h_tiny:
+.if FLOAT_IEEE
+        cp      #126 - 24
+        jr      c,.f2h_zero             ; below 2^-25: rounds to 0
+        neg
+        add     a,#126
+        ld      c,a                     ; c = 126 - exponent, 14..24
+        set     7,l                     ; implicit bit
+        ld      h,#0                    ; guard byte
+.f2h_bytes:
+        ld      a,c
+        sub     #8
+        jr      c,.f2h_bits
+        ld      c,a
+        ld      a,h
+        or      a
+        ld      a,e
+        jr      z,.f2h_byte
+        or      #1                      ; sticky
+.f2h_byte:
+        ld      h,a
+        ld      e,d
+        ld      d,l
+        ld      l,#0
+        jr      .f2h_bytes
+.f2h_bits:
+        inc     c
+        jr      .f2h_next
+.f2h_shift:
+        srl     l
+        rr      d
+        rr      e
+        rr      h
+        jr      nc,.f2h_next
+        set     0,h
+.f2h_next:
+        dec     c
+        jr      nz,.f2h_shift
+        ld      a,h
+        ex      de,hl                   ; hl = denormal mantissa
+        jr      .f2h_round
+.else
+.if FLOAT_ROUND_NEAREST
+        cp      #127 - 15
+        jr      nz,.f2h_zero            ; below 2^-15: never reaches 2^-14
+        ld      a,l
+        or      #0x80
+        inc     a
+        jr      nz,.f2h_zero
+        ld      a,d
+        cp      #0xE0
+        jr      c,.f2h_zero             ; below 2^-14 - 2^-25
+        ld      a,b
+        or      #0x04                   ; rounds up to 2^-14
+        ld      d,a
+        ld      e,#0
+        ret
+.endif
+.endif
+.f2h_zero:
+        ld      d,b
+        ld      e,#0
+        ret
+
+.f2h_inf:
+        ld      a,b
+        or      #0x7C
+        ld      d,a
+        ld      e,#0
+        ret
+
+.if FLOAT_IEEE
+.f2h_special:
+        ld      a,l
+        and     #0x7F
+        or      d
+        or      e
+        jr      z,.f2h_inf
+        ld      a,b
+        or      #0x7E                   ; quiet NaN
+        ld      d,a
+        ld      e,#0
+        ret
+.endif
+
+        ;; _half2fs
+        ;; inputs:  HL = h
+        ;; outputs: HLDE = h as a float (exact)
+        ;; clobbers: af, bc, de, hl
+_half2fs:
+        ld      a,h
+        and     #0x80
+        ld      b,a                     ; b = sign
+        ld      a,h
+        rrca
+        rrca
+        and     #0x1F
+        ld      c,a                     ; c = exponent
+        ld      a,h
+        and     #0x03
+        ld      h,a                     ; hl = mantissa
+        ld      a,c
+        or      a
+        jr      z,.h2f_tiny
+        cp      #31
+        jr      z,.h2f_special
+        add     a,#127 - 15
+        ld      c,a
+.h2f_pack:
+        add     hl,hl
+        add     hl,hl
+        add     hl,hl
+        add     hl,hl
+        add     hl,hl                   ; mantissa << 5, bit 7 of h clear
+        ld      d,l
+        ld      e,#0
+        ld      l,h
+        jp      __fp_pack_norm
+
+.h2f_special:
+        ld      c,#255                  ; Inf, NaN
+        jr      .h2f_pack
+
+.h2f_tiny:
+.if FLOAT_IEEE
+        ld      a,h
+        or      l
+        jr      z,.h2f_zero
+        ld      c,#127 - 14
+.h2f_norm:
+        add     hl,hl
+        dec     c
+        bit     2,h
+        jr      z,.h2f_norm
+        res     2,h                     ; implicit bit
+        jr      .h2f_pack
+.endif
+.h2f_zero:
+        ld      h,b
+        ld      l,#0
+        ld      d,l
+        ld      e,l
+        ret
@@ -0,0 +1,417 @@
+        ;; float reciprocal (ieee-754 single) for sdcc z80
+        ;; result = 1 / x
+        ;;
+        ;; Newton-Raphson on the 24-bit mantissa B, w ~ 2 / b with
+        ;; b = B / 2^23 in [1, 2). the seed W = 2^16 + F0 comes from a
+        ;; 257-entry table of 2 / b over the top 8 fraction bits,
+        ;; interpolated on the next 8, good to about 2^-16. one step
+        ;; with the exact error e = 2^40 - B W gives
+        ;;   Y = W 2^15 (1 + e / 2^40) ~ 2^55 / B
+        ;; within 4 units. the products are ___muluint2ulong and
+        ;; __mul16 (the error needs only the low 32 bits of B W, so
+        ;; two products instead of three), the interpolation one
+        ;; __mul8x8.
+        ;;
+        ;; Y carries 7 bits below the rounding bit. unless they are
+        ;; within 4 of a multiple of 2^7 (1 in 16) they give the round
+        ;; and sticky bits as they are, and the result is rounded once
+        ;; per FLOAT_ROUND, correctly. otherwise the nearest multiple
+        ;; is checked exactly with one __mullong: Y B is 2^55 mod 2^32
+        ;; when exact, below when Y is too small.
+        ;;
+        ;; a loop dividing by the same x can take 1 / x once and call
+        ;; ___fsmul, within 1.5 ulp of the quotient (two roundings,
+        ;; 3 ulp with FLOAT_ROUND=trunc).
+        ;;
+        ;; fast profile: 0 and denormals give +-max finite, results
+        ;; below 2^-126 flush to +-0.
+        ;; FLOAT_PROFILE=ieee: 1 / +-0 = +-Inf, 1 / +-Inf = +-0, a NaN
+        ;; is returned quiet, denormals are normalized and results
+        ;; past 2^128 overflow to +-Inf or underflow to denormals.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in regs: HLDE  (H=x3, L=x2, D=x1, E=x0)
+        ;;   result in HLDE
+        ;;
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fsinv
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  ___fsinv
+        .globl  __fp_unpack_norm
+        .globl  __fp_norm_pack
+        .globl  __mul8x8
+        .globl  __mul16
+        .globl  ___muluint2ulong
+        .globl  __mullong
+
+        .include "config.inc"
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+2,3: return address
+;;   ix+0,1: saved ix
+;;   ix-1 : H = x3        \  push hl
+;;   ix-2 : L = x2        /
+;;   ix-3 : D = x1        \  push de
+;;   ix-4 : E = x0        /
+;;   ix-5 : sign mask for __fp_norm_pack
+;;   ix-6 : bit 7 clear when e = 2^40 - B W is negative
+;;   ix-7  : B[0]  (LSB)
+;;   ix-8  : B[1]
+;;   ix-9  : B[2]  (MSB, with implicit 1)
+;;   ix-11,-10 : F0 (-10 low)
+;;   ix-13,-12 : exponent of x (-12 low)
+;; ============================================================
+
+        ;; ___fsinv
+        ;; inputs:  x in HLDE
+        ;; outputs: HLDE = IEEE-754 single 1 / x
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+___fsinv:
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+        push    hl
+        push    de
+        ld      hl,#-9
+        add     hl,sp
+        ld      sp,hl
+
+        ld      a,-2(ix)
+        rla
+        ld      a,-1(ix)
+        rla
+        ld      c,a                     ; c = biased exponent
+        sbc     a,a
+        and     #0x80
+        ld      -5(ix),a                ; sign
+
+.if FLOAT_IEEE
+        ld      a,c
+        inc     a
+        jp      z,.special
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        or      c
+        jp      z,.inf                  ; 1 / +-0 = +-Inf
+.else
+        ld      a,c
+        or      a
+        jp      z,.maxfin               ; 0 and denormals
+.endif
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        call    __fp_unpack_norm        ; |x| = m / 2^31 * 2^e
+        ld      -12(ix),e
+        ld      -13(ix),d
+        ld      -9(ix),h
+        ld      -8(ix),l
+        exx
+        ld      a,h
+        exx
+        ld      -7(ix),a                ; B = m >> 8
+        ld      a,h
+        and     #0x7F
+        or      l
+        or      -7(ix)
+        jr      nz,.seed
+
+        ;; ---- B = 2^23: 1 / x = 2^-e, m as it is ----
+        xor     a
+        sub     e
+        ld      e,a
+        sbc     a,a
+        sub     d
+        ld      d,a                     ; de = -e
+        jp      .pack
+
+        ;; ---- F0 = T[i] - (T[i] - T[i+1]) t / 256 ----
+.seed:
+        ld      a,-7(ix)
+        add     a,a
+        ld      a,l
+        rla
+        ld      c,a                     ; c = t, fraction bits 14..7
+        ld      a,h
+        rla                             ; a = i, fraction bits 22..15
+        ld      l,a
+        ld      h,#0
+        add     hl,hl
+        ld      de,#.tab
+        add     hl,de
+        ld      e,(hl)
+        inc     hl
+        ld      d,(hl)
+        inc     hl
+        push    de                      ; T[i]
+        ld      a,e
+        sub     (hl)
+        ld      e,a
+        inc     hl
+        ld      a,d
+        sbc     a,(hl)                  ; a:e = T[i] - T[i+1], 9 bits
+        push    af
+        ld      l,e
+        ld      h,c
+        call    __mul8x8
+        pop     af
+        ld      b,#0
+        or      a
+        jr      z,.lerp
+        ld      a,h
+        add     a,c
+        ld      h,a
+        rl      b                       ; b:hl = (T[i] - T[i+1]) t
+.lerp:
+        ld      a,l
+        add     a,#0x80
+        ld      a,h
+        adc     a,#0
+        ld      e,a
+        ld      a,b
+        adc     a,#0
+        ld      d,a                     ; rounded / 256
+        pop     hl
+        or      a
+        sbc     hl,de
+        ld      -10(ix),l
+        ld      -11(ix),h               ; F0
+
+        ;; ---- B W mod 2^32 = (b1:b0) F0 + (b1:b0 + b2 F0) 2^16 ----
+        ld      e,-7(ix)
+        ld      d,-8(ix)
+        call    ___muluint2ulong        ; de:hl = (b1:b0) F0
+        push    hl
+        push    de
+        ld      c,-9(ix)
+        ld      b,#0
+        ld      e,-10(ix)
+        ld      d,-11(ix)
+        call    __mul16                 ; de = low 16 bits of b2 F0
+        ld      l,-7(ix)
+        ld      h,-8(ix)
+        add     hl,de
+        pop     de
+        pop     bc
+        add     hl,bc                   ; hl:de = B W mod 2^32
+
+        ;; ---- |e| / 2^9, e = -(B W) mod 2^32, |e| < 2^25 ----
+        ld      -6(ix),h
+        bit     7,h
+        jr      z,.e_abs                ; e < 0: |e| = B W mod 2^32
+        xor     a
+        sub     e
+        ld      e,a
+        ld      a,#0
+        sbc     a,d
+        ld      d,a
+        ld      a,#0
+        sbc     a,l
+        ld      l,a
+        ld      a,#0
+        sbc     a,h
+        ld      h,a
+.e_abs:
+        srl     h
+        rr      l
+        rr      d
+        ld      e,d
+        ld      d,l                     ; de = |e| / 2^9
+        push    de
+        ld      l,-10(ix)
+        ld      h,-11(ix)
+        call    ___muluint2ulong        ; hl = F0 |e| / 2^25
+        pop     de
+        add     hl,de
+        ld      a,#0
+        rla
+        ld      c,a                     ; c:hl = W |e| / 2^25
+
+        ;; ---- Y = W 2^15 +- W |e| / 2^25 ----
+        push    hl
+        exx
+        pop     de
+        exx
+        ld      l,-10(ix)
+        ld      h,-11(ix)
+        scf
+        rr      h
+        rr      l                       ; hl = W / 2
+        ld      a,#0
+        rra
+        ld      d,#0
+        ld      e,c
+        exx
+        ld      h,a
+        ld      l,#0                    ; hl:hl' = W 2^15
+        bit     7,-6(ix)
+        jr      z,.y_sub
+        add     hl,de
+        exx
+        adc     hl,de
+        jr      .ziv
+.y_sub:
+        or      a
+        sbc     hl,de
+        exx
+        sbc     hl,de
+
+        ;; ---- 7 bits below the round bit, unless near a boundary ----
+.ziv:
+        exx
+        ld      a,l
+        exx
+        and     #0x7F
+        sub     #4
+        cp      #120
+        jr      c,.e_out                ; round and sticky as they are
+
+        ;; ---- I 2^7 = nearest multiple, Y B 2^7 - 2^55 exactly ----
+        exx
+        ld      bc,#64
+        add     hl,bc
+        push    hl
+        exx
+        ld      bc,#0
+        adc     hl,bc
+        pop     de
+        ld      a,e
+        and     #0x80
+        ld      e,a                     ; hl:de = I 2^7
+        push    hl
+        push    de
+        ld      c,-9(ix)
+        push    bc                      ; b = 0
+        ld      c,-7(ix)
+        ld      b,-8(ix)
+        push    bc
+        call    __mullong               ; hl:de = (I B - 2^48) 2^7 mod 2^32
+        pop     bc
+        pop     bc
+        ld      a,h
+        or      l
+        or      d
+        or      e
+        jr      z,.exact                ; 1 / x = I exactly
+        bit     7,h
+        pop     de
+        pop     hl
+        jr      nz,.sticky              ; I B < 2^48: I is the floor
+        ex      de,hl
+        ld      bc,#-127
+        add     hl,bc
+        ex      de,hl
+        ld      bc,#-1
+        adc     hl,bc                   ; (I - 1) 2^7 + 1
+        jr      .m_set
+.exact:
+        pop     de
+        pop     hl
+        jr      .m_set
+.sticky:
+        set     0,e
+.m_set:
+        push    de
+        exx
+        pop     hl
+        exx
+
+        ;; ---- 1 / x = Y / 2^31 * 2^(-e - 1) ----
+.e_out:
+        ld      a,-12(ix)
+        cpl
+        ld      e,a
+        ld      a,-13(ix)
+        cpl
+        ld      d,a
+.pack:
+        call    __fp_norm_pack
+        jr      .done
+
+.if FLOAT_IEEE
+        ;; ---- exponent 255: NaN quiet, 1 / +-Inf = +-0 ----
+.special:
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        jr      z,.zero
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        set     6,l
+        jr      .done
+.zero:
+        ld      h,-5(ix)
+        ld      l,#0
+        ld      d,l
+        ld      e,l
+        jr      .done
+.inf:
+        ld      a,-5(ix)
+        or      #0x7F
+        ld      h,a
+        ld      l,#0x80
+        ld      de,#0
+.else
+.maxfin:
+        ld      a,-5(ix)
+        or      #0x7F
+        ld      h,a
+        ld      l,#0x7F
+        ld      de,#0xFFFF
+.endif
+.done:
+        ld      sp,ix
+        pop     ix
+        ret
+
+        ;; 2^17 / (1 + i / 256) - 2^16, i = 0..256, lsb first
+        ;; (i = 0 is 2^16 - 1)
+.tab:
+        .db     0xff, 0xff, 0x02, 0xfe, 0x08, 0xfc, 0x12, 0xfa, 0x20, 0xf8, 0x31, 0xf6, 0x46, 0xf4, 0x5f, 0xf2
+        .db     0x7c, 0xf0, 0x9c, 0xee, 0xc0, 0xec, 0xe8, 0xea, 0x13, 0xe9, 0x42, 0xe7, 0x74, 0xe5, 0xa9, 0xe3
+        .db     0xe2, 0xe1, 0x1e, 0xe0, 0x5d, 0xde, 0xa0, 0xdc, 0xe6, 0xda, 0x2f, 0xd9, 0x7b, 0xd7, 0xcb, 0xd5
+        .db     0x1d, 0xd4, 0x73, 0xd2, 0xcb, 0xd0, 0x27, 0xcf, 0x85, 0xcd, 0xe7, 0xcb, 0x4b, 0xca, 0xb2, 0xc8
+        .db     0x1c, 0xc7, 0x89, 0xc5, 0xf9, 0xc3, 0x6b, 0xc2, 0xe0, 0xc0, 0x58, 0xbf, 0xd3, 0xbd, 0x50, 0xbc
+        .db     0xd0, 0xba, 0x52, 0xb9, 0xd7, 0xb7, 0x5e, 0xb6, 0xe8, 0xb4, 0x75, 0xb3, 0x03, 0xb2, 0x95, 0xb0
+        .db     0x28, 0xaf, 0xbf, 0xad, 0x57, 0xac, 0xf2, 0xaa, 0x8f, 0xa9, 0x2e, 0xa8, 0xd0, 0xa6, 0x74, 0xa5
+        .db     0x1a, 0xa4, 0xc3, 0xa2, 0x6d, 0xa1, 0x1a, 0xa0, 0xc9, 0x9e, 0x7a, 0x9d, 0x2d, 0x9c, 0xe2, 0x9a
+        .db     0x9a, 0x99, 0x53, 0x98, 0x0e, 0x97, 0xcc, 0x95, 0x8b, 0x94, 0x4c, 0x93, 0x10, 0x92, 0xd5, 0x90
+        .db     0x9c, 0x8f, 0x65, 0x8e, 0x30, 0x8d, 0xfd, 0x8b, 0xcc, 0x8a, 0x9c, 0x89, 0x6e, 0x88, 0x42, 0x87
+        .db     0x18, 0x86, 0xf0, 0x84, 0xc9, 0x83, 0xa5, 0x82, 0x82, 0x81, 0x60, 0x80, 0x40, 0x7f, 0x22, 0x7e
+        .db     0x06, 0x7d, 0xeb, 0x7b, 0xd2, 0x7a, 0xbb, 0x79, 0xa5, 0x78, 0x91, 0x77, 0x7e, 0x76, 0x6d, 0x75
+        .db     0x5d, 0x74, 0x4f, 0x73, 0x43, 0x72, 0x38, 0x71, 0x2e, 0x70, 0x26, 0x6f, 0x1f, 0x6e, 0x1a, 0x6d
+        .db     0x17, 0x6c, 0x15, 0x6b, 0x14, 0x6a, 0x14, 0x69, 0x17, 0x68, 0x1a, 0x67, 0x1f, 0x66, 0x25, 0x65
+        .db     0x2d, 0x64, 0x35, 0x63, 0x40, 0x62, 0x4b, 0x61, 0x58, 0x60, 0x66, 0x5f, 0x76, 0x5e, 0x86, 0x5d
+        .db     0x99, 0x5c, 0xac, 0x5b, 0xc0, 0x5a, 0xd6, 0x59, 0xed, 0x58, 0x05, 0x58, 0x1f, 0x57, 0x39, 0x56
+        .db     0x55, 0x55, 0x72, 0x54, 0x91, 0x53, 0xb0, 0x52, 0xd0, 0x51, 0xf2, 0x50, 0x15, 0x50, 0x39, 0x4f
+        .db     0x5e, 0x4e, 0x84, 0x4d, 0xac, 0x4c, 0xd4, 0x4b, 0xfd, 0x4a, 0x28, 0x4a, 0x54, 0x49, 0x80, 0x48
+        .db     0xae, 0x47, 0xdd, 0x46, 0x0d, 0x46, 0x3e, 0x45, 0x70, 0x44, 0xa2, 0x43, 0xd6, 0x42, 0x0b, 0x42
+        .db     0x41, 0x41, 0x78, 0x40, 0xb0, 0x3f, 0xe9, 0x3e, 0x23, 0x3e, 0x5e, 0x3d, 0x99, 0x3c, 0xd6, 0x3b
+        .db     0x14, 0x3b, 0x52, 0x3a, 0x92, 0x39, 0xd2, 0x38, 0x14, 0x38, 0x56, 0x37, 0x99, 0x36, 0xdd, 0x35
+        .db     0x22, 0x35, 0x68, 0x34, 0xae, 0x33, 0xf6, 0x32, 0x3e, 0x32, 0x87, 0x31, 0xd2, 0x30, 0x1d, 0x30
+        .db     0x68, 0x2f, 0xb5, 0x2e, 0x02, 0x2e, 0x51, 0x2d, 0xa0, 0x2c, 0xf0, 0x2b, 0x40, 0x2b, 0x92, 0x2a
+        .db     0xe4, 0x29, 0x37, 0x29, 0x8b, 0x28, 0xe0, 0x27, 0x35, 0x27, 0x8b, 0x26, 0xe2, 0x25, 0x3a, 0x25
+        .db     0x92, 0x24, 0xeb, 0x23, 0x45, 0x23, 0xa0, 0x22, 0xfb, 0x21, 0x58, 0x21, 0xb4, 0x20, 0x12, 0x20
+        .db     0x70, 0x1f, 0xcf, 0x1e, 0x2f, 0x1e, 0x8f, 0x1d, 0xf0, 0x1c, 0x52, 0x1c, 0xb5, 0x1b, 0x18, 0x1b
+        .db     0x7c, 0x1a, 0xe0, 0x19, 0x45, 0x19, 0xab, 0x18, 0x12, 0x18, 0x79, 0x17, 0xe0, 0x16, 0x49, 0x16
+        .db     0xb2, 0x15, 0x1c, 0x15, 0x86, 0x14, 0xf1, 0x13, 0x5d, 0x13, 0xc9, 0x12, 0x36, 0x12, 0xa3, 0x11
+        .db     0x11, 0x11, 0x80, 0x10, 0xef, 0x0f, 0x5f, 0x0f, 0xcf, 0x0e, 0x40, 0x0e, 0xb2, 0x0d, 0x24, 0x0d
+        .db     0x97, 0x0c, 0x0a, 0x0c, 0x7e, 0x0b, 0xf3, 0x0a, 0x68, 0x0a, 0xde, 0x09, 0x54, 0x09, 0xcb, 0x08
+        .db     0x42, 0x08, 0xba, 0x07, 0x32, 0x07, 0xab, 0x06, 0x25, 0x06, 0x9f, 0x05, 0x19, 0x05, 0x95, 0x04
+        .db     0x10, 0x04, 0x8c, 0x03, 0x09, 0x03, 0x86, 0x02, 0x04, 0x02, 0x82, 0x01, 0x01, 0x01, 0x80, 0x00
+        .db     0x00, 0x00
@@ -1,6 +1,13 @@
 ;; float multiply (ieee-754 single) for sdcc z80
         ;; result = a * b
-        ;; denormals treated as 0; NaN/Inf unsupported.
+        ;; fast profile: denormals treated as 0; NaN/Inf unsupported.
+        ;; FLOAT_PROFILE=ieee: NaN/Inf/denormal operands and results
+        ;; handled per IEEE-754 (see fpspecial.s).
+        ;; rounding per FLOAT_ROUND (see fppack.s): the bits below the
+        ;; 24-bit result become a guard byte plus sticky bit.
+        ;;
+        ;; the 24x24 mantissa product comes from __fp_mul48_ab
+        ;; (fpmul48.s), nine 8x8 partial products by __mul8x8.
         ;;
         ;; ABI (sdcccall(1)):
         ;;   a in regs: HLDE  (H=a3, L=a2, D=a1, E=a0)
@@ -25,11 +32,26 @@
         .area   _CODE
 
         .globl  ___fsmul
+        .globl  __fp_mul_frame
+        .globl  __fp_mul_mant
         .globl  __fp_retpop4
         .globl  __fp_unpack_sign_exps
         .globl  __fp_unpack_mant24_ab
-        .globl  __fp_pack_norm
+        .globl  __fp_round_pack
         .globl  __fp_zero32
+        .globl  __fp_mul48_ab
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_nan_ab
+        .globl  __fp_class_ab
+        .globl  __fp_nan32
+        .globl  __fp_inf_sign
+        .globl  __fp_zero_sign
+        .globl  __fp_ieee_norm_ab
+        .globl  __fp_ieee_pack
+.endif
 
 ;; ============================================================
 ;; Frame layout:
@@ -58,6 +80,7 @@
 ;;   ix-16 : prod[3]
 ;;   ix-17 : prod[4]
 ;;   ix-18 : prod[5]    (MSB)
+;;   ix-19 : result exponent high byte (FLOAT_IEEE only)
 ;; ============================================================
 
         ;; ___fsmul
@@ -73,14 +96,85 @@ ___fsmul:
         push    hl              ; ix-1=H(a3), ix-2=L(a2)
         push    de              ; ix-3=D(a1), ix-4=E(a0)
 
+.if FLOAT_IEEE
+        ;; allocate locals (15 bytes)
+        ld      hl,#-15
+.else
         ;; allocate locals (14 bytes)
         ld      hl,#-14
+.endif
         add     hl,sp
         ld      sp,hl
 
+        call    __fp_mul_frame
+
+        ld      sp,ix
+        pop     ix
+        jp      __fp_retpop4
+
+        ;; __fp_mul_frame
+        ;; inputs:  IX frame above: a at -4..-1(ix), b at 4..7(ix),
+        ;;          locals allocated
+        ;; outputs: HLDE = IEEE-754 single product a * b
+        ;; clobbers: af, bc, de, hl
+        ;; notes: fs_scale (fsscale.s) builds this frame once and falls
+        ;;        back to it for elements __fp_mul_mant does not take.
+__fp_mul_frame:
         ;; ---- extract result sign and exponents ----
         call    __fp_unpack_sign_exps
 
+.if FLOAT_IEEE
+        ;; ---- zero, denormal, Inf and NaN operands ----
+        ld      a,c
+        dec     a
+        cp      #254
+        jr      nc,.special
+        ld      a,b
+        dec     a
+        cp      #254
+        jr      c,.finite
+
+.special:
+        call    __fp_nan_ab
+        jp      c,.cleanup
+        call    __fp_class_ab
+        ld      a,d
+        cp      #2
+        jr      z,.inf_times
+        ld      a,e
+        cp      #2
+        jr      nz,.not_inf
+.inf_times:
+        ld      a,d
+        or      a
+        jr      z,.ret_nan              ; 0 * Inf
+        ld      a,e
+        or      a
+        jr      z,.ret_nan              ; Inf * 0
+        call    __fp_inf_sign
+        jp      .cleanup
+.ret_nan:
+        call    __fp_nan32
+        jp      .cleanup
+.not_inf:
+        ld      a,d
+        and     e
+        jr      nz,.finite              ; only denormals left
+        call    __fp_zero_sign
+        jp      .cleanup
+
+.finite:
+        ;; ---- build mantissas, denormals normalized ----
+        call    __fp_unpack_mant24_ab
+        call    __fp_ieee_norm_ab
+
+        ;; ---- result exponent: EA + EB - 127 (16-bit) ----
+        add     hl,de
+        ld      de,#-127
+        add     hl,de
+        ld      -6(ix),l
+        ld      -19(ix),h
+.else
         ;; ---- check for zero exponent ----
         ld      a,c
         or      a
@@ -107,135 +201,54 @@ ___fsmul:
 
         ;; ---- build mantissas A/B (with implicit 1) ----
         call    __fp_unpack_mant24_ab
+.endif
 
-        ;; ---- zero 48-bit product ----
-        xor     a
-        ld      -13(ix),a
-        ld      -14(ix),a
-        ld      -15(ix),a
-        ld      -16(ix),a
-        ld      -17(ix),a
-        ld      -18(ix),a
-
-        ;; ---- 24x24 multiply: nine 8x8 partial products ----
-
-        ;; a[0] * b[0] -> prod[1:0]
-        ld      l,-7(ix)
-        ld      h,-10(ix)
-        call    .mul8x8
-        ld      -13(ix),l
-        ld      -14(ix),h
-
-        ;; a[0] * b[1] -> prod[2:1]
-        ld      l,-7(ix)
-        ld      h,-11(ix)
-        call    .mul8x8
-        ld      a,-14(ix)
-        add     a,l
-        ld      -14(ix),a
-        ld      a,-15(ix)
-        adc     a,h
-        ld      -15(ix),a
-        jr      nc,.pp02
-        inc     -16(ix)
-.pp02:
-        ;; a[0] * b[2] -> prod[3:2]
-        ld      l,-7(ix)
-        ld      h,-12(ix)
-        call    .mul8x8
-        ld      a,-15(ix)
-        add     a,l
-        ld      -15(ix),a
-        ld      a,-16(ix)
-        adc     a,h
-        ld      -16(ix),a
-        jr      nc,.pp10
-        inc     -17(ix)
-.pp10:
-        ;; a[1] * b[0] -> prod[2:1]
-        ld      l,-8(ix)
-        ld      h,-10(ix)
-        call    .mul8x8
-        ld      a,-14(ix)
-        add     a,l
-        ld      -14(ix),a
-        ld      a,-15(ix)
-        adc     a,h
-        ld      -15(ix),a
-        jr      nc,.pp11
-        inc     -16(ix)
-        jr      nz,.pp11
-        inc     -17(ix)
-.pp11:
-        ;; a[1] * b[1] -> prod[3:2]
-        ld      l,-8(ix)
-        ld      h,-11(ix)
-        call    .mul8x8
-        ld      a,-15(ix)
-        add     a,l
-        ld      -15(ix),a
-        ld      a,-16(ix)
-        adc     a,h
-        ld      -16(ix),a
-        jr      nc,.pp12
-        inc     -17(ix)
-        jr      nz,.pp12
-        inc     -18(ix)
-.pp12:
-        ;; a[1] * b[2] -> prod[4:3]
-        ld      l,-8(ix)
-        ld      h,-12(ix)
-        call    .mul8x8
-        ld      a,-16(ix)
-        add     a,l
-        ld      -16(ix),a
-        ld      a,-17(ix)
-        adc     a,h
-        ld      -17(ix),a
-        jr      nc,.pp20
-        inc     -18(ix)
-.pp20:
-        ;; a[2] * b[0] -> prod[3:2]
-        ld      l,-9(ix)
-        ld      h,-10(ix)
-        call    .mul8x8
-        ld      a,-15(ix)
-        add     a,l
-        ld      -15(ix),a
-        ld      a,-16(ix)
-        adc     a,h
-        ld      -16(ix),a
-        jr      nc,.pp21
-        inc     -17(ix)
-        jr      nz,.pp21
-        inc     -18(ix)
-.pp21:
-        ;; a[2] * b[1] -> prod[4:3]
-        ld      l,-9(ix)
-        ld      h,-11(ix)
-        call    .mul8x8
-        ld      a,-16(ix)
-        add     a,l
-        ld      -16(ix),a
-        ld      a,-17(ix)
-        adc     a,h
-        ld      -17(ix),a
-        jr      nc,.pp22
-        inc     -18(ix)
-.pp22:
-        ;; a[2] * b[2] -> prod[5:4]
-        ld      l,-9(ix)
-        ld      h,-12(ix)
-        call    .mul8x8
-        ld      a,-17(ix)
-        add     a,l
-        ld      -17(ix),a
-        ld      a,-18(ix)
-        adc     a,h
-        ld      -18(ix),a
+        ;; __fp_mul_mant
+        ;; inputs:  IX frame above with sign at -5(ix), exponent at
+        ;;          -6(ix) (-19(ix) high byte with FLOAT_IEEE), normal
+        ;;          mantissas at -7..-12(ix)
+        ;; outputs: HLDE = IEEE-754 single product
+        ;; clobbers: af, bc, de, hl
+        ;; notes: fs_scale unpacks a once and enters here per element.
+__fp_mul_mant:
+        ;; ---- 24x24 multiply into prod[5:0] ----
+        call    __fp_mul48_ab
 
         ;; ---- normalize ----
+        ;; prod[1:0] only matter as a sticky bit below the guard byte,
+        ;; jam them into the lowest bit of prod[2]
+        ld      a,-14(ix)
+        or      -13(ix)
+        jr      z,.no_sticky
+        set     0,-15(ix)
+.no_sticky:
         ld      b,-5(ix)
+
+.if FLOAT_IEEE
+        ld      l,-6(ix)
+        ld      h,-19(ix)
+
+        bit     7,-18(ix)
+        jr      z,.no_shift
+
+        ;; bit47=1: exp++
+        inc     hl
+        jr      .pack
+
+.no_shift:
+        ;; bit46=1: shift prod[5:2] left by 1
+        sla     -15(ix)
+        rl      -16(ix)
+        rl      -17(ix)
+        rl      -18(ix)
+
+.pack:
+        ld      e,-16(ix)
+        ld      d,-17(ix)
+        ld      c,-18(ix)
+        ld      a,-15(ix)               ; guard byte
+        call    __fp_ieee_pack
+.else
         ld      c,-6(ix)
 
         bit     7,-18(ix)
@@ -250,12 +263,14 @@ ___fsmul:
         ld      a,-18(ix)
         and     #0x7F
         ld      l,a
+        ld      a,-15(ix)               ; guard byte = prod[2]
         jr      .pack
 
 .no_shift:
         ;; bit46=1: shift prod[5:2] left by 1
         ld      a,-15(ix)
         add     a,a
+        ld      h,a                     ; guard byte = prod[2] << 1
         ld      a,-16(ix)
         rla
         ld      e,a
@@ -266,9 +281,11 @@ ___fsmul:
         rla
         and     #0x7F
         ld      l,a
+        ld      a,h
 
 .pack:
-        call    __fp_pack_norm
+        call    __fp_round_pack
+.endif
 
         jr      .cleanup
 
@@ -285,30 +302,4 @@ ___fsmul:
         ld      e,#0
 
 .cleanup:
-        ld      sp,ix
-        pop     ix
-        jp      __fp_retpop4
-
-
-;; ============================================================
-;; .mul8x8: unsigned 8x8 -> 16-bit multiply
-;; Input:  L = multiplicand, H = multiplier
-;; Output: HL = product
-;; Clobbers: A, B, DE
-;; ============================================================
-.mul8x8:
-        ld      d,#0
-        ld      e,l
-        ld      l,#0
-        ld      a,h
-        ld      h,#0
-        ld      b,#8
-.mul8_loop:
-        rra
-        jr      nc,.mul8_skip
-        add     hl,de
-.mul8_skip:
-        sla     e
-        rl      d
-        djnz    .mul8_loop
         ret
@@ -0,0 +1,194 @@
+        ;; float array kernel: scale in place
+        ;;
+        ;; x[i] = a * x[i] in one stack frame. a is unpacked once: its
+        ;; sign, exponent and mantissa stay in the frame, each x[i] is
+        ;; unpacked straight from memory into mant_b and the multiply
+        ;; runs from __fp_mul_mant. elements that need the special
+        ;; cases of ___fsmul (zero, denormal, Inf, NaN, exponent out of
+        ;; range) and every element when a itself is one of those go
+        ;; through the whole body (__fp_mul_frame), so the result is
+        ;; always that of ___fsmul.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   a in HLDE, x and n on stack (2 bytes each, x nearest to the
+        ;;   return address)
+        ;;   callee cleans x and n from stack
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fsscale
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fs_scale
+        .globl  __fp_mul_frame
+        .globl  __fp_mul_mant
+        .globl  __fp_unpack_mant24_a
+        .globl  __fp_retpop4
+
+        .include "config.inc"
+
+;; ============================================================
+;; Frame layout (the __fp_mul_frame part is the ___fsmul one):
+;;
+;;   ix+12,13 : n
+;;   ix+10,11 : x
+;;   ix+8,9   : return address
+;;   ix+4..7  : x[i], for __fp_mul_frame
+;;   ix+3     : exponent of a, 0 when a takes __fp_mul_frame
+;;   ix+2     : sign of a (bit 7)
+;;   ix+0,1   : saved ix
+;;   ix-1..-4 : a3..a0
+;;   ix-5..   : __fp_mul_frame locals
+;; ============================================================
+
+        ;; _fs_scale
+        ;; inputs:  a in HLDE, x at 2(sp), n at 4(sp)
+        ;; outputs: x[0..n-1] *= a
+        ;; clobbers: af, bc, de, hl
+_fs_scale:
+        push    af              ; x[i] slot, sign and exponent of a
+        push    af              ; under the return address, where
+        push    af              ; ___fsmul has b
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+
+        push    hl              ; ix-1=H(a3), ix-2=L(a2)
+        push    de              ; ix-3=D(a1), ix-4=E(a0)
+
+.if FLOAT_IEEE
+        ld      hl,#-15
+.else
+        ld      hl,#-14
+.endif
+        add     hl,sp
+        ld      sp,hl
+
+        ;; ---- a, once ----
+        ld      a,-2(ix)
+        rla
+        ld      a,-1(ix)
+        ld      2(ix),a
+        rla                     ; a = exponent of a
+.if FLOAT_IEEE
+        ld      c,a
+        dec     a
+        cp      #254
+        ld      a,c
+        jr      c,.a_normal
+        xor     a               ; zero, denormal, Inf or NaN
+.a_normal:
+.endif
+        ld      3(ix),a
+        call    __fp_unpack_mant24_a
+
+        ld      l,10(ix)
+        ld      h,11(ix)        ; hl = x
+        ld      c,12(ix)
+        ld      b,13(ix)        ; bc = n
+
+.loop:
+        ld      a,b
+        or      c
+        jr      z,.done
+        dec     bc
+        push    bc
+        push    hl
+
+        ld      a,(hl)          ; x[i] to mant_b
+        ld      -10(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      -11(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      c,a
+        or      #0x80
+        ld      -12(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      b,a
+        xor     2(ix)
+        and     #0x80
+        ld      -5(ix),a        ; sign of the product
+        sla     c
+        ld      a,b
+        rla                     ; a = exponent of x[i]
+.if FLOAT_IEEE
+        ld      e,a
+        dec     a
+        cp      #254
+        jr      nc,.frame
+        ld      a,3(ix)
+        or      a
+        jr      z,.frame
+        ld      l,a
+        ld      h,#0
+        ld      d,h
+        add     hl,de
+        ld      de,#-127
+        add     hl,de
+        ld      -6(ix),l
+        ld      -19(ix),h
+.else
+        or      a
+        jr      z,.frame
+        ld      c,a
+        ld      a,3(ix)
+        or      a
+        jr      z,.frame
+        add     a,c
+        jr      nc,.exp_low
+        add     a,#129
+        jr      c,.frame        ; overflow
+        jr      .exp_store
+.exp_low:
+        sub     #127
+        jr      c,.frame        ; underflow
+.exp_store:
+        ld      -6(ix),a
+.endif
+        call    __fp_mul_mant
+
+.store:
+        ld      b,h
+        ld      c,l
+        pop     hl
+        ld      (hl),e          ; x[i] = a * x[i]
+        inc     hl
+        ld      (hl),d
+        inc     hl
+        ld      (hl),c
+        inc     hl
+        ld      (hl),b
+        inc     hl
+        pop     bc
+        jr      .loop
+
+.frame:
+        pop     hl              ; x[i] to 4..7, the whole body
+        push    hl
+        ld      a,(hl)
+        ld      4(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      5(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      6(ix),a
+        inc     hl
+        ld      a,(hl)
+        ld      7(ix),a
+        call    __fp_mul_frame
+        jr      .store
+
+.done:
+        ld      sp,ix
+        pop     ix
+        pop     af              ; drop the slots
+        pop     af
+        pop     af
+        jp      __fp_retpop4
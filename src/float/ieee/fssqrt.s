@@ -0,0 +1,299 @@
+        ;; float square root (ieee-754 single) for sdcc z80
+        ;; result = sqrt(x)
+        ;;
+        ;; bitwise (digit by digit) root of the unpacked mantissa: each
+        ;; step brings down two radicand bits, r = 4 r + bits, and tries
+        ;; to subtract 4 q + 1 from the remainder r, the new root bit is
+        ;; 1 when that does not borrow. 25 steps give the 24 mantissa bits
+        ;; and a round bit, the remainder is the sticky bit. a root is
+        ;; never exactly halfway between two floats, so rounding to
+        ;; nearest needs no tie case. the first 12 steps keep r and q in
+        ;; 16 bits, only the last 12 or 13 (which bring down zeros) need
+        ;; 32 bits. q is kept as 4 q so the trial value is 4 q + 1 with
+        ;; the carry flag.
+        ;;
+        ;; the exponent is halved, an odd unbiased exponent first doubles
+        ;; the mantissa. the result is always a normal number, so it is
+        ;; packed by __fp_round_pack in both profiles.
+        ;;
+        ;; fast profile: zero and denormals give +-0, x < 0 gives +0.
+        ;; FLOAT_PROFILE=ieee: denormals are normalized, sqrt(-0) = -0,
+        ;; sqrt(+Inf) = +Inf, a NaN is returned quiet and x < 0 gives
+        ;; the default NaN.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in regs: HLDE  (H=x3, L=x2, D=x1, E=x0)
+        ;;   result in HLDE
+        ;;
+        ;; clobbers: af, bc, de, hl, bc', de', hl'
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fssqrt
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  ___fssqrt
+        .globl  __fp_unpack_mant24_a
+        .globl  __fp_round_pack
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_nan32
+.endif
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+2,3: return address
+;;   ix+0,1: saved ix
+;;   ix-1 : H = x3        \  push hl
+;;   ix-2 : L = x2        /
+;;   ix-3 : D = x1        \  push de
+;;   ix-4 : E = x0        /
+;;   ix-5 : sign
+;;   ix-6 : unused
+;;   ix-7  : mant[0]  (LSB)
+;;   ix-8  : mant[1]
+;;   ix-9  : mant[2]  (MSB, with implicit 1)
+;; ============================================================
+
+        ;; ___fssqrt
+        ;; inputs:  x in HLDE
+        ;; outputs: HLDE = IEEE-754 single sqrt(x)
+        ;; clobbers: af, bc, de, hl, bc', de', hl'
+___fssqrt:
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+        push    hl
+        push    de
+        ld      hl,#-5
+        add     hl,sp
+        ld      sp,hl
+
+        ld      a,-2(ix)
+        rla
+        ld      a,-1(ix)
+        rla
+        ld      c,a                     ; c = biased exponent
+        sbc     a,a
+        and     #0x80
+        ld      -5(ix),a                ; sign
+
+.if FLOAT_IEEE
+        ld      a,c
+        inc     a
+        jp      z,.special
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        or      c
+        jp      z,.zero                 ; sqrt(+-0) = +-0
+        bit     7,-5(ix)
+        jp      nz,.invalid             ; x < 0
+.else
+        ld      a,c
+        or      a
+        jp      z,.zero                 ; 0 and denormals
+        bit     7,-5(ix)
+        jp      nz,.negative
+.endif
+
+        ;; ---- mantissa into A:B:C, exponent into DE ----
+        call    __fp_unpack_mant24_a
+        ld      e,c
+        ld      d,#0
+        ld      a,-9(ix)
+        ld      b,-8(ix)
+        ld      c,-7(ix)
+.if FLOAT_IEEE
+        inc     e
+        dec     e
+        jr      nz,.normal
+        inc     e                       ; denormal: exponent 1, no implicit 1
+        and     #0x7F
+.denorm:
+        sla     c
+        rl      b
+        rla
+        dec     de
+        bit     7,a
+        jr      z,.denorm
+.normal:
+.endif
+
+        ;; ---- result exponent (E + 127) / 2, cf = E even ----
+        ex      de,hl
+        ld      de,#127
+        add     hl,de
+        sra     h
+        rr      l                       ; l = result exponent, h = 0
+        ld      h,#12                   ; zero pairs after phase 1
+        jr      nc,.exp_odd
+        inc     h                       ; E even: radicand 2 m, 12 + 13 pairs
+        push    hl
+        ld      hl,#0                   ; r = 0
+        ld      d,h
+        ld      e,l                     ; 4 q = 0
+        jr      .phase1
+.exp_odd:
+        push    hl                      ; E odd: radicand m, the top pair
+        sla     c                       ; is 01, so q = 1 and r = 0
+        rl      b
+        rla
+        ld      hl,#0
+        ld      de,#4
+
+        ;; ---- phase 1: the 12 pairs of mantissa bits, 16-bit r and q ----
+.phase1:
+        exx
+        ld      b,#12
+        exx
+.p1_loop:
+        sla     c
+        rl      b
+        rla
+        adc     hl,hl
+        sla     c
+        rl      b
+        rla
+        adc     hl,hl                   ; r = 4 r + next two bits
+        scf
+        sbc     hl,de                   ; r - (4 q + 1)
+        jr      c,.p1_zero
+        sla     e
+        rl      d
+        set     2,e                     ; 4 q = 4 (2 q + 1)
+        exx
+        dec     b
+        exx
+        jr      nz,.p1_loop
+        jr      .phase2
+.p1_zero:
+        adc     hl,de                   ; cf set: r restored
+        sla     e
+        rl      d                       ; 4 q = 4 (2 q)
+        exx
+        dec     b
+        exx
+        jr      nz,.p1_loop
+
+        ;; ---- phase 2: the zero pairs, r in HL:HL', 4 q in DE:DE' ----
+.phase2:
+        push    hl
+        push    de
+        exx
+        pop     de
+        pop     hl
+        exx
+        ld      hl,#0
+        ld      d,h
+        ld      e,l
+        pop     bc                      ; b = pairs left, c = result exponent
+.p2_loop:
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl                   ; r = 4 r
+        scf
+        exx
+        sbc     hl,de
+        exx
+        sbc     hl,de                   ; r - (4 q + 1)
+        jr      c,.p2_zero
+        exx
+        sla     e
+        rl      d
+        set     2,e
+        exx
+        rl      e
+        rl      d                       ; 4 q = 4 (2 q + 1)
+        djnz    .p2_loop
+        jr      .round
+.p2_zero:
+        exx
+        adc     hl,de
+        exx
+        adc     hl,de                   ; cf set: r restored
+        exx
+        sla     e
+        rl      d
+        exx
+        rl      e
+        rl      d                       ; 4 q = 4 (2 q)
+        djnz    .p2_loop
+
+        ;; ---- 4 q has the mantissa at bits 26..3, the round bit at 2 ----
+.round:
+        ld      a,h
+        or      l
+        exx
+        or      h
+        or      l
+        exx
+        jr      z,.exact
+        ld      a,#2                    ; sticky, lands in bit 0
+.exact:
+        ld      b,#3
+.q_shift:
+        srl     d
+        rr      e
+        exx
+        rr      d
+        rr      e
+        exx
+        djnz    .q_shift                ; cf = round bit
+        rra                             ; guard byte
+        ld      l,e
+        res     7,l                     ; L = mantissa hi7
+        exx
+        push    de
+        exx
+        pop     de                      ; DE = mantissa low16
+        ld      b,#0
+        call    __fp_round_pack
+        jr      .done
+
+.if FLOAT_IEEE
+        ;; ---- exponent 255: NaN quiet, +Inf, -Inf invalid ----
+.special:
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        jr      nz,.nan
+        bit     7,-5(ix)
+        jr      nz,.invalid
+.nan:
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        jr      z,.done                 ; +Inf
+        set     6,l
+        jr      .done
+.invalid:
+        call    __fp_nan32
+        jr      .done
+.else
+.negative:
+        ld      -5(ix),#0
+.endif
+.zero:
+        ld      h,-5(ix)
+        ld      l,#0
+        ld      d,l
+        ld      e,l
+.done:
+        ld      sp,ix
+        pop     ix
+        ret
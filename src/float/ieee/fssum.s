@@ -0,0 +1,66 @@
+        ;; float array kernel: sum
+        ;;
+        ;; sum of x[i] in an unpacked accumulator on the stack (see
+        ;; fpacc.s). the terms are unpacked straight from the buffer and
+        ;; the sum is rounded once at the end.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in HL, n in DE
+        ;;   result in HLDE
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module fssum
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _fs_sum
+        .globl  __fpacc_addf
+        .globl  _fpacc_result
+
+        ;; _fs_sum
+        ;; inputs:  HL = x, DE = n
+        ;; outputs: HLDE = x[0] + ... + x[n-1]
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl', iy
+_fs_sum:
+        ld      iy,#-7          ; fpacc_t on the stack
+        add     iy,sp
+        ld      sp,iy
+        xor     a
+        ld      3(iy),a         ; acc = +0
+        ld      5(iy),a
+
+.loop:
+        ld      a,d
+        or      e
+        jr      z,.done
+        dec     de
+        push    de
+
+        ld      e,(hl)          ; bcde = x[i]
+        inc     hl
+        ld      d,(hl)
+        inc     hl
+        ld      c,(hl)
+        inc     hl
+        ld      b,(hl)
+        inc     hl
+        push    hl
+
+        call    __fpacc_addf
+
+        pop     hl
+        pop     de
+        jr      .loop
+
+.done:
+        push    iy
+        pop     hl
+        call    _fpacc_result
+
+        ld      iy,#7
+        add     iy,sp
+        ld      sp,iy
+        ret
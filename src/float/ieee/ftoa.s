@@ -0,0 +1,430 @@
+        ;; float to decimal string for sdcc z80
+        ;;
+        ;; char *ftoa(float x, char *buf, unsigned char digits);
+        ;;
+        ;; writes x as [-]d.ddde+dd with digits significant digits (1..9,
+        ;; 0 counts as 1 and more than 9 as 9) and returns a pointer to
+        ;; the terminating 0. exponent 255 is written as inf or nan.
+        ;; 9 digits are enough for strtof to give back the same float.
+        ;;
+        ;; the float is unpacked once into a 32-bit mantissa and binary
+        ;; exponent, the decimal exponent k is estimated from the binary
+        ;; one and x * 10^(digits - 1 - k) is formed with __fp_scale10 and
+        ;; rounded to an integer Y. when the estimate was one off, Y has
+        ;; one digit too many or too few and the scaling is redone with
+        ;; k + 1 or k - 1. the digits of Y come from subtracting powers of
+        ;; ten, 16-bit ones for the last four.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in HLDE, buf and digits on stack (buf nearest to the return
+        ;;   address, digits as a single byte)
+        ;;   callee cleans buf and digits from stack
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module ftoa
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _ftoa
+        .globl  __fp_scale10
+        .globl  ___mulsint2slong
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+6     : digits
+;;   ix+4,5   : buf, moved past the sign
+;;   ix+2,3   : return address
+;;   ix+0,1   : saved ix
+;;   ix-1..-4 : x3..x0
+;;   ix-5     : n, digits clamped to 1..9
+;;   ix-6     : k, decimal exponent
+;;   ix-7     : bit 0 k was lowered, bit 1 k was raised; then the
+;;              count of digits left to write
+;;   ix-8..-11: m3..m0, mantissa with bit 31 set
+;;   ix-12,-13: e, binary exponent (high, low)
+;; ============================================================
+
+        ;; _ftoa
+        ;; inputs:  x in HLDE, buf at 2(sp), digits at 4(sp)
+        ;; outputs: buf = decimal form of x, DE = pointer to its 0
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+_ftoa:
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+        push    hl                      ; ix-1=H(x3), ix-2=L(x2)
+        push    de                      ; ix-3=D(x1), ix-4=E(x0)
+        ld      hl,#-9
+        add     hl,sp
+        ld      sp,hl
+
+        ld      a,6(ix)
+        or      a
+        jr      nz,.n_min
+        inc     a
+.n_min:
+        cp      #10
+        jr      c,.n_max
+        ld      a,#9
+.n_max:
+        ld      -5(ix),a
+        xor     a
+        ld      -7(ix),a
+
+        bit     7,-1(ix)
+        jr      z,.positive
+        ld      l,4(ix)
+        ld      h,5(ix)
+        ld      (hl),#0x2D              ; '-'
+        inc     hl
+        ld      4(ix),l
+        ld      5(ix),h
+.positive:
+        ;; biased exponent -> BC, mantissa -> H:L:D
+        ld      a,-2(ix)
+        rla
+        ld      a,-1(ix)
+        rla
+        ld      c,a
+        ld      b,#0
+        inc     a
+        jp      z,.special
+        ld      a,-2(ix)
+        and     #0x7F
+        ld      h,a
+        ld      l,-3(ix)
+        ld      d,-4(ix)
+        ld      a,c
+        or      a
+        jr      z,.small
+        set     7,h
+        jr      .unpacked
+.small:
+        ld      a,h
+        or      l
+        or      d
+        jp      z,.zero
+        inc     c                       ; denormal: exponent 1, no implicit 1
+.denorm:
+        sla     d
+        adc     hl,hl
+        dec     bc
+        bit     7,h
+        jr      z,.denorm
+.unpacked:
+        ld      -8(ix),h
+        ld      -9(ix),l
+        ld      -10(ix),d
+        ld      -11(ix),#0
+        ld      a,c
+        sub     #127
+        ld      -13(ix),a
+        ld      l,a
+        ld      a,b
+        sbc     a,#0
+        ld      -12(ix),a
+        ld      h,a                     ; hl = e
+
+        ;; k = floor(log10(x)), from log2(x) ~ e + (m - 1) in 1/128 steps;
+        ;; the linear mantissa term is low by up to 0.09, so k is rarely
+        ;; one less than it should be
+        ld      a,h
+        rra
+        rr      l
+        ld      h,l                     ; h = e >> 1, cf = bit 0 of e
+        ld      a,-8(ix)
+        rla
+        rrca                            ; bit 0 of e over the top 7
+        ld      l,a                     ; mantissa bits: hl = e * 128 + frac
+        ld      de,#19728               ; log10(2) * 2^16
+        call    ___mulsint2slong        ; hl:de = lg * log10(2) * 2^16
+        sla     d
+        adc     hl,hl
+        ld      -6(ix),h                ; k = hl:de >> 23
+
+.scale:
+        ld      b,-8(ix)
+        ld      c,-9(ix)
+        exx
+        ld      b,-10(ix)
+        ld      c,-11(ix)
+        exx
+        ld      l,-13(ix)
+        ld      h,-12(ix)
+        ld      a,-5(ix)
+        dec     a
+        sub     -6(ix)                  ; p = n - 1 - k
+        call    __fp_scale10            ; x * 10^p = m / 2^31 * 2^s
+
+        ;; Y = m >> (31 - s), s = 0..30, with the last bit out in C
+        ld      a,h
+        or      a
+        jr      z,.s_pos
+        rla
+        jr      c,.too_small            ; Y < 1
+        jr      .too_big
+.s_pos:
+        ld      a,l
+        cp      #31
+        jr      nc,.too_big             ; Y >= 2^30
+        ld      a,#30
+        sub     l
+        ld      d,b
+        ld      e,c
+        exx
+        push    bc
+        exx
+        pop     hl                      ; DEHL = m
+.bytes:
+        cp      #8
+        jr      c,.bits
+        ld      l,h
+        ld      h,e
+        ld      e,d
+        ld      d,#0
+        sub     #8
+        jr      .bytes
+.bits:
+        or      a
+        jr      z,.last_bit
+        ld      b,a
+.bit:
+        srl     d
+        rr      e
+        rr      h
+        rr      l
+        djnz    .bit
+.last_bit:
+        srl     d
+        rr      e
+        rr      h
+        rr      l
+        ld      a,#0
+        adc     a,a
+        ld      c,a                     ; c = rounding bit
+        call    .pow_n1
+
+        ;; 10^(n-1) <= Y < 10^n
+        ld      a,l
+        sub     0(iy)
+        ld      a,h
+        sbc     a,1(iy)
+        ld      a,e
+        sbc     a,2(iy)
+        ld      a,d
+        sbc     a,3(iy)
+        jr      c,.too_small
+        call    .cmp_n
+        jr      nc,.too_big
+
+        ld      a,c
+        rra
+        ld      bc,#0
+        adc     hl,bc
+        ex      de,hl
+        adc     hl,bc
+        ex      de,hl
+        call    .cmp_n
+        jr      c,.digits
+.carry:
+        inc     -6(ix)                  ; rounded up to 10^n
+        jr      .y_low
+
+.too_small:
+        bit     1,-7(ix)
+        jr      nz,.y_low               ; between the two: 10^(n-1)
+        set     0,-7(ix)
+        dec     -6(ix)
+        jp      .scale
+.too_big:
+        bit     0,-7(ix)
+        jr      nz,.carry
+        set     1,-7(ix)
+        inc     -6(ix)
+        jp      .scale
+
+.zero:
+        ld      -6(ix),#0
+        ld      hl,#0
+        ld      d,h
+        ld      e,l
+        jr      .digits_iy
+.y_low:
+        call    .pow_n1
+        ld      l,0(iy)
+        ld      h,1(iy)
+        ld      e,2(iy)
+        ld      d,3(iy)
+        jr      .digits
+
+.digits_iy:
+        call    .pow_n1
+.digits:
+        push    de
+        exx
+        pop     hl                      ; HL' = Y high word
+        exx                             ; HL = Y low word
+        ld      e,4(ix)
+        ld      d,5(ix)
+        ld      a,-5(ix)
+        ld      -7(ix),a
+        dec     a
+        jr      z,.digit
+        inc     de                      ; the point goes after the first digit
+.digit:
+        ld      a,-7(ix)
+        cp      #5
+        jr      c,.digit16
+        ld      c,0(iy)
+        ld      b,1(iy)
+        exx
+        ld      c,2(iy)
+        ld      b,3(iy)
+        exx
+        ld      a,#0x2F                 ; '0' - 1
+.sub32:
+        inc     a
+        or      a
+        sbc     hl,bc
+        exx
+        sbc     hl,bc
+        exx
+        jr      nc,.sub32
+        add     hl,bc
+        exx
+        adc     hl,bc
+        exx
+        jr      .put
+.digit16:
+        dec     a
+        jr      z,.units                ; Y < 10^4 from here on
+        ld      c,0(iy)
+        ld      b,1(iy)
+        ld      a,#0x2F
+.sub16:
+        inc     a
+        or      a
+        sbc     hl,bc
+        jr      nc,.sub16
+        add     hl,bc
+.put:
+        ld      (de),a
+        inc     de
+        ld      bc,#-4
+        add     iy,bc
+        dec     -7(ix)
+        jr      .digit
+.units:
+        ld      a,l
+        add     a,#0x30
+        ld      (de),a
+        inc     de
+
+        ld      a,-5(ix)
+        dec     a
+        jr      z,.exponent
+        ld      l,4(ix)
+        ld      h,5(ix)
+        inc     hl
+        ld      a,(hl)
+        ld      (hl),#0x2E              ; '.'
+        dec     hl
+        ld      (hl),a
+.exponent:
+        ex      de,hl
+        ld      (hl),#0x65              ; 'e'
+        inc     hl
+        ld      (hl),#0x2B              ; '+'
+        ld      a,-6(ix)
+        or      a
+        jp      p,.exp_pos
+        ld      (hl),#0x2D              ; '-'
+        neg
+.exp_pos:
+        inc     hl
+        ld      b,#0x2F
+.tens:
+        inc     b
+        sub     #10
+        jr      nc,.tens
+        add     a,#0x3A                 ; '0' + 10
+        ld      (hl),b
+        inc     hl
+        ld      (hl),a
+        inc     hl
+        ld      (hl),#0
+        ex      de,hl
+.done:
+        ld      sp,ix
+        pop     ix
+        pop     hl                      ; return address
+        pop     bc                      ; drop buf
+        inc     sp                      ; drop digits
+        jp      (hl)
+
+        ;; exponent 255
+.special:
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        ld      hl,#.inf
+        jr      z,.copy
+        ld      hl,#.nan
+.copy:
+        ld      e,4(ix)
+        ld      d,5(ix)
+        ld      bc,#4
+        ldir
+        dec     de
+        jr      .done
+
+        ;; IY = 10^(n-1) in .dec_tab
+        ;; clobbers: af
+.pow_n1:
+        push    bc
+        ld      a,-5(ix)
+        dec     a
+        add     a,a
+        add     a,a
+        ld      c,a
+        ld      b,#0
+        ld      iy,#.dec_tab
+        add     iy,bc
+        pop     bc
+        ret
+
+        ;; cf = DEHL < 10^n (4..7(iy))
+        ;; clobbers: af
+.cmp_n:
+        ld      a,l
+        sub     4(iy)
+        ld      a,h
+        sbc     a,5(iy)
+        ld      a,e
+        sbc     a,6(iy)
+        ld      a,d
+        sbc     a,7(iy)
+        ret
+
+.inf:
+        .db     0x69, 0x6E, 0x66, 0x00  ; "inf"
+.nan:
+        .db     0x6E, 0x61, 0x6E, 0x00  ; "nan"
+
+        ;; 10^0 .. 10^9, lsb first
+.dec_tab:
+        .db     0x01, 0x00, 0x00, 0x00
+        .db     0x0a, 0x00, 0x00, 0x00
+        .db     0x64, 0x00, 0x00, 0x00
+        .db     0xe8, 0x03, 0x00, 0x00
+        .db     0x10, 0x27, 0x00, 0x00
+        .db     0xa0, 0x86, 0x01, 0x00
+        .db     0x40, 0x42, 0x0f, 0x00
+        .db     0x80, 0x96, 0x98, 0x00
+        .db     0x00, 0xe1, 0xf5, 0x05
+        .db     0x00, 0xca, 0x9a, 0x3b
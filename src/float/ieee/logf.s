@@ -0,0 +1,423 @@
+        ;; natural logarithm (ieee-754 single) for sdcc z80
+        ;;
+        ;; float logf(float x);
+        ;;
+        ;; x = m 2^e, 1/2 <= m < 1: m is multiplied up to 1 by factors
+        ;; 1 + 2^-i, i = 1..16, digit by digit as in expf.s (a factor
+        ;; is taken when the product stays below 1), summing their
+        ;; logarithms z from the ROM table (see fpcordic.s). the gap
+        ;; d = 1 - v left below 1 is the last term, ln m = -(z + d),
+        ;; and log x = e ln 2 - (z + d) in 40 bits.
+        ;;
+        ;; x within 2^-6 of 1 would lose bits to that subtraction, so
+        ;; there a = |x - 1| goes through the series
+        ;;   ln(1 +- a) = +-a - a^2 / 2 +- a^3 / 3 - a^4 / 4
+        ;; on Q0.32 fractions with __mulhu32. results are within 1 ulp.
+        ;;
+        ;; log(1) = +0.
+        ;; fast profile: 0, denormals and x < 0 give -Inf.
+        ;; FLOAT_PROFILE=ieee: log(+-0) = -Inf, log(+Inf) = +Inf, a NaN
+        ;; is returned quiet and x < 0 gives the default NaN.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in regs: HLDE  (H=x3, L=x2, D=x1, E=x0)
+        ;;   result in HLDE
+        ;;
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module logf
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _logf
+        .globl  __fp_unpack_norm
+        .globl  __fp_norm32
+        .globl  __fp_norm_pack
+        .globl  __fp_shr32
+        .globl  __fp_srl_bc
+        .globl  __fp_ln_tab
+        .globl  __fp_mul8x32
+        .globl  __mulhu32
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_nan32
+.endif
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+2,3: return address
+;;   ix+0,1: saved ix
+;;   ix-1 : H = x3        \  push hl
+;;   ix-2 : L = x2        /
+;;   ix-3 : D = x1        \  push de
+;;   ix-4 : E = x0        /
+;;   ix-5 : sign mask for __fp_norm_pack, series: 0x80 for 1 - a
+;;   ix-6 : step i
+;;   ix-7 : |e + 1|
+;;   ix-11..-8  : a (lsb first)
+;;   ix-13,-12  : exponent of a normalized
+;; ============================================================
+
+        ;; _logf
+        ;; inputs:  x in HLDE
+        ;; outputs: HLDE = log(x)
+_logf:
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+        push    hl
+        push    de
+        ld      hl,#-9
+        add     hl,sp
+        ld      sp,hl
+        xor     a
+        ld      -5(ix),a
+
+        ld      a,-2(ix)
+        rla
+        ld      a,-1(ix)
+        rla                             ; a = biased exponent
+.if FLOAT_IEEE
+        ld      c,a
+        inc     a
+        jp      z,.special
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        or      c
+        jp      z,.minus_inf            ; log(+-0) = -Inf
+        bit     7,-1(ix)
+        jp      nz,.invalid             ; x < 0
+.else
+        or      a
+        jp      z,.minus_inf            ; 0 and denormals
+        bit     7,-1(ix)
+        jp      nz,.minus_inf           ; x < 0
+.endif
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        call    __fp_unpack_norm        ; x = m / 2^31 * 2^e
+        ld      a,d
+        or      e
+        jr      nz,.below
+        ld      a,h
+        cp      #0x82
+        jp      nc,.log2                ; x >= 1 + 2^-6
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl                   ; a = x - 1, Q0.32
+        ld      a,h
+        or      l
+        exx
+        or      h
+        or      l
+        exx
+        jp      z,.zero                 ; log(1) = +0
+        jr      .series
+.below:
+        ld      a,d
+        and     e
+        inc     a
+        jp      nz,.log2                ; e != -1
+        ld      a,h
+        cp      #0xFC
+        jp      c,.log2                 ; x < 1 - 2^-6
+        ld      -5(ix),#0x80
+        call    .neg_hl                 ; a = 1 - x, Q0.32
+
+        ;; ---- a < 2^-6: ln(1 +- a) = +-(a -+ a t) ----
+        ;; t = a (1/2 -+ a (1/3 -+ a / 4))
+.series:
+        ld      -8(ix),h
+        ld      -9(ix),l
+        exx
+        ld      -10(ix),h
+        ld      -11(ix),l
+        exx
+        ld      a,#2
+        call    __fp_shr32
+        ld      bc,#0x5555
+        exx
+        ld      bc,#0x5555
+        exx
+        call    .pm                     ; 1/3 -+ a / 4
+        ld      d,-8(ix)
+        ld      e,-9(ix)
+        exx
+        ld      d,-10(ix)
+        ld      e,-11(ix)
+        exx
+        call    __mulhu32
+        ld      bc,#0x8000
+        exx
+        ld      bc,#0
+        exx
+        call    .pm                     ; 1/2 -+ a (1/3 -+ a / 4)
+        call    __mulhu32               ; t
+        ld      b,h
+        ld      c,l
+        exx
+        ld      b,h
+        ld      c,l
+        exx
+        ex      de,hl
+        exx
+        ex      de,hl
+        exx                             ; a, keeping its full precision
+        ld      de,#-1
+        call    __fp_norm32
+        ld      -12(ix),e
+        ld      -13(ix),d
+        ex      de,hl
+        exx
+        ex      de,hl
+        exx
+        call    __mulhu32               ; a t
+        bit     7,-5(ix)
+        jr      nz,.s_add
+        exx
+        ex      de,hl
+        or      a
+        sbc     hl,de
+        exx
+        ex      de,hl
+        sbc     hl,de                   ; a - a t
+        ld      e,-12(ix)
+        ld      d,-13(ix)
+        jp      .pack
+.s_add:
+        exx
+        add     hl,de
+        exx
+        adc     hl,de                   ; a + a t
+        ld      e,-12(ix)
+        ld      d,-13(ix)
+        jp      nc,.pack
+        call    .rr_jam
+        inc     de
+        jp      .pack
+
+        ;; ---- m up to 1 by factors 1 + 2^-i, z = sum of their logs ----
+.log2:
+        ld      a,e
+        bit     7,d
+        jr      z,.k_pos
+        cpl                             ; |e + 1| = -e - 1
+        ld      -5(ix),#0x80
+        jr      .k_set
+.k_pos:
+        inc     a
+.k_set:
+        ld      -7(ix),a
+        ld      de,#0
+        exx
+        ld      de,#0
+        exx                             ; z = 0
+        ld      iy,#__fp_ln_tab
+        ld      -6(ix),#1
+.step:
+        ld      b,h
+        ld      c,l
+        exx
+        ld      b,h
+        ld      c,l
+        push    hl
+        exx
+        push    hl
+        ld      a,-6(ix)
+        call    __fp_srl_bc             ; bc = v >> i, cf = round
+        exx
+        adc     hl,bc
+        exx
+        adc     hl,bc                   ; v += v >> i
+        jr      c,.undo                 ; v would reach 1
+        pop     bc
+        pop     bc
+        exx
+        ld      a,e
+        add     a,0(iy)
+        ld      e,a
+        ld      a,d
+        adc     a,1(iy)
+        ld      d,a
+        exx
+        ld      a,e
+        adc     a,2(iy)
+        ld      e,a
+        ld      a,d
+        adc     a,3(iy)
+        ld      d,a                     ; z += ln(1 + 2^-i)
+        jr      .next
+.undo:
+        pop     hl
+        exx
+        pop     hl
+        exx
+.next:
+        ld      bc,#4
+        add     iy,bc
+        inc     -6(ix)
+        ld      a,-6(ix)
+        cp      #17
+        jr      nz,.step
+        exx
+        ex      de,hl
+        or      a
+        sbc     hl,de
+        push    hl
+        exx
+        ex      de,hl
+        sbc     hl,de                   ; z + d = z + 2^32 - v, Q0.32
+        push    hl
+        ld      e,-7(ix)
+        ld      bc,#0xB172
+        exx
+        ld      bc,#0x17F8              ; ln 2, Q0.32
+        exx
+        call    __fp_mul8x32            ; a:hl:hl' = |e + 1| ln 2
+        pop     bc
+        exx
+        pop     bc
+        exx
+        bit     7,-5(ix)
+        jr      nz,.neg
+        exx
+        or      a
+        sbc     hl,bc
+        exx
+        sbc     hl,bc
+        sbc     a,#0                    ; (e + 1) ln 2 - (z + d)
+        jr      .fit
+.neg:
+        exx
+        add     hl,bc
+        exx
+        adc     hl,bc
+        adc     a,#0                    ; (-e - 1) ln 2 + (z + d)
+.fit:
+        ld      de,#-1
+.fit_loop:
+        or      a
+        jr      z,.pack
+        srl     a
+        call    .rr_jam
+        inc     de
+        jr      .fit_loop
+.pack:
+        call    __fp_norm_pack
+        jr      .done
+
+.if FLOAT_IEEE
+        ;; ---- exponent 255: NaN quiet, +Inf, -Inf invalid ----
+.special:
+        ld      a,-2(ix)
+        and     #0x7F
+        or      -3(ix)
+        or      -4(ix)
+        jr      nz,.nan
+        bit     7,-1(ix)
+        jr      nz,.invalid
+        ld      hl,#0x7F80              ; log(+Inf) = +Inf
+        ld      de,#0
+        jr      .done
+.nan:
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        set     6,l
+        jr      .done
+.invalid:
+        call    __fp_nan32
+        jr      .done
+.endif
+.minus_inf:
+        ld      hl,#0xFF80
+        ld      de,#0
+        jr      .done
+.zero:
+        ld      hl,#0
+        ld      d,h
+        ld      e,l
+.done:
+        ld      sp,ix
+        pop     ix
+        ret
+
+        ;; BC:BC' = BC:BC' - HL:HL', or + when -5(ix) is 0x80
+.pm:
+        bit     7,-5(ix)
+        jr      nz,.pm_add
+        exx
+        ld      a,c
+        sub     l
+        ld      c,a
+        ld      a,b
+        sbc     a,h
+        ld      b,a
+        exx
+        ld      a,c
+        sbc     a,l
+        ld      c,a
+        ld      a,b
+        sbc     a,h
+        ld      b,a
+        ret
+.pm_add:
+        exx
+        ld      a,c
+        add     a,l
+        ld      c,a
+        ld      a,b
+        adc     a,h
+        ld      b,a
+        exx
+        ld      a,c
+        adc     a,l
+        ld      c,a
+        ld      a,b
+        adc     a,h
+        ld      b,a
+        ret
+
+        ;; HL:HL' = -HL:HL'
+.neg_hl:
+        xor     a
+        exx
+        sub     l
+        ld      l,a
+        ld      a,#0
+        sbc     a,h
+        ld      h,a
+        exx
+        ld      a,#0
+        sbc     a,l
+        ld      l,a
+        ld      a,#0
+        sbc     a,h
+        ld      h,a
+        ret
+
+        ;; HL:HL' = cf:HL:HL' >> 1, the bit out kept in bit 0 (sticky)
+.rr_jam:
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        jr      nc,.rr_done
+        set     0,l
+.rr_done:
+        exx
+        ret
@@ -0,0 +1,953 @@
+        ;; sine and cosine (ieee-754 single) for sdcc z80
+        ;;
+        ;; float sinf(float x);
+        ;; float cosf(float x);
+        ;; void sincosf(float x, float *s, float *c);
+        ;;
+        ;; |x| is reduced to r = |x| - q pi/2, |r| <= pi/4, with a window
+        ;; of 2/pi bits (Payne-Hanek): the 24-bit mantissa times 64 bits
+        ;; of 2/pi starting at the exponent gives q and the fraction f of
+        ;; a quarter turn in 32 bits, and when f is small (x close to a
+        ;; multiple of pi/2) another 32 bits keep r at full precision.
+        ;; then r = f pi/2.
+        ;;
+        ;; |r| >= 1/8: CORDIC rotation (see fpcordic.s) of (K, 0) by r,
+        ;; 16 steps, and the angle left over (below 2^-15) as one linear
+        ;; step, x -= z y and y += z x, with 16 x 16 bit products.
+        ;; |r| < 1/8: Taylor polynomials,
+        ;;   sin r = r - r (s / 6 - s^2 / 120),  cos r = 1 - s / 2 + s^2 / 24
+        ;; with s = r^2, on Q0.32 fractions with __mulhu32.
+        ;; the quadrant q picks +-sin r or +-cos r. results are within
+        ;; 1 ulp; the CORDIC path computes both, the Taylor path only
+        ;; what is asked for.
+        ;;
+        ;; |x| < 2^-12 gives sin x = x and cos x = 1.
+        ;; fast profile: denormals give +-0 for sinf.
+        ;; FLOAT_PROFILE=ieee: NaN is returned quiet, +-Inf gives the
+        ;; default NaN.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in regs: HLDE  (H=x3, L=x2, D=x1, E=x0)
+        ;;   s, c on stack (sincosf), callee cleans
+        ;;   result in HLDE
+        ;;
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module sincosf
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _sinf
+        .globl  _cosf
+        .globl  _sincosf
+        .globl  __fp_unpack_norm
+        .globl  __fp_norm32
+        .globl  __fp_norm_pack
+        .globl  __fp_shr32
+        .globl  __fp_cordic
+        .globl  __fp_cordic_z2d
+        .globl  __fp_retpop4
+        .globl  __mulhu32
+        .globl  __mullong
+        .globl  ___muluint2ulong
+
+        .include "config.inc"
+
+.if FLOAT_IEEE
+        .globl  __fp_nan32
+.endif
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+6,7   : c (sincosf)
+;;   ix+4,5   : s (sincosf)
+;;   ix+2,3   : return address
+;;   ix+0,1   : saved ix
+;;   ix-1     : H = x3        \  push hl
+;;   ix-2     : L = x2        /
+;;   ix-3     : D = x1        \  push de
+;;   ix-4     : E = x0        /
+;;   ix-5     : sign mask for __fp_norm_pack
+;;   ix-6     : CORDIC step (see __fp_cordic)
+;;   ix-7     : bit 0 S needed, bit 1 C needed
+;;   ix-8     : quadrant q, bit 7 results are packed floats
+;;   ix-9     : sign of S
+;;   ix-10    : bit 0 sin wanted, bit 1 cos wanted, bit 7 sign of x
+;;   ix-14..-11 : M' (mantissa << sh), then r mantissa (lsb first)
+;;   ix-16,-15  : 2/pi window pointer, then r exponent
+;;   ix-20..-17 : y1, then s = r^2
+;;   ix-24..-21 : y0, then |z| left by the CORDIC and its sign (-21)
+;;   ix-28..-25 : S mantissa (sin r)
+;;   ix-30,-29  : S exponent
+;;   ix-34..-31 : C mantissa (cos r)
+;;   ix-36,-35  : C exponent
+;;
+;; mantissa m and exponent e hold m / 2^31 * 2^e (see fpnorm.s)
+;; ============================================================
+
+        ;; _sinf
+        ;; inputs:  x in HLDE
+        ;; outputs: HLDE = sin(x)
+_sinf:
+        ld      a,#1
+        jr      .entry
+
+        ;; _cosf
+        ;; inputs:  x in HLDE
+        ;; outputs: HLDE = cos(x)
+_cosf:
+        ld      a,#2
+        jr      .entry
+
+        ;; _sincosf
+        ;; inputs:  x in HLDE, s at 2(sp), c at 4(sp)
+        ;; outputs: *s = sin(x), *c = cos(x)
+        ;; notes: callee cleans s and c from stack
+_sincosf:
+        ld      a,#3
+.entry:
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+        push    hl
+        push    de
+        ld      hl,#-32
+        add     hl,sp
+        ld      sp,hl
+        ld      c,a
+        ld      a,-1(ix)
+        and     #0x80
+        or      c
+        ld      -10(ix),a               ; wanted, sign of x
+        xor     a
+        ld      -8(ix),a                ; q = 0
+        ld      -9(ix),a
+
+        ld      a,-2(ix)
+        rla
+        ld      a,-1(ix)
+        rla                             ; a = biased exponent
+.if FLOAT_IEEE
+        cp      #0xFF
+        jp      z,.nan
+.else
+        or      a
+        jp      z,.flush
+.endif
+        cp      #127-12
+        jp      c,.tiny
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        call    __fp_unpack_norm        ; |x| = m / 2^31 * 2^e
+        ld      a,d
+        or      a
+        jr      z,.reduce               ; e >= 0
+        ld      a,e
+        inc     a
+        jp      nz,.kernel              ; e <= -2: r = x
+        exx
+        ld      a,h
+        exx
+        sub     #0xDB
+        ld      a,l
+        sbc     a,#0x0F
+        ld      a,h
+        sbc     a,#0xC9
+        jp      c,.kernel               ; |x| < pi/4
+
+        ;; ---- k = e + 7, window at 2/pi byte k / 8, M' = M << (k & 7) ----
+.reduce:
+        ld      a,e
+        add     a,#7
+        ld      c,a
+        and     #7
+        ld      b,a
+        ld      a,#8
+        sub     b
+        call    __fp_shr32              ; M' = m >> (8 - k & 7)
+        ld      -11(ix),h
+        ld      -12(ix),l
+        exx
+        ld      -13(ix),h
+        ld      -14(ix),l
+        exx
+        ld      a,c
+        rrca
+        rrca
+        rrca
+        and     #0x1F
+        ld      e,a
+        ld      d,#0
+        ld      hl,#.twobypi
+        add     hl,de
+        ld      -16(ix),l
+        ld      -15(ix),h
+
+        ;; ---- y1 = lo32(M' Wh) + hi32(M' Wm): q and f in quarter turns ----
+        call    .lo_mul                 ; HL:DE = lo32(M' Wh)
+        ld      -17(ix),h
+        ld      -18(ix),l
+        ld      -19(ix),d
+        ld      -20(ix),e
+        ld      l,-16(ix)
+        ld      h,-15(ix)
+        ld      de,#4
+        add     hl,de
+        call    .hi_mul                 ; HL:HL' = hi32(M' Wm)
+        exx
+        ld      a,l
+        add     a,-20(ix)
+        ld      l,a
+        ld      -20(ix),a
+        ld      a,h
+        adc     a,-19(ix)
+        ld      h,a
+        ld      -19(ix),a
+        exx
+        ld      a,l
+        adc     a,-18(ix)
+        ld      l,a
+        ld      -18(ix),a
+        ld      a,h
+        adc     a,-17(ix)
+        ld      h,a
+        ld      -17(ix),a               ; y1
+        call    .centre                 ; q, HL:HL' = f (2^32 = 4 turns)
+        bit     7,h
+        jr      z,.f_pos
+        call    .neg_hl
+        ld      -9(ix),#0x80
+.f_pos:
+        ld      a,h
+        cp      #0x08
+        jr      c,.stage2               ; |f| < 1/8 of a quarter turn
+
+        ;; ---- r = f pi/2 in Q1.31, |r| >= 0.19 ----
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl
+        call    .half_pi                ; HL:HL' = |r|
+        call    .needed
+        jp      .cordic
+
+        ;; ---- 32 more bits: y0 = lo32(M' Wm) + hi32(M' Wl) ----
+.stage2:
+        ld      l,-16(ix)
+        ld      h,-15(ix)
+        ld      de,#4
+        add     hl,de
+        call    .lo_mul                 ; HL:DE = lo32(M' Wm)
+        ld      -21(ix),h
+        ld      -22(ix),l
+        ld      -23(ix),d
+        ld      -24(ix),e
+        ld      l,-16(ix)
+        ld      h,-15(ix)
+        ld      de,#8
+        add     hl,de
+        call    .hi_mul                 ; HL:HL' = hi32(M' Wl)
+        exx
+        ld      a,l
+        add     a,-24(ix)
+        ld      e,a
+        ld      a,h
+        adc     a,-23(ix)
+        ld      d,a
+        exx
+        ld      a,l
+        adc     a,-22(ix)
+        ld      e,a
+        ld      a,h
+        adc     a,-21(ix)
+        ld      d,a                     ; DE:DE' = y0
+        ld      h,-17(ix)
+        ld      l,-18(ix)
+        ld      bc,#0
+        exx
+        ld      h,-19(ix)
+        ld      l,-20(ix)
+        ld      bc,#0
+        adc     hl,bc
+        exx
+        adc     hl,bc                   ; HL:HL':DE:DE' = y1:y0
+        call    .centre
+        bit     7,h
+        jr      z,.F_pos
+        xor     a                       ; F = -F, 64 bits
+        exx
+        sub     e
+        ld      e,a
+        ld      a,#0
+        sbc     a,d
+        ld      d,a
+        exx
+        ld      a,#0
+        sbc     a,e
+        ld      e,a
+        ld      a,#0
+        sbc     a,d
+        ld      d,a
+        call    .neg_hl_c
+        ld      -9(ix),#0x80
+.F_pos:
+        ld      a,h
+        or      l
+        or      d
+        or      e
+        exx
+        or      h
+        or      l
+        or      d
+        or      e
+        exx
+        jr      nz,.F_norm
+        ld      de,#-64                 ; r = 0
+        jp      .kernel
+.F_norm:
+        ld      c,#0
+.F_bytes:
+        ld      a,h
+        or      a
+        jr      nz,.F_bits
+        ld      h,l                     ; 64-bit byte step
+        exx
+        ld      a,h
+        ld      h,l
+        exx
+        ld      l,a
+        ld      a,d
+        ld      d,e
+        exx
+        ld      l,a
+        ld      a,d
+        ld      d,e
+        ld      e,#0
+        exx
+        ld      e,a
+        ld      a,c
+        add     a,#8
+        ld      c,a
+        jr      .F_bytes
+.F_bits:
+        bit     7,h
+        jr      nz,.F_top
+        exx
+        sla     e
+        rl      d
+        exx
+        rl      e
+        rl      d
+        exx
+        adc     hl,hl
+        exx
+        adc     hl,hl
+        inc     c
+        jr      .F_bits
+.F_top:
+        ld      a,#2
+        sub     c
+        push    af                      ; 2 - shift
+        call    .half_pi                ; r = top32(F) pi/2 / 2^32
+        pop     af
+        ld      e,a
+        ld      d,#0xFF
+        call    __fp_norm32
+
+        ;; ---- r = m / 2^31 * 2^e, |r| <= pi/4, sign in -9(ix) ----
+.kernel:
+        ld      -11(ix),h
+        ld      -12(ix),l
+        exx
+        ld      -13(ix),h
+        ld      -14(ix),l
+        exx
+        ld      -16(ix),e
+        ld      -15(ix),d
+        call    .needed
+        ld      a,e
+        cp      #0xFD
+        jp      c,.taylor               ; e <= -4
+        xor     a
+        sub     e
+        call    __fp_shr32              ; Q1.31
+
+        ;; ---- CORDIC, then z y and z x for the angle left over ----
+.cordic:
+        bit     7,-9(ix)
+        call    nz,.neg_hl
+        call    __fp_cordic_z2d         ; IY = directions, z left
+        ld      -21(ix),h
+        bit     7,h
+        call    nz,.neg_hl
+        exx
+        ld      de,#1
+        add     hl,de
+        exx
+        ld      de,#0
+        adc     hl,de
+        srl     h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        ld      -24(ix),l
+        ld      -23(ix),h               ; zr = (|z| + 1) / 2, Q0.15
+        ld      hl,#0x3B6A
+        ld      de,#0
+        exx
+        ld      hl,#0x26DD              ; x = K, 1 / prod sqrt(1 + 2^-2i)
+        ld      de,#0                   ; y = 0
+        ld      -6(ix),#0
+        call    __fp_cordic
+        ld      -25(ix),d
+        ld      -26(ix),e
+        ld      -31(ix),h
+        ld      -32(ix),l
+        exx
+        ld      -27(ix),d
+        ld      -28(ix),e
+        ld      -33(ix),h
+        ld      -34(ix),l
+        ld      a,h
+        exx
+        call    .round15                ; xr = x / 2^15
+        ld      e,-24(ix)
+        ld      d,-23(ix)
+        call    ___muluint2ulong
+        ld      a,d
+        call    .round15
+        push    hl                      ; z x
+        ld      h,-25(ix)
+        ld      l,-26(ix)
+        exx
+        ld      h,-27(ix)
+        ld      l,-28(ix)
+        exx
+        bit     7,h
+        call    nz,.neg_hl
+        exx
+        ld      a,h
+        exx
+        call    .round15                ; yr = |y| / 2^15
+        ld      e,-24(ix)
+        ld      d,-23(ix)
+        call    ___muluint2ulong
+        ld      a,d
+        call    .round15
+        ex      de,hl                   ; de = z y
+        ld      a,-21(ix)
+        xor     -25(ix)
+        rla
+        jr      c,.x_add
+        ld      a,-34(ix)               ; x -= z y
+        sub     e
+        ld      -34(ix),a
+        ld      a,-33(ix)
+        sbc     a,d
+        ld      -33(ix),a
+        ld      a,-32(ix)
+        sbc     a,#0
+        ld      -32(ix),a
+        ld      a,-31(ix)
+        sbc     a,#0
+        ld      -31(ix),a
+        jr      .x_done
+.x_add:
+        ld      a,-34(ix)               ; x += z y (z y < 0)
+        add     a,e
+        ld      -34(ix),a
+        ld      a,-33(ix)
+        adc     a,d
+        ld      -33(ix),a
+        ld      a,-32(ix)
+        adc     a,#0
+        ld      -32(ix),a
+        ld      a,-31(ix)
+        adc     a,#0
+        ld      -31(ix),a
+.x_done:
+        pop     de                      ; z x
+        bit     7,-21(ix)
+        jr      nz,.y_sub
+        ld      a,-28(ix)               ; y += z x
+        add     a,e
+        ld      l,a
+        ld      a,-27(ix)
+        adc     a,d
+        ld      h,a
+        exx
+        ld      a,-26(ix)
+        adc     a,#0
+        ld      l,a
+        ld      a,-25(ix)
+        adc     a,#0
+        ld      h,a
+        jr      .y_done
+.y_sub:
+        ld      a,-28(ix)               ; y -= z x
+        sub     e
+        ld      l,a
+        ld      a,-27(ix)
+        sbc     a,d
+        ld      h,a
+        exx
+        ld      a,-26(ix)
+        sbc     a,#0
+        ld      l,a
+        ld      a,-25(ix)
+        sbc     a,#0
+        ld      h,a
+.y_done:
+        ld      -9(ix),#0               ; S = |y|, C = x, Q2.30
+        bit     7,h
+        jr      z,.y_pos
+        call    .neg_hl
+        ld      -9(ix),#0x80
+.y_pos:
+        ld      -25(ix),h
+        ld      -26(ix),l
+        exx
+        ld      -27(ix),h
+        ld      -28(ix),l
+        ld      a,#1
+        ld      -30(ix),a
+        ld      -36(ix),a
+        xor     a
+        ld      -29(ix),a
+        ld      -35(ix),a
+        jp      .output
+
+        ;; ---- Taylor polynomials, s = r^2 ----
+.taylor:
+        ld      d,h
+        ld      e,l
+        ld      b,h
+        ld      c,l
+        exx
+        ld      d,h
+        ld      e,l
+        ld      b,h
+        ld      c,#0
+        exx
+        call    __mulhu32               ; r^2 / 2^(2 e + 2)
+        ld      a,-16(ix)
+        add     a,a
+        add     a,#2
+        neg
+        call    __fp_shr32              ; s, Q0.32
+        ld      -17(ix),h
+        ld      -18(ix),l
+        exx
+        ld      -19(ix),h
+        ld      -20(ix),l
+        exx
+        bit     0,-7(ix)
+        jp      z,.t_cos
+        ld      b,h                     ; S = r - r (s / 6 - s^2 / 120)
+        ld      c,l
+        ld      de,#0x0222
+        exx
+        ld      bc,#0
+        ld      de,#0x2222
+        exx
+        call    __mulhu32
+        exx
+        ld      a,#0xAB
+        sub     l
+        ld      a,#0xAA
+        sbc     a,h
+        ld      b,a
+        ld      c,#0
+        exx
+        ld      a,#0xAA
+        sbc     a,l
+        ld      c,a
+        ld      a,#0x2A
+        sbc     a,h
+        ld      b,a                     ; 1/6 - s / 120
+        call    .s_de
+        call    __mulhu32
+        ld      b,h
+        ld      c,l
+        exx
+        ld      b,h
+        ld      c,l
+        exx
+        ld      d,-11(ix)
+        ld      e,-12(ix)
+        exx
+        ld      d,-13(ix)
+        ld      e,-14(ix)
+        exx
+        call    __mulhu32
+        exx
+        ld      a,-14(ix)
+        sub     l
+        ld      -28(ix),a
+        ld      a,-13(ix)
+        sbc     a,h
+        ld      -27(ix),a
+        exx
+        ld      a,-12(ix)
+        sbc     a,l
+        ld      -26(ix),a
+        ld      a,-11(ix)
+        sbc     a,h
+        ld      -25(ix),a
+        ld      a,-16(ix)
+        ld      -30(ix),a
+        ld      a,-15(ix)
+        ld      -29(ix),a
+.t_cos:
+        bit     1,-7(ix)
+        jr      z,.output
+        ld      b,-17(ix)               ; C = 1 - s (1/2 - s / 24)
+        ld      c,-18(ix)
+        ld      de,#0x0AAA
+        exx
+        ld      bc,#0
+        ld      de,#0xAAAB
+        exx
+        call    __mulhu32
+        xor     a
+        exx
+        sub     l
+        ld      a,#0
+        sbc     a,h
+        ld      b,a
+        ld      c,#0
+        exx
+        ld      a,#0
+        sbc     a,l
+        ld      c,a
+        ld      a,#0x80
+        sbc     a,h
+        ld      b,a                     ; 1/2 - s / 24
+        call    .s_de
+        call    __mulhu32
+        xor     a
+        exx
+        sub     l
+        ld      -34(ix),a
+        ld      a,#0
+        sbc     a,h
+        ld      -33(ix),a
+        exx
+        ld      a,#0
+        sbc     a,l
+        ld      -32(ix),a
+        ld      a,#0
+        sbc     a,h
+        ld      -31(ix),a
+        ld      a,#0xFF
+        ld      -36(ix),a
+        ld      -35(ix),a               ; Q0.32
+        ld      a,h
+        or      l
+        exx
+        or      h
+        or      l
+        exx
+        jr      nz,.output
+        ld      -31(ix),#0x80           ; s too small: 1.0
+        ld      -36(ix),a
+        ld      -35(ix),a
+
+        ;; ---- pick the results by quadrant ----
+.output:
+        ld      a,-10(ix)
+        and     #3
+        cp      #2
+        jr      z,.cos_only
+        call    .sin_out
+        bit     1,-10(ix)
+        jr      z,.done
+        ld      c,4(ix)
+        ld      b,5(ix)
+        call    .store
+        call    .cos_out
+        ld      c,6(ix)
+        ld      b,7(ix)
+        call    .store
+        ld      sp,ix
+        pop     ix
+        jp      __fp_retpop4
+.cos_only:
+        call    .cos_out
+.done:
+        ld      sp,ix
+        pop     ix
+        ret
+
+        ;; ---- |x| < 2^-12: sin x = x, cos x = 1 ----
+.tiny:
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        call    .raw_s
+        ld      hl,#0x3F80
+        ld      de,#0
+        jr      .raw_c
+
+.if FLOAT_IEEE
+        ;; ---- NaN quiet, +-Inf gives the default NaN ----
+.nan:
+        ld      h,-1(ix)
+        ld      l,-2(ix)
+        ld      d,-3(ix)
+        ld      e,-4(ix)
+        ld      a,l
+        and     #0x7F
+        or      d
+        or      e
+        jr      z,.inf
+        set     6,l
+        jr      .nan_out
+.inf:
+        call    __fp_nan32
+.nan_out:
+        call    .raw_s
+        jr      .raw_c
+.else
+        ;; ---- denormal: sin x = +-0 ----
+.flush:
+        ld      -2(ix),a
+        ld      -3(ix),a
+        ld      -4(ix),a
+        ld      a,-1(ix)
+        and     #0x80
+        ld      -1(ix),a
+        jr      .tiny
+.endif
+.raw_c:
+        ld      -31(ix),h
+        ld      -32(ix),l
+        ld      -33(ix),d
+        ld      -34(ix),e
+        set     7,-8(ix)
+        jr      .output
+.raw_s:
+        ld      -25(ix),h
+        ld      -26(ix),l
+        ld      -27(ix),d
+        ld      -28(ix),e
+        ret
+
+        ;; HLDE = sin x
+.sin_out:
+        ld      a,-10(ix)
+        and     #0x80
+        ld      b,a                     ; sin is odd
+        ld      a,-8(ix)
+        bit     7,a
+        jr      z,.out
+        ld      h,-25(ix)
+        ld      l,-26(ix)
+        ld      d,-27(ix)
+        ld      e,-28(ix)
+        ret
+
+        ;; HLDE = cos x
+.cos_out:
+        ld      b,#0
+        ld      a,-8(ix)
+        bit     7,a
+        jr      nz,.cos_raw
+        inc     a                       ; cos x = sin(x + pi/2)
+        jr      .out
+.cos_raw:
+        ld      h,-31(ix)
+        ld      l,-32(ix)
+        ld      d,-33(ix)
+        ld      e,-34(ix)
+        ret
+
+        ;; HLDE = S or C by quadrant A, B = sign to add
+        ;;   q = 0: S, 1: C, 2: -S, 3: -C
+.out:
+        ld      c,a
+        bit     0,c
+        jr      nz,.out_c
+        ld      a,-9(ix)
+        ld      h,-25(ix)
+        ld      l,-26(ix)
+        exx
+        ld      h,-27(ix)
+        ld      l,-28(ix)
+        exx
+        ld      e,-30(ix)
+        ld      d,-29(ix)
+        jr      .out_sign
+.out_c:
+        xor     a
+        ld      h,-31(ix)
+        ld      l,-32(ix)
+        exx
+        ld      h,-33(ix)
+        ld      l,-34(ix)
+        exx
+        ld      e,-36(ix)
+        ld      d,-35(ix)
+.out_sign:
+        bit     1,c
+        jr      z,.out_pack
+        xor     #0x80
+.out_pack:
+        xor     b
+        ld      -5(ix),a
+        jp      __fp_norm_pack
+
+        ;; (bc) = HLDE
+.store:
+        ld      a,e
+        ld      (bc),a
+        inc     bc
+        ld      a,d
+        ld      (bc),a
+        inc     bc
+        ld      a,l
+        ld      (bc),a
+        inc     bc
+        ld      a,h
+        ld      (bc),a
+        ret
+
+        ;; -7(ix) = S and C needed for the wanted results and q
+.needed:
+        ld      a,-10(ix)
+        and     #3
+        bit     0,-8(ix)
+        jr      z,.needed_set
+        cp      #3
+        jr      z,.needed_set
+        xor     #3                      ; odd q: sin from C, cos from S
+.needed_set:
+        ld      -7(ix),a
+        ret
+
+        ;; q = (y + 2^29) >> 30 to -8(ix), HL = y - q 2^30 (signed)
+.centre:
+        ld      a,h
+        add     a,#0x20
+        ld      c,a
+        rlca
+        rlca
+        and     #3
+        ld      -8(ix),a
+        ld      a,c
+        and     #0x3F
+        sub     #0x20
+        ld      h,a
+        ret
+
+        ;; HL:HL' = HL:HL' * pi/2 / 2^32
+.half_pi:
+        ex      de,hl
+        exx
+        ex      de,hl
+        ld      bc,#0xDAA2
+        exx
+        ld      bc,#0xC90F
+        jp      __mulhu32
+
+        ;; HL:HL' = -HL:HL'
+.neg_hl:
+        or      a
+        ;; HL:HL' = -HL:HL' - cf
+.neg_hl_c:
+        exx
+        ld      a,#0
+        sbc     a,l
+        ld      l,a
+        ld      a,#0
+        sbc     a,h
+        ld      h,a
+        exx
+        ld      a,#0
+        sbc     a,l
+        ld      l,a
+        ld      a,#0
+        sbc     a,h
+        ld      h,a
+        ret
+
+        ;; HL = round(HL:A / 2^15), HL:A < 2^31
+.round15:
+        ld      bc,#0
+        add     a,a
+        adc     hl,hl
+        add     a,a
+        adc     hl,bc
+        ret
+
+        ;; DE:DE' = s
+.s_de:
+        ld      d,-17(ix)
+        ld      e,-18(ix)
+        exx
+        ld      d,-19(ix)
+        ld      e,-20(ix)
+        exx
+        ret
+
+        ;; HL:DE = lo32(M' W), W at hl
+.lo_mul:
+        ld      b,(hl)
+        inc     hl
+        ld      c,(hl)
+        inc     hl
+        ld      d,(hl)
+        inc     hl
+        ld      e,(hl)
+        push    bc
+        push    de
+        ld      h,-11(ix)
+        ld      l,-12(ix)
+        ld      d,-13(ix)
+        ld      e,-14(ix)
+        call    __mullong
+        pop     af
+        pop     af
+        ret
+
+        ;; HL:HL' = hi32(M' W), W at hl
+.hi_mul:
+        ld      b,(hl)
+        inc     hl
+        ld      c,(hl)
+        inc     hl
+        ld      a,(hl)
+        inc     hl
+        ld      l,(hl)
+        exx
+        ld      b,a
+        exx
+        ld      a,l
+        exx
+        ld      c,a
+        ld      d,-13(ix)
+        ld      e,-14(ix)
+        exx
+        ld      d,-11(ix)
+        ld      e,-12(ix)
+        jp      __mulhu32
+
+        ;; 2/pi, msb first, after 4 zero bytes
+.twobypi:
+        .db     0x00, 0x00, 0x00, 0x00, 0xa2, 0xf9, 0x83, 0x6e
+        .db     0x4e, 0x44, 0x15, 0x29, 0xfc, 0x27, 0x57, 0xd1
+        .db     0xf5, 0x34, 0xdd, 0xc0, 0xdb, 0x62, 0x95, 0x99
+        .db     0x3c, 0x43, 0x90, 0x41, 0xfe, 0x51, 0x63, 0xab
@@ -55,7 +55,9 @@ ___slong2fs:
         cpl
         ld      h,a
 
-        inc     de
+        inc     de               ; inc rr leaves the flags alone
+        ld      a,d
+        or      e
         jr      nz, .mag_ok
         inc     hl
 
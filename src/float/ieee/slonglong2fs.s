@@ -0,0 +1,46 @@
+        ;; signed long long to float via __u64tofs (ieee-754 single) for
+        ;; sdcc z80: negates a negative argument in place, converts the
+        ;; magnitude and sets the sign bit of the result.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   a on stack: 2(sp)..9(sp) = a0..a7 (lsb..msb)
+        ;;   callee cleans a from stack
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module slonglong2fs
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  ___slonglong2fs
+        .globl  __u64tofs
+        .globl  __fp_retpop8
+
+        ;; ___slonglong2fs
+        ;; inputs:  a at 2(sp)..9(sp) (signed)
+        ;; outputs: hl:de = (float)a
+        ;; clobbers: af, bc, de, hl, iy
+___slonglong2fs:
+        ld      iy,#2
+        add     iy,sp
+        bit     7,7(iy)
+        jr      nz,.neg
+        call    __u64tofs
+        jp      __fp_retpop8
+
+.neg:
+        push    iy
+        pop     hl
+        ld      b,#8
+        or      a
+.neg_loop:
+        ld      a,#0                    ; a = -a, -2^63 stays 2^63 unsigned
+        sbc     a,(hl)
+        ld      (hl),a
+        inc     hl
+        djnz    .neg_loop
+        call    __u64tofs
+        set     7,h
+        jp      __fp_retpop8
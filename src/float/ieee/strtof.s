@@ -0,0 +1,465 @@
+        ;; decimal string to float for sdcc z80
+        ;;
+        ;; float strtof(const char *s, char **end);
+        ;;
+        ;; accepts leading white space, a sign, digits with an optional
+        ;; point and an optional exponent e[+-]ddd. with FLOAT_PROFILE=ieee
+        ;; also inf, infinity and nan (any case). *end (when end is not 0)
+        ;; is set past the last character used, or to s when there is no
+        ;; number. results that overflow are +-Inf, in the fast profile
+        ;; results below the normal range are +-0.
+        ;;
+        ;; the first 9 significant digits are gathered into a 32-bit
+        ;; integer D (the tenth rounds it), the point and the exponent
+        ;; into a decimal exponent p. D is normalized to a 32-bit
+        ;; mantissa, multiplied by 10^p with __fp_scale10 and rounded to
+        ;; 24 bits once, by __fp_round_pack (or __fp_ieee_pack).
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   s in HL, end in DE
+        ;;   result in HLDE
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module strtof
+        .optsdcc -mz80 sdcccall(1)
+
+        .include "config.inc"
+
+        .area   _CODE
+
+        .globl  _strtof
+        .globl  __fp_scale10
+.if FLOAT_IEEE
+        .globl  __fp_ieee_pack
+.else
+        .globl  __fp_round_pack
+.endif
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+0,1   : saved ix
+;;   ix-1,-2  : end (high, low)
+;;   ix-3,-4  : s (high, low)
+;;   ix-5     : sign mask
+;;   ix-6     : bit 0 a digit was seen, bit 1 after the point,
+;;              bit 2 a digit was dropped, bit 3 round D up,
+;;              bit 4 negative exponent
+;;   ix-7     : count of digits in D
+;;
+;; while parsing: DE = s, HL:HL' = D, IY = p
+;; ============================================================
+
+        ;; _strtof
+        ;; inputs:  HL = s, DE = end
+        ;; outputs: HLDE = IEEE-754 single
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+_strtof:
+        push    ix
+        ld      ix,#0
+        add     ix,sp
+        push    de                      ; ix-1,-2 = end
+        push    hl                      ; ix-3,-4 = s
+        xor     a
+        push    af
+        push    af
+        ld      -5(ix),a
+        ld      -6(ix),a
+        ld      -7(ix),a
+        ex      de,hl
+        ld      hl,#0
+        exx
+        ld      hl,#0
+        exx
+        ld      iy,#0
+
+.space:
+        ld      a,(de)
+        cp      #0x20
+        jr      z,.skip
+        sub     #9                      ; \t \n \v \f \r
+        cp      #5
+        jr      nc,.sign
+.skip:
+        inc     de
+        jr      .space
+.sign:
+        ld      a,(de)
+        cp      #0x2D                   ; '-'
+        jr      nz,.plus
+        ld      -5(ix),#0x80
+        jr      .signed
+.plus:
+        cp      #0x2B                   ; '+'
+        jr      nz,.mant
+.signed:
+        inc     de
+
+.mant:
+        ld      a,(de)
+        cp      #0x2E                   ; '.'
+        jr      z,.point
+        sub     #0x30
+        cp      #10
+        jr      nc,.mant_end
+        set     0,-6(ix)
+        ld      c,a
+        ld      a,-7(ix)
+        cp      #9
+        jr      nc,.drop
+        or      c
+        jr      z,.lead0                ; leading zeros are not counted
+        inc     -7(ix)
+        ld      a,c
+
+        ;; D = D * 10 + a
+        exx
+        add     hl,hl
+        ld      b,h
+        ld      c,l
+        exx
+        adc     hl,hl
+        ld      b,h
+        ld      c,l                     ; BC:BC' = 2 D
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl                   ; 8 D
+        exx
+        add     hl,bc
+        exx
+        adc     hl,bc                   ; 10 D
+        exx
+        ld      c,a
+        ld      b,#0
+        add     hl,bc
+        exx
+        ld      bc,#0
+        adc     hl,bc
+.lead0:
+        bit     1,-6(ix)
+        jr      z,.next
+        dec     iy                      ; a fraction digit
+        jr      .next
+.drop:
+        bit     1,-6(ix)
+        jr      nz,.drop_frac
+        inc     iy                      ; an integer digit past the ninth
+.drop_frac:
+        bit     2,-6(ix)
+        jr      nz,.next
+        set     2,-6(ix)
+        ld      a,c
+        cp      #5
+        jr      c,.next
+        set     3,-6(ix)
+.next:
+        inc     de
+        jr      .mant
+.point:
+        bit     1,-6(ix)
+        jr      nz,.mant_end
+        set     1,-6(ix)
+        inc     de
+        jr      .mant
+
+.mant_end:
+        bit     0,-6(ix)
+        jp      z,.no_digits
+        ld      a,(de)
+        or      #0x20
+        cp      #0x65                   ; 'e' or 'E'
+        jr      nz,.value
+        push    hl
+        exx
+        push    hl
+        exx
+        push    de                      ; the end if no exponent digits follow
+        inc     de
+        ld      a,(de)
+        cp      #0x2D
+        jr      nz,.e_plus
+        set     4,-6(ix)
+        jr      .e_signed
+.e_plus:
+        cp      #0x2B
+        jr      nz,.e_digits
+.e_signed:
+        inc     de
+.e_digits:
+        ld      a,(de)
+        sub     #0x30
+        cp      #10
+        jr      nc,.e_none
+        ld      hl,#0
+.e_loop:
+        ld      b,a
+        ld      a,h
+        cp      #4
+        jr      nc,.e_next              ; stop growing past 1023
+        ld      a,b
+        add     hl,hl
+        ld      b,h
+        ld      c,l
+        add     hl,hl
+        add     hl,hl
+        add     hl,bc
+        add     a,l
+        ld      l,a
+        jr      nc,.e_next
+        inc     h
+.e_next:
+        inc     de
+        ld      a,(de)
+        sub     #0x30
+        cp      #10
+        jr      c,.e_loop
+        pop     bc
+        bit     4,-6(ix)
+        jr      z,.e_add
+        xor     a
+        sub     l
+        ld      l,a
+        sbc     a,a
+        sub     h
+        ld      h,a
+.e_add:
+        ex      de,hl
+        add     iy,de                   ; p += exponent
+        ex      de,hl
+        jr      .e_done
+.e_none:
+        pop     de
+.e_done:
+        exx
+        pop     hl
+        exx
+        pop     hl
+
+.value:
+        push    hl
+        call    .set_end
+        pop     hl
+        bit     3,-6(ix)
+        jr      z,.rounded
+        exx
+        ld      bc,#1
+        add     hl,bc
+        exx
+        ld      bc,#0
+        adc     hl,bc
+.rounded:
+        ld      a,h
+        or      l
+        exx
+        or      h
+        or      l
+        exx
+        jp      z,.zero
+
+        ;; D < 2^30: p > 47 overflows, p < -64 is below any denormal
+        push    iy
+        pop     bc
+        ld      a,b
+        or      a
+        jr      nz,.p_neg
+        ld      a,c
+        cp      #48
+        jp      nc,.inf
+        jr      .p_ok
+.p_neg:
+        inc     a
+        jr      nz,.p_far
+        ld      a,c
+        cp      #0xC0
+        jp      c,.zero
+        jr      .p_ok
+.p_far:
+        bit     7,b
+        jp      z,.inf
+        jp      .zero
+.p_ok:
+        ld      a,c
+        push    af                      ; a = p
+
+        ;; m = D << (31 - e), bit 31 set
+        ld      de,#31
+.norm8:
+        ld      a,h
+        or      a
+        jr      nz,.norm1
+        ld      h,l
+        exx
+        ld      a,h
+        ld      h,l
+        ld      l,#0
+        exx
+        ld      l,a
+        ld      a,e
+        sub     #8
+        ld      e,a
+        jr      .norm8
+.norm1:
+        bit     7,h
+        jr      nz,.normed
+        exx
+        add     hl,hl
+        exx
+        adc     hl,hl
+        dec     e
+        jr      .norm1
+.normed:
+        ld      b,h
+        ld      c,l
+        exx
+        ld      b,h
+        ld      c,l
+        exx
+        ex      de,hl                   ; hl = e
+        pop     af
+        call    __fp_scale10            ; D * 10^p = m / 2^31 * 2^e
+        ld      de,#127
+        add     hl,de                   ; biased exponent
+
+.if FLOAT_IEEE
+        ld      d,c
+        ld      c,b                     ; C:D = mantissa bits 23..8
+        exx
+        ld      a,b
+        exx
+        ld      e,a                     ; E = mantissa bits 7..0
+        exx
+        ld      a,c
+        exx                             ; A = guard byte
+        ld      b,-5(ix)
+        call    __fp_ieee_pack
+.else
+        bit     7,h
+        jr      nz,.zero
+        ld      a,h
+        or      a
+        jr      nz,.inf
+        ld      a,l
+        inc     a
+        jr      z,.inf
+        ld      a,b
+        and     #0x7F
+        ld      d,c
+        ld      c,l                     ; C = biased exponent
+        ld      l,a                     ; L:D = mantissa bits 22..8
+        exx
+        ld      a,b
+        exx
+        ld      e,a                     ; E = mantissa bits 7..0
+        exx
+        ld      a,c
+        exx                             ; A = guard byte
+        ld      b,-5(ix)
+        call    __fp_round_pack
+        ld      a,l
+        rla
+        ld      a,h
+        rla
+        or      a
+        jr      z,.zero                 ; did not round up to 2^-126
+.endif
+        jr      .done
+
+.zero:
+        ld      h,-5(ix)
+        ld      l,#0
+        ld      d,l
+        ld      e,l
+        jr      .done
+.inf:
+        ld      a,-5(ix)
+        or      #0x7F
+        ld      h,a
+        ld      l,#0x80
+        ld      de,#0
+.done:
+        ld      sp,ix
+        pop     ix
+        ret
+
+.no_digits:
+.if FLOAT_IEEE
+        bit     1,-6(ix)
+        jr      nz,.fail
+        ld      hl,#.s_inf
+        call    .match
+        jr      nz,.not_inf
+        ld      hl,#.s_inity
+        call    .match
+        call    .set_end
+        jr      .inf
+.not_inf:
+        ld      hl,#.s_nan
+        call    .match
+        jr      nz,.fail
+        call    .set_end
+        ld      a,-5(ix)
+        or      #0x7F
+        ld      h,a
+        ld      l,#0xC0
+        ld      de,#0
+        jr      .done
+.endif
+.fail:
+        ld      e,-4(ix)
+        ld      d,-3(ix)
+        call    .set_end
+        ld      -5(ix),#0
+        jr      .zero
+
+        ;; *end = DE unless end is 0
+        ;; clobbers: af, hl
+.set_end:
+        ld      l,-2(ix)
+        ld      h,-1(ix)
+        ld      a,h
+        or      l
+        ret     z
+        ld      (hl),e
+        inc     hl
+        ld      (hl),d
+        ret
+
+.if FLOAT_IEEE
+        ;; z and DE past the word if DE starts with the lower case word
+        ;; at HL in any case, nz and DE unchanged otherwise
+        ;; clobbers: af, c, hl
+.match:
+        push    de
+.m_next:
+        ld      a,(hl)
+        or      a
+        jr      z,.m_ok
+        ld      c,a
+        ld      a,(de)
+        or      #0x20
+        cp      c
+        jr      nz,.m_fail
+        inc     hl
+        inc     de
+        jr      .m_next
+.m_ok:
+        pop     bc
+        ret
+.m_fail:
+        pop     de
+        ret
+
+.s_inf:
+        .db     0x69, 0x6E, 0x66, 0x00  ; "inf"
+.s_inity:
+        .db     0x69, 0x6E, 0x69, 0x74, 0x79, 0x00 ; "inity"
+.s_nan:
+        .db     0x6E, 0x61, 0x6E, 0x00  ; "nan"
+.endif
@@ -0,0 +1,146 @@
+        ;; unsigned long long to float (ieee-754 single) for sdcc z80
+        ;; converts a 64-bit unsigned long long to single precision with
+        ;; rounding-to-nearest-even.
+        ;;
+        ;; values below 2^32 go to ___ulong2fs. above that only the five
+        ;; bytes from the top nonzero one down are shifted, everything
+        ;; under them is folded into one sticky byte.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   a on stack: 2(sp)..9(sp) = a0..a7 (lsb..msb)
+        ;;   callee cleans a from stack
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module ulonglong2fs
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  ___ulonglong2fs
+        .globl  __u64tofs
+        .globl  ___ulong2fs
+        .globl  __fp_retpop8
+
+        ;; ___ulonglong2fs
+        ;; inputs:  a at 2(sp)..9(sp)
+        ;; outputs: hl:de = (float)a
+        ;; clobbers: af, bc, de, hl, iy
+___ulonglong2fs:
+        ld      iy,#2
+        add     iy,sp
+        call    __u64tofs
+        jp      __fp_retpop8
+
+        ;; __u64tofs
+        ;; inputs:  IY = &a (a0..a7)
+        ;; outputs: hl:de = (float)a
+        ;; clobbers: af, bc, de, hl, iy
+__u64tofs::
+        ld      a,4(iy)
+        or      5(iy)
+        or      6(iy)
+        or      7(iy)
+        jr      nz,.wide
+        ld      e,0(iy)
+        ld      d,1(iy)
+        ld      l,2(iy)
+        ld      h,3(iy)
+        jp      ___ulong2fs
+
+.wide:
+        push    iy
+        pop     hl                      ; hl = &a[0]
+        ld      de,#7
+        add     iy,de
+        ld      c,#7                    ; c = index of the top nonzero byte
+.find:
+        ld      a,0(iy)
+        or      a
+        jr      nz,.found
+        dec     iy
+        dec     c
+        jr      .find                   ; stops at 4 at the latest
+
+.found:
+        ;; a[t] bit 7 has weight 2^(8t + 7)
+        ld      a,c
+        add     a,a
+        add     a,a
+        add     a,a
+        add     a,#134                  ; 127 + 7
+        push    af
+
+        ;; sticky = a[0] | .. | a[t-5]
+        ld      a,c
+        sub     #4
+        ld      b,a
+        ld      a,#0
+        jr      z,.sticky_done
+.sticky:
+        or      (hl)
+        inc     hl
+        djnz    .sticky
+.sticky_done:
+        ld      d,a
+
+        ;; window b:c:h:l:e = a[t]..a[t-4]
+        ld      b,0(iy)
+        ld      c,-1(iy)
+        ld      h,-2(iy)
+        ld      l,-3(iy)
+        ld      e,-4(iy)
+        pop     af                      ; a = exponent
+.norm:
+        bit     7,b
+        jr      nz,.norm_done
+        sla     e
+        adc     hl,hl
+        rl      c
+        rl      b
+        dec     a
+        jr      .norm
+.norm_done:
+        push    af
+
+        ;; kept bytes are b:c:h, l is the round byte
+        ld      a,e
+        or      d
+        ld      d,a                     ; d = sticky
+        ld      a,l
+        cp      #0x80
+        jr      c,.rounded
+        jr      nz,.round_up
+        ld      a,d
+        or      a
+        jr      nz,.round_up
+        bit     0,h
+        jr      z,.rounded
+.round_up:
+        inc     h
+        jr      nz,.rounded
+        inc     c
+        jr      nz,.rounded
+        inc     b
+        jr      nz,.rounded
+        ld      b,#0x80
+        pop     af
+        inc     a
+        push    af
+
+.rounded:
+        pop     af
+        ld      d,a                     ; d = exponent
+        ld      e,h                     ; e = byte3
+        srl     a
+        ld      h,a                     ; h = byte0
+        ld      a,b
+        and     #0x7f
+        bit     0,d
+        jr      z,.no_explsb
+        or      #0x80
+.no_explsb:
+        ld      l,a                     ; l = byte1
+        ld      d,c                     ; d = byte2
+        ret
@@ -0,0 +1,77 @@
+        ;; decimal text to 16-bit integer
+        ;;
+        ;; int atoi16(const char *s);
+        ;;
+        ;; skips leading white space, takes an optional sign and the
+        ;; digits that follow. each digit is x = x * 10 + d with shifts
+        ;; and adds, no __mulint. the result wraps modulo 2^16 like the
+        ;; C arithmetic it replaces, so "65535" gives -1.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   s in HL
+        ;;   result in DE
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module atoi16
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _atoi16
+
+        ;; _atoi16
+        ;; inputs:  hl = s
+        ;; outputs: de = value
+        ;; clobbers: af, bc, de, hl
+_atoi16:
+        ex      de, hl
+.space:
+        ld      a, (de)
+        cp      #0x20
+        jr      z, .skip
+        sub     #9                                 ; \t \n \v \f \r
+        cp      #5
+        jr      nc, .sign
+.skip:
+        inc     de
+        jr      .space
+.sign:
+        ld      a, (de)
+        cp      #0x2D                              ; '-'
+        jr      z, .neg
+        cp      #0x2B                              ; '+'
+        jr      nz, .parse
+        inc     de
+.parse:
+        ld      hl, #0
+.digit:
+        ld      a, (de)
+        sub     #0x30
+        cp      #10
+        jr      nc, .end
+        ld      b, h
+        ld      c, l
+        add     hl, hl
+        add     hl, hl
+        add     hl, bc
+        add     hl, hl                             ; x * 10
+        ld      c, a
+        ld      b, #0
+        add     hl, bc
+        inc     de
+        jr      .digit
+.end:
+        ex      de, hl
+        ret
+.neg:
+        inc     de
+        call    .parse
+        xor     a
+        sub     e
+        ld      e, a
+        sbc     a, a
+        sub     d
+        ld      d, a
+        ret
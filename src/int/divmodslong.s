@@ -0,0 +1,56 @@
+        ;; signed 32-bit division with remainder (long)
+        ;;
+        ;; one pass of __divs32 yields both trunc(x / y) and x % y
+        ;; (sign(remainder) == sign(x)).
+        ;;
+        ;; ABI (sdcccall(1), same as __divslong):
+        ;;   x (dividend) in regs:  DE = low16, HL = high16
+        ;;   y (divisor)  on stack: 2(sp)..5(sp) = y0..y3 (lsb..msb), caller pops
+        ;; returns:
+        ;;   quotient in regs:      DE = low16, HL = high16
+        ;;   remainder in shadow:   DE' = low16, HL' = high16
+        ;;
+        ;; C entry point (see include/divmod.h):
+        ;;   long ldivmod(long x, long y, long *rem);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module divmodslong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __divmodslong
+        .globl  _ldivmod
+        .globl  __divs32
+        .globl  __divmod32_ret
+        .globl  __divmod32_store
+
+        ;; __divmodslong
+        ;; inputs:  x in DE:HL (signed), y at 2(sp)..5(sp) (signed, lsb..msb)
+        ;; outputs: DE:HL = trunc(x / y), DE':HL' = x % y
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+__divmodslong:
+        pop     af                                 ; return address
+        pop     bc                                 ; bc = y low
+        pop     iy                                 ; iy = y high
+        push    iy                                 ; caller pops the argument
+        push    bc
+        push    af
+        call    __divs32
+        jp      __divmod32_ret
+
+        ;; _ldivmod
+        ;; inputs:  x in DE:HL, y at 2(sp)..5(sp), rem pointer at 6(sp)..7(sp)
+        ;; outputs: DE:HL = trunc(x / y), *rem = x % y
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+_ldivmod:
+        pop     af                                 ; return address
+        pop     bc                                 ; bc = y low
+        pop     iy                                 ; iy = y high
+        push    iy                                 ; caller pops the arguments
+        push    bc
+        push    af
+        call    __divs32
+        jp      __divmod32_store
@@ -0,0 +1,92 @@
+        ;; unsigned 32-bit division with remainder (long)
+        ;;
+        ;; one pass of __divu32 yields both x / y and x % y, so code that
+        ;; needs both (number formatting, base conversion, time splitting)
+        ;; does not pay for two divisions.
+        ;;
+        ;; ABI (sdcccall(1), same as __divulong):
+        ;;   x (dividend) in regs:  DE = low16, HL = high16
+        ;;   y (divisor)  on stack: 2(sp)..5(sp) = y0..y3 (lsb..msb), caller pops
+        ;; returns:
+        ;;   quotient in regs:      DE = low16, HL = high16
+        ;;   remainder in shadow:   DE' = low16, HL' = high16
+        ;;
+        ;; C entry point (see include/divmod.h):
+        ;;   unsigned long uldivmod(unsigned long x, unsigned long y,
+        ;;                          unsigned long *rem);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module divmodulong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __divmodulong
+        .globl  _uldivmod
+        .globl  __divu32
+
+        ;; __divmodulong
+        ;; inputs:  x in DE:HL (DE=low16, HL=high16), y at 2(sp)..5(sp) (lsb..msb)
+        ;; outputs: DE:HL = x / y, DE':HL' = x % y
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+__divmodulong:
+        pop     af                                 ; return address
+        pop     bc                                 ; bc = y low
+        pop     iy                                 ; iy = y high
+        push    iy                                 ; caller pops the argument
+        push    bc
+        push    af
+        call    __divu32
+
+        ;; __divu32 leaves quotient in de':de and remainder in hl':hl,
+        ;; swap quotient high (de') with remainder low (hl)
+__divmod32_ret::
+        push    hl
+        exx
+        push    de
+        exx
+        pop     hl
+        exx
+        pop     de
+        exx
+        ret
+
+        ;; _uldivmod
+        ;; inputs:  x in DE:HL, y at 2(sp)..5(sp), rem pointer at 6(sp)..7(sp)
+        ;; outputs: DE:HL = x / y, *rem = x % y
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+_uldivmod:
+        pop     af                                 ; return address
+        pop     bc                                 ; bc = y low
+        pop     iy                                 ; iy = y high
+        push    iy                                 ; caller pops the arguments
+        push    bc
+        push    af
+        call    __divu32
+
+        ;; store the remainder (hl':hl) through rem, return quotient
+__divmod32_store::
+        ld      iy, #6
+        add     iy, sp
+        ld      c, 0(iy)
+        ld      b, 1(iy)                           ; bc = rem
+        ld      a, l
+        ld      (bc), a
+        inc     bc
+        ld      a, h
+        ld      (bc), a
+        inc     bc
+        exx
+        push    de                                 ; quotient high
+        push    hl                                 ; remainder high
+        exx
+        pop     hl
+        ld      a, l
+        ld      (bc), a
+        inc     bc
+        ld      a, h
+        ld      (bc), a
+        pop     hl                                 ; hl = quotient high
+        ret
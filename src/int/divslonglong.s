@@ -0,0 +1,126 @@
+        ;; signed 64-bit division (long long)
+        ;;
+        ;; ABI (sdcccall(1), return values wider than 32 bits):
+        ;;   result pointer (hidden first argument) in HL
+        ;;   x (dividend) on stack: 2(sp)..9(sp)   = x0..x7 (lsb..msb)
+        ;;   y (divisor)  on stack: 10(sp)..17(sp) = y0..y7, caller pops
+        ;; returns:
+        ;;   *HL = trunc(x / y) toward zero
+        ;;
+        ;; also provides __divs64, the signed wrapper around __divu64
+        ;; shared by __divslonglong and __modslonglong.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module divslonglong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __divslonglong
+        .globl  __divs64
+        .globl  __divu64
+
+        ;; __divslonglong
+        ;; inputs:  HL = result pointer, x at 2(sp)..9(sp), y at 10(sp)..17(sp)
+        ;; outputs: *HL = trunc(x / y)
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl', iy
+__divslonglong:
+        push    hl                                 ; result pointer
+        ld      iy, #4
+        add     iy, sp                             ; iy = &x
+        call    __divs64
+        pop     de
+        push    iy
+        pop     hl
+        ld      bc, #8
+        ldir
+        ret
+
+        ;; __divs64
+        ;; inputs:  IY = &x (signed), y at 8(iy)..15(iy) (signed)
+        ;; outputs: trunc(x / y) in 0(iy)..7(iy)
+        ;;          x % y in d'e'h'l':dehl, sign(rem) = sign(x)
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl'
+        ;; notes: divides |x| by |y| in place with __divu64, then fixes
+        ;;        the signs. both arguments are the caller's copies.
+__divs64::
+        ;; a bit 7 = sign(quotient), bit 0 = sign(remainder) = sign(x)
+        ld      a, 7(iy)
+        xor     a, 15(iy)
+        and     a, #0x80
+        bit     7, 7(iy)
+        jr      z, .x_abs_done
+        inc     a
+        push    iy
+        pop     hl
+        push    af
+        call    .neg                               ; |x|
+        pop     af
+.x_abs_done:
+        bit     7, 15(iy)
+        jr      z, .y_abs_done
+        push    iy
+        pop     hl
+        ld      de, #8
+        add     hl, de
+        push    af
+        call    .neg                               ; |y|
+        pop     af
+.y_abs_done:
+        push    af
+        call    __divu64
+        pop     af
+        ld      c, a                               ; c = sign flags
+
+        bit     7, c
+        jr      z, .q_done
+        push    hl
+        push    iy
+        pop     hl
+        call    .neg                               ; quotient = -quotient
+        pop     hl
+.q_done:
+        bit     0, c
+        ret     z
+        xor     a                                  ; remainder = -remainder
+        sub     a, l
+        ld      l, a
+        ld      a, #0
+        sbc     a, h
+        ld      h, a
+        ld      a, #0
+        sbc     a, e
+        ld      e, a
+        ld      a, #0
+        sbc     a, d
+        ld      d, a
+        exx
+        ld      a, #0
+        sbc     a, l
+        ld      l, a
+        ld      a, #0
+        sbc     a, h
+        ld      h, a
+        ld      a, #0
+        sbc     a, e
+        ld      e, a
+        ld      a, #0
+        sbc     a, d
+        ld      d, a
+        exx
+        ret
+
+        ;; (hl)..(hl+7) = -(hl)..(hl+7)
+        ;; clobbers: af, b, hl
+.neg:
+        ld      b, #8
+        or      a
+.neg_loop:
+        ld      a, #0
+        sbc     a, (hl)
+        ld      (hl), a
+        inc     hl
+        djnz    .neg_loop
+        ret
@@ -2,10 +2,15 @@
         ;;
         ;; ABI (sdcccall(1), matches your build):
         ;;   dividend x in regs:  DE = low16, HL = high16
-        ;;   divisor  y on stack: 4(ix)..7(ix) = y0..y3 (lsb..msb)
+        ;;   divisor  y on stack: 2(sp)..5(sp) = y0..y3 (lsb..msb), caller pops
         ;; returns:
         ;;   quotient in DE = low16, HL = high16
         ;;
+        ;; also provides __divu32, the register-only non-restoring core
+        ;; shared by __divulong, __modulong, __divslong and __modslong.
+        ;; it keeps the low words in the main register set and the high
+        ;; words in the shadow set (exx), so the loop never touches memory.
+        ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2026 tomaz stih
         .module divulong
@@ -16,116 +21,191 @@
         .globl  __divulong_rrx_s
         .globl  __divulong_rrf_s
         .globl  __divulong
-
-        ;; locals (relative to ix):
-        ;;   -8..-5  : remainder (low..high)
-        ;;   -12..-9 : divisor y (low..high)
+        .globl  __divu32
+        .globl  __divu16
 
         ;; __divulong
-        ;; inputs:  x in DE:HL (DE=low16, HL=high16), y at 4(ix)..7(ix) (lsb..msb)
+        ;; inputs:  x in DE:HL (DE=low16, HL=high16), y at 2(sp)..5(sp) (lsb..msb)
         ;; outputs: DE:HL = unsigned quotient x / y
-        ;; clobbers: af, bc, de, hl, ix
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
 __divulong_rrx_s::
 __divulong_rrf_s::
 __divulong:
-        push    ix
-        ld      ix, #0
-        add     ix, sp
-
-        ;; save incoming x.high (HL) into BC; HL needed for frame math
-        ld      b, h
-        ld      c, l
-
-        ;; reserve 12 bytes locals
-        ld      hl, #-12
-        add     hl, sp
-        ld      sp, hl
-
-        ;; restore HL (x.high)
-        ld      h, b
-        ld      l, c
-
-        ;; normalize dividend into internal order DE:HL = high:low
-        ;; incoming: DE low, HL high -> internal: DE high, HL low
-        ex      de, hl
-
-        ;; remainder = 0
-        xor     a
-        ld      -8(ix), a
-        ld      -7(ix), a
-        ld      -6(ix), a
-        ld      -5(ix), a
-
-        ;; copy divisor y into -12..-9 from 4..7(ix) (low..high)
-        ld      a, 4(ix)
-        ld      -12(ix), a
-        ld      a, 5(ix)
-        ld      -11(ix), a
-        ld      a, 6(ix)
-        ld      -10(ix), a
-        ld      a, 7(ix)
-        ld      -9(ix), a
-
-        ;; 32 iterations, restoring division
-.run_div:
-        ;; 32 iterations, restoring division
-        ld      b, #32
+        pop     af                                 ; return address
+        pop     bc                                 ; bc = y low
+        pop     iy                                 ; iy = y high
+        push    iy                                 ; caller pops the argument
+        push    bc
+        push    af
+        call    __divu32
+        exx                                        ; quotient high is in de'
+        push    de
+        exx
+        pop     hl
+        ret
 
-.u32_div_loop:
-        ;; shift quotient (currently in de:hl) left by 1
-        add     hl, hl
+        ;; __divu32
+        ;; inputs:  x in DE:HL (DE=low16, HL=high16),
+        ;;          y in BC:IY (BC=low16, IY=high16)
+        ;; outputs: quotient  = de' (high16) : de (low16)
+        ;;          remainder = hl' (high16) : hl (low16)
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;; notes: non-restoring division. while the partial remainder is
+        ;;        >= 0 the divisor is subtracted, while it is negative it is
+        ;;        added back on the next bit instead of restoring at once.
+        ;;        that needs a 33rd remainder bit, so divisors >= 2^31 take
+        ;;        a separate path (the quotient can only be 0 or 1 there).
+        ;;        16/16 bit operands go to __divu16, leading zero bytes of
+        ;;        the dividend are skipped 8 iterations at a time.
+__divu32::
+        push    iy
+        exx
+        pop     bc                                 ; bc' = y high
+        bit     7, b
+        jp      nz, .big                           ; y >= 2^31
+        ld      a, b
+        or      a, c
+        exx
+        jr      nz, .long
+        ld      a, h
+        or      a, l
+        jr      z, .short                          ; x and y fit in 16 bits
+
+.long:
+        ;; skip leading zero bytes of x: they only shift zeros into the
+        ;; remainder and produce zero quotient bits
+        ld      a, #32                             ; a = iterations left
+.skip:
+        inc     h
+        dec     h
+        jr      nz, .split
+        cp      a, #8
+        jr      z, .split
+        ld      h, l                               ; x <<= 8
+        ld      l, d
+        ld      d, e
+        ld      e, #0
+        sub     a, #8
+        jr      .skip
+
+.split:
+        ;; main: de = x/quotient low, hl = remainder low, bc = y low
+        ;; shadow: de' = x/quotient high, hl' = remainder high, bc' = y high
+        push    hl
+        ld      hl, #0
+        exx
+        pop     de
+        ld      hl, #0
+        exx
+        or      a                                  ; no quotient bit yet
+
+        ;; remainder >= 0: shift in the next bit and subtract y
+.pos:
+        rl      e                                  ; (rem:x) <<= 1, carry = q bit
+        rl      d
+        exx
         rl      e
         rl      d
+        exx
+        adc     hl, hl
+        exx
+        adc     hl, hl                             ; carry = 0, rem < y < 2^31
+        exx
+        sbc     hl, bc                             ; rem -= y
+        exx
+        sbc     hl, bc
+        exx
+        ccf                                        ; carry = quotient bit
+        jr      nc, .pos_to_neg
+        dec     a
+        jp      nz, .pos
+        jr      .done
+
+.pos_to_neg:
+        dec     a
+        jr      z, .done_neg
+
+        ;; remainder < 0: shift in the next bit and add y
+.neg:
+        rl      e                                  ; (rem:x) <<= 1, carry = 0
+        rl      d
+        exx
+        rl      e
+        rl      d
+        exx
+        adc     hl, hl
+        exx
+        adc     hl, hl
+        exx
+        add     hl, bc                             ; rem += y
+        exx
+        adc     hl, bc
+        exx                                        ; carry = quotient bit
+        jr      c, .neg_to_pos
+        dec     a
+        jp      nz, .neg
+        jr      .done_neg
+
+.neg_to_pos:
+        dec     a
+        jp      nz, .pos
+
+.done:
+        rl      e                                  ; shift in the last q bit
+        rl      d
+        exx
+        rl      e
+        rl      d
+        exx
+        ret
 
-        ;; remainder <<= 1, bring in carry from dividend shift
-        rl      -8(ix)
-        rl      -7(ix)
-        rl      -6(ix)
-        rl      -5(ix)
-
-        ;; try remainder -= divisor
-        or      a                                  ; clear carry
-        ld      a, -8(ix)
-        sbc     a, -12(ix)
-        ld      -8(ix), a
-        ld      a, -7(ix)
-        sbc     a, -11(ix)
-        ld      -7(ix), a
-        ld      a, -6(ix)
-        sbc     a, -10(ix)
-        ld      -6(ix), a
-        ld      a, -5(ix)
-        sbc     a, -9(ix)
-        ld      -5(ix), a
-        jr      nc, .keep_sub
-
-        ;; borrow -> restore remainder (add divisor back)
-        or      a                                  ; CLEAR carry before adc!
-        ld      a, -8(ix)
-        adc     a, -12(ix)
-        ld      -8(ix), a
-        ld      a, -7(ix)
-        adc     a, -11(ix)
-        ld      -7(ix), a
-        ld      a, -6(ix)
-        adc     a, -10(ix)
-        ld      -6(ix), a
-        ld      a, -5(ix)
-        adc     a, -9(ix)
-        ld      -5(ix), a
-        jr      .next_bit
-
-.keep_sub:
-        set     0, l
-
-.next_bit:
-        djnz    .u32_div_loop
+.done_neg:
+        rl      e                                  ; last q bit is 0
+        rl      d
+        exx
+        rl      e
+        rl      d
+        exx
+        add     hl, bc                             ; final remainder += y
+        exx
+        adc     hl, bc
+        exx
+        ret
 
-.finish:
-        ;; quotient currently internal (DE high, HL low) -> ABI wants (DE low, HL high)
+.short:
+        ;; 16/16 bit: de = quotient, hl = remainder, high words zero
         ex      de, hl
+        ld      d, b
+        ld      e, c
+        call    __divu16
+        exx
+        ld      de, #0
+        ld      hl, #0
+        exx
+        ret
 
-        ;; tear down frame
-        ld      sp, ix
-        pop     ix
+.big:
+        ;; y >= 2^31 (shadow set active): q = (x >= y), rem = x - q * y
+        exx
+        push    hl                                 ; x high
+        ld      h, d
+        ld      l, e
+        or      a
+        sbc     hl, bc                             ; hl = x low - y low
+        exx
+        pop     de                                 ; de' = x high
+        ld      h, d
+        ld      l, e
+        sbc     hl, bc                             ; hl' = x high - y high
+        jr      nc, .big_one
+        ex      de, hl                             ; x < y: rem = x, q = 0
+        ld      de, #0
+        exx
+        ex      de, hl
+        ld      de, #0
+        ret
+.big_one:
+        ld      de, #0                             ; q = 1, rem = x - y
+        exx
+        ld      de, #1
         ret
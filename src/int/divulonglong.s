@@ -0,0 +1,460 @@
+        ;; unsigned 64-bit division (long long)
+        ;;
+        ;; ABI (sdcccall(1), return values wider than 32 bits):
+        ;;   result pointer (hidden first argument) in HL
+        ;;   x (dividend) on stack: 2(sp)..9(sp)   = x0..x7 (lsb..msb)
+        ;;   y (divisor)  on stack: 10(sp)..17(sp) = y0..y7, caller pops
+        ;; returns:
+        ;;   *HL = x / y
+        ;;
+        ;; also provides __divu64, the core shared by __divulonglong,
+        ;; __modulonglong, __divslonglong and __modslonglong. it divides
+        ;; x in place, so the wrappers hand it their own stack arguments.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module divulonglong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __divulonglong
+        .globl  __divu64
+        .globl  __divu32
+
+        ;; __divulonglong
+        ;; inputs:  HL = result pointer, x at 2(sp)..9(sp), y at 10(sp)..17(sp)
+        ;; outputs: *HL = x / y
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+__divulonglong:
+        push    hl                                 ; result pointer
+        ld      iy, #4
+        add     iy, sp                             ; iy = &x
+        call    __divu64
+        pop     de
+        push    iy
+        pop     hl
+        ld      bc, #8
+        ldir
+        ret
+
+        ;; __divu64
+        ;; inputs:  IY = &x (x0..x7), y at 8(iy)..15(iy)
+        ;; outputs: x / y in 0(iy)..7(iy)
+        ;;          x % y in d'e'h'l':dehl (msb..lsb)
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl'
+        ;; notes: picks the cheapest of four paths:
+        ;;        - x and y fit in 32 bits: one __divu32.
+        ;;        - y fits in 16 bits: one __divu32 per 16-bit word of x,
+        ;;          the remainder of a word is the high half of the next.
+        ;;        - y >= 2^63: the quotient is 0 or 1.
+        ;;        - else non-restoring division as in __divu32, with the
+        ;;          remainder in registers. the top (bytes of y - 1) bytes
+        ;;          of x are below y, so they preload the remainder and
+        ;;          only the bytes under them are shifted in bit by bit.
+__divu64::
+        ld      a, 4(iy)                           ; x, y < 2^32?
+        or      a, 5(iy)
+        or      a, 6(iy)
+        or      a, 7(iy)
+        or      a, 12(iy)
+        or      a, 13(iy)
+        or      a, 14(iy)
+        or      a, 15(iy)
+        jp      z, .by_long
+
+        push    iy
+        pop     hl
+        ld      de, #15
+        add     hl, de                             ; hl = &y[7]
+        call    .bytes
+        ld      c, b                               ; c = bytes of y
+        push    iy
+        pop     hl
+        ld      de, #7
+        add     hl, de                             ; hl = &x[7]
+        call    .bytes
+        ld      a, b
+        ld      b, c
+        ld      c, a                               ; b = bytes of y, c = of x
+
+        ld      a, b
+        cp      a, #3
+        jp      c, .by_word                        ; y < 2^16
+        bit     7, 15(iy)
+        jp      nz, .big                           ; y >= 2^63
+        ld      a, c
+        cp      a, b
+        jp      c, .x_small                        ; fewer bytes than y: x < y
+
+        ;; ---- generic: m = bytes of y - 1, k = bytes of x - m ----
+        dec     b                                  ; b = m (2..7)
+        sub     a, b                               ; a = k (1..6)
+        ex      af, af'                            ; a' = k
+        ld      hl, #0                             ; 8 zero bytes for the
+        push    hl                                 ; preloaded remainder
+        push    hl
+        push    hl
+        push    hl
+        add     hl, sp
+        ex      de, hl                             ; de = scratch
+        ex      af, af'
+        ld      c, a
+        ex      af, af'
+        push    iy
+        pop     hl
+        ld      a, l
+        add     a, c
+        ld      l, a
+        jr      nc, .pre_src
+        inc     h                                  ; hl = &x[k]
+.pre_src:
+        ld      c, b
+        ld      b, #0
+        ldir                                       ; scratch[0..m-1] = x[k..]
+
+        ;; x[0..k-1] to the top of the buffer, zeros below
+        push    iy
+        pop     hl
+        ld      de, #7
+        add     hl, de
+        ex      de, hl                             ; de = &x[7]
+        ex      af, af'
+        ld      c, a                               ; bc = k
+        ex      af, af'
+        push    iy
+        pop     hl
+        add     hl, bc
+        dec     hl                                 ; hl = &x[k-1]
+        lddr
+        ex      de, hl                             ; hl = &x[7-k]
+        ex      af, af'
+        ld      b, a
+        ex      af, af'
+        ld      a, #8
+        sub     a, b
+        ld      b, a                               ; b = 8 - k
+.gen_zero:
+        ld      (hl), #0
+        dec     hl
+        djnz    .gen_zero
+
+        pop     hl                                 ; remainder = scratch
+        pop     de
+        exx
+        pop     hl
+        pop     de
+        exx
+        ex      af, af'
+        add     a, a
+        add     a, a
+        add     a, a
+        ld      b, a                               ; b = 8k iterations
+        or      a                                  ; no quotient bit yet
+
+        ;; remainder >= 0: shift in the next bit and subtract y
+.pos:
+        rl      0(iy)                              ; quotient bit in,
+        rl      1(iy)                              ; next bit of x out
+        rl      2(iy)
+        rl      3(iy)
+        rl      4(iy)
+        rl      5(iy)
+        rl      6(iy)
+        rl      7(iy)
+        adc     hl, hl                             ; rem = rem * 2 + bit
+        rl      e
+        rl      d
+        exx
+        adc     hl, hl
+        rl      e
+        rl      d                                  ; carry = 0, rem < y < 2^63
+        exx
+        ld      a, l                               ; rem -= y
+        sub     a, 8(iy)
+        ld      l, a
+        ld      a, h
+        sbc     a, 9(iy)
+        ld      h, a
+        ld      a, e
+        sbc     a, 10(iy)
+        ld      e, a
+        ld      a, d
+        sbc     a, 11(iy)
+        ld      d, a
+        exx
+        ld      a, l
+        sbc     a, 12(iy)
+        ld      l, a
+        ld      a, h
+        sbc     a, 13(iy)
+        ld      h, a
+        ld      a, e
+        sbc     a, 14(iy)
+        ld      e, a
+        ld      a, d
+        sbc     a, 15(iy)
+        ld      d, a
+        exx
+        ccf                                        ; carry = quotient bit
+        jr      nc, .pos_to_neg
+        dec     b
+        jp      nz, .pos
+        jp      .done
+
+.pos_to_neg:
+        dec     b
+        jp      z, .done_neg
+
+        ;; remainder < 0: shift in the next bit and add y
+.neg:
+        rl      0(iy)
+        rl      1(iy)
+        rl      2(iy)
+        rl      3(iy)
+        rl      4(iy)
+        rl      5(iy)
+        rl      6(iy)
+        rl      7(iy)
+        adc     hl, hl
+        rl      e
+        rl      d
+        exx
+        adc     hl, hl
+        rl      e
+        rl      d
+        exx
+        ld      a, l                               ; rem += y
+        add     a, 8(iy)
+        ld      l, a
+        ld      a, h
+        adc     a, 9(iy)
+        ld      h, a
+        ld      a, e
+        adc     a, 10(iy)
+        ld      e, a
+        ld      a, d
+        adc     a, 11(iy)
+        ld      d, a
+        exx
+        ld      a, l
+        adc     a, 12(iy)
+        ld      l, a
+        ld      a, h
+        adc     a, 13(iy)
+        ld      h, a
+        ld      a, e
+        adc     a, 14(iy)
+        ld      e, a
+        ld      a, d
+        adc     a, 15(iy)
+        ld      d, a
+        exx                                        ; carry = quotient bit
+        jr      c, .neg_to_pos
+        dec     b
+        jp      nz, .neg
+        jr      .done_neg
+
+.neg_to_pos:
+        dec     b
+        jp      nz, .pos
+
+.done:
+        call    .shift_q                           ; shift in the last q bit
+        ret
+
+.done_neg:
+        call    .shift_q                           ; last q bit is 0
+        jp      .add_y                             ; final remainder += y
+
+        ;; ---- x and y below 2^32 ----
+.by_long:
+        push    iy
+        ld      c, 8(iy)
+        ld      b, 9(iy)
+        ld      l, 10(iy)
+        ld      h, 11(iy)
+        ld      e, 0(iy)
+        ld      d, 1(iy)
+        push    hl
+        ld      l, 2(iy)
+        ld      h, 3(iy)
+        pop     iy                                 ; iy = y high
+        call    __divu32
+        pop     iy
+        ld      0(iy), e                           ; x[4..7] are zero already
+        ld      1(iy), d
+        exx
+        ld      2(iy), e
+        ld      3(iy), d
+        push    hl
+        ld      hl, #0
+        ld      de, #0
+        exx
+        pop     de                                 ; remainder high
+        ret
+
+        ;; ---- y below 2^16, x at least 5 bytes: word by word ----
+.by_word:
+        ld      a, c
+        inc     a
+        srl     a                                  ; a = words of x (3, 4)
+        ld      c, 8(iy)
+        ld      b, 9(iy)                           ; bc = y
+        push    iy
+        ld      e, a
+        ld      d, #0
+        add     iy, de
+        add     iy, de                             ; iy = past the top word
+        ld      hl, #0                             ; remainder
+.word:
+        dec     iy
+        dec     iy
+        push    af
+        push    bc
+        push    iy
+        ld      e, 0(iy)
+        ld      d, 1(iy)
+        ld      iy, #0
+        call    __divu32                           ; (rem:word) / y, rem < y
+        pop     iy
+        ld      0(iy), e
+        ld      1(iy), d
+        pop     bc
+        pop     af
+        dec     a
+        jr      nz, .word
+        pop     iy
+        ld      de, #0
+        exx
+        ld      hl, #0
+        ld      de, #0
+        exx
+        ret
+
+        ;; ---- y >= 2^63: q = (x >= y), rem = x - q * y ----
+.big:
+        call    .load_x
+        call    .sub_y
+        ld      a, #1
+        jr      nc, .set_q
+        call    .add_y                             ; x < y: rem = x
+        xor     a
+.set_q:
+        ld      0(iy), a
+        xor     a
+        ld      1(iy), a
+        ld      2(iy), a
+        ld      3(iy), a
+        ld      4(iy), a
+        ld      5(iy), a
+        ld      6(iy), a
+        ld      7(iy), a
+        ret
+
+        ;; ---- x < y: q = 0, rem = x ----
+.x_small:
+        call    .load_x
+        xor     a
+        jr      .set_q
+
+        ;; remainder registers = x
+.load_x:
+        ld      l, 0(iy)
+        ld      h, 1(iy)
+        ld      e, 2(iy)
+        ld      d, 3(iy)
+        exx
+        ld      l, 4(iy)
+        ld      h, 5(iy)
+        ld      e, 6(iy)
+        ld      d, 7(iy)
+        exx
+        ret
+
+        ;; remainder registers -= y, carry = borrow
+.sub_y:
+        ld      a, l
+        sub     a, 8(iy)
+        ld      l, a
+        ld      a, h
+        sbc     a, 9(iy)
+        ld      h, a
+        ld      a, e
+        sbc     a, 10(iy)
+        ld      e, a
+        ld      a, d
+        sbc     a, 11(iy)
+        ld      d, a
+        exx
+        ld      a, l
+        sbc     a, 12(iy)
+        ld      l, a
+        ld      a, h
+        sbc     a, 13(iy)
+        ld      h, a
+        ld      a, e
+        sbc     a, 14(iy)
+        ld      e, a
+        ld      a, d
+        sbc     a, 15(iy)
+        ld      d, a
+        exx
+        ret
+
+        ;; remainder registers += y
+.add_y:
+        ld      a, l
+        add     a, 8(iy)
+        ld      l, a
+        ld      a, h
+        adc     a, 9(iy)
+        ld      h, a
+        ld      a, e
+        adc     a, 10(iy)
+        ld      e, a
+        ld      a, d
+        adc     a, 11(iy)
+        ld      d, a
+        exx
+        ld      a, l
+        adc     a, 12(iy)
+        ld      l, a
+        ld      a, h
+        adc     a, 13(iy)
+        ld      h, a
+        ld      a, e
+        adc     a, 14(iy)
+        ld      e, a
+        ld      a, d
+        adc     a, 15(iy)
+        ld      d, a
+        exx
+        ret
+
+        ;; quotient <<= 1, carry in
+.shift_q:
+        rl      0(iy)
+        rl      1(iy)
+        rl      2(iy)
+        rl      3(iy)
+        rl      4(iy)
+        rl      5(iy)
+        rl      6(iy)
+        rl      7(iy)
+        ret
+
+        ;; .bytes
+        ;; inputs:  hl = address of the top byte of an 8-byte value
+        ;; outputs: b = number of significant bytes (0..8)
+        ;; clobbers: af, hl
+.bytes:
+        ld      b, #8
+.bytes_loop:
+        ld      a, (hl)
+        or      a
+        ret     nz
+        dec     hl
+        djnz    .bytes_loop
+        ret
@@ -0,0 +1,147 @@
+        ;; integer square roots, shift-subtract core
+        ;; provides isqrt16 and isqrt32, floor(sqrt(x))
+        ;;
+        ;; the root is built one bit per step, like the quotient of
+        ;; __divuint: two bits of x are shifted into the remainder r and
+        ;; the trial value 4 q + 1 is subtracted, the root bit is 1 when
+        ;; that does not borrow, otherwise r is restored. q is kept as
+        ;; 4 q so the + 1 comes from the carry flag (scf, sbc).
+        ;;
+        ;; isqrt32 runs the high word through the 16-bit steps of isqrt16
+        ;; (r and 4 q stay below 2^16 for the first 8 root bits) and only
+        ;; the low word through 32-bit steps.
+        ;;
+        ;; C entry points (see include/sqrt.h), sdcccall(1):
+        ;;   unsigned char isqrt16(unsigned int x);
+        ;;   unsigned int isqrt32(unsigned long x);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module isqrt
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _isqrt16
+        .globl  _isqrt32
+
+        ;; _isqrt16
+        ;; inputs:  hl = x
+        ;; outputs: a = floor(sqrt(x))
+        ;; clobbers: af, bc, de, hl
+_isqrt16:
+        ex      de, hl                             ; de = x
+        call    .root8
+        srl     b
+        rr      c
+        srl     b
+        rr      c
+        ld      a, c                               ; q = 4 q / 4
+        ret
+
+        ;; _isqrt32
+        ;; inputs:  x in HL:DE (HL=high16, DE=low16)
+        ;; outputs: de = floor(sqrt(x))
+        ;; clobbers: af, bc, de, hl, bc', de', hl'
+_isqrt32:
+        push    de                                 ; x low
+        ex      de, hl
+        call    .root8                             ; root bits 15..8
+        push    hl
+        push    bc
+        exx
+        pop     de                                 ; de' = 4 q
+        pop     hl                                 ; hl' = r
+        pop     bc                                 ; bc' = x low
+        exx
+        ld      hl, #0
+        ld      d, h
+        ld      e, l
+        ld      b, #8
+.loop32:
+        exx
+        sla     c
+        rl      b
+        adc     hl, hl
+        exx
+        adc     hl, hl
+        exx
+        sla     c
+        rl      b
+        adc     hl, hl
+        exx
+        adc     hl, hl                             ; r = 4 r + next two bits
+        scf
+        exx
+        sbc     hl, de
+        exx
+        sbc     hl, de                             ; r - (4 q + 1)
+        jr      c, .zero32
+        exx
+        sla     e
+        rl      d
+        set     2, e
+        exx
+        rl      e
+        rl      d                                  ; 4 q = 4 (2 q + 1)
+        djnz    .loop32
+        jr      .done32
+.zero32:
+        exx
+        adc     hl, de
+        exx
+        adc     hl, de                             ; cf set: r restored
+        exx
+        sla     e
+        rl      d
+        exx
+        rl      e
+        rl      d                                  ; 4 q = 4 (2 q)
+        djnz    .loop32
+.done32:
+        ld      a, e                               ; 4 q < 2^18
+        exx
+        rra
+        rr      d
+        rr      e
+        rra
+        rr      d
+        rr      e                                  ; q = 4 q / 4
+        push    de
+        exx
+        pop     de
+        ret
+
+        ;; 8 root bits from the 16 bits in de
+        ;; inputs:  de = radicand bits
+        ;; outputs: bc = 4 q, hl = r
+        ;; clobbers: af, de
+.root8:
+        ld      hl, #0                             ; r = 0
+        ld      b, h
+        ld      c, l                               ; 4 q = 0
+        ld      a, #8
+.loop16:
+        sla     e
+        rl      d
+        adc     hl, hl
+        sla     e
+        rl      d
+        adc     hl, hl                             ; r = 4 r + next two bits
+        scf
+        sbc     hl, bc                             ; r - (4 q + 1)
+        jr      c, .zero16
+        sla     c
+        rl      b
+        set     2, c                               ; 4 q = 4 (2 q + 1)
+        dec     a
+        jr      nz, .loop16
+        ret
+.zero16:
+        adc     hl, bc                             ; cf set: r restored
+        sla     c
+        rl      b                                  ; 4 q = 4 (2 q)
+        dec     a
+        jr      nz, .loop16
+        ret
@@ -0,0 +1,41 @@
+        ;; signed 64-bit modulus (long long)
+        ;;
+        ;; ABI (sdcccall(1), return values wider than 32 bits):
+        ;;   result pointer (hidden first argument) in HL
+        ;;   x (dividend) on stack: 2(sp)..9(sp)   = x0..x7 (lsb..msb)
+        ;;   y (divisor)  on stack: 10(sp)..17(sp) = y0..y7, caller pops
+        ;; returns:
+        ;;   *HL = x % y, with the sign of x (C semantics)
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module modslonglong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __modslonglong
+        .globl  __divs64
+
+        ;; __modslonglong
+        ;; inputs:  HL = result pointer, x at 2(sp)..9(sp), y at 10(sp)..17(sp)
+        ;; outputs: *HL = x % y
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl', iy
+__modslonglong:
+        push    hl                                 ; result pointer
+        ld      iy, #4
+        add     iy, sp                             ; iy = &x
+        call    __divs64                           ; quotient lands in x
+        pop     iy
+        ld      0(iy), l
+        ld      1(iy), h
+        ld      2(iy), e
+        ld      3(iy), d
+        exx
+        ld      4(iy), l
+        ld      5(iy), h
+        ld      6(iy), e
+        ld      7(iy), d
+        exx
+        ret
@@ -7,12 +7,20 @@
         ;;   multiplier in bc (shift right), early-out when bc==0
         ;; optional swap to make multiplier smaller -> fewer iterations
         ;;
+        ;; with FAST_MUL=quarter (see config.inc) __mul16 is built from
+        ;; three lookups in the quarter-square table of mul8.s instead:
+        ;;   lo16(bc * de) = c * e + ((c * d + b * e) << 8)
+        ;; where only the low byte of the two cross products is needed.
+        ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright 2009-2010 philipp klaus krause
         ;; copytight 2026 tomaz stih
 
         .module mul
         .optsdcc -mz80 sdcccall(1)
+
+        .include "config.inc"
+
         .area   _CODE
 
         .globl  __mulint_rrx_s
@@ -35,6 +43,80 @@ __mulint:
         ;; inputs:  bc = multiplicand, de = multiplier
         ;; outputs: de = product low 16
         ;; clobbers: a, b, c, h, l, f
+.if FAST_MUL_QUARTER
+        .globl  __qsq_lo
+
+__mul16:
+        ;; d = lo8(c * d)
+        ld      a, c
+        sub     a, d
+        jr      nc, .cd_diff
+        neg
+.cd_diff:
+        ld      l, a
+        ld      h, #>__qsq_lo
+        ld      a, c
+        add     a, d                               ; cf = bit 8 of c + d
+        ld      d, (hl)                            ; d = lo8(sq4(|c - d|))
+        ld      l, a
+        ld      a, #>__qsq_lo
+        adc     a, #0
+        ld      h, a
+        ld      a, (hl)
+        sub     a, d
+        ld      d, a
+
+        ;; d += lo8(b * e)
+        ld      a, b
+        sub     a, e
+        jr      nc, .be_diff
+        neg
+.be_diff:
+        ld      l, a
+        ld      h, #>__qsq_lo
+        ld      a, b
+        add     a, e
+        ld      b, (hl)                            ; b = lo8(sq4(|b - e|))
+        ld      l, a
+        ld      a, #>__qsq_lo
+        adc     a, #0
+        ld      h, a
+        ld      a, (hl)
+        sub     a, b
+        add     a, d
+        ld      d, a                               ; d = cross term
+
+        ;; de = c * e + (d << 8)
+        ld      a, c
+        sub     a, e
+        jr      nc, .ce_diff
+        neg
+.ce_diff:
+        ld      l, a
+        ld      h, #>__qsq_lo
+        ld      a, c
+        add     a, e
+        ld      b, (hl)
+        inc     h                                  ; inc keeps cf
+        inc     h
+        ld      c, (hl)                            ; c:b = sq4(|c - e|)
+        ld      l, a
+        ld      a, #>__qsq_lo
+        adc     a, #0
+        ld      h, a                               ; hl -> sq4(c + e)
+        ld      a, (hl)
+        sub     a, b
+        ld      e, a
+        inc     h                                  ; inc keeps cf for sbc
+        inc     h
+        ld      a, (hl)
+        sbc     a, c
+        add     a, d
+        ld      d, a
+        ret
+
+.else
+
 __mul16:
         ;; quick zero checks
         ld      a, b
@@ -95,3 +177,5 @@ __mul16:
         ld      d, a
         ld      e, a
         ret
+
+.endif
@@ -1,6 +1,11 @@
         ;; multiplication shims for signed/unsigned 8×8→16 bit
         ;; prepares operands in bc and de, then tail-calls __mul16
         ;;
+        ;; with FAST_MUL=quarter (see config.inc) the operands are
+        ;; multiplied unsigned by the table-driven __mul8x8 instead and
+        ;; the sign is fixed up in the high byte:
+        ;;   lo16(a * b) = ua * ub - ((a < 0 ? ub : 0) + (b < 0 ? ua : 0)) << 8
+        ;;
         ;; loosely based on code from sdcc project
         ;;
         ;; gpl-2.0-or-later (see: LICENSE)
@@ -9,6 +14,9 @@
 
         .module mulchar                            ; module name
         .optsdcc -mz80 sdcccall(1)
+
+        .include "config.inc"
+
         .area   _CODE                              ; code segment
 
         .globl  __mulsuchar_rrx_s
@@ -20,6 +28,67 @@
         .globl  __mulschar_rrx_s
         .globl  __mulschar_rrf_s
         .globl  __mulschar
+
+.if FAST_MUL_QUARTER
+        .globl  __mul8x8                           ; imported
+
+        ;; __muluschar
+        ;; inputs:  a = signed lhs, l = unsigned rhs
+        ;; outputs: de = 16-bit product
+        ;; clobbers: a, b, c, d, e, h, l, f
+__muluschar_rrx_s::
+__muluschar_rrf_s::
+__muluschar:
+        ld      h, a
+        rlca
+        sbc     a, a                               ; a = 00/ff from lhs sign
+        and     a, l
+        ld      c, a                               ; c = high byte correction
+        jr      .fixup
+
+        ;; __mulsuchar
+        ;; inputs:  a = unsigned lhs, l = signed rhs
+        ;; outputs: de = 16-bit product
+        ;; clobbers: a, b, c, d, e, h, l, f
+__mulsuchar_rrx_s::
+__mulsuchar_rrf_s::
+__mulsuchar:
+        ld      h, a
+        ld      a, l
+        rlca
+        sbc     a, a                               ; a = 00/ff from rhs sign
+        and     a, h
+        ld      c, a                               ; c = high byte correction
+        jr      .fixup
+
+        ;; __mulschar
+        ;; inputs:  a = signed lhs, l = signed rhs
+        ;; outputs: de = 16-bit product
+        ;; clobbers: a, b, c, d, e, h, l, f
+__mulschar_rrx_s::
+__mulschar_rrf_s::
+__mulschar:
+        ld      h, a
+        rlca
+        sbc     a, a
+        and     a, l
+        ld      c, a                               ; c = lhs < 0 ? rhs : 0
+        ld      a, l
+        rlca
+        sbc     a, a
+        and     a, h
+        add     a, c
+        ld      c, a                               ; c += rhs < 0 ? lhs : 0
+
+.fixup:
+        call    __mul8x8                           ; hl = unsigned l * h
+        ld      a, h
+        sub     a, c
+        ld      d, a
+        ld      e, l
+        ret
+
+.else
         .globl  __mul16                            ; imported
 
         ;; __muluschar
@@ -78,3 +147,5 @@ __mulschar:
 
         ;; tail-call: (bc) × (de) -> de (low 16 bits)
         jp      __mul16
+
+.endif
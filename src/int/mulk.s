@@ -0,0 +1,191 @@
+        ;; 16-bit multiply by small constants
+        ;; unrolled shift/add sequences for the multipliers that show up in
+        ;; screen address and decimal code, in place of __mulint(x, k)
+        ;;
+        ;; every entry takes x in hl and returns the low 16 bits of x * k
+        ;; in de, like __mulint, so the result is the same for signed and
+        ;; unsigned x. the C prototypes are in include/mulk.h.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module mulk
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _mul16_3
+        .globl  _mul16_5
+        .globl  _mul16_6
+        .globl  _mul16_10
+        .globl  _mul16_12
+        .globl  _mul16_24
+        .globl  _mul16_40
+        .globl  _mul16_80
+        .globl  _mul16_100
+        .globl  _mul16_160
+        .globl  _mul16_320
+        .globl  _mul16_1000
+
+        ;; _mul16_3 .. _mul16_160
+        ;; inputs:  hl = x
+        ;; outputs: de = x * k (low 16)
+        ;; clobbers: f, h, l
+_mul16_3:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, de                             ; 3x
+        ex      de, hl
+        ret
+
+_mul16_5:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, hl
+        add     hl, de                             ; 5x
+        ex      de, hl
+        ret
+
+_mul16_6:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, de                             ; 3x
+        add     hl, hl
+        ex      de, hl
+        ret
+
+_mul16_10:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, hl
+        add     hl, de                             ; 5x
+        add     hl, hl
+        ex      de, hl
+        ret
+
+_mul16_12:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, de                             ; 3x
+        add     hl, hl
+        add     hl, hl
+        ex      de, hl
+        ret
+
+_mul16_24:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, de                             ; 3x
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        ex      de, hl
+        ret
+
+_mul16_40:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, hl
+        add     hl, de                             ; 5x
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        ex      de, hl
+        ret
+
+_mul16_80:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, hl
+        add     hl, de                             ; 5x
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        ex      de, hl
+        ret
+
+_mul16_100:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, de                             ; 3x
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        add     hl, de                             ; 25x
+        add     hl, hl
+        add     hl, hl
+        ex      de, hl
+        ret
+
+_mul16_160:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, hl
+        add     hl, de                             ; 5x
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        ex      de, hl
+        ret
+
+        ;; _mul16_320
+        ;; inputs:  hl = x
+        ;; outputs: de = x * 320 (low 16)
+        ;; clobbers: af, h, l
+        ;; notes: 5x << 6 is taken as (5x >> 2) << 8 plus the two bits
+        ;;        that fall off, cheaper than six adds
+_mul16_320:
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, hl
+        add     hl, de                             ; 5x
+        xor     a
+        srl     h
+        rr      l
+        rra
+        srl     h
+        rr      l
+        rra                                        ; a = bits 1..0 of 5x << 6
+        ld      d, l
+        ld      e, a
+        ret
+
+        ;; _mul16_1000
+        ;; inputs:  hl = x
+        ;; outputs: de = x * 1000 (low 16)
+        ;; clobbers: af, c, h, l
+        ;; notes: x * 1024 - x * 24, the first term is just (x << 2) << 8
+_mul16_1000:
+        ld      c, l
+        ld      d, h
+        ld      e, l
+        add     hl, hl
+        add     hl, de                             ; 3x
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl                             ; 24x
+        ld      a, c
+        add     a, a
+        add     a, a
+        ld      d, a                               ; d = lo8(x << 2)
+        xor     a
+        sub     a, l
+        ld      e, a
+        ld      a, d
+        sbc     a, h
+        ld      d, a
+        ret
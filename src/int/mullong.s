@@ -1,14 +1,20 @@
-        ;; signed 32-bit multiply (low 32 bits)
+        ;; 32-bit multiply (low 32 bits, same for signed and unsigned)
         ;;
-        ;; ABI (confirmed from caller):
+        ;; ABI (sdcccall(1), matches your build):
         ;;   a in regs:  DE = low16, HL = high16
-        ;;   b on stack: 4(ix)..7(ix) = b0..b3 (lsb..msb)
+        ;;   b on stack: 2(sp)..5(sp) = b0..b3 (lsb..msb), caller pops
         ;; returns:
         ;;   DE = low16, HL = high16
         ;;
-        ;; implementation uses internal order DE:HL = high:low
-        ;; (bytes l,h,e,d are lsb..msb), so we swap at entry and swap
-        ;; back at return.
+        ;; the low 32 bits of a two's complement product need no sign
+        ;; handling, so it is built from 16-bit halves:
+        ;;   a * b = a.lo * b.lo + ((a.hi * b.lo + a.lo * b.hi) << 16)
+        ;; with ___muluint2ulong for the full 16x16 -> 32 product and
+        ;; __mul16 (low 16 bits only) for the two cross terms.
+        ;;
+        ;; operands that fit in 16 bits skip the cross terms: both high
+        ;; words zero take one ___muluint2ulong, both high words a sign
+        ;; extension of the low word take one ___mulsint2slong.
         ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2026 tomaz stih
@@ -20,168 +26,70 @@
         .globl  __mullong_rrx_s
         .globl  __mullong_rrf_s
         .globl  __mullong
-
-        ;; locals:
-        ;;  -12..-9 : multiplier |b| (low..high)
-        ;;  -8..-5  : accumulator (low 32)
-        ;;  -13     : sign flag
+        .globl  __mul16
+        .globl  ___muluint2ulong
+        .globl  ___mulsint2slong
 
         ;; __mullong
-        ;; inputs:  a in DE:HL, b at 4(ix)..7(ix) (lsb..msb)
-        ;; outputs: DE:HL = low 32 bits of signed product
-        ;; clobbers: af, bc, de, hl, ix
+        ;; inputs:  a in DE:HL (DE=low16, HL=high16), b at 2(sp)..5(sp) (lsb..msb)
+        ;; outputs: DE:HL = low 32 bits of a * b (DE=low16, HL=high16)
+        ;; clobbers: af, bc, de, hl, iy
 __mullong_rrx_s::
 __mullong_rrf_s::
 __mullong:
-        push    ix
-        ld      ix, #0
-        add     ix, sp
-
-        ;; save incoming a.high (HL) into BC, because HL is needed for
-        ;; stack frame arithmetic below.
-        ld      b, h
-        ld      c, l
-
-        ;; reserve 13 bytes locals using HL as scratch
-        ld      hl, #-13
-        add     hl, sp
-        ld      sp, hl
-
-        ;; restore incoming a.high back into HL
-        ld      h, b
-        ld      l, c
-
-        ;; now normalize a from ABI order (DE low, HL high)
-        ;; into internal order (DE high, HL low)
-        ex      de, hl
-
-        ;; sign = sign(a) xor sign(b)
-        xor     a
-        ld      -13(ix), a
-        bit     7, d                                ; sign(a) after swap
-        jr      z, .a_nonneg
-        ld      -13(ix), #1
-.a_nonneg:
-        bit     7, 7(ix)                             ; b msb is at 7(ix)
-        jr      z, .sign_done
-        ld      a, -13(ix)
-        xor     #1
-        ld      -13(ix), a
-.sign_done:
-
-        ;; abs(a) if negative (a in de:hl = high:low)
-        bit     7, d
-        jr      z, .abs_a_done
-        xor     a
-        sub     a, l
-        ld      l, a
-        ld      a, #0
-        sbc     a, h
-        ld      h, a
-        ld      a, #0
-        sbc     a, e
-        ld      e, a
-        ld      a, #0
-        sbc     a, d
-        ld      d, a
-.abs_a_done:
-
-        ;; copy b from stack 4..7 into locals -12..-9 (low..high)
-        ld      a, 4(ix)
-        ld      -12(ix), a
-        ld      a, 5(ix)
-        ld      -11(ix), a
-        ld      a, 6(ix)
-        ld      -10(ix), a
-        ld      a, 7(ix)
-        ld      -9(ix), a
-
-        ;; abs(b) if negative
-        bit     7, -9(ix)
-        jr      z, .abs_b_done
-        xor     a
-        sub     a, -12(ix)
-        ld      -12(ix), a
-        ld      a, #0
-        sbc     a, -11(ix)
-        ld      -11(ix), a
-        ld      a, #0
-        sbc     a, -10(ix)
-        ld      -10(ix), a
-        ld      a, #0
-        sbc     a, -9(ix)
-        ld      -9(ix), a
-.abs_b_done:
-
-        ;; acc = 0
-        xor     a
-        ld      -8(ix), a
-        ld      -7(ix), a
-        ld      -6(ix), a
-        ld      -5(ix), a
-
-        ;; shift-add 32 iterations
-        ld      b, #32
-.mul_loop:
-        bit     0, -12(ix)
-        jr      z, .no_add
-
-        ;; acc += multiplicand (bytes l,h,e,d)
-        ld      a, -8(ix)
-        add     a, l
-        ld      -8(ix), a
-        ld      a, -7(ix)
-        adc     a, h
-        ld      -7(ix), a
-        ld      a, -6(ix)
-        adc     a, e
-        ld      -6(ix), a
-        ld      a, -5(ix)
-        adc     a, d
-        ld      -5(ix), a
-
-.no_add:
-        ;; multiplicand <<= 1
-        add     hl, hl
-        rl      e
-        rl      d
-
-        ;; multiplier >>= 1 (msb -9 .. lsb -12)
-        srl     -9(ix)
-        rr      -10(ix)
-        rr      -11(ix)
-        rr      -12(ix)
-
-        djnz    .mul_loop
-
-        ;; acc -> de:hl (internal order)
-        ld      l, -8(ix)
-        ld      h, -7(ix)
-        ld      e, -6(ix)
-        ld      d, -5(ix)
-
-        ;; apply sign if needed
-        ld      a, -13(ix)
-        or      a
-        jr      z, .ret_order
-        xor     a
-        sub     a, l
-        ld      l, a
-        ld      a, #0
-        sbc     a, h
-        ld      h, a
-        ld      a, #0
-        sbc     a, e
-        ld      e, a
-        ld      a, #0
-        sbc     a, d
-        ld      d, a
-
-.ret_order:
-        ;; tear down frame
-        ld      sp, ix
-        pop     ix
-
-        ;; convert internal (DE high, HL low) -> ABI return (DE low, HL high)
+        ld      iy, #2
+        add     iy, sp                             ; iy = &b
+
+        ;; both high words zero: a.lo * b.lo unsigned
+        ld      a, h
+        or      a, l
+        or      a, 2(iy)
+        or      a, 3(iy)
+        jr      nz, .not_u16
+        ld      l, 0(iy)
+        ld      h, 1(iy)
+        jp      ___muluint2ulong
+
+        ;; both high words the sign of the low word: a.lo * b.lo signed
+.not_u16:
+        ld      a, d
+        rla
+        sbc     a, a                               ; a = sign of a.lo
+        cp      a, h
+        jr      nz, .wide
+        cp      a, l
+        jr      nz, .wide
+        ld      a, 1(iy)
+        rla
+        sbc     a, a                               ; a = sign of b.lo
+        cp      a, 2(iy)
+        jr      nz, .wide
+        cp      a, 3(iy)
+        jr      nz, .wide
         ex      de, hl
+        ld      e, 0(iy)
+        ld      d, 1(iy)
+        jp      ___mulsint2slong
+
+        ;; three partial products
+.wide:
+        push    de                                 ; a.lo
+        ex      de, hl                             ; de = a.hi
+        ld      c, 0(iy)
+        ld      b, 1(iy)
+        call    __mul16                            ; de = lo16(a.hi * b.lo)
+        pop     bc                                 ; bc = a.lo
+        push    bc
+        push    de
+        ld      e, 2(iy)
+        ld      d, 3(iy)
+        call    __mul16                            ; de = lo16(a.lo * b.hi)
+        pop     hl
+        add     hl, de
+        ex      (sp), hl                           ; (sp) = cross sum, hl = a.lo
+        ld      e, 0(iy)
+        ld      d, 1(iy)
+        call    ___muluint2ulong                   ; de:hl = a.lo * b.lo
+        pop     bc
+        add     hl, bc                             ; high word += cross sum
         ret
@@ -0,0 +1,182 @@
+        ;; 64-bit multiply (long long, low 64 bits)
+        ;;
+        ;; ABI (sdcccall(1), return values wider than 32 bits):
+        ;;   result pointer (hidden first argument) in HL
+        ;;   a on stack: 2(sp)..9(sp)   = a0..a7 (lsb..msb)
+        ;;   b on stack: 10(sp)..17(sp) = b0..b7 (lsb..msb), caller pops
+        ;; returns:
+        ;;   *HL = low 64 bits of a * b (same for signed and unsigned)
+        ;;
+        ;; schoolbook multiply on bytes with __mul8x8 (so FAST_MUL picks
+        ;; the partial product), one row per significant byte of the
+        ;; shorter operand. leading zero bytes of both operands are
+        ;; skipped and products above byte 7 are never formed, so 32x32
+        ;; bit operands take 16 partial products and 16x16 take 4.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module mullonglong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __mullonglong
+        .globl  __mul8x8
+
+        ;; locals:
+        ;;  -2,-1 : result pointer, + i for row i
+        ;;  -4,-3 : &a[i] (row operand)
+        ;;  -6,-5 : &b[0] (column operand)
+        ;;  -7    : rows left
+        ;;  -8    : significant bytes of the column operand
+        ;;  -9    : result bytes from row i up (8 - i)
+
+        ;; __mullonglong
+        ;; inputs:  HL = result pointer, a at 2(sp)..9(sp), b at 10(sp)..17(sp)
+        ;; outputs: *HL = low 64 bits of a * b
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+__mullonglong:
+        push    ix
+        ld      ix, #0
+        add     ix, sp
+
+        push    hl                                 ; -2,-1 = result
+        ld      b, #8                              ; result = 0
+        xor     a
+.clear:
+        ld      (hl), a
+        inc     hl
+        djnz    .clear
+
+        ld      hl, #-7
+        add     hl, sp
+        ld      sp, hl
+
+        ;; c = significant bytes of a, b = of b
+        push    ix
+        pop     hl
+        ld      de, #11
+        add     hl, de                             ; hl = &a[7]
+        call    .bytes
+        ld      c, b
+        ld      de, #19
+        push    ix
+        pop     hl
+        add     hl, de                             ; hl = &b[7]
+        call    .bytes
+        ld      a, c
+        or      a
+        jp      z, .done                           ; a == 0
+        ld      a, b
+        or      a
+        jp      z, .done                           ; b == 0
+
+        ;; rows over the operand with fewer significant bytes
+        push    ix
+        pop     hl
+        ld      de, #4
+        add     hl, de
+        ex      de, hl                             ; de = &a[0]
+        ld      hl, #8
+        add     hl, de                             ; hl = &b[0]
+        ld      a, b
+        cp      a, c
+        jr      nc, .rows_set                      ; b has no fewer bytes
+        ex      de, hl
+        ld      a, c
+        ld      c, b
+        ld      b, a
+.rows_set:
+        ld      -4(ix), e
+        ld      -3(ix), d
+        ld      -6(ix), l
+        ld      -5(ix), h
+        ld      -7(ix), c
+        ld      -8(ix), b
+        ld      -9(ix), #8
+
+.row:
+        ld      l, -4(ix)
+        ld      h, -3(ix)
+        ld      c, (hl)                            ; c = a[i]
+        inc     hl
+        ld      -4(ix), l
+        ld      -3(ix), h
+        ld      a, c
+        or      a
+        jr      z, .next_row                       ; zero byte: nothing to add
+        ld      l, -2(ix)
+        ld      h, -1(ix)
+        push    hl
+        pop     iy                                 ; iy = result + i
+        ld      a, -8(ix)
+        cp      a, -9(ix)
+        jr      c, .row_len                        ; whole row fits below byte 8
+        ld      a, -9(ix)
+.row_len:
+        exx
+        ld      b, a                               ; b' = columns in this row
+        ld      c, #0                              ; c' = carry byte
+        ld      l, -6(ix)
+        ld      h, -5(ix)                          ; hl' = &b[0]
+.col:
+        ld      a, (hl)
+        inc     hl
+        exx
+        ld      h, a
+        ld      l, c
+        call    __mul8x8                           ; hl = a[i] * b[j]
+        exx
+        ld      a, c
+        exx
+        add     a, 0(iy)                           ; carry + result byte < 2^9
+        jr      nc, .col_sum
+        inc     h
+.col_sum:
+        add     a, l
+        ld      0(iy), a
+        ld      a, h
+        adc     a, #0                              ; fits: 255*255 + 2*255 < 2^16
+        inc     iy
+        exx
+        ld      c, a
+        djnz    .col
+        ld      a, c
+        exx
+
+        ;; the row carry lands on a byte no earlier row has reached,
+        ;; unless the row was cut at byte 7
+        ld      b, a
+        ld      a, -8(ix)
+        cp      a, -9(ix)
+        jr      nc, .next_row
+        ld      0(iy), b
+
+.next_row:
+        inc     -2(ix)
+        jr      nz, .row_ptr
+        inc     -1(ix)
+.row_ptr:
+        dec     -9(ix)
+        dec     -7(ix)
+        jp      nz, .row
+
+.done:
+        ld      sp, ix
+        pop     ix
+        ret
+
+        ;; .bytes
+        ;; inputs:  hl = address of the top byte of an 8-byte value
+        ;; outputs: b = number of significant bytes (0..8)
+        ;; clobbers: af, hl
+.bytes:
+        ld      b, #8
+.bytes_loop:
+        ld      a, (hl)
+        or      a
+        ret     nz
+        dec     hl
+        djnz    .bytes_loop
+        ret
@@ -21,6 +21,12 @@
 ___muluint2ulong:
         ld      iy, #0                             ; iy = low 16 of product
         ld      b, #16                             ; .loop over 16 multiplier bits
+        inc     h
+        dec     h
+        jr      nz, .loop                          ; multiplier >= 2^8
+        ld      h, l                               ; else skip its zero high byte
+        ld      l, #0
+        ld      b, #8
 .loop:
         add     iy, iy                             ; (iy:hl) <<= 1, start with low
         adc     hl, hl                             ; then high with carry from iy
@@ -0,0 +1,60 @@
+        ;; 32-bit shift left (long) by a variable count
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in regs:       DE = low16, HL = high16
+        ;;   s on stack:      2(sp) (char), caller pops
+        ;; returns:
+        ;;   x << s in regs:  DE = low16, HL = high16 (0 for s >= 32)
+        ;;
+        ;; whole bytes are moved between registers, only the last 0..7
+        ;; bits are shifted one at a time.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module rlulong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __rlulong
+        .globl  __rlslong
+
+        ;; __rlulong
+        ;; inputs:  x in DE:HL (DE=low16, HL=high16), s at 2(sp)
+        ;; outputs: DE:HL = x << s
+        ;; clobbers: af, b, de, hl, iy
+__rlslong::
+__rlulong:
+        ld      iy, #2
+        add     iy, sp
+        ld      a, 0(iy)                           ; a = s
+        cp      a, #32
+        jr      nc, .zero
+        bit     4, a
+        jr      z, .no16
+        ex      de, hl                             ; << 16
+        ld      de, #0
+.no16:
+        bit     3, a
+        jr      z, .no8
+        ld      h, l                               ; << 8
+        ld      l, d
+        ld      d, e
+        ld      e, #0
+.no8:
+        and     a, #7
+        ret     z
+        ld      b, a
+.bits:
+        sla     e
+        rl      d
+        adc     hl, hl
+        djnz    .bits
+        ret
+
+.zero:
+        ld      hl, #0
+        ld      d, h
+        ld      e, l
+        ret
@@ -0,0 +1,118 @@
+        ;; 64-bit shift left (long long) by a variable count
+        ;;
+        ;; ABI (sdcccall(1), return values wider than 32 bits):
+        ;;   result pointer (hidden first argument) in HL
+        ;;   x on stack: 2(sp)..9(sp) = x0..x7 (lsb..msb)
+        ;;   s on stack: 10(sp) (char), caller pops
+        ;; returns:
+        ;;   *HL = x << s (0 for s >= 64)
+        ;;
+        ;; whole bytes are copied to the result with ldir, the last 0..7
+        ;; bits are shifted with the value held in bcde and bcde'.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module rlulonglong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __rlulonglong
+        .globl  __rlslonglong
+
+        ;; __rlulonglong
+        ;; inputs:  HL = result pointer, x at 2(sp)..9(sp), s at 10(sp)
+        ;; outputs: *HL = x << s
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+__rlslonglong::
+__rlulonglong:
+        ld      iy, #2
+        add     iy, sp                             ; iy = &x, s at 8(iy)
+        push    hl                                 ; result
+        ld      a, 8(iy)
+        cp      a, #64
+        jr      c, .bytes
+        ld      a, #64                             ; every byte goes out
+.bytes:
+        rrca
+        rrca
+        rrca
+        and     a, #0x0f
+        ld      b, a                               ; b = whole bytes (0..8)
+        ld      a, #8
+        sub     a, b
+        ld      c, a                               ; c = bytes kept
+        inc     b
+        jr      .zero_next
+.zero:
+        ld      (hl), #0                           ; result[0..k-1] = 0
+        inc     hl
+.zero_next:
+        djnz    .zero
+        ld      a, c
+        or      a
+        jr      z, .bits_start
+        ex      de, hl
+        push    iy
+        pop     hl
+        ldir                                       ; result[k..7] = x[0..7-k]
+
+.bits_start:
+        pop     hl
+        ld      a, 8(iy)
+        and     a, #7
+        ret     z
+        push    hl
+        ld      e, (hl)
+        inc     hl
+        ld      d, (hl)
+        inc     hl
+        ld      c, (hl)
+        inc     hl
+        ld      b, (hl)
+        inc     hl
+        push    hl
+        exx
+        pop     hl
+        ld      e, (hl)
+        inc     hl
+        ld      d, (hl)
+        inc     hl
+        ld      c, (hl)
+        inc     hl
+        ld      b, (hl)
+        exx
+.bits:
+        sla     e
+        rl      d
+        rl      c
+        rl      b
+        exx
+        rl      e
+        rl      d
+        rl      c
+        rl      b
+        exx
+        dec     a
+        jr      nz, .bits
+        pop     hl
+        ld      (hl), e
+        inc     hl
+        ld      (hl), d
+        inc     hl
+        ld      (hl), c
+        inc     hl
+        ld      (hl), b
+        inc     hl
+        push    hl
+        exx
+        pop     hl
+        ld      (hl), e
+        inc     hl
+        ld      (hl), d
+        inc     hl
+        ld      (hl), c
+        inc     hl
+        ld      (hl), b
+        ret
@@ -0,0 +1,66 @@
+        ;; 32-bit arithmetic shift right (long) by a variable count
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in regs:       DE = low16, HL = high16
+        ;;   s on stack:      2(sp) (char), caller pops
+        ;; returns:
+        ;;   x >> s in regs:  DE = low16, HL = high16, sign filled
+        ;;                    (0 or -1 for s >= 32)
+        ;;
+        ;; whole bytes are moved between registers, only the last 0..7
+        ;; bits are shifted one at a time.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module rrslong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __rrslong
+
+        ;; __rrslong
+        ;; inputs:  x in DE:HL (DE=low16, HL=high16, signed), s at 2(sp)
+        ;; outputs: DE:HL = x >> s (sign filled)
+        ;; clobbers: af, bc, de, hl, iy
+__rrslong:
+        ld      a, h
+        rla
+        sbc     a, a
+        ld      c, a                               ; c = fill byte
+        ld      iy, #2
+        add     iy, sp
+        ld      a, 0(iy)                           ; a = s
+        cp      a, #32
+        jr      nc, .fill
+        bit     4, a
+        jr      z, .no16
+        ex      de, hl                             ; >> 16
+        ld      h, c
+        ld      l, c
+.no16:
+        bit     3, a
+        jr      z, .no8
+        ld      e, d                               ; >> 8
+        ld      d, l
+        ld      l, h
+        ld      h, c
+.no8:
+        and     a, #7
+        ret     z
+        ld      b, a
+.bits:
+        sra     h
+        rr      l
+        rr      d
+        rr      e
+        djnz    .bits
+        ret
+
+.fill:
+        ld      h, c
+        ld      l, c
+        ld      d, c
+        ld      e, c
+        ret
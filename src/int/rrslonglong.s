@@ -0,0 +1,32 @@
+        ;; 64-bit arithmetic shift right (long long) by a variable count
+        ;;
+        ;; ABI (sdcccall(1), return values wider than 32 bits):
+        ;;   result pointer (hidden first argument) in HL
+        ;;   x on stack: 2(sp)..9(sp) = x0..x7 (lsb..msb)
+        ;;   s on stack: 10(sp) (char), caller pops
+        ;; returns:
+        ;;   *HL = x >> s, sign filled (0 or -1 for s >= 64)
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module rrslonglong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __rrslonglong
+        .globl  __rr64
+
+        ;; __rrslonglong
+        ;; inputs:  HL = result pointer, x at 2(sp)..9(sp), s at 10(sp)
+        ;; outputs: *HL = x >> s (sign filled)
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl', iy
+__rrslonglong:
+        ld      iy, #2
+        add     iy, sp                             ; iy = &x
+        ld      a, 7(iy)
+        rla
+        sbc     a, a
+        ld      c, a                               ; c = fill byte
+        jp      __rr64
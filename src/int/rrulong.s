@@ -0,0 +1,59 @@
+        ;; 32-bit logical shift right (unsigned long) by a variable count
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   x in regs:       DE = low16, HL = high16
+        ;;   s on stack:      2(sp) (char), caller pops
+        ;; returns:
+        ;;   x >> s in regs:  DE = low16, HL = high16 (0 for s >= 32)
+        ;;
+        ;; whole bytes are moved between registers, only the last 0..7
+        ;; bits are shifted one at a time.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module rrulong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __rrulong
+
+        ;; __rrulong
+        ;; inputs:  x in DE:HL (DE=low16, HL=high16), s at 2(sp)
+        ;; outputs: DE:HL = x >> s
+        ;; clobbers: af, b, de, hl, iy
+__rrulong:
+        ld      iy, #2
+        add     iy, sp
+        ld      a, 0(iy)                           ; a = s
+        cp      a, #32
+        jr      nc, .zero
+        bit     4, a
+        jr      z, .no16
+        ex      de, hl                             ; >> 16
+        ld      hl, #0
+.no16:
+        bit     3, a
+        jr      z, .no8
+        ld      e, d                               ; >> 8
+        ld      d, l
+        ld      l, h
+        ld      h, #0
+.no8:
+        and     a, #7
+        ret     z
+        ld      b, a
+.bits:
+        srl     h
+        rr      l
+        rr      d
+        rr      e
+        djnz    .bits
+        ret
+
+.zero:
+        ld      hl, #0
+        ld      d, h
+        ld      e, l
+        ret
@@ -0,0 +1,142 @@
+        ;; 64-bit logical shift right (unsigned long long) by a variable
+        ;; count
+        ;;
+        ;; ABI (sdcccall(1), return values wider than 32 bits):
+        ;;   result pointer (hidden first argument) in HL
+        ;;   x on stack: 2(sp)..9(sp) = x0..x7 (lsb..msb)
+        ;;   s on stack: 10(sp) (char), caller pops
+        ;; returns:
+        ;;   *HL = x >> s (0 for s >= 64)
+        ;;
+        ;; also provides __rr64, the right shift shared with __rrslonglong.
+        ;; whole bytes are copied to the result with ldir, the last 0..7
+        ;; bits are shifted with the value held in bcde and bcde'.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module rrulonglong
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __rrulonglong
+        .globl  __rr64
+
+        ;; __rrulonglong
+        ;; inputs:  HL = result pointer, x at 2(sp)..9(sp), s at 10(sp)
+        ;; outputs: *HL = x >> s
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl', iy
+__rrulonglong:
+        ld      iy, #2
+        add     iy, sp                             ; iy = &x
+        ld      c, #0
+
+        ;; __rr64
+        ;; inputs:  HL = result pointer, IY = &x, s at 8(iy),
+        ;;          C = fill byte (0x00 or 0xff)
+        ;; outputs: *HL = x >> s, vacated bits from the fill byte
+        ;; clobbers: af, bc, de, hl, af', bc', de', hl'
+__rr64::
+        push    hl                                 ; result
+        ex      de, hl                             ; de = result
+        ld      a, 8(iy)
+        cp      a, #64
+        jr      c, .bytes
+        ld      a, #64                             ; every byte goes out
+.bytes:
+        rrca
+        rrca
+        rrca
+        and     a, #0x0f
+        ld      b, a                               ; b = whole bytes (0..8)
+        push    iy
+        pop     hl
+        add     a, l
+        ld      l, a
+        jr      nc, .src
+        inc     h                                  ; hl = &x[k]
+.src:
+        ld      a, #8
+        sub     a, b                               ; a = bytes kept
+        jr      z, .fill_start
+        push    bc
+        ld      c, a
+        ld      b, #0
+        ldir                                       ; result[0..7-k] = x[k..7]
+        pop     bc
+.fill_start:
+        inc     b
+        jr      .fill_next
+.fill:
+        ld      a, c                               ; result[8-k..7] = fill
+        ld      (de), a
+        inc     de
+.fill_next:
+        djnz    .fill
+
+        pop     hl
+        ld      a, 8(iy)
+        and     a, #7
+        ret     z
+        push    hl
+        ld      a, c
+        ex      af, af'                            ; a' = fill
+        ld      e, (hl)
+        inc     hl
+        ld      d, (hl)
+        inc     hl
+        ld      c, (hl)
+        inc     hl
+        ld      b, (hl)
+        inc     hl
+        push    hl
+        exx
+        pop     hl
+        ld      e, (hl)
+        inc     hl
+        ld      d, (hl)
+        inc     hl
+        ld      c, (hl)
+        inc     hl
+        ld      b, (hl)
+        exx
+        ex      af, af'
+        ld      h, a                               ; h = fill
+        ld      a, 8(iy)
+        and     a, #7
+        ld      l, a                               ; l = bits
+.bits:
+        rlc     h                                  ; carry = fill bit
+        exx
+        rr      b
+        rr      c
+        rr      d
+        rr      e
+        exx
+        rr      b
+        rr      c
+        rr      d
+        rr      e
+        dec     l
+        jr      nz, .bits
+        pop     hl
+        ld      (hl), e
+        inc     hl
+        ld      (hl), d
+        inc     hl
+        ld      (hl), c
+        inc     hl
+        ld      (hl), b
+        inc     hl
+        push    hl
+        exx
+        pop     hl
+        ld      (hl), e
+        inc     hl
+        ld      (hl), d
+        inc     hl
+        ld      (hl), c
+        inc     hl
+        ld      (hl), b
+        ret
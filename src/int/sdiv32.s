@@ -0,0 +1,287 @@
+        ;; signed 32-bit division by a run-time invariant divisor
+        ;;
+        ;; same scheme as udiv32.s for long, as in libdivide:
+        ;;   q = mulhi_s(m, x) (+ x or - x with the add step, by sign of d)
+        ;;   x / d = (q >> shift) + (q < 0)              (arithmetic >>)
+        ;; m is negated for d < 0. a power of two shifts |x| and puts
+        ;; the sign back, which rounds toward zero like C.
+        ;;
+        ;; the signed multiply-high is __mulhu32 on the same bits with
+        ;; the two usual corrections: - x when m < 0, - m when x < 0.
+        ;;
+        ;; C entry points (see include/fastdiv.h), sdcccall(1):
+        ;;   void sdiv32_prepare(sdiv32_t *s, long d);
+        ;;   long sdiv32_apply(const sdiv32_t *s, long x);
+        ;;   void sdiv32_array(const sdiv32_t *s, long *x, unsigned int n);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module sdiv32
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _sdiv32_prepare
+        .globl  _sdiv32_apply
+        .globl  _sdiv32_array
+        .globl  __sdiv32
+        .globl  __mulhu32
+        .globl  __log2_32
+        .globl  __div32_magic
+
+        ;; _sdiv32_prepare
+        ;; inputs:  hl = s, d at 2(sp)..5(sp)
+        ;; outputs: *s = magic and more for d
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;; notes: callee cleans d from stack
+_sdiv32_prepare:
+        pop     af                                 ; return address
+        pop     de                                 ; de = d low
+        pop     bc                                 ; bc = d high
+        push    af
+        push    hl                                 ; s
+        ld      h, b
+        ld      l, c                               ; hl:de = d
+        ld      a, h
+        push    af                                 ; a bit 7 = sign(d)
+        bit     7, h
+        call    nz, .neg_hlde                      ; |d|
+        call    __log2_32                          ; b = floor(log2(|d|))
+        jr      z, .prep_pow2
+        ld      c, b
+        dec     c                                  ; 2^(31 + l) / |d|
+        call    __div32_magic
+        pop     af
+        rla
+        jr      nc, .prep_store
+        call    .neg_hlde                          ; magic = -magic
+        set     7, c
+        jr      .prep_store
+.prep_pow2:
+        pop     af
+        and     a, #0x80
+        or      a, b
+        ld      c, a                               ; more = sign | shift
+        ld      hl, #0                             ; magic = 0
+        ld      d, h
+        ld      e, l
+.prep_store:
+        pop     iy
+        ld      0(iy), e
+        ld      1(iy), d
+        ld      2(iy), l
+        ld      3(iy), h
+        ld      4(iy), c
+        ret
+
+        ;; _sdiv32_apply
+        ;; inputs:  hl = s, x at 2(sp)..5(sp)
+        ;; outputs: DE:HL = trunc(x / d) (DE=low16, HL=high16)
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;; notes: caller pops x
+_sdiv32_apply:
+        push    hl
+        pop     iy
+        ld      hl, #2
+        add     hl, sp
+        ld      e, (hl)
+        inc     hl
+        ld      d, (hl)
+        inc     hl
+        ld      a, (hl)
+        inc     hl
+        ld      h, (hl)
+        ld      l, a
+        ;; fall through to __sdiv32
+
+        ;; __sdiv32
+        ;; inputs:  iy = s, x in DE:HL (DE=low16, HL=high16)
+        ;; outputs: DE:HL = trunc(x / d)
+        ;; clobbers: af, bc, de, hl, bc', de', hl'
+__sdiv32:
+        ld      a, 0(iy)
+        or      a, 1(iy)
+        or      a, 2(iy)
+        or      a, 3(iy)
+        jp      z, .pow2
+        ld      b, h
+        ld      c, l                               ; bc = x high
+        push    de
+        exx
+        pop     bc                                 ; bc' = x low
+        ld      e, 0(iy)
+        ld      d, 1(iy)                           ; de' = m low
+        exx
+        ld      e, 2(iy)
+        ld      d, 3(iy)                           ; de = m high
+        call    __mulhu32                          ; hl:hl' = mulhi_u(m, x)
+        bit     7, d
+        jr      z, .m_pos
+        exx
+        or      a
+        sbc     hl, bc
+        exx
+        sbc     hl, bc                             ; - x
+.m_pos:
+        bit     7, b
+        jr      z, .x_pos
+        exx
+        or      a
+        sbc     hl, de
+        exx
+        sbc     hl, de                             ; - m
+.x_pos:
+        ld      a, 4(iy)
+        bit     6, a
+        jr      z, .q_out
+        bit     7, a
+        jr      nz, .sub_x
+        exx
+        add     hl, bc
+        exx
+        adc     hl, bc                             ; q += x
+        jr      .q_out
+.sub_x:
+        exx
+        or      a
+        sbc     hl, bc
+        exx
+        sbc     hl, bc                             ; q -= x
+.q_out:
+        exx
+        push    hl
+        exx
+        pop     de                                 ; hl:de = q
+        bit     4, a
+        jr      z, .no16
+        ex      de, hl                             ; >> 16
+        ld      a, d
+        rla
+        sbc     a, a
+        ld      h, a
+        ld      l, a
+        ld      a, 4(iy)
+.no16:
+        bit     3, a
+        jr      z, .no8
+        ld      e, d                               ; >> 8
+        ld      d, l
+        ld      l, h
+        ld      a, h
+        rla
+        sbc     a, a
+        ld      h, a
+        ld      a, 4(iy)
+.no8:
+        and     a, #7
+        jr      z, .round
+        ld      b, a
+.bits:
+        sra     h
+        rr      l
+        rr      d
+        rr      e
+        djnz    .bits
+.round:
+        bit     7, h
+        ret     z
+        inc     de                                 ; toward zero
+        ld      a, d
+        or      a, e
+        ret     nz
+        inc     hl
+        ret
+
+        ;; d = +-2^shift: |x| >> shift with the sign of x / d
+.pow2:
+        ld      a, 4(iy)
+        xor     a, h
+        push    af                                 ; a bit 7 = sign(x / d)
+        bit     7, h
+        call    nz, .neg_hlde
+        ld      a, 4(iy)
+        bit     4, a
+        jr      z, .p_no16
+        ex      de, hl                             ; >> 16
+        ld      hl, #0
+.p_no16:
+        bit     3, a
+        jr      z, .p_no8
+        ld      e, d                               ; >> 8
+        ld      d, l
+        ld      l, h
+        ld      h, #0
+.p_no8:
+        and     a, #7
+        jr      z, .p_sign
+        ld      b, a
+.p_bits:
+        srl     h
+        rr      l
+        rr      d
+        rr      e
+        djnz    .p_bits
+.p_sign:
+        pop     af
+        rla
+        ret     nc
+        ;; fall through to .neg_hlde
+
+        ;; hl:de = -hl:de
+.neg_hlde:
+        xor     a
+        sub     a, e
+        ld      e, a
+        ld      a, #0
+        sbc     a, d
+        ld      d, a
+        ld      a, #0
+        sbc     a, l
+        ld      l, a
+        ld      a, #0
+        sbc     a, h
+        ld      h, a
+        ret
+
+        ;; _sdiv32_array
+        ;; inputs:  hl = s, de = x, n at 2(sp)
+        ;; outputs: x[i] = trunc(x[i] / d) for i < n
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;; notes: callee cleans n from stack
+_sdiv32_array:
+        pop     af                                 ; return address
+        pop     bc                                 ; bc = n
+        push    af
+        push    hl
+        pop     iy                                 ; iy = s
+        ex      de, hl                             ; hl = x
+.next:
+        ld      a, b
+        or      a, c
+        ret     z
+        dec     bc
+        push    bc
+        push    hl
+        ld      e, (hl)
+        inc     hl
+        ld      d, (hl)
+        inc     hl
+        ld      a, (hl)
+        inc     hl
+        ld      h, (hl)
+        ld      l, a
+        call    __sdiv32
+        ld      b, h
+        ld      c, l
+        pop     hl
+        ld      (hl), e
+        inc     hl
+        ld      (hl), d
+        inc     hl
+        ld      (hl), c
+        inc     hl
+        ld      (hl), b
+        inc     hl
+        pop     bc
+        jr      .next
@@ -0,0 +1,284 @@
+        ;; decimal or hex text to 32-bit unsigned integer
+        ;;
+        ;; unsigned long strtoul32(const char *s, char **end,
+        ;;                         unsigned char base);
+        ;;
+        ;; skips leading white space, takes an optional sign and the
+        ;; digits that follow. base is 10 or 16, 0 picks 16 after a 0x or
+        ;; 0X prefix and 10 otherwise (there is no octal), any other base
+        ;; reads decimal. a hex digit shifts x left by 4, a decimal one is
+        ;; x = (x * 4 + x) * 2 + d with 32-bit adds, checking the carry of
+        ;; every step. on overflow the result is 0xFFFFFFFF, a minus sign
+        ;; negates the value otherwise, as C's strtoul does. *end (when
+        ;; end is not 0) is set past the last digit, or to s when there is
+        ;; none.
+        ;;
+        ;; ABI (sdcccall(1)):
+        ;;   s in HL, end in DE, base at 2(sp) as a single byte
+        ;;   result in HL:DE (HL=high16, DE=low16)
+        ;;   caller pops base
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module strtoul32
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _strtoul32
+
+;; ============================================================
+;; Frame layout:
+;;
+;;   ix+4     : base, replaced by 10 or 16
+;;   ix+2,3   : return address
+;;   ix+0,1   : saved ix
+;;   ix-1,-2  : end (high, low)
+;;   ix-3,-4  : s (high, low)
+;;   ix-5     : bit 0 minus sign, bit 1 overflow
+;;
+;; while parsing: DE = s, HL:HL' = x
+;; ============================================================
+
+        ;; _strtoul32
+        ;; inputs:  hl = s, de = end, base at 2(sp)
+        ;; outputs: HL:DE = value
+        ;; clobbers: af, bc, de, hl, bc', de', hl'
+_strtoul32:
+        push    ix
+        ld      ix, #0
+        add     ix, sp
+        push    de                                 ; ix-1,-2 = end
+        push    hl                                 ; ix-3,-4 = s
+        xor     a
+        push    af
+        ld      -5(ix), a
+        ex      de, hl
+.space:
+        ld      a, (de)
+        cp      #0x20
+        jr      z, .skip
+        sub     #9                                 ; \t \n \v \f \r
+        cp      #5
+        jr      nc, .sign
+.skip:
+        inc     de
+        jr      .space
+.sign:
+        ld      a, (de)
+        cp      #0x2D                              ; '-'
+        jr      nz, .plus
+        set     0, -5(ix)
+        jr      .signed
+.plus:
+        cp      #0x2B                              ; '+'
+        jr      nz, .base
+.signed:
+        inc     de
+
+        ;; a 0x prefix counts only when a hex digit follows, else the 0
+        ;; is the number and *end points at the x
+.base:
+        ld      a, 4(ix)
+        or      a
+        jr      z, .prefix
+        cp      #16
+        jr      z, .prefix
+        ld      4(ix), #10
+        jr      .parse
+.prefix:
+        ld      c, a                               ; c = 0 or 16
+        ld      4(ix), #16
+        ex      de, hl
+        ld      a, (hl)
+        cp      #0x30                              ; '0'
+        jr      nz, .no_prefix
+        inc     hl
+        ld      a, (hl)
+        or      #0x20
+        cp      #0x78                              ; 'x' or 'X'
+        jr      nz, .no_prefix_dec
+        inc     hl
+        ld      a, (hl)
+        call    .value
+        jr      nc, .no_prefix_dec2
+        ex      de, hl                             ; de past the prefix
+        jr      .parse
+.no_prefix_dec2:
+        dec     hl
+.no_prefix_dec:
+        dec     hl
+.no_prefix:
+        ex      de, hl
+        ld      a, c
+        or      a
+        jr      nz, .parse
+        ld      4(ix), #10
+
+.parse:
+        push    de                                 ; where the digits start
+        ld      hl, #0
+        exx
+        ld      hl, #0
+        exx
+        ld      a, 4(ix)
+        cp      #16
+        jr      z, .hex
+
+        ;; x = x * 10 + a
+.dec:
+        ld      a, (de)
+        sub     #0x30
+        cp      #10
+        jr      nc, .end
+        ld      b, h
+        ld      c, l
+        exx
+        ld      b, h
+        ld      c, l
+        add     hl, hl
+        exx
+        adc     hl, hl
+        jr      c, .overflow
+        exx
+        add     hl, hl
+        exx
+        adc     hl, hl
+        jr      c, .overflow                       ; 4 x
+        exx
+        add     hl, bc
+        exx
+        adc     hl, bc
+        jr      c, .overflow                       ; 5 x
+        exx
+        add     hl, hl
+        exx
+        adc     hl, hl
+        jr      c, .overflow                       ; 10 x
+        exx
+        ld      c, a
+        ld      b, #0
+        add     hl, bc
+        exx
+        ld      bc, #0
+        adc     hl, bc
+        jr      c, .overflow
+        inc     de
+        jr      .dec
+
+        ;; x = x * 16 + a
+.hex:
+        ld      a, (de)
+        call    .value
+        jr      nc, .end
+        ld      c, a
+        ld      a, h
+        and     #0xF0
+        jr      nz, .overflow
+        exx
+        ld      a, h                               ; top nibble of the low word
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        exx
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        add     hl, hl
+        rlca
+        rlca
+        rlca
+        rlca
+        and     #0x0F
+        or      l
+        ld      l, a
+        ld      a, c
+        exx
+        or      l
+        ld      l, a
+        exx
+        inc     de
+        jr      .hex
+
+.overflow:
+        set     1, -5(ix)
+.rest:
+        inc     de                                 ; skip the remaining digits
+        ld      a, (de)
+        call    .value
+        jr      c, .rest
+
+.end:
+        pop     bc
+        ld      a, e
+        xor     c
+        jr      nz, .set_end
+        ld      a, d
+        xor     b
+        jr      nz, .set_end
+        ld      e, -4(ix)                          ; no digits: *end = s
+        ld      d, -3(ix)
+.set_end:
+        ld      c, -2(ix)
+        ld      b, -1(ix)
+        ld      a, b
+        or      c
+        jr      z, .result
+        ld      a, e
+        ld      (bc), a
+        inc     bc
+        ld      a, d
+        ld      (bc), a
+.result:
+        exx
+        ex      de, hl                             ; de' = x low
+        exx
+        ld      a, -5(ix)
+        bit     1, a
+        jr      nz, .max
+        rra
+        jr      nc, .done
+        exx                                        ; x = -x
+        xor     a
+        ld      h, a
+        ld      l, a
+        sbc     hl, de
+        ex      de, hl
+        exx
+        ld      d, h
+        ld      e, l
+        ld      h, a
+        ld      l, a
+        sbc     hl, de
+        jr      .done
+.max:
+        ld      hl, #0xFFFF
+        exx
+        ld      de, #0xFFFF
+        exx
+.done:
+        exx
+        push    de
+        exx
+        pop     de                                 ; de = x low
+        ld      sp, ix
+        pop     ix
+        ret
+
+        ;; a = value of the digit a, cf set when it is below 4(ix)
+        ;; clobbers: f
+.value:
+        sub     #0x30
+        cp      #10
+        jr      c, .in_base
+        add     a, #0x30
+        or      #0x20
+        sub     #0x61                              ; 'a'
+        cp      #6
+        ret     nc
+        add     a, #10
+.in_base:
+        cp      4(ix)
+        ret
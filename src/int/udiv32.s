@@ -0,0 +1,502 @@
+        ;; unsigned 32-bit division by a run-time invariant divisor
+        ;;
+        ;; udiv32_prepare(s, d) stores a magic number m and a shift so that
+        ;;   x / d = mulhi(m, x) >> shift                 (no add step)
+        ;;   x / d = (((x - q) >> 1) + q) >> shift        (add step)
+        ;; with q = mulhi(m, x) = (m * x) >> 32, as in libdivide. a power
+        ;; of two stores m = 0 and is a plain shift.
+        ;;
+        ;; __mulhu32 keeps the 33-bit accumulator in hl:hl' and m in
+        ;; de:de', and shifts it right once per bit of x, a byte of x at
+        ;; a time. a zero byte of x is a byte move. that is about half
+        ;; the 32 steps of __divu32, which each add or subtract as well.
+        ;; the magic number itself comes from one __divu64.
+        ;;
+        ;; C entry points (see include/fastdiv.h), sdcccall(1):
+        ;;   void udiv32_prepare(udiv32_t *s, unsigned long d);
+        ;;   unsigned long udiv32_apply(const udiv32_t *s, unsigned long x);
+        ;;   void udiv32_array(const udiv32_t *s, unsigned long *x,
+        ;;                     unsigned int n);
+        ;;
+        ;; also provides __mulhu32, __log2_32 and __div32_magic, shared
+        ;; with the signed versions in sdiv32.s.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module udiv32
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _udiv32_prepare
+        .globl  _udiv32_apply
+        .globl  _udiv32_array
+        .globl  __udiv32
+        .globl  __mulhu32
+        .globl  __log2_32
+        .globl  __div32_magic
+        .globl  __divu64
+
+        ;; _udiv32_prepare
+        ;; inputs:  hl = s, d at 2(sp)..5(sp)
+        ;; outputs: *s = magic and more for d
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;; notes: callee cleans d from stack
+_udiv32_prepare:
+        pop     af                                 ; return address
+        pop     de                                 ; de = d low
+        pop     bc                                 ; bc = d high
+        push    af
+        push    hl                                 ; s
+        ld      h, b
+        ld      l, c                               ; hl:de = d
+        call    __log2_32                          ; b = floor(log2(d))
+        jr      z, .prep_pow2
+        ld      c, b                               ; 2^(32 + l) / d
+        call    __div32_magic
+        jr      .prep_store
+.prep_pow2:
+        ld      c, b                               ; more = shift
+        ld      hl, #0                             ; magic = 0
+        ld      d, h
+        ld      e, l
+.prep_store:
+        pop     iy
+        ld      0(iy), e
+        ld      1(iy), d
+        ld      2(iy), l
+        ld      3(iy), h
+        ld      4(iy), c
+        ret
+
+        ;; _udiv32_apply
+        ;; inputs:  hl = s, x at 2(sp)..5(sp)
+        ;; outputs: DE:HL = x / d (DE=low16, HL=high16)
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;; notes: caller pops x
+_udiv32_apply:
+        push    hl
+        pop     iy
+        ld      hl, #2
+        add     hl, sp
+        ld      e, (hl)
+        inc     hl
+        ld      d, (hl)
+        inc     hl
+        ld      a, (hl)
+        inc     hl
+        ld      h, (hl)
+        ld      l, a
+        ;; fall through to __udiv32
+
+        ;; __udiv32
+        ;; inputs:  iy = s, x in DE:HL (DE=low16, HL=high16)
+        ;; outputs: DE:HL = x / d
+        ;; clobbers: af, bc, de, hl, bc', de', hl'
+__udiv32:
+        ld      a, 0(iy)
+        or      a, 1(iy)
+        or      a, 2(iy)
+        or      a, 3(iy)
+        jr      z, .shift                          ; power of two
+        ld      b, h
+        ld      c, l                               ; bc = x high
+        push    de
+        exx
+        pop     bc                                 ; bc' = x low
+        ld      e, 0(iy)
+        ld      d, 1(iy)                           ; de' = m low
+        exx
+        ld      e, 2(iy)
+        ld      d, 3(iy)                           ; de = m high
+        call    __mulhu32                          ; hl:hl' = q
+        ld      a, 4(iy)                           ; a = more
+        bit     6, a
+        jr      z, .q_out
+        exx
+        ld      d, h
+        ld      e, l                               ; de' = q low
+        ld      h, b
+        ld      l, c
+        or      a
+        sbc     hl, de
+        exx
+        ld      d, h
+        ld      e, l                               ; de = q high
+        ld      h, b
+        ld      l, c
+        sbc     hl, de                             ; x - q, q <= x
+        srl     h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        add     hl, de
+        exx
+        adc     hl, de                             ; t = ((x - q) >> 1) + q
+.q_out:
+        exx
+        push    hl
+        exx
+        pop     de
+        jr      .shift_q
+.shift:
+        ld      a, 4(iy)
+.shift_q:
+        bit     4, a
+        jr      z, .no16
+        ex      de, hl                             ; >> 16
+        ld      hl, #0
+.no16:
+        bit     3, a
+        jr      z, .no8
+        ld      e, d                               ; >> 8
+        ld      d, l
+        ld      l, h
+        ld      h, #0
+.no8:
+        and     a, #7
+        ret     z
+        ld      b, a
+.bits:
+        srl     h
+        rr      l
+        rr      d
+        rr      e
+        djnz    .bits
+        ret
+
+        ;; _udiv32_array
+        ;; inputs:  hl = s, de = x, n at 2(sp)
+        ;; outputs: x[i] = x[i] / d for i < n
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;; notes: callee cleans n from stack
+_udiv32_array:
+        pop     af                                 ; return address
+        pop     bc                                 ; bc = n
+        push    af
+        push    hl
+        pop     iy                                 ; iy = s
+        ex      de, hl                             ; hl = x
+.next:
+        ld      a, b
+        or      a, c
+        ret     z
+        dec     bc
+        push    bc
+        push    hl
+        ld      e, (hl)
+        inc     hl
+        ld      d, (hl)
+        inc     hl
+        ld      a, (hl)
+        inc     hl
+        ld      h, (hl)
+        ld      l, a
+        call    __udiv32
+        ld      b, h
+        ld      c, l
+        pop     hl
+        ld      (hl), e
+        inc     hl
+        ld      (hl), d
+        inc     hl
+        ld      (hl), c
+        inc     hl
+        ld      (hl), b
+        inc     hl
+        pop     bc
+        jr      .next
+
+        ;; __mulhu32 on a zero byte of b: hl:hl' >>= 8
+.move:
+        exx
+        ld      l, h
+        exx
+        ld      a, l
+        exx
+        ld      h, a
+        exx
+        ld      l, h
+        ld      h, #0
+        ret
+
+        ;; __mulhu32
+        ;; inputs:  de:de' = a (de high), bc:bc' = b (bc high)
+        ;; outputs: hl:hl' = (a * b) >> 32 (hl high)
+        ;; clobbers: af
+__mulhu32::
+        ld      hl, #0
+        exx
+        ld      hl, #0
+        ld      a, c
+        exx
+        call    .byte                              ; b0
+        exx
+        ld      a, b
+        exx
+        call    .byte                              ; b1
+        ld      a, c
+        call    .byte                              ; b2
+        ld      a, b
+        ;; fall through for b3
+
+        ;; hl:hl' = (hl:hl' + de:de' * a) >> 8
+.byte:
+        or      a, a
+        jr      z, .move
+        rra
+        jr      nc, .b0
+        exx
+        add     hl, de
+        exx
+        adc     hl, de
+.b0:
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        exx
+        rra
+        jr      nc, .b1
+        exx
+        add     hl, de
+        exx
+        adc     hl, de
+.b1:
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        exx
+        rra
+        jr      nc, .b2
+        exx
+        add     hl, de
+        exx
+        adc     hl, de
+.b2:
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        exx
+        rra
+        jr      nc, .b3
+        exx
+        add     hl, de
+        exx
+        adc     hl, de
+.b3:
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        exx
+        rra
+        jr      nc, .b4
+        exx
+        add     hl, de
+        exx
+        adc     hl, de
+.b4:
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        exx
+        rra
+        jr      nc, .b5
+        exx
+        add     hl, de
+        exx
+        adc     hl, de
+.b5:
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        exx
+        rra
+        jr      nc, .b6
+        exx
+        add     hl, de
+        exx
+        adc     hl, de
+.b6:
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        exx
+        rra
+        jr      nc, .b7
+        exx
+        add     hl, de
+        exx
+        adc     hl, de
+.b7:
+        rr      h
+        rr      l
+        exx
+        rr      h
+        rr      l
+        exx
+        ret
+
+        ;; __log2_32
+        ;; inputs:  d in DE:HL (DE=low16, HL=high16)
+        ;; outputs: b = floor(log2(d)), 0 for d <= 1
+        ;;          z set if d is a power of two (or d <= 1)
+        ;; clobbers: af
+__log2_32::
+        push    hl
+        push    de
+        ld      b, #31
+.log2:
+        sla     e
+        rl      d
+        adc     hl, hl
+        jr      c, .log2_top
+        djnz    .log2
+        xor     a                                  ; d <= 1
+        jr      .log2_ret
+.log2_top:
+        ld      a, h                               ; bits under the top one
+        or      a, l
+        or      a, d
+        or      a, e
+.log2_ret:
+        pop     de
+        pop     hl
+        ret
+
+        ;; locals:
+        ;;  -4..-1  : d (lsb..msb)
+        ;;  -5      : l
+        ;;  -6      : k
+        ;;  -10..-7 : t = d - 2^l
+        ;;  -26..-11: __divu64 operands, x = 2^k << 32, then y = d
+
+        ;; __div32_magic
+        ;; inputs:  d in DE:HL (not a power of two), b = l = floor(log2(d)),
+        ;;          c = k, the exponent of the first try (l, or l - 1
+        ;;          for signed divisors)
+        ;; outputs: DE:HL = magic, c = more (k, or l | 0x40 with the add step)
+        ;; clobbers: af, b, bc', de', hl', iy
+        ;; notes: m = 2^(32 + k) / d + 1 is exact for all x when the
+        ;;        remainder leaves e = d - rem < 2^l. otherwise one more
+        ;;        bit is taken and the 33rd bit of m is put back by the
+        ;;        add step.
+__div32_magic::
+        push    ix
+        ld      ix, #0
+        add     ix, sp
+        push    hl                                 ; d high
+        push    de                                 ; d low
+        push    bc                                 ; l, k
+
+        call    .pow2                              ; hl:de = 2^l
+        ld      a, e
+        xor     a, -4(ix)
+        ld      e, a
+        ld      a, d
+        xor     a, -3(ix)
+        ld      d, a
+        ld      a, l
+        xor     a, -2(ix)
+        ld      l, a
+        ld      a, h
+        xor     a, -1(ix)
+        ld      h, a
+        push    hl
+        push    de                                 ; t
+
+        ld      hl, #0
+        push    hl
+        push    hl                                 ; y high = 0
+        ld      l, -2(ix)
+        ld      h, -1(ix)
+        push    hl
+        ld      l, -4(ix)
+        ld      h, -3(ix)
+        push    hl                                 ; y low = d
+        ld      b, -6(ix)
+        call    .pow2
+        push    hl
+        push    de                                 ; x high = 2^k
+        ld      hl, #0
+        push    hl
+        push    hl                                 ; x low = 0
+        ld      iy, #0
+        add     iy, sp
+        call    __divu64                           ; pm at 0(iy), rem in de:hl
+
+        ld      a, -10(ix)                         ; e < 2^l <=> t < rem
+        sub     a, l
+        ld      a, -9(ix)
+        sbc     a, h
+        ld      a, -8(ix)
+        sbc     a, e
+        ld      a, -7(ix)
+        sbc     a, d
+        ld      c, -6(ix)                          ; more = k
+        jr      c, .one
+        add     hl, hl
+        ex      de, hl
+        adc     hl, hl
+        ex      de, hl                             ; 2 rem, cf = bit 32
+        jr      c, .up
+        ld      a, l
+        sub     a, -4(ix)
+        ld      a, h
+        sbc     a, -3(ix)
+        ld      a, e
+        sbc     a, -2(ix)
+        ld      a, d
+        sbc     a, -1(ix)
+        ccf                                        ; cf = 2 rem >= d
+.up:
+        rl      0(iy)
+        rl      1(iy)
+        rl      2(iy)
+        rl      3(iy)                              ; pm = 2 pm + cf
+        ld      a, -5(ix)
+        or      a, #0x40
+        ld      c, a                               ; more = l | add
+.one:
+        ld      e, 0(iy)
+        ld      d, 1(iy)
+        ld      l, 2(iy)
+        ld      h, 3(iy)
+        inc     de                                 ; magic = pm + 1
+        ld      a, d
+        or      a, e
+        jr      nz, .done
+        inc     hl
+.done:
+        ld      sp, ix
+        pop     ix
+        ret
+
+        ;; hl:de = 2^b, b < 32
+.pow2:
+        ld      hl, #0
+        ld      de, #1
+        inc     b
+        jr      .pow2_next
+.pow2_loop:
+        sla     e
+        rl      d
+        adc     hl, hl
+.pow2_next:
+        djnz    .pow2_loop
+        ret
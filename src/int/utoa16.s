@@ -0,0 +1,119 @@
+        ;; 16-bit integer to decimal text
+        ;;
+        ;; digits come from subtracting a power of ten until the value
+        ;; wraps, 10000, 1000 and 100 in 16 bits, the tens and units in 8
+        ;; bits. leading zeros are skipped by comparing x once against
+        ;; 10000, 1000, 100 and 10 and entering the chain at the first
+        ;; digit, there is no per-digit test. a digit costs 150-350
+        ;; T-states against a __divuint and a __moduint per digit for
+        ;; C's x / 10 and x % 10.
+        ;;
+        ;; C entry points (see include/numconv.h), sdcccall(1):
+        ;;   char *utoa16(unsigned int x, char *buf);
+        ;;   char *itoa(int x, char *buf);
+        ;;
+        ;; also provides __utoa16_4 for utoa32.s.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module utoa16
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _utoa16
+        .globl  _itoa
+        .globl  __utoa16_4
+
+        ;; _itoa
+        ;; inputs:  hl = x, de = buf
+        ;; outputs: buf = [-]digits of x and a 0, de = pointer to the 0
+        ;; clobbers: af, bc, hl
+_itoa:
+        bit     7, h
+        jr      z, _utoa16
+        ld      a, #0x2D                           ; '-'
+        ld      (de), a
+        inc     de
+        xor     a
+        sub     l
+        ld      l, a
+        sbc     a, a
+        sub     h
+        ld      h, a                               ; hl = -x, 32768 as unsigned
+        ;; fall through to _utoa16
+
+        ;; _utoa16
+        ;; inputs:  hl = x, de = buf
+        ;; outputs: buf = digits of x and a 0, de = pointer to the 0
+        ;; clobbers: af, bc, hl
+_utoa16:
+        ld      a, h
+        or      a
+        jr      nz, .wide
+        ld      a, l
+        cp      #100
+        jr      nc, .d100
+        cp      #10
+        jr      nc, .d10
+        add     a, #0x30
+        jr      .last
+.wide:
+        ld      a, l
+        sub     #0x10
+        ld      a, h
+        sbc     a, #0x27
+        jr      c, .lt10000                        ; x < 10000
+        ld      bc, #-10000
+        call    .digit
+        jr      __utoa16_4
+.lt10000:
+        ld      a, l
+        sub     #0xE8
+        ld      a, h
+        sbc     a, #0x03
+        jr      c, .d100                           ; x < 1000
+
+        ;; __utoa16_4
+        ;; inputs:  hl = x < 10000, de = buf
+        ;; outputs: buf = x as exactly 4 digits and a 0, de = pointer to the 0
+        ;; clobbers: af, bc, hl
+__utoa16_4:
+        ld      bc, #-1000
+        call    .digit
+.d100:
+        ld      bc, #-100
+        call    .digit
+        ld      a, l                               ; x < 100 from here on
+.d10:
+        ld      b, #0x2F                           ; '0' - 1
+.tens:
+        inc     b
+        sub     #10
+        jr      nc, .tens
+        add     a, #0x3A                           ; '0' + 10
+        ld      c, a
+        ld      a, b
+        ld      (de), a
+        inc     de
+        ld      a, c
+.last:
+        ld      (de), a
+        inc     de
+        xor     a
+        ld      (de), a
+        ret
+
+        ;; (de++) = '0' + hl / p, hl = hl % p for bc = -p
+        ;; clobbers: af
+.digit:
+        ld      a, #0x2F
+.sub:
+        inc     a
+        add     hl, bc
+        jr      c, .sub
+        sbc     hl, bc                             ; cf clear: hl += p
+        ld      (de), a
+        inc     de
+        ret
@@ -0,0 +1,107 @@
+        ;; 32-bit integer to decimal text
+        ;;
+        ;; the digits for 10^9 .. 10^4 come from 32-bit subtraction of a
+        ;; power of ten until the value wraps, the rest is < 10000 and goes
+        ;; to __utoa16_4. leading zeros are the digits computed before the
+        ;; first non-zero one, they are not written. x < 65536 is handed to
+        ;; utoa16 whole.
+        ;;
+        ;; C entry point (see include/numconv.h), sdcccall(1):
+        ;;   char *utoa32(unsigned long x, char *buf);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module utoa32
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _utoa32
+        .globl  _utoa16
+        .globl  __utoa16_4
+
+        ;; _utoa32
+        ;; inputs:  x in HL:DE (HL=high16, DE=low16), buf at 2(sp)
+        ;; outputs: buf = digits of x and a 0, de = pointer to the 0
+        ;; clobbers: af, bc, de, hl, bc', de', hl', iy
+        ;; notes: callee cleans buf from stack
+_utoa32:
+        pop     bc                                 ; return address
+        pop     iy                                 ; iy = buf
+        push    bc
+        ld      a, h
+        or      a, l
+        jr      nz, .wide
+        ex      de, hl                             ; x < 65536
+        push    iy
+        pop     de
+        jp      _utoa16
+.wide:
+        push    de
+        exx
+        pop     hl                                 ; hl' = x low
+        ld      e, #6                              ; e' = powers left
+        exx
+        push    iy
+        pop     de                                 ; de = buf
+        ld      iy, #.pow_tab
+.lead:
+        call    .digit                             ; x >= 65536: stops at 10^4
+        cp      #0x30
+        jr      nz, .put
+        call    .next
+        jr      .lead
+.put:
+        ld      (de), a
+        inc     de
+        call    .next
+        jr      z, .low
+        call    .digit
+        jr      .put
+.low:
+        exx
+        push    hl
+        exx
+        pop     hl                                 ; hl = x % 10000
+        jp      __utoa16_4
+
+        ;; iy to the next power, z after the last one
+        ;; clobbers: f, bc
+.next:
+        ld      bc, #4
+        add     iy, bc
+        exx
+        dec     e
+        exx
+        ret
+
+        ;; a = '0' + x / p, x = x % p for -p at iy
+        ;; clobbers: f, bc, bc'
+.digit:
+        ld      c, 2(iy)
+        ld      b, 3(iy)
+        exx
+        ld      c, 0(iy)
+        ld      b, 1(iy)
+        ld      a, #0x2F                           ; '0' - 1
+.sub:
+        inc     a
+        add     hl, bc
+        exx
+        adc     hl, bc
+        exx
+        jr      c, .sub
+        sbc     hl, bc                             ; cf clear: x += p
+        exx
+        sbc     hl, bc
+        ret
+
+        ;; -10^9 .. -10^4, lsb first
+.pow_tab:
+        .db     0x00, 0x36, 0x65, 0xc4
+        .db     0x00, 0x1f, 0x0a, 0xfa
+        .db     0x80, 0x69, 0x67, 0xff
+        .db     0xc0, 0xbd, 0xf0, 0xff
+        .db     0x60, 0x79, 0xfe, 0xff
+        .db     0xf0, 0xd8, 0xff, 0xff
@@ -0,0 +1,19 @@
+        ;; default bank port for the banked call helpers
+        ;;
+        ;; linked only when the program does not define __bank_port and
+        ;; __bank_mask itself (see banked_call.s). a mask of 0 makes
+        ;; every banked call a plain call into flat memory.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module bank_cfg
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  __bank_port
+        .globl  __bank_mask
+
+        __bank_port == 0x0000
+        __bank_mask == 0x00
@@ -5,10 +5,44 @@
         ;; is followed by a 4-byte inline descriptor:
         ;;   [+0..+1] target function address (little-endian)
         ;;   [+2..+3] target bank number     (little-endian)
+        ;; ___sdcc_bcall_ehl takes the bank in e and the address in hl.
         ;;
-        ;; NOTE: bank switching is platform-specific. the two hook
-        ;; points (.switch_bank / .restore_bank) must be adapted to
-        ;; your hardware. as written they are no-ops (flat memory).
+        ;; the bank register is an output port. the program defines two
+        ;; absolute symbols at link time, in any of its own modules:
+        ;;   __bank_port == 0x00FE       ; port address, for out (c),a
+        ;;   __bank_mask == 0x07         ; port bits that select the bank
+        ;; without them bank_cfg.s supplies a mask of 0: banked calls,
+        ;; bank_init() and bank_sync() never touch the port and memory
+        ;; stays flat.
+        ;;
+        ;; __bank_cur shadows the last value written to the port, so
+        ;; the bank id in e (or the descriptor) is the port value of the
+        ;; bank: its bits already in place, the bits outside the mask
+        ;; are kept. a call whose bank is already mapped skips the port
+        ;; write. every banked call pushes the port value it found and
+        ;; the address of __sdcc_banked_ret under the target's return,
+        ;; so the machine stack is the bank stack and the target sees
+        ;; its stack arguments 4 bytes further up, like the stock
+        ;; runtime. __sdcc_banked_ret pops the value and writes it back
+        ;; only when it differs.
+        ;;
+        ;; the shadow is written just before the port. an interrupt
+        ;; handler that calls banked code should start with bank_sync()
+        ;; (see include/bank.h).
+        ;;
+        ;; BANK_PROFILE=on counts every banked call in __bank_prof, a
+        ;; table keyed by target address, target bank, caller bank and
+        ;; call site (the return address). test/sim/bankplan reads it
+        ;; from a z80sim memory dump. layout, little-endian:
+        ;;   +0     used entries          +1  BANK_PROF_SLOTS
+        ;;   +2..3  calls that found the table full (saturates)
+        ;;   +4     entries of 10 bytes: target address, target bank,
+        ;;          caller bank, call site, 32-bit count
+        ;; bank_init() empties the table.
+        ;;
+        ;; C entry points (see include/bank.h), sdcccall(1):
+        ;;   void bank_init(unsigned char value);
+        ;;   void bank_sync(void);
         ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2026 tomaz stih
@@ -16,13 +50,36 @@
         .module banked_call
         .optsdcc -mz80 sdcccall(1)
 
+        .include "config.inc"
+
+        BANK_PROF_SLOTS = 96
+        BANK_PROF_KEY   = 6
+        BANK_PROF_ENTRY = 10
+
+        .area   _DATA
+
+__bank_cur:
+        .ds     1
+.if BANK_PROFILE
+__bank_prof:
+        .ds     4 + BANK_PROF_SLOTS * BANK_PROF_ENTRY
+.endif
+
         .area   _CODE
 
+        .globl  __bank_cur
+        .globl  _bank_init
+        .globl  _bank_sync
         .globl  ___sdcc_bcall
         .globl  ___sdcc_bcall_ehl
         .globl  __sdcc_bcall
         .globl  __sdcc_banked_call
         .globl  __sdcc_banked_ret
+        .globl  __bank_port
+        .globl  __bank_mask
+.if BANK_PROFILE
+        .globl  __bank_prof
+.endif
 
 ___sdcc_bcall:
         ;; __sdcc_bcall
@@ -32,54 +89,200 @@ __sdcc_bcall:
         ;; __sdcc_banked_call
         ;; inputs:  inline 4-byte descriptor after call (addr + bank)
         ;; outputs: n/a (calls target, then returns past descriptor)
-        ;; clobbers: af (others depend on target)
+        ;; clobbers: af, bc, de, hl (others depend on target)
 __sdcc_banked_call:
         pop     hl              ; hl = pointer to inline descriptor
-
-        ;; read target address
-        ld      e, (hl)
+        ld      c, (hl)
         inc     hl
-        ld      d, (hl)         ; de = target function address
+        ld      b, (hl)         ; bc = target function address
         inc     hl
-
-        ;; read target bank
-        ld      c, (hl)
+        ld      e, (hl)         ; e = target bank, high byte unused
         inc     hl
-        ld      b, (hl)         ; bc = target bank number
         inc     hl
-
-        ;; hl now points past the descriptor (our true return address)
-        push    hl              ; push return address past descriptor
-
-        ;; ---- platform hook: switch to bank bc ----
-        ;; replace the nops below with your bank switching logic
-        ;; e.g. ld a, c / out (BANK_PORT), a
-        nop
-        nop
-        ;; ---- end platform hook ----
-
-        ;; call the target function
-        push    de
-        pop     hl              ; hl = target address
-        jp      (hl)
+        push    hl              ; return address past descriptor
+        ld      l, c
+        ld      h, b
 
         ;; ___sdcc_bcall_ehl
-        ;; banked-call helper variant used by some sdcc large-model paths:
-        ;;   e = bank id, hl = target address.
-        ;; with flat-memory default hooks this degrades to an indirect jump.
+        ;; inputs:  e = target bank, hl = target address
+        ;; outputs: n/a (calls target, returns through __sdcc_banked_ret)
+        ;; clobbers: af, bc, d (others depend on target)
 ___sdcc_bcall_ehl:
+.if BANK_PROFILE
+        call    .count
+.endif
+        ld      a, (__bank_cur)
+        push    af              ; bank stack: port value of the caller
+        ld      bc, #__sdcc_banked_ret
+        push    bc
+        ld      d, a
+        xor     e
+        and     #<__bank_mask
+        jr      z, .mapped      ; target bank already mapped
+        xor     d               ; a = caller value, bank bits from e
+        ld      (__bank_cur), a
+        ld      bc, #__bank_port
+        out     (c), a
+.mapped:
         jp      (hl)
 
         ;; __sdcc_banked_ret
-        ;; inputs:  n/a
+        ;; inputs:  caller port value on the stack
         ;; outputs: n/a (returns to caller with bank restored)
-        ;; clobbers: af
+        ;; clobbers: bc, af' (a, de and hl carry the return value)
 __sdcc_banked_ret:
+        ex      af, af'
+        pop     af              ; a = caller port value
+        ld      b, a
+        ld      a, (__bank_cur)
+        cp      b
+        jr      z, .same
+        ld      a, b
+        ld      (__bank_cur), a
+        ld      bc, #__bank_port
+        out     (c), a
+.same:
+        ex      af, af'
+        ret
 
-        ;; ---- platform hook: restore previous bank ----
-        ;; replace the nops below with your bank restore logic
-        nop
-        nop
-        ;; ---- end platform hook ----
+        ;; _bank_sync
+        ;; inputs:  n/a
+        ;; outputs: port = __bank_cur
+        ;; clobbers: af, bc
+_bank_sync:
+        ld      a, (__bank_cur)
+        jr      .write
+
+        ;; _bank_init
+        ;; inputs:  a = port value
+        ;; outputs: port = __bank_cur = a, __bank_prof empty
+        ;; clobbers: bc, hl
+_bank_init:
+.if BANK_PROFILE
+        ld      hl, #__bank_prof
+        ld      (hl), #0
+        inc     hl
+        ld      (hl), #BANK_PROF_SLOTS
+        inc     hl
+        ld      (hl), #0
+        inc     hl
+        ld      (hl), #0
+.endif
+.write:
+        ld      (__bank_cur), a
+        ld      b, a
+        ld      a, #<__bank_mask
+        or      a
+        ld      a, b
+        ret     z               ; flat memory, no port
+        ld      bc, #__bank_port
+        out     (c), a
+        ret
 
+.if BANK_PROFILE
+        ;; .count
+        ;; inputs:  e = target bank, hl = target address, call site
+        ;;          at 2(sp) (the return address of ___sdcc_bcall_ehl)
+        ;; outputs: the matching __bank_prof entry counts one more call
+        ;; clobbers: af, bc
+.count:
+        push    hl
+        push    de
+        ld      hl, #6
+        add     hl, sp
+        ld      c, (hl)
+        inc     hl
+        ld      b, (hl)
+        push    bc              ; key +4: call site
+        ld      a, (__bank_cur)
+        and     #<__bank_mask
+        ld      d, a
+        ld      a, e
+        and     #<__bank_mask
+        ld      e, a
+        push    de              ; key +2: target bank, caller bank
+        ld      hl, #6
+        add     hl, sp
+        ld      a, (hl)
+        inc     hl
+        ld      h, (hl)
+        ld      l, a
+        push    hl              ; key +0: target address
+        ld      hl, #0
+        add     hl, sp
+        ex      de, hl          ; de = key
+        ld      hl, #__bank_prof
+        ld      b, (hl)
+        inc     b
+        ld      hl, #__bank_prof + 4
+.slot:
+        dec     b
+        jr      z, .new
+        push    hl
+        push    de
+        ld      c, #BANK_PROF_KEY
+.cmp:
+        ld      a, (de)
+        cp      (hl)
+        jr      nz, .miss
+        inc     de
+        inc     hl
+        dec     c
+        jr      nz, .cmp
+        pop     de
+        pop     af              ; drop the entry pointer, hl = count
+        inc     (hl)
+        jr      nz, .done
+        inc     hl
+        inc     (hl)
+        jr      nz, .done
+        inc     hl
+        inc     (hl)
+        jr      nz, .done
+        inc     hl
+        inc     (hl)
+        jr      .done
+.miss:
+        pop     de
+        pop     hl
+        ld      a, #BANK_PROF_ENTRY
+        add     a, l
+        ld      l, a
+        adc     a, h
+        sub     l
+        ld      h, a            ; next entry
+        jr      .slot
+.new:
+        ld      a, (__bank_prof)
+        cp      #BANK_PROF_SLOTS
+        jr      nc, .full
+        inc     a
+        ld      (__bank_prof), a
+        ex      de, hl
+        ld      bc, #BANK_PROF_KEY
+        ldir
+        ex      de, hl
+        ld      (hl), #1
+        xor     a
+        inc     hl
+        ld      (hl), a
+        inc     hl
+        ld      (hl), a
+        inc     hl
+        ld      (hl), a
+        jr      .done
+.full:
+        ld      hl, (__bank_prof + 2)
+        inc     hl
+        ld      a, h
+        or      l
+        jr      z, .done        ; saturated
+        ld      (__bank_prof + 2), hl
+.done:
+        pop     hl              ; key
+        pop     hl
+        pop     hl
+        pop     de
+        pop     hl
         ret
+.endif
@@ -6,12 +6,23 @@
         ;;   ei
         ;; no_ei:
         ;;
+        ;; on an NMOS z80 `ld a,i` reads P/V as 0 when an interrupt is
+        ;; accepted during the instruction. CRITICAL_NMOS=on leaves a
+        ;; zero word below sp first; when P/V reads 0 and the word was
+        ;; overwritten, an interrupt pushed its return address there, so
+        ;; they were on. an NMI that lands between writing the word and
+        ;; reading it back while interrupts are off also overwrites it,
+        ;; and the caller then enables them on exit. the word is read
+        ;; back right after `di` to keep that window short.
+        ;;
         ;; gpl-2.0-or-later (see: LICENSE)
         ;; copyright (c) 2026 tomaz stih
 
         .module critical
         .optsdcc -mz80 sdcccall(1)
 
+        .include "config.inc"
+
         .area   _CODE
 
         .globl  ___sdcc_critical
@@ -20,9 +31,34 @@
 ___sdcc_critical:
         ;; __sdcc_critical
         ;; inputs:  n/a
-        ;; outputs: A = I register, P/V reflects previous IFF2
+        ;; outputs: P/V = previous IFF2, interrupts disabled
         ;; clobbers: A, F
 __sdcc_critical:
+.if CRITICAL_NMOS
+        push    hl
+        ld      hl, #0
+        push    hl
+        pop     hl              ; 0 just below sp
+        ld      a, i
+        di
+        dec     sp
+        dec     sp
+        pop     hl              ; still 0 unless an interrupt came in
+        jp      pe, .was_on
+        ld      a, h
+        or      l
+        jr      nz, .taken
+        inc     a               ; a = 1: P/V = 0, were off
+        or      a
+        pop     hl
+        ret
+.taken:
+        xor     a               ; P/V = 1, were on
+.was_on:
+        pop     hl
+        ret
+.else
         ld      a, i
         di
         ret
+.endif
@@ -0,0 +1,220 @@
+        ;; nesting critical sections for sdcc z80
+        ;;
+        ;; critical_enter and critical_exit pair up and nest. only the
+        ;; outermost enter disables interrupts, sampling the previous
+        ;; state with ___sdcc_critical (safe on NMOS parts with
+        ;; CRITICAL_NMOS=on), and only the
+        ;; matching exit enables them again, if they were on. inner
+        ;; levels just count. works in interrupt handlers too: there the
+        ;; sample reads off and the exit keeps them off.
+        ;;
+        ;; CRITICAL_PROFILE=on latches the z80sim T-state counter (ports
+        ;; 0xF4..0xF7) at the outermost enter and exit and keeps the
+        ;; count, total and longest time interrupts were held off by
+        ;; these sections, exit included. critical_stats() reads and
+        ;; clears them; without the option it returns zeros.
+        ;;
+        ;; C entry points (see include/critical.h), sdcccall(1):
+        ;;   void critical_enter(void);
+        ;;   void critical_exit(void);
+        ;;   void critical_stats(critical_stats_t *s);
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module critical_nest
+        .optsdcc -mz80 sdcccall(1)
+
+        .include "config.inc"
+
+        COUNTER_PORT    = 0xF4
+
+        .area   _DATA
+
+__crit_depth:
+        .ds     1
+__crit_on:
+        .ds     1
+.if CRITICAL_PROFILE
+__crit_t0:
+        .ds     4
+__crit_stats:
+        .ds     12              ; count, total, max
+.endif
+
+        .area   _CODE
+
+        .globl  _critical_enter
+        .globl  _critical_exit
+        .globl  _critical_stats
+        .globl  ___sdcc_critical
+
+        ;; _critical_enter
+        ;; inputs:  n/a
+        ;; outputs: interrupts disabled, one level deeper
+        ;; clobbers: af (and hl with CRITICAL_PROFILE=on)
+_critical_enter:
+        ld      a, (__crit_depth)
+        or      a
+        jr      nz, .nested
+        call    ___sdcc_critical
+        ld      a, #0
+        jp      po, .off
+        inc     a
+.off:
+        ld      (__crit_on), a
+.if CRITICAL_PROFILE
+        ld      hl, #__crit_t0
+        call    .now
+.endif
+        ld      a, #1
+        ld      (__crit_depth), a
+        ret
+.nested:
+        inc     a
+        ld      (__crit_depth), a
+        ret
+
+        ;; _critical_exit
+        ;; inputs:  n/a
+        ;; outputs: one level out, interrupts back on after the outermost
+        ;; clobbers: af, hl (and bc, de with CRITICAL_PROFILE=on)
+_critical_exit:
+        ld      hl, #__crit_depth
+        dec     (hl)
+        ret     nz
+.if CRITICAL_PROFILE
+        call    .account
+.endif
+        ld      a, (__crit_on)
+        or      a
+        ret     z
+        ei
+        ret
+
+        ;; _critical_stats
+        ;; inputs:  hl = s
+        ;; outputs: *s = count, total and max T-states, then cleared
+        ;; clobbers: af, bc, de, hl
+_critical_stats:
+.if CRITICAL_PROFILE
+        ex      de, hl
+        call    ___sdcc_critical
+        push    af
+        ld      hl, #__crit_stats
+        ld      bc, #12
+        ldir
+        ld      hl, #__crit_stats
+        ld      b, #12
+.clear:
+        ld      (hl), #0
+        inc     hl
+        djnz    .clear
+        pop     af
+        ret     po
+        ei
+        ret
+.else
+        ld      b, #12
+.zero:
+        ld      (hl), #0
+        inc     hl
+        djnz    .zero
+        ret
+.endif
+
+.if CRITICAL_PROFILE
+        ;; .now
+        ;; inputs:  hl = 4 bytes
+        ;; outputs: (hl) = T-state counter, hl advanced by 4
+        ;; clobbers: af
+.now:
+        in      a, (COUNTER_PORT)
+        ld      (hl), a
+        inc     hl
+        in      a, (COUNTER_PORT + 1)
+        ld      (hl), a
+        inc     hl
+        in      a, (COUNTER_PORT + 2)
+        ld      (hl), a
+        inc     hl
+        in      a, (COUNTER_PORT + 3)
+        ld      (hl), a
+        inc     hl
+        ret
+
+        ;; .account
+        ;; inputs:  __crit_t0 = counter at the outermost enter
+        ;; outputs: count += 1, total += dt, max = max(max, dt)
+        ;; clobbers: af, bc, de, hl
+.account:
+        ld      hl, #__crit_t0
+        in      a, (COUNTER_PORT)
+        sub     (hl)
+        ld      e, a
+        inc     hl
+        in      a, (COUNTER_PORT + 1)
+        sbc     a, (hl)
+        ld      d, a
+        inc     hl
+        in      a, (COUNTER_PORT + 2)
+        sbc     a, (hl)
+        ld      c, a
+        inc     hl
+        in      a, (COUNTER_PORT + 3)
+        sbc     a, (hl)
+        ld      b, a            ; bcde = dt
+        inc     hl              ; hl = count
+        ld      a, #1
+        add     a, (hl)
+        ld      (hl), a
+        inc     hl
+        ld      a, #0
+        adc     a, (hl)
+        ld      (hl), a
+        inc     hl
+        ld      a, #0
+        adc     a, (hl)
+        ld      (hl), a
+        inc     hl
+        ld      a, #0
+        adc     a, (hl)
+        ld      (hl), a
+        inc     hl              ; hl = total
+        ld      a, e
+        add     a, (hl)
+        ld      (hl), a
+        inc     hl
+        ld      a, d
+        adc     a, (hl)
+        ld      (hl), a
+        inc     hl
+        ld      a, c
+        adc     a, (hl)
+        ld      (hl), a
+        inc     hl
+        ld      a, b
+        adc     a, (hl)
+        ld      (hl), a
+        inc     hl              ; hl = max
+        ld      a, e
+        sub     (hl)
+        inc     hl
+        ld      a, d
+        sbc     a, (hl)
+        inc     hl
+        ld      a, c
+        sbc     a, (hl)
+        inc     hl
+        ld      a, b
+        sbc     a, (hl)
+        ret     c               ; dt < max
+        ld      (hl), b
+        dec     hl
+        ld      (hl), c
+        dec     hl
+        ld      (hl), d
+        dec     hl
+        ld      (hl), e
+        ret
+.endif
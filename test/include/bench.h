@@ -0,0 +1,16 @@
+/*
+ * benchmark probe declarations (z80sim cycle counter)
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+/* start timing every call to target; label names the result row */
+extern void bench_begin(const char *label, void *target);
+
+/* close the phase; the simulator prints calls, min, avg and max T-states */
+extern void bench_end(void);
+
+#endif /* __BENCH_H__ */
@@ -16,5 +16,7 @@ typedef int             int16_t;
 typedef unsigned int    uint16_t;
 typedef long            int32_t;
 typedef unsigned long   uint32_t;
+typedef long long       int64_t;
+typedef unsigned long long uint64_t;
 
 #endif /* __STDINT_H_ */
\ No newline at end of file
@@ -0,0 +1,31 @@
+#!/bin/sh
+#
+# run_bench.sh
+#
+# Build the host-side z80sim and run bench.com under it.
+# Results (calls, min/avg/max T-states per helper) go to bin/bench.txt.
+#
+# Usage: run_bench.sh
+#   BIN_DIR  - directory holding bench.com (default: /src/bin)
+#
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+BINDIR=${BIN_DIR:-/src/bin}
+COMFILE="${BINDIR}/bench.com"
+OUTFILE="${BINDIR}/bench.txt"
+
+if [ ! -f "$COMFILE" ]; then
+    printf "SKIP bench: %s not found\n" "$COMFILE"
+    exit 1
+fi
+
+make -s -C "${ROOT}/test/sim" BIN_DIR="$BINDIR" all test || exit 1
+
+printf "Running bench ...\n"
+"${BINDIR}/z80sim" "$COMFILE" > "$OUTFILE" || exit 1
+
+printf "=== bench ===\n"
+cat "$OUTFILE"
+
+# self checks in the benchmark print a FAIL line
+! grep -q "^FAIL" "$OUTFILE"
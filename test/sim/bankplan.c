@@ -0,0 +1,456 @@
+/*
+ * bankplan.c
+ *
+ * proposes a module-to-bank placement from a banked call profile.
+ *
+ * a library built with BANK_PROFILE=on counts every banked call in
+ * __bank_prof (see src/runtime/banked_call.s): target address, target
+ * bank, caller bank, call site and count. bankplan reads that table
+ * from a z80sim memory dump (-d), names targets and call sites through
+ * the sdldz80 .map, and weighs every pair of banked modules by the
+ * calls between them. sdcc banks whole modules (#pragma bank,
+ * --codeseg), so modules are the unit of placement.
+ *
+ * placement is greedy: module pairs are merged heaviest first as long
+ * as the group still fits the largest bank, then the groups are packed
+ * into the banks largest first. it prints the switches between banked
+ * modules before and after, and one line per module with its pragma
+ * and codeseg.
+ *
+ * a symbol is banked if its area name ends in a bank number (BANK3,
+ * _CODE_3) or its address is above 0xFFFF (bank in bits 16 and up).
+ * calls from common code are reported but do not move modules.
+ *
+ * usage: bankplan [-b banks] [-s bytes] program.map dump.bin
+ *   -b 1,2,3       banks to fill (default: the banks in the map)
+ *   -s 16384       bank size, or one size per bank: -s 16384,8192
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+
+#define NAME_MAX_LEN 64
+#define MAX_BANKS    256
+#define PROF_ENTRY   10
+
+/* ---------- map ---------- */
+
+typedef struct sym_s {
+    char     name[NAME_MAX_LEN];
+    int      mod;
+    int      area;
+    uint32_t addr;
+    uint32_t size;
+    int      bank;              /* -1: common */
+} sym_t;
+
+typedef struct area_s {
+    char     name[NAME_MAX_LEN];
+    uint32_t addr, size;
+    int      bank;
+} area_t;
+
+typedef struct mod_s {
+    char     name[NAME_MAX_LEN];
+    uint32_t size;              /* bytes in banked areas */
+    int      bank;              /* current bank, -1: common */
+    int      group;             /* union-find parent */
+    uint32_t group_size;
+    int      plan;              /* proposed bank */
+} mod_t;
+
+static sym_t  *syms;
+static int     nsyms, cap_syms;
+static area_t *areas;
+static int     nareas, cap_areas;
+static mod_t  *mods;
+static int     nmods, cap_mods;
+
+static void *grow(void *p, int *cap, size_t elem)
+{
+    *cap = *cap ? *cap * 2 : 64;
+    p = realloc(p, (size_t)*cap * elem);
+    if (!p) {
+        perror("bankplan");
+        exit(2);
+    }
+    return p;
+}
+
+static int is_hex(const char *s)
+{
+    size_t n = strlen(s);
+    if (n != 4 && n != 8)
+        return 0;
+    while (*s)
+        if (!isxdigit((unsigned char)*s++))
+            return 0;
+    return 1;
+}
+
+/* trailing digits of an area name, -1 if none */
+static int area_bank(const char *name)
+{
+    size_t n = strlen(name);
+    if (n == 0 || !isdigit((unsigned char)name[n - 1]))
+        return -1;
+    while (n && isdigit((unsigned char)name[n - 1]))
+        n--;
+    return atoi(name + n);
+}
+
+static int find_mod(const char *name)
+{
+    int i;
+    for (i = 0; i < nmods; i++)
+        if (!strcmp(mods[i].name, name))
+            return i;
+    if (nmods == cap_mods)
+        mods = grow(mods, &cap_mods, sizeof(*mods));
+    memset(&mods[nmods], 0, sizeof(*mods));
+    snprintf(mods[nmods].name, NAME_MAX_LEN, "%s", name);
+    mods[nmods].bank = -1;
+    return nmods++;
+}
+
+static int cmp_sym(const void *a, const void *b)
+{
+    const sym_t *x = a, *y = b;
+    if (x->area != y->area)
+        return x->area - y->area;
+    return x->addr < y->addr ? -1 : x->addr > y->addr;
+}
+
+/*
+ * area lines:   _CODE   00000200   00001234 =   4660. bytes (REL,CON)
+ * symbol lines:      00000200  _main     main
+ */
+static void load_map(const char *path)
+{
+    char line[512], t[4][NAME_MAX_LEN];
+    FILE *fp = fopen(path, "r");
+    int i, n, area = -1;
+
+    if (!fp) {
+        perror(path);
+        exit(2);
+    }
+    while (fgets(line, sizeof(line), fp)) {
+        n = sscanf(line, "%63s %63s %63s %63s", t[0], t[1], t[2], t[3]);
+        if (n >= 3 && is_hex(t[1]) && is_hex(t[2]) && strstr(line, "bytes")) {
+            if (nareas == cap_areas)
+                areas = grow(areas, &cap_areas, sizeof(*areas));
+            snprintf(areas[nareas].name, NAME_MAX_LEN, "%s", t[0]);
+            areas[nareas].addr = (uint32_t)strtoul(t[1], NULL, 16);
+            areas[nareas].size = (uint32_t)strtoul(t[2], NULL, 16);
+            areas[nareas].bank = area_bank(t[0]);
+            if (areas[nareas].bank < 0 && areas[nareas].addr > 0xFFFF)
+                areas[nareas].bank = (int)(areas[nareas].addr >> 16);
+            area = nareas++;
+            continue;
+        }
+        if (area < 0 || areas[area].name[0] == '.' || n < 2 || !is_hex(t[0])
+                || !strncmp(t[1], "l_", 2) || !strncmp(t[1], "s_", 2))
+            continue;
+        if (nsyms == cap_syms)
+            syms = grow(syms, &cap_syms, sizeof(*syms));
+        snprintf(syms[nsyms].name, NAME_MAX_LEN, "%s", t[1]);
+        syms[nsyms].mod = find_mod(n >= 3 ? t[2] : "?");
+        syms[nsyms].area = area;
+        syms[nsyms].addr = (uint32_t)strtoul(t[0], NULL, 16);
+        syms[nsyms].bank = areas[area].bank;
+        if (syms[nsyms].bank < 0 && syms[nsyms].addr > 0xFFFF)
+            syms[nsyms].bank = (int)(syms[nsyms].addr >> 16);
+        nsyms++;
+    }
+    fclose(fp);
+
+    /* a symbol runs up to the next one in its area */
+    qsort(syms, (size_t)nsyms, sizeof(*syms), cmp_sym);
+    for (i = 0; i < nsyms; i++) {
+        const area_t *a = &areas[syms[i].area];
+        uint32_t end = a->addr + a->size;
+        if (i + 1 < nsyms && syms[i + 1].area == syms[i].area)
+            end = syms[i + 1].addr;
+        syms[i].size = end > syms[i].addr ? end - syms[i].addr : 0;
+        if (syms[i].bank >= 0) {
+            mods[syms[i].mod].size += syms[i].size;
+            mods[syms[i].mod].bank = syms[i].bank;
+        }
+    }
+}
+
+static const sym_t *find_sym(const char *name)
+{
+    int i;
+    for (i = 0; i < nsyms; i++)
+        if (!strcmp(syms[i].name, name))
+            return &syms[i];
+    return NULL;
+}
+
+/* the symbol at or below addr in the given bank (-1: common) */
+static const sym_t *sym_at(uint16_t addr, int bank, int exact)
+{
+    const sym_t *best = NULL;
+    int i;
+    for (i = 0; i < nsyms; i++) {
+        const sym_t *s = &syms[i];
+        uint16_t lo = (uint16_t)s->addr;
+        if (s->bank != bank || areas[s->area].name[0] == '.')
+            continue;
+        if (exact ? lo != addr : (addr < lo || (uint32_t)(addr - lo) >= s->size))
+            continue;
+        if (!best || s->size > best->size)
+            best = s;
+    }
+    return best;
+}
+
+/* ---------- placement ---------- */
+
+static uint64_t *weight;        /* nmods x nmods, calls both ways */
+
+static int root(int m)
+{
+    while (mods[m].group != m)
+        m = mods[m].group = mods[mods[m].group].group;
+    return m;
+}
+
+typedef struct pair_s {
+    int      a, b;
+    uint64_t w;
+} pair_t;
+
+static int cmp_pair(const void *x, const void *y)
+{
+    const pair_t *p = x, *q = y;
+    return p->w < q->w ? 1 : p->w > q->w ? -1 : 0;
+}
+
+static int cmp_group(const void *x, const void *y)
+{
+    const mod_t *p = &mods[*(const int *)x], *q = &mods[*(const int *)y];
+    return p->group_size < q->group_size ? 1 : p->group_size > q->group_size ? -1 : 0;
+}
+
+static uint64_t switches(int planned)
+{
+    uint64_t n = 0;
+    int a, b;
+    for (a = 0; a < nmods; a++)
+        for (b = a + 1; b < nmods; b++) {
+            int ba = planned ? mods[a].plan : mods[a].bank;
+            int bb = planned ? mods[b].plan : mods[b].bank;
+            if (mods[a].bank >= 0 && mods[b].bank >= 0 && ba != bb)
+                n += weight[a * nmods + b];
+        }
+    return n;
+}
+
+static int parse_list(const char *s, long *out, int max)
+{
+    int n = 0;
+    char *end;
+    while (*s && n < max) {
+        out[n++] = strtol(s, &end, 0);
+        if (end == s)
+            return -1;
+        s = *end == ',' ? end + 1 : end;
+    }
+    return n;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: bankplan [-b banks] [-s bytes] program.map dump.bin\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    const char *map = NULL, *dump = NULL, *blist = NULL, *slist = NULL;
+    static uint8_t mem[0x10000];
+    long banks[MAX_BANKS], sizes[MAX_BANKS], fill[MAX_BANKS];
+    int nbanks = 0, nsizes, i, m, *order;
+    uint64_t total = 0, from_common = 0, unknown = 0;
+    const sym_t *prof;
+    pair_t *pairs;
+    int npairs = 0, ngroups;
+    long largest = 0;
+    FILE *fp;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-b") && i + 1 < argc)
+            blist = argv[++i];
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+            slist = argv[++i];
+        else if (argv[i][0] == '-')
+            usage();
+        else if (!map)
+            map = argv[i];
+        else
+            dump = argv[i];
+    }
+    if (!map || !dump)
+        usage();
+
+    load_map(map);
+
+    fp = fopen(dump, "rb");
+    if (!fp) {
+        perror(dump);
+        return 2;
+    }
+    if (fread(mem, 1, sizeof(mem), fp) != sizeof(mem)) {
+        fprintf(stderr, "%s: expected a 64 KB z80sim dump\n", dump);
+        return 2;
+    }
+    fclose(fp);
+
+    prof = find_sym("__bank_prof");
+    if (!prof) {
+        fprintf(stderr, "%s: no __bank_prof, link a BANK_PROFILE=on library\n", map);
+        return 2;
+    }
+
+    /* ---- weigh module pairs ---- */
+    weight = calloc((size_t)nmods * (size_t)nmods, sizeof(*weight));
+    if (!weight) {
+        perror("bankplan");
+        return 2;
+    }
+    for (i = 0; i < mem[prof->addr]; i++) {
+        const uint8_t *e = &mem[(uint16_t)(prof->addr + 4 + i * PROF_ENTRY)];
+        uint16_t target = (uint16_t)(e[0] | e[1] << 8);
+        uint16_t site = (uint16_t)(e[4] | e[5] << 8);
+        uint32_t count = (uint32_t)e[6] | (uint32_t)e[7] << 8
+                       | (uint32_t)e[8] << 16 | (uint32_t)e[9] << 24;
+        /* site is the return address: a call at the very end of a
+           function returns to the first byte of the next symbol */
+        const sym_t *callee = sym_at(target, e[2], 1);
+        const sym_t *caller = sym_at((uint16_t)(site - 1), e[3], 0);
+        total += count;
+        if (!caller)
+            caller = sym_at((uint16_t)(site - 1), -1, 0);
+        if (!callee || !caller) {
+            unknown += count;
+            continue;
+        }
+        if (caller->bank < 0) {
+            from_common += count;
+            continue;
+        }
+        weight[caller->mod * nmods + callee->mod] += count;
+        weight[callee->mod * nmods + caller->mod] += count;
+    }
+    if (mem[(uint16_t)(prof->addr + 2)] | mem[(uint16_t)(prof->addr + 3)])
+        fprintf(stderr, "bankplan: __bank_prof was full, %u calls not counted\n",
+                mem[(uint16_t)(prof->addr + 2)] | mem[(uint16_t)(prof->addr + 3)] << 8);
+
+    /* ---- banks and their sizes ---- */
+    if (blist) {
+        nbanks = parse_list(blist, banks, MAX_BANKS);
+        if (nbanks <= 0)
+            usage();
+    } else {
+        for (m = 0; m < nmods; m++) {
+            int seen = 0;
+            if (mods[m].bank < 0)
+                continue;
+            for (i = 0; i < nbanks; i++)
+                seen |= banks[i] == mods[m].bank;
+            if (!seen && nbanks < MAX_BANKS)
+                banks[nbanks++] = mods[m].bank;
+        }
+    }
+    nsizes = slist ? parse_list(slist, sizes, MAX_BANKS) : 0;
+    if (nsizes < 0)
+        usage();
+    for (i = 0; i < nbanks; i++) {
+        sizes[i] = nsizes == 0 ? 16384 : sizes[i < nsizes ? i : nsizes - 1];
+        fill[i] = 0;
+        if (sizes[i] > largest)
+            largest = sizes[i];
+    }
+    if (nbanks == 0) {
+        fprintf(stderr, "%s: no banked modules\n", map);
+        return 2;
+    }
+
+    /* ---- merge the heaviest pairs that still fit one bank ---- */
+    pairs = malloc(sizeof(*pairs) * (size_t)nmods * (size_t)nmods / 2 + sizeof(*pairs));
+    order = malloc(sizeof(*order) * (size_t)nmods);
+    if (!pairs || !order) {
+        perror("bankplan");
+        return 2;
+    }
+    for (m = 0; m < nmods; m++) {
+        int b;
+        mods[m].group = m;
+        mods[m].group_size = mods[m].size;
+        mods[m].plan = mods[m].bank;
+        for (b = m + 1; b < nmods; b++)
+            if (mods[m].bank >= 0 && mods[b].bank >= 0 && weight[m * nmods + b]) {
+                pairs[npairs].a = m;
+                pairs[npairs].b = b;
+                pairs[npairs].w = weight[m * nmods + b];
+                npairs++;
+            }
+    }
+    qsort(pairs, (size_t)npairs, sizeof(*pairs), cmp_pair);
+    for (i = 0; i < npairs; i++) {
+        int ra = root(pairs[i].a), rb = root(pairs[i].b);
+        if (ra == rb || mods[ra].group_size + mods[rb].group_size > (uint32_t)largest)
+            continue;
+        mods[rb].group = ra;
+        mods[ra].group_size += mods[rb].group_size;
+    }
+
+    /* ---- pack the groups, largest first, into the first bank that fits ---- */
+    for (m = ngroups = 0; m < nmods; m++)
+        if (mods[m].bank >= 0 && root(m) == m)
+            order[ngroups++] = m;
+    qsort(order, (size_t)ngroups, sizeof(*order), cmp_group);
+    for (i = 0; i < ngroups; i++) {
+        int g = order[i], b;
+        for (b = 0; b < nbanks; b++)
+            if (fill[b] + (long)mods[g].group_size <= sizes[b])
+                break;
+        if (b == nbanks) {
+            fprintf(stderr, "bankplan: %s and the modules it calls (%lu bytes) fit no bank\n",
+                    mods[g].name, (unsigned long)mods[g].group_size);
+            return 1;
+        }
+        fill[b] += (long)mods[g].group_size;
+        mods[g].plan = (int)banks[b];
+    }
+    for (m = 0; m < nmods; m++)
+        if (mods[m].bank >= 0)
+            mods[m].plan = mods[root(m)].plan;
+
+    /* ---- report ---- */
+    printf("/* bankplan: %llu banked calls", (unsigned long long)total);
+    if (from_common)
+        printf(", %llu from common code", (unsigned long long)from_common);
+    if (unknown)
+        printf(", %llu not in the map", (unsigned long long)unknown);
+    printf(" */\n");
+    printf("/* switches between banked modules: %llu now, %llu placed */\n",
+           (unsigned long long)switches(0), (unsigned long long)switches(1));
+    for (i = 0; i < nbanks; i++) {
+        printf("\n/* bank %ld: %ld of %ld bytes */\n", banks[i], fill[i], sizes[i]);
+        for (m = 0; m < nmods; m++)
+            if (mods[m].bank >= 0 && mods[m].plan == banks[i])
+                printf("%-16s #pragma bank %-3ld  --codeseg BANK%ld  /* %lu bytes, was %d */\n",
+                       mods[m].name, banks[i], banks[i],
+                       (unsigned long)mods[m].size, mods[m].bank);
+    }
+    return 0;
+}
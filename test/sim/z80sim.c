@@ -0,0 +1,1052 @@
+/*
+ * z80sim.c
+ *
+ * minimal cycle-counting z80 simulator used by the benchmark suite.
+ *
+ * runs a CP/M .COM image (loaded at 0x0100) and emulates just enough
+ * of the BDOS (functions 0, 2 and 9) for the test console helpers in
+ * test/lib/cpm. every instruction is charged its documented T-state
+ * cost, so timings are exact for a wait-state free z80.
+ *
+ * simulator ports (see README.md, "Benchmarks"):
+ *   out 0xF0  probe control: 1 = begin phase, 0 = end phase (print stats)
+ *   out 0xF1  append one character to the phase label
+ *   out 0xF2  probe target address, low byte
+ *   out 0xF3  probe target address, high byte
+ *   in  0xF4  latch the free running T-state counter, return byte 0
+ *   in  0xF5  latched counter byte 1
+ *   in  0xF6  latched counter byte 2
+ *   in  0xF7  latched counter byte 3
+ *   out 0xF8  map bank (v & 7) at 0xC000..0xDFFF, bank 0 is plain memory
+ *   in  0xF8  the mapped bank
+ *   out 0xF9  raise an interrupt as the next `ld a,i` or `ld a,r` ends:
+ *             bit 0 maskable (rst 0x38 when enabled), bit 1 nmi (0x66),
+ *             bit 7 nmos: the interrupted instruction reads P/V as 0
+ *   in  0xF9  interrupts taken since the last out 0xF9
+ *
+ * while a phase is open every call that enters the target address is
+ * timed from its first instruction up to and including the ret that
+ * returns to the caller. nested calls to the target (recursion) are
+ * counted as part of the outer call.
+ *
+ * usage: z80sim [-t max_tstates] [-d dump.bin] program.com
+ *
+ * gpl-2.0-or-later (see: LICENSE)
+ * copyright (c) 2026 tomaz stih
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* ---------- flags ---------- */
+
+#define FC  0x01
+#define FN  0x02
+#define FPV 0x04
+#define F3  0x08
+#define FH  0x10
+#define F5  0x20
+#define FZ  0x40
+#define FS  0x80
+
+/* ---------- machine state ---------- */
+
+typedef struct z80_s {
+    uint8_t  a, f, b, c, d, e, h, l;
+    uint8_t  a_, f_, b_, c_, d_, e_, h_, l_;
+    uint16_t ix, iy, sp, pc;
+    uint8_t  i, r, iff1, iff2, im, halted;
+    uint64_t t;
+} z80_t;
+
+static uint8_t mem[0x10000];
+static z80_t cpu;
+
+/* ---------- banked window ---------- */
+
+#define BANK_BASE  0xC000
+#define BANK_SIZE  0x2000
+#define BANK_COUNT 8
+
+static uint8_t bank_mem[BANK_COUNT][BANK_SIZE];
+static uint8_t bank_sel;
+
+static uint8_t parity[256];
+
+/* ---------- probe state ---------- */
+
+#define PROBE_LABEL_MAX 64
+
+static char     probe_label[PROBE_LABEL_MAX + 1];
+static int      probe_label_len;
+static uint16_t probe_target;
+static int      probe_open;
+static int      probe_active;      /* inside a timed call */
+static uint16_t probe_entry_sp;    /* sp on entry to the timed call */
+static uint16_t probe_ret_pc;      /* return address of the timed call */
+static uint64_t probe_t0;
+static uint32_t probe_calls;
+static uint64_t probe_sum;
+static uint32_t probe_min, probe_max;
+
+static uint32_t counter_latch;
+static int      exit_requested;
+
+/* ---------- interrupt on ld a,i ---------- */
+
+#define IRQ_INT  0x01
+#define IRQ_NMI  0x02
+#define IRQ_NMOS 0x80
+
+static uint8_t  irq_arm;           /* out 0xF9, cleared when it fires */
+static int      irq_due;           /* an armed ld a,i just ran */
+static uint8_t  irq_taken;
+
+/* ---------- memory helpers ---------- */
+
+static uint8_t *loc(uint16_t a)
+{
+    if (bank_sel && (uint16_t)(a - BANK_BASE) < BANK_SIZE)
+        return &bank_mem[bank_sel][a - BANK_BASE];
+    return &mem[a];
+}
+
+static uint8_t rd(uint16_t a) { return *loc(a); }
+static void wr(uint16_t a, uint8_t v) { *loc(a) = v; }
+static uint16_t rd16(uint16_t a) { return (uint16_t)(rd(a) | (rd((uint16_t)(a + 1)) << 8)); }
+static void wr16(uint16_t a, uint16_t v) { wr(a, (uint8_t)v); wr((uint16_t)(a + 1), (uint8_t)(v >> 8)); }
+
+static uint8_t fetch(void) { return rd(cpu.pc++); }
+static uint16_t fetch16(void) { uint16_t v = rd16(cpu.pc); cpu.pc += 2; return v; }
+
+static void push16(uint16_t v) { cpu.sp -= 2; wr16(cpu.sp, v); }
+static uint16_t pop16(void) { uint16_t v = rd16(cpu.sp); cpu.sp += 2; return v; }
+
+#define BC ((uint16_t)((cpu.b << 8) | cpu.c))
+#define DE ((uint16_t)((cpu.d << 8) | cpu.e))
+#define HL ((uint16_t)((cpu.h << 8) | cpu.l))
+#define AF ((uint16_t)((cpu.a << 8) | cpu.f))
+
+static void set_bc(uint16_t v) { cpu.b = (uint8_t)(v >> 8); cpu.c = (uint8_t)v; }
+static void set_de(uint16_t v) { cpu.d = (uint8_t)(v >> 8); cpu.e = (uint8_t)v; }
+static void set_hl(uint16_t v) { cpu.h = (uint8_t)(v >> 8); cpu.l = (uint8_t)v; }
+static void set_af(uint16_t v) { cpu.a = (uint8_t)(v >> 8); cpu.f = (uint8_t)v; }
+
+/* ---------- probe / port handling ---------- */
+
+static void probe_reset(void)
+{
+    probe_calls = 0;
+    probe_sum = 0;
+    probe_min = 0xFFFFFFFFu;
+    probe_max = 0;
+    probe_active = 0;
+}
+
+static void probe_report(void)
+{
+    if (probe_calls == 0) {
+        printf("%-32s %8s %8s %8s %8s\n", probe_label, "0", "-", "-", "-");
+    } else {
+        printf("%-32s %8lu %8lu %8lu %8lu\n", probe_label,
+               (unsigned long)probe_calls,
+               (unsigned long)probe_min,
+               (unsigned long)((probe_sum + probe_calls / 2) / probe_calls),
+               (unsigned long)probe_max);
+    }
+    fflush(stdout);
+}
+
+static void port_out(uint8_t port, uint8_t v)
+{
+    switch (port) {
+    case 0xF0:
+        if (v) {
+            probe_open = 1;
+            probe_reset();
+        } else {
+            if (probe_open)
+                probe_report();
+            probe_open = 0;
+            probe_label_len = 0;
+            probe_label[0] = 0;
+        }
+        break;
+    case 0xF1:
+        if (probe_label_len < PROBE_LABEL_MAX) {
+            probe_label[probe_label_len++] = (char)v;
+            probe_label[probe_label_len] = 0;
+        }
+        break;
+    case 0xF2:
+        probe_target = (uint16_t)((probe_target & 0xFF00) | v);
+        break;
+    case 0xF3:
+        probe_target = (uint16_t)((probe_target & 0x00FF) | (v << 8));
+        break;
+    case 0xF8:
+        bank_sel = v & (BANK_COUNT - 1);
+        break;
+    case 0xF9:
+        irq_arm = v;
+        irq_taken = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+static uint8_t port_in(uint8_t port)
+{
+    switch (port) {
+    case 0xF4:
+        counter_latch = (uint32_t)cpu.t;
+        return (uint8_t)counter_latch;
+    case 0xF5:
+        return (uint8_t)(counter_latch >> 8);
+    case 0xF6:
+        return (uint8_t)(counter_latch >> 16);
+    case 0xF7:
+        return (uint8_t)(counter_latch >> 24);
+    case 0xF8:
+        return bank_sel;
+    case 0xF9:
+        return irq_taken;
+    default:
+        return 0xFF;
+    }
+}
+
+/* ---------- cp/m bdos subset ---------- */
+
+static void bdos(void)
+{
+    uint16_t p;
+    switch (cpu.c) {
+    case 0x00:
+        exit_requested = 1;
+        break;
+    case 0x02:
+        putchar(cpu.e);
+        break;
+    case 0x09:
+        for (p = DE; rd(p) != '$'; p++)
+            putchar(rd(p));
+        break;
+    default:
+        break;
+    }
+    /* behave like a ret from the bdos entry */
+    cpu.pc = pop16();
+    cpu.t += 10;
+}
+
+/* ---------- alu ---------- */
+
+static uint8_t sz53(uint8_t v)
+{
+    return (uint8_t)((v & (FS | F5 | F3)) | (v ? 0 : FZ));
+}
+
+static uint8_t sz53p(uint8_t v)
+{
+    return (uint8_t)(sz53(v) | parity[v]);
+}
+
+static void alu(int op, uint8_t v)
+{
+    unsigned a = cpu.a, r;
+    uint8_t c = (uint8_t)(cpu.f & FC);
+    switch (op) {
+    case 0: /* add */
+    case 1: /* adc */
+        if (op == 0) c = 0;
+        r = a + v + c;
+        cpu.f = (uint8_t)(sz53((uint8_t)r) | ((r >> 8) & FC)
+                | ((a ^ v ^ r) & FH)
+                | ((((a ^ ~v) & (a ^ r)) & 0x80) ? FPV : 0));
+        cpu.a = (uint8_t)r;
+        break;
+    case 2: /* sub */
+    case 3: /* sbc */
+    case 7: /* cp */
+        if (op != 3) c = 0;
+        r = a - v - c;
+        cpu.f = (uint8_t)(sz53((uint8_t)r) | ((r >> 8) & FC) | FN
+                | ((a ^ v ^ r) & FH)
+                | ((((a ^ v) & (a ^ r)) & 0x80) ? FPV : 0));
+        if (op == 7)
+            cpu.f = (uint8_t)((cpu.f & ~(F3 | F5)) | (v & (F3 | F5)));
+        else
+            cpu.a = (uint8_t)r;
+        break;
+    case 4: /* and */
+        cpu.a &= v;
+        cpu.f = (uint8_t)(sz53p(cpu.a) | FH);
+        break;
+    case 5: /* xor */
+        cpu.a ^= v;
+        cpu.f = sz53p(cpu.a);
+        break;
+    case 6: /* or */
+        cpu.a |= v;
+        cpu.f = sz53p(cpu.a);
+        break;
+    }
+}
+
+static uint8_t inc8(uint8_t v)
+{
+    uint8_t r = (uint8_t)(v + 1);
+    cpu.f = (uint8_t)((cpu.f & FC) | sz53(r) | ((r & 0x0F) ? 0 : FH)
+            | (r == 0x80 ? FPV : 0));
+    return r;
+}
+
+static uint8_t dec8(uint8_t v)
+{
+    uint8_t r = (uint8_t)(v - 1);
+    cpu.f = (uint8_t)((cpu.f & FC) | sz53(r) | FN | ((v & 0x0F) ? 0 : FH)
+            | (v == 0x80 ? FPV : 0));
+    return r;
+}
+
+static uint16_t add16(uint16_t a, uint16_t b)
+{
+    uint32_t r = (uint32_t)a + b;
+    cpu.f = (uint8_t)((cpu.f & (FS | FZ | FPV)) | ((r >> 16) & FC)
+            | (((a ^ b ^ r) >> 8) & FH) | ((r >> 8) & (F3 | F5)));
+    return (uint16_t)r;
+}
+
+static uint16_t adc16(uint16_t a, uint16_t b)
+{
+    uint32_t r = (uint32_t)a + b + (cpu.f & FC);
+    cpu.f = (uint8_t)(((r >> 16) & FC) | (((a ^ b ^ r) >> 8) & FH)
+            | ((r >> 8) & (FS | F3 | F5)) | ((r & 0xFFFF) ? 0 : FZ)
+            | ((((a ^ ~b) & (a ^ r)) & 0x8000) ? FPV : 0));
+    return (uint16_t)r;
+}
+
+static uint16_t sbc16(uint16_t a, uint16_t b)
+{
+    uint32_t r = (uint32_t)a - b - (cpu.f & FC);
+    cpu.f = (uint8_t)(((r >> 16) & FC) | FN | (((a ^ b ^ r) >> 8) & FH)
+            | ((r >> 8) & (FS | F3 | F5)) | ((r & 0xFFFF) ? 0 : FZ)
+            | ((((a ^ b) & (a ^ r)) & 0x8000) ? FPV : 0));
+    return (uint16_t)r;
+}
+
+/* cb-prefixed rotate/shift, op = y field */
+static uint8_t rot(int op, uint8_t v)
+{
+    uint8_t c = (uint8_t)(cpu.f & FC), r = 0, co = 0;
+    switch (op) {
+    case 0: co = v >> 7; r = (uint8_t)((v << 1) | co); break;           /* rlc */
+    case 1: co = v & 1;  r = (uint8_t)((v >> 1) | (co << 7)); break;    /* rrc */
+    case 2: co = v >> 7; r = (uint8_t)((v << 1) | c); break;            /* rl  */
+    case 3: co = v & 1;  r = (uint8_t)((v >> 1) | (c << 7)); break;     /* rr  */
+    case 4: co = v >> 7; r = (uint8_t)(v << 1); break;                  /* sla */
+    case 5: co = v & 1;  r = (uint8_t)((v >> 1) | (v & 0x80)); break;   /* sra */
+    case 6: co = v >> 7; r = (uint8_t)((v << 1) | 1); break;            /* sll */
+    case 7: co = v & 1;  r = (uint8_t)(v >> 1); break;                  /* srl */
+    }
+    cpu.f = (uint8_t)(sz53p(r) | co);
+    return r;
+}
+
+static int cond(int cc)
+{
+    switch (cc) {
+    case 0: return !(cpu.f & FZ);
+    case 1: return  (cpu.f & FZ);
+    case 2: return !(cpu.f & FC);
+    case 3: return  (cpu.f & FC);
+    case 4: return !(cpu.f & FPV);
+    case 5: return  (cpu.f & FPV);
+    case 6: return !(cpu.f & FS);
+    default: return (cpu.f & FS);
+    }
+}
+
+/* ---------- register access with index substitution ---------- */
+
+/* idx: 0 = hl, 1 = ix, 2 = iy */
+static uint16_t get_hlx(int idx)
+{
+    return idx == 0 ? HL : (idx == 1 ? cpu.ix : cpu.iy);
+}
+
+static void set_hlx(int idx, uint16_t v)
+{
+    if (idx == 0) set_hl(v);
+    else if (idx == 1) cpu.ix = v;
+    else cpu.iy = v;
+}
+
+/* 8-bit register by index; 6 is never passed here */
+static uint8_t get_r(int r, int idx)
+{
+    switch (r) {
+    case 0: return cpu.b;
+    case 1: return cpu.c;
+    case 2: return cpu.d;
+    case 3: return cpu.e;
+    case 4: return idx == 0 ? cpu.h : (uint8_t)(get_hlx(idx) >> 8);
+    case 5: return idx == 0 ? cpu.l : (uint8_t)get_hlx(idx);
+    default: return cpu.a;
+    }
+}
+
+static void set_r(int r, int idx, uint8_t v)
+{
+    uint16_t x;
+    switch (r) {
+    case 0: cpu.b = v; break;
+    case 1: cpu.c = v; break;
+    case 2: cpu.d = v; break;
+    case 3: cpu.e = v; break;
+    case 4:
+        if (idx == 0) cpu.h = v;
+        else { x = get_hlx(idx); set_hlx(idx, (uint16_t)((x & 0x00FF) | (v << 8))); }
+        break;
+    case 5:
+        if (idx == 0) cpu.l = v;
+        else { x = get_hlx(idx); set_hlx(idx, (uint16_t)((x & 0xFF00) | v)); }
+        break;
+    default: cpu.a = v; break;
+    }
+}
+
+static uint16_t get_rp(int p, int idx)
+{
+    switch (p) {
+    case 0: return BC;
+    case 1: return DE;
+    case 2: return get_hlx(idx);
+    default: return cpu.sp;
+    }
+}
+
+static void set_rp(int p, int idx, uint16_t v)
+{
+    switch (p) {
+    case 0: set_bc(v); break;
+    case 1: set_de(v); break;
+    case 2: set_hlx(idx, v); break;
+    default: cpu.sp = v; break;
+    }
+}
+
+static uint16_t get_rp2(int p, int idx)
+{
+    return p == 3 ? AF : get_rp(p, idx);
+}
+
+static void set_rp2(int p, int idx, uint16_t v)
+{
+    if (p == 3) set_af(v); else set_rp(p, idx, v);
+}
+
+/* ---------- cb prefix ---------- */
+
+static void exec_cb(int idx)
+{
+    int8_t d = 0;
+    uint16_t addr = 0;
+    uint8_t op, v, r;
+    int x, y, z;
+
+    if (idx) {
+        d = (int8_t)fetch();
+        addr = (uint16_t)(get_hlx(idx) + d);
+    }
+    op = fetch();
+    x = op >> 6; y = (op >> 3) & 7; z = op & 7;
+
+    if (idx) {
+        v = rd(addr);
+    } else if (z == 6) {
+        addr = HL;
+        v = rd(addr);
+    } else {
+        v = get_r(z, 0);
+    }
+
+    switch (x) {
+    case 0:
+        r = rot(y, v);
+        break;
+    case 1:
+        r = v;
+        cpu.f = (uint8_t)((cpu.f & FC) | FH | (v & (F3 | F5))
+                | ((v & (1 << y)) ? (y == 7 ? FS : 0) : (FZ | FPV)));
+        break;
+    case 2:
+        r = (uint8_t)(v & ~(1 << y));
+        break;
+    default:
+        r = (uint8_t)(v | (1 << y));
+        break;
+    }
+
+    if (idx) {
+        cpu.t += (x == 1) ? 20 : 23;
+        if (x != 1) {
+            wr(addr, r);
+            if (z != 6) set_r(z, 0, r);    /* undocumented copy */
+        }
+    } else if (z == 6) {
+        cpu.t += (x == 1) ? 12 : 15;
+        if (x != 1) wr(addr, r);
+    } else {
+        cpu.t += 8;
+        if (x != 1) set_r(z, 0, r);
+    }
+}
+
+/* ---------- ed prefix ---------- */
+
+static void exec_ed(void)
+{
+    uint8_t op = fetch(), v;
+    int x = op >> 6, y = (op >> 3) & 7, z = op & 7, p = y >> 1, q = y & 1;
+    uint16_t nn, hl;
+
+    if (x == 1) {
+        switch (z) {
+        case 0:
+            v = port_in(cpu.c);
+            if (y != 6) set_r(y, 0, v);
+            cpu.f = (uint8_t)((cpu.f & FC) | sz53p(v));
+            cpu.t += 12;
+            break;
+        case 1:
+            port_out(cpu.c, y == 6 ? 0 : get_r(y, 0));
+            cpu.t += 12;
+            break;
+        case 2:
+            if (q == 0) set_hl(sbc16(HL, get_rp(p, 0)));
+            else set_hl(adc16(HL, get_rp(p, 0)));
+            cpu.t += 15;
+            break;
+        case 3:
+            nn = fetch16();
+            if (q == 0) wr16(nn, get_rp(p, 0));
+            else set_rp(p, 0, rd16(nn));
+            cpu.t += 20;
+            break;
+        case 4:
+            v = cpu.a;
+            cpu.a = 0;
+            alu(2, v);
+            cpu.t += 8;
+            break;
+        case 5:
+            cpu.pc = pop16();
+            cpu.iff1 = cpu.iff2;
+            cpu.t += 14;
+            break;
+        case 6:
+            cpu.im = (uint8_t)((y & 3) == 0 ? 0 : ((y & 3) == 2 ? 1 : 2));
+            cpu.t += 8;
+            break;
+        default:
+            switch (y) {
+            case 0: cpu.i = cpu.a; cpu.t += 9; break;
+            case 1: cpu.r = cpu.a; cpu.t += 9; break;
+            case 2:
+            case 3:
+                cpu.a = (y == 2) ? cpu.i : cpu.r;
+                cpu.f = (uint8_t)((cpu.f & FC) | sz53(cpu.a)
+                        | (cpu.iff2 ? FPV : 0));
+                cpu.t += 9;
+                irq_due = irq_arm != 0;
+                break;
+            case 4: /* rrd */
+                v = rd(HL);
+                wr(HL, (uint8_t)((cpu.a << 4) | (v >> 4)));
+                cpu.a = (uint8_t)((cpu.a & 0xF0) | (v & 0x0F));
+                cpu.f = (uint8_t)((cpu.f & FC) | sz53p(cpu.a));
+                cpu.t += 18;
+                break;
+            case 5: /* rld */
+                v = rd(HL);
+                wr(HL, (uint8_t)((v << 4) | (cpu.a & 0x0F)));
+                cpu.a = (uint8_t)((cpu.a & 0xF0) | (v >> 4));
+                cpu.f = (uint8_t)((cpu.f & FC) | sz53p(cpu.a));
+                cpu.t += 18;
+                break;
+            default:
+                cpu.t += 8;
+                break;
+            }
+            break;
+        }
+        return;
+    }
+
+    if (x == 2 && y >= 4 && z <= 3) {
+        int dec = y & 1, rep = y >= 6;
+        uint16_t bc;
+        hl = HL;
+        switch (z) {
+        case 0: /* ldi/ldd/ldir/lddr */
+            v = rd(hl);
+            wr(DE, v);
+            set_de((uint16_t)(dec ? DE - 1 : DE + 1));
+            set_hl((uint16_t)(dec ? hl - 1 : hl + 1));
+            bc = (uint16_t)(BC - 1);
+            set_bc(bc);
+            cpu.f = (uint8_t)((cpu.f & (FS | FZ | FC)) | (bc ? FPV : 0));
+            if (rep && bc) { cpu.pc -= 2; cpu.t += 21; }
+            else cpu.t += 16;
+            break;
+        case 1: /* cpi/cpd/cpir/cpdr */
+        {
+            uint8_t c = (uint8_t)(cpu.f & FC), r;
+            v = rd(hl);
+            r = (uint8_t)(cpu.a - v);
+            set_hl((uint16_t)(dec ? hl - 1 : hl + 1));
+            bc = (uint16_t)(BC - 1);
+            set_bc(bc);
+            cpu.f = (uint8_t)(c | FN | (r & FS) | (r ? 0 : FZ)
+                    | ((cpu.a ^ v ^ r) & FH) | (bc ? FPV : 0));
+            if (rep && bc && r) { cpu.pc -= 2; cpu.t += 21; }
+            else cpu.t += 16;
+            break;
+        }
+        case 2: /* ini/ind/inir/indr */
+            wr(hl, port_in(cpu.c));
+            set_hl((uint16_t)(dec ? hl - 1 : hl + 1));
+            cpu.b--;
+            cpu.f = (uint8_t)(FN | (cpu.b ? 0 : FZ) | (cpu.f & FC));
+            if (rep && cpu.b) { cpu.pc -= 2; cpu.t += 21; }
+            else cpu.t += 16;
+            break;
+        default: /* outi/outd/otir/otdr */
+            cpu.b--;
+            port_out(cpu.c, rd(hl));
+            set_hl((uint16_t)(dec ? hl - 1 : hl + 1));
+            cpu.f = (uint8_t)(FN | (cpu.b ? 0 : FZ) | (cpu.f & FC));
+            if (rep && cpu.b) { cpu.pc -= 2; cpu.t += 21; }
+            else cpu.t += 16;
+            break;
+        }
+        return;
+    }
+
+    cpu.t += 8;     /* undefined ed opcode: nop */
+}
+
+/* ---------- main decoder ---------- */
+
+static void exec(void)
+{
+    int idx = 0;
+    uint8_t op, v;
+    int x, y, z, p, q;
+    int8_t d;
+    uint16_t nn, addr;
+
+    op = fetch();
+    cpu.r = (uint8_t)((cpu.r & 0x80) | ((cpu.r + 1) & 0x7F));
+
+    /* index prefixes; a run of prefixes costs 4 T-states each */
+    while (op == 0xDD || op == 0xFD) {
+        idx = (op == 0xDD) ? 1 : 2;
+        cpu.t += 4;
+        op = fetch();
+    }
+
+    if (op == 0xED) {
+        exec_ed();          /* index prefix ignored, already charged */
+        return;
+    }
+    if (op == 0xCB) {
+        if (idx) cpu.t -= 4;    /* ddcb timings include the prefix */
+        exec_cb(idx);
+        return;
+    }
+
+    x = op >> 6; y = (op >> 3) & 7; z = op & 7; p = y >> 1; q = y & 1;
+
+    switch (x) {
+    case 0:
+        switch (z) {
+        case 0:
+            switch (y) {
+            case 0: cpu.t += 4; break;
+            case 1:
+                v = cpu.a; cpu.a = cpu.a_; cpu.a_ = v;
+                v = cpu.f; cpu.f = cpu.f_; cpu.f_ = v;
+                cpu.t += 4;
+                break;
+            case 2:
+                d = (int8_t)fetch();
+                if (--cpu.b) { cpu.pc = (uint16_t)(cpu.pc + d); cpu.t += 13; }
+                else cpu.t += 8;
+                break;
+            case 3:
+                d = (int8_t)fetch();
+                cpu.pc = (uint16_t)(cpu.pc + d);
+                cpu.t += 12;
+                break;
+            default:
+                d = (int8_t)fetch();
+                if (cond(y - 4)) { cpu.pc = (uint16_t)(cpu.pc + d); cpu.t += 12; }
+                else cpu.t += 7;
+                break;
+            }
+            break;
+        case 1:
+            if (q == 0) {
+                set_rp(p, idx, fetch16());
+                cpu.t += 10;
+            } else {
+                set_hlx(idx, add16(get_hlx(idx), get_rp(p, idx)));
+                cpu.t += 11;
+            }
+            break;
+        case 2:
+            switch (y) {
+            case 0: wr(BC, cpu.a); cpu.t += 7; break;
+            case 1: cpu.a = rd(BC); cpu.t += 7; break;
+            case 2: wr(DE, cpu.a); cpu.t += 7; break;
+            case 3: cpu.a = rd(DE); cpu.t += 7; break;
+            case 4: wr16(fetch16(), get_hlx(idx)); cpu.t += 16; break;
+            case 5: set_hlx(idx, rd16(fetch16())); cpu.t += 16; break;
+            case 6: wr(fetch16(), cpu.a); cpu.t += 13; break;
+            default: cpu.a = rd(fetch16()); cpu.t += 13; break;
+            }
+            break;
+        case 3:
+            if (q == 0) set_rp(p, idx, (uint16_t)(get_rp(p, idx) + 1));
+            else set_rp(p, idx, (uint16_t)(get_rp(p, idx) - 1));
+            cpu.t += 6;
+            break;
+        case 4:
+        case 5:
+            if (y == 6) {
+                if (idx) { d = (int8_t)fetch(); addr = (uint16_t)(get_hlx(idx) + d); cpu.t += 8; }
+                else { addr = HL; }
+                v = rd(addr);
+                wr(addr, z == 4 ? inc8(v) : dec8(v));
+                cpu.t += 11;
+            } else {
+                v = get_r(y, idx);
+                set_r(y, idx, z == 4 ? inc8(v) : dec8(v));
+                cpu.t += 4;
+            }
+            break;
+        case 6:
+            if (y == 6) {
+                if (idx) { d = (int8_t)fetch(); addr = (uint16_t)(get_hlx(idx) + d); cpu.t += 5; }
+                else { addr = HL; }
+                wr(addr, fetch());
+                cpu.t += 10;
+            } else {
+                set_r(y, idx, fetch());
+                cpu.t += 7;
+            }
+            break;
+        default:
+        {
+            uint8_t a = cpu.a, c;
+            switch (y) {
+            case 0: /* rlca */
+                c = a >> 7; cpu.a = (uint8_t)((a << 1) | c);
+                cpu.f = (uint8_t)((cpu.f & (FS | FZ | FPV)) | c | (cpu.a & (F3 | F5)));
+                break;
+            case 1: /* rrca */
+                c = a & 1; cpu.a = (uint8_t)((a >> 1) | (c << 7));
+                cpu.f = (uint8_t)((cpu.f & (FS | FZ | FPV)) | c | (cpu.a & (F3 | F5)));
+                break;
+            case 2: /* rla */
+                c = a >> 7; cpu.a = (uint8_t)((a << 1) | (cpu.f & FC));
+                cpu.f = (uint8_t)((cpu.f & (FS | FZ | FPV)) | c | (cpu.a & (F3 | F5)));
+                break;
+            case 3: /* rra */
+                c = a & 1; cpu.a = (uint8_t)((a >> 1) | ((cpu.f & FC) << 7));
+                cpu.f = (uint8_t)((cpu.f & (FS | FZ | FPV)) | c | (cpu.a & (F3 | F5)));
+                break;
+            case 4: /* daa */
+            {
+                uint8_t corr = 0, cf = (uint8_t)(cpu.f & FC);
+                if ((cpu.f & FH) || (a & 0x0F) > 9) corr |= 0x06;
+                if (cf || a > 0x99) { corr |= 0x60; cf = FC; }
+                if (cpu.f & FN) {
+                    cpu.a = (uint8_t)(a - corr);
+                    cpu.f = (uint8_t)(FN | cf | sz53p(cpu.a)
+                            | (((cpu.f & FH) && (a & 0x0F) < 6) ? FH : 0));
+                } else {
+                    cpu.a = (uint8_t)(a + corr);
+                    cpu.f = (uint8_t)(cf | sz53p(cpu.a)
+                            | (((a & 0x0F) > 9) ? FH : 0));
+                }
+                break;
+            }
+            case 5: /* cpl */
+                cpu.a = (uint8_t)~a;
+                cpu.f = (uint8_t)((cpu.f & (FS | FZ | FPV | FC)) | FH | FN | (cpu.a & (F3 | F5)));
+                break;
+            case 6: /* scf */
+                cpu.f = (uint8_t)((cpu.f & (FS | FZ | FPV)) | FC | (a & (F3 | F5)));
+                break;
+            default: /* ccf */
+                cpu.f = (uint8_t)(((cpu.f & (FS | FZ | FPV | FC)) | ((cpu.f & FC) << 4)
+                        | (a & (F3 | F5))) ^ FC);
+                break;
+            }
+            cpu.t += 4;
+            break;
+        }
+        }
+        break;
+
+    case 1:
+        if (y == 6 && z == 6) {
+            cpu.halted = 1;
+            cpu.t += 4;
+        } else if (y == 6 || z == 6) {
+            /* ld (hl),r / ld r,(hl): with an index prefix h/l stay h/l */
+            if (idx) { d = (int8_t)fetch(); addr = (uint16_t)(get_hlx(idx) + d); cpu.t += 8; }
+            else { addr = HL; }
+            if (y == 6) wr(addr, get_r(z, 0));
+            else set_r(y, 0, rd(addr));
+            cpu.t += 7;
+        } else {
+            set_r(y, idx, get_r(z, idx));
+            cpu.t += 4;
+        }
+        break;
+
+    case 2:
+        if (z == 6) {
+            if (idx) { d = (int8_t)fetch(); addr = (uint16_t)(get_hlx(idx) + d); cpu.t += 8; }
+            else { addr = HL; }
+            alu(y, rd(addr));
+            cpu.t += 7;
+        } else {
+            alu(y, get_r(z, idx));
+            cpu.t += 4;
+        }
+        break;
+
+    default:
+        switch (z) {
+        case 0:
+            if (cond(y)) { cpu.pc = pop16(); cpu.t += 11; }
+            else cpu.t += 5;
+            break;
+        case 1:
+            if (q == 0) {
+                set_rp2(p, idx, pop16());
+                cpu.t += 10;
+            } else {
+                switch (p) {
+                case 0: cpu.pc = pop16(); cpu.t += 10; break;
+                case 1:
+                    v = cpu.b; cpu.b = cpu.b_; cpu.b_ = v;
+                    v = cpu.c; cpu.c = cpu.c_; cpu.c_ = v;
+                    v = cpu.d; cpu.d = cpu.d_; cpu.d_ = v;
+                    v = cpu.e; cpu.e = cpu.e_; cpu.e_ = v;
+                    v = cpu.h; cpu.h = cpu.h_; cpu.h_ = v;
+                    v = cpu.l; cpu.l = cpu.l_; cpu.l_ = v;
+                    cpu.t += 4;
+                    break;
+                case 2: cpu.pc = get_hlx(idx); cpu.t += 4; break;
+                default: cpu.sp = get_hlx(idx); cpu.t += 6; break;
+                }
+            }
+            break;
+        case 2:
+            nn = fetch16();
+            if (cond(y)) cpu.pc = nn;
+            cpu.t += 10;
+            break;
+        case 3:
+            switch (y) {
+            case 0: cpu.pc = fetch16(); cpu.t += 10; break;
+            case 2: port_out(fetch(), cpu.a); cpu.t += 11; break;
+            case 3: cpu.a = port_in(fetch()); cpu.t += 11; break;
+            case 4:
+                nn = rd16(cpu.sp);
+                wr16(cpu.sp, get_hlx(idx));
+                set_hlx(idx, nn);
+                cpu.t += 19;
+                break;
+            case 5:
+                nn = DE; set_de(HL); set_hl(nn);
+                cpu.t += 4;
+                break;
+            case 6: cpu.iff1 = cpu.iff2 = 0; cpu.t += 4; break;
+            default: cpu.iff1 = cpu.iff2 = 1; cpu.t += 4; break;
+            }
+            break;
+        case 4:
+            nn = fetch16();
+            if (cond(y)) { push16(cpu.pc); cpu.pc = nn; cpu.t += 17; }
+            else cpu.t += 10;
+            break;
+        case 5:
+            if (q == 0) {
+                push16(get_rp2(p, idx));
+                cpu.t += 11;
+            } else {
+                /* p == 0: call nn; prefixes are handled above */
+                nn = fetch16();
+                push16(cpu.pc);
+                cpu.pc = nn;
+                cpu.t += 17;
+            }
+            break;
+        case 6:
+            alu(y, fetch());
+            cpu.t += 7;
+            break;
+        default:
+            push16(cpu.pc);
+            cpu.pc = (uint16_t)(y * 8);
+            cpu.t += 11;
+            break;
+        }
+        break;
+    }
+}
+
+/* ---------- interrupts ---------- */
+
+/* the interrupt armed by out 0xF9, between two instructions */
+static void interrupt(void)
+{
+    uint8_t kind = irq_arm;
+
+    irq_arm = 0;
+    irq_due = 0;
+    if (!(kind & IRQ_NMI) && !((kind & IRQ_INT) && cpu.iff1))
+        return;
+    if (kind & IRQ_NMOS)
+        cpu.f &= (uint8_t)~FPV;
+    push16(cpu.pc);
+    if (kind & IRQ_NMI) {
+        cpu.iff1 = 0;
+        cpu.pc = 0x0066;
+        cpu.t += 11;
+    } else {
+        cpu.iff1 = cpu.iff2 = 0;
+        cpu.pc = 0x0038;
+        cpu.t += 13;
+    }
+    irq_taken++;
+}
+
+/* ---------- driver ---------- */
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: z80sim [-t max_tstates] [-d dump.bin] program.com\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    const char *prog = NULL, *dump = NULL;
+    unsigned long long max_t = 4000000000ULL;
+    FILE *fp;
+    size_t n;
+    int i, rc = 0;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc)
+            max_t = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-d") && i + 1 < argc)
+            dump = argv[++i];
+        else if (argv[i][0] == '-')
+            usage();
+        else
+            prog = argv[i];
+    }
+    if (!prog)
+        usage();
+
+    for (i = 0; i < 256; i++) {
+        int b, c = 0;
+        for (b = 0; b < 8; b++) c += (i >> b) & 1;
+        parity[i] = (uint8_t)((c & 1) ? 0 : FPV);
+    }
+
+    fp = fopen(prog, "rb");
+    if (!fp) {
+        perror(prog);
+        return 2;
+    }
+    n = fread(mem + 0x0100, 1, sizeof(mem) - 0x0100, fp);
+    fclose(fp);
+    if (n == 0) {
+        fprintf(stderr, "%s: empty image\n", prog);
+        return 2;
+    }
+
+    /* cp/m page zero: warm boot at 0x0000, bdos entry at 0x0005 */
+    mem[0x0000] = 0x76;                 /* halt */
+    mem[0x0005] = 0xC9;                 /* trapped below */
+    mem[0x0006] = 0x00;
+    mem[0x0007] = 0xFE;                 /* top of tpa for programs that ask */
+
+    memset(&cpu, 0, sizeof(cpu));
+    cpu.pc = 0x0100;
+    cpu.sp = 0xFE00;
+    push16(0x0000);
+
+    while (!cpu.halted && !exit_requested) {
+        if (cpu.pc == 0x0005) {
+            bdos();
+            continue;
+        }
+        if (cpu.pc == 0x0000)
+            break;
+
+        if (probe_open && !probe_active && cpu.pc == probe_target) {
+            probe_active = 1;
+            probe_entry_sp = cpu.sp;
+            probe_ret_pc = rd16(cpu.sp);
+            probe_t0 = cpu.t;
+        }
+
+        exec();
+        if (irq_due)
+            interrupt();
+
+        /* callee-cleanup helpers return with sp above entry + 2 */
+        if (probe_active && cpu.pc == probe_ret_pc
+                && (uint16_t)(cpu.sp - probe_entry_sp - 1) < 0x100) {
+            uint32_t dt = (uint32_t)(cpu.t - probe_t0);
+            probe_active = 0;
+            probe_calls++;
+            probe_sum += dt;
+            if (dt < probe_min) probe_min = dt;
+            if (dt > probe_max) probe_max = dt;
+        }
+
+        if (cpu.t > max_t) {
+            fprintf(stderr, "z80sim: T-state limit reached at pc=%04X\n", cpu.pc);
+            rc = 1;
+            break;
+        }
+    }
+
+    if (dump) {
+        fp = fopen(dump, "wb");
+        if (!fp) {
+            perror(dump);
+            return 2;
+        }
+        fwrite(mem, 1, sizeof(mem), fp);
+        fclose(fp);
+    }
+
+    fflush(stdout);
+    return rc;
+}
@@ -0,0 +1,100 @@
+        ;; bank.s - banked call test fixture for the z80sim bank window
+        ;;
+        ;; z80sim maps one of 8 banks at 0xC000..0xDFFF through port
+        ;; 0xF8 (see test/sim/z80sim.c). bank_setup copies a routine
+        ;; into banks 1..3 at BANK_BASE and stores the bank number at
+        ;; BANK_BASE + 0xFF: banks 2 and 3 return that marker, bank 1
+        ;; calls bank 2 and adds its own marker, so a result of 3 means
+        ;; bank 1 was mapped again after the inner call.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module bank
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _bank_setup
+        .globl  _bank_call
+        .globl  _bank_call_desc
+        .globl  _bank_mapped
+        .globl  _bank_init
+        .globl  ___sdcc_bcall_ehl
+        .globl  __sdcc_banked_call
+
+        ;; the bank port of the simulator, for the library helpers
+        .globl  __bank_port
+        .globl  __bank_mask
+
+        __bank_port == 0x00F8
+        __bank_mask == 0x07
+
+        BANK_PORT       = 0xF8
+        BANK_BASE       = 0xC000
+        BANK_MARK       = BANK_BASE + 0xFF
+
+        ;; _bank_setup(void)
+        ;; inputs:  n/a
+        ;; outputs: banks 1..3 filled, bank 0 mapped
+        ;; clobbers: af, bc, de, hl
+_bank_setup:
+        ld      b,#3
+.copy:
+        ld      a,b
+        out     (BANK_PORT),a
+        ld      (BANK_MARK),a           ; marker: the bank number
+        ld      hl,#leaf
+        dec     a
+        jr      nz,.fill
+        ld      hl,#nested
+.fill:
+        ld      de,#BANK_BASE
+        push    bc
+        ld      bc,#nested_end - nested
+        ldir
+        pop     bc
+        djnz    .copy
+        xor     a
+        jp      _bank_init
+
+        ;; _bank_call(uint8_t bank)
+        ;; inputs:  a = bank
+        ;; outputs: a = result of the routine in that bank
+        ;; clobbers: af, bc, de, hl
+_bank_call:
+        ld      e,a
+        ld      hl,#BANK_BASE
+        jp      ___sdcc_bcall_ehl
+
+        ;; _bank_call_desc(void)
+        ;; inputs:  n/a
+        ;; outputs: a = result of the routine in bank 3
+        ;; clobbers: af, bc, de, hl
+_bank_call_desc:
+        call    __sdcc_banked_call
+        .dw     BANK_BASE
+        .dw     3
+        ret
+
+        ;; _bank_mapped(void)
+        ;; inputs:  n/a
+        ;; outputs: a = bank the simulator has mapped
+        ;; clobbers: af
+_bank_mapped:
+        in      a,(BANK_PORT)
+        ret
+
+        ;; copied to BANK_BASE, so no references into themselves
+nested:
+        ld      e,#2
+        ld      hl,#BANK_BASE
+        call    ___sdcc_bcall_ehl       ; a = 2
+        ld      hl,#BANK_MARK
+        add     a,(hl)
+        ret
+nested_end:
+
+leaf:
+        ld      a,(BANK_MARK)
+        ret
@@ -0,0 +1,70 @@
+        ;; irq.s - interrupt enable state for the critical section check
+        ;;
+        ;; irq_arm has z80sim raise an interrupt as the next `ld a,i`
+        ;; ends (see test/sim/z80sim.c, port 0xF9), to hit the NMOS
+        ;; window of ___sdcc_critical. the handlers only return: the
+        ;; maskable one at 0x0038 enables interrupts again, the nmi at
+        ;; 0x0066 restores them with retn.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module irq
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _irq_enabled
+        .globl  _irq_on
+        .globl  _irq_off
+        .globl  _irq_arm
+        .globl  _irq_taken
+
+        IRQ_PORT        = 0xF9
+
+        ;; _irq_enabled(void)
+        ;; inputs:  n/a
+        ;; outputs: a = 1 if interrupts are enabled (IFF2), else 0
+        ;; clobbers: af
+_irq_enabled:
+        ld      a,i
+        ld      a,#0
+        ret     po
+        inc     a
+        ret
+
+        ;; _irq_on(void), _irq_off(void)
+        ;; inputs:  n/a
+        ;; outputs: interrupts enabled / disabled
+        ;; clobbers: n/a
+_irq_on:
+        ei
+        ret
+_irq_off:
+        di
+        ret
+
+        ;; _irq_arm(uint8_t mode)
+        ;; inputs:  a = mode, the z80sim port 0xF9 bits
+        ;; outputs: handlers in place, interrupt armed
+        ;; clobbers: hl
+_irq_arm:
+        ld      hl,#0x0038
+        ld      (hl),#0xFB              ; ei
+        inc     hl
+        ld      (hl),#0xC9              ; ret
+        ld      hl,#0x0066
+        ld      (hl),#0xED              ; retn
+        inc     hl
+        ld      (hl),#0x45
+        im      1
+        out     (IRQ_PORT),a
+        ret
+
+        ;; _irq_taken(void)
+        ;; inputs:  n/a
+        ;; outputs: a = interrupts taken since irq_arm
+        ;; clobbers: af
+_irq_taken:
+        in      a,(IRQ_PORT)
+        ret
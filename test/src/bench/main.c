@@ -0,0 +1,1090 @@
+// gpl-2.0-or-later (see: LICENSE)
+// (c) 2026 tomaz stih
+
+#include <stdint.h>
+#include <io.h>
+#include <bench.h>
+#include <fpacc.h>
+#include <fsvec.h>
+#include <mulk.h>
+#include <fastdiv.h>
+#include <numconv.h>
+#include <fconv.h>
+#include <sqrt.h>
+#include <recip.h>
+#include <fmath.h>
+#include <fixed.h>
+#include <fstore.h>
+#include <bank.h>
+#include <critical.h>
+
+/* ---------- helper entry points (prototypes as sdcc declares them) ---------- */
+
+extern int           _mulint(int a, int b);
+extern unsigned int  _divuint(unsigned int a, unsigned int b);
+extern int           _divsint(int a, int b);
+extern unsigned int  _moduint(unsigned int a, unsigned int b);
+extern int           _modsint(int a, int b);
+extern long          _mullong(long a, long b);
+extern unsigned long _divulong(unsigned long a, unsigned long b);
+extern long          _divslong(long a, long b);
+extern unsigned long _modulong(unsigned long a, unsigned long b);
+extern long          _modslong(long a, long b);
+extern long long     _mullonglong(long long a, long long b);
+extern unsigned long long _divulonglong(unsigned long long a, unsigned long long b);
+extern long long     _divslonglong(long long a, long long b);
+extern unsigned long long _modulonglong(unsigned long long a, unsigned long long b);
+extern unsigned long _rlulong(unsigned long x, char s);
+extern unsigned long _rrulong(unsigned long x, char s);
+extern long          _rrslong(long x, char s);
+extern unsigned long long _rlulonglong(unsigned long long x, char s);
+extern unsigned long long _rrulonglong(unsigned long long x, char s);
+
+extern float         __fsadd(float a, float b);
+extern float         __fssub(float a, float b);
+extern float         __fsmul(float a, float b);
+extern float         __fsdiv(float a, float b);
+extern float         __fsfma(float a, float b, float c);
+extern int           __fscmp(float a, float b);
+extern char          __fslt(float a, float b);
+extern char          __fseq(float a, float b);
+
+extern void          __sdcc_bcall_ehl(void);
+extern void          _sdcc_critical(void);
+
+/* bank.s: routines in the z80sim bank window */
+extern void          bank_setup(void);
+extern uint8_t       bank_call(uint8_t bank);
+extern uint8_t       bank_call_desc(void);
+extern uint8_t       bank_mapped(void);
+
+/* irq.s */
+extern uint8_t       irq_enabled(void);
+extern void          irq_on(void);
+extern void          irq_off(void);
+extern void          irq_arm(uint8_t mode);
+extern uint8_t       irq_taken(void);
+
+#define IRQ_INT  0x01               /* z80sim port 0xF9 */
+#define IRQ_NMOS 0x80
+
+extern unsigned char __fs2uchar(float f);
+extern signed char   __fs2schar(float f);
+extern unsigned int  __fs2uint(float f);
+extern int           __fs2sint(float f);
+extern unsigned long __fs2ulong(float f);
+extern long          __fs2slong(float f);
+extern unsigned long long __fs2ulonglong(float f);
+extern long long     __fs2slonglong(float f);
+extern float         __uchar2fs(unsigned char c);
+extern float         __schar2fs(signed char c);
+extern float         __uint2fs(unsigned int i);
+extern float         __sint2fs(int i);
+extern float         __ulong2fs(unsigned long l);
+extern float         __slong2fs(long l);
+extern float         __ulonglong2fs(unsigned long long l);
+extern float         __slonglong2fs(long long l);
+
+/* calls per operand distribution */
+#define BENCH_N 64
+
+/* ---------- deterministic operands ---------- */
+
+typedef union f32u_u {
+    float    f;
+    uint32_t u;
+} f32u_t;
+
+static uint32_t seed = 0x2545F491UL;
+
+/* xorshift32: shifts and xors only, so it never calls a timed helper */
+static uint32_t rnd32(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static uint16_t rnd16(void) { return (uint16_t)rnd32(); }
+
+/* two draws, shifted by hand so no 64-bit helper runs inside a phase */
+static uint64_t rnd64(void) {
+    uint64_t r;
+    ((uint32_t *)&r)[1] = rnd32();
+    ((uint32_t *)&r)[0] = rnd32();
+    return r;
+}
+
+/* random float with sign, full mantissa and exponent in [emin, emin+espan) */
+static float rnd_f32(int8_t emin, uint8_t espan, uint8_t negative) {
+    f32u_t t;
+    uint32_t r = rnd32();
+    uint8_t e = (uint8_t)(127 + emin + (uint8_t)(r >> 24) % espan);
+    t.u = (r & 0x007FFFFFUL) | ((uint32_t)e << 23);
+    if (negative && (r & 0x80000000UL)) t.u |= 0x80000000UL;
+    return t.f;
+}
+
+/* results are stored here so the calls are never optimised away */
+static volatile uint16_t sink16;
+static volatile uint32_t sink32;
+static volatile uint64_t sink64;
+static volatile float    sinkf;
+
+/* ---------- 16-bit integer ---------- */
+
+static void bench_mulint(const char *label, uint16_t mask) {
+    uint8_t i;
+    bench_begin(label, (void *)_mulint);
+    for (i = 0; i < BENCH_N; i++)
+        sink16 = (uint16_t)((int)(rnd16() & mask) * (int)(rnd16() & mask));
+    bench_end();
+}
+
+/* x * k through the generic helper, as sdcc emits it */
+static void bench_mulint_k(const char *label, uint16_t k) {
+    uint8_t i;
+    bench_begin(label, (void *)_mulint);
+    for (i = 0; i < BENCH_N; i++)
+        sink16 = (uint16_t)_mulint((int)rnd16(), (int)k);
+    bench_end();
+}
+
+/* the same through the fixed-constant entry from mulk.h */
+static void bench_mulk(const char *label, unsigned int (*f)(unsigned int)) {
+    uint8_t i;
+    bench_begin(label, (void *)f);
+    for (i = 0; i < BENCH_N; i++)
+        sink16 = f(rnd16());
+    bench_end();
+}
+
+static void bench_divuint(const char *label, uint16_t xmask, uint16_t ymask) {
+    uint8_t i;
+    uint16_t x, y;
+    bench_begin(label, (void *)_divuint);
+    for (i = 0; i < BENCH_N; i++) {
+        x = rnd16() & xmask;
+        y = (rnd16() & ymask) | 1;
+        sink16 = x / y;
+    }
+    bench_end();
+}
+
+static void bench_moduint(const char *label, uint16_t xmask, uint16_t ymask) {
+    uint8_t i;
+    uint16_t x, y;
+    bench_begin(label, (void *)_moduint);
+    for (i = 0; i < BENCH_N; i++) {
+        x = rnd16() & xmask;
+        y = (rnd16() & ymask) | 1;
+        sink16 = x % y;
+    }
+    bench_end();
+}
+
+static void bench_divsint(const char *label) {
+    uint8_t i;
+    int x, y;
+    bench_begin(label, (void *)_divsint);
+    for (i = 0; i < BENCH_N; i++) {
+        x = (int)rnd16();
+        y = (int)(rnd16() & 0x83FF) | 1;
+        sink16 = (uint16_t)(x / y);
+    }
+    bench_end();
+}
+
+static void bench_modsint(const char *label) {
+    uint8_t i;
+    int x, y;
+    bench_begin(label, (void *)_modsint);
+    for (i = 0; i < BENCH_N; i++) {
+        x = (int)rnd16();
+        y = (int)(rnd16() & 0x83FF) | 1;
+        sink16 = (uint16_t)(x % y);
+    }
+    bench_end();
+}
+
+/* ---------- 32-bit integer ---------- */
+
+static void bench_mullong(const char *label, uint32_t amask, uint32_t bmask) {
+    uint8_t i;
+    bench_begin(label, (void *)_mullong);
+    for (i = 0; i < BENCH_N; i++)
+        sink32 = (uint32_t)((long)(rnd32() & amask) * (long)(rnd32() & bmask));
+    bench_end();
+}
+
+static void bench_divulong(const char *label, uint32_t xmask, uint32_t ymask) {
+    uint8_t i;
+    uint32_t x, y;
+    bench_begin(label, (void *)_divulong);
+    for (i = 0; i < BENCH_N; i++) {
+        x = rnd32() & xmask;
+        y = (rnd32() & ymask) | 1;
+        sink32 = x / y;
+    }
+    bench_end();
+}
+
+static void bench_modulong(const char *label, uint32_t xmask, uint32_t ymask) {
+    uint8_t i;
+    uint32_t x, y;
+    bench_begin(label, (void *)_modulong);
+    for (i = 0; i < BENCH_N; i++) {
+        x = rnd32() & xmask;
+        y = (rnd32() & ymask) | 1;
+        sink32 = x % y;
+    }
+    bench_end();
+}
+
+static void bench_divslong(const char *label) {
+    uint8_t i;
+    long x, y;
+    bench_begin(label, (void *)_divslong);
+    for (i = 0; i < BENCH_N; i++) {
+        x = (long)rnd32();
+        y = (long)(rnd32() & 0x80FFFFFFUL) | 1;
+        sink32 = (uint32_t)(x / y);
+    }
+    bench_end();
+}
+
+static void bench_modslong(const char *label) {
+    uint8_t i;
+    long x, y;
+    bench_begin(label, (void *)_modslong);
+    for (i = 0; i < BENCH_N; i++) {
+        x = (long)rnd32();
+        y = (long)(rnd32() & 0x80FFFFFFUL) | 1;
+        sink32 = (uint32_t)(x % y);
+    }
+    bench_end();
+}
+
+/* x / d with d fixed for the whole phase, as in a loop over an array */
+static void bench_divulong_k(const char *label, uint32_t d) {
+    uint8_t i;
+    bench_begin(label, (void *)_divulong);
+    for (i = 0; i < BENCH_N; i++)
+        sink32 = _divulong(rnd32(), d);
+    bench_end();
+}
+
+/* the same through a divisor prepared once with fastdiv.h */
+static void bench_udiv32(const char *label, uint32_t d) {
+    uint8_t i;
+    udiv32_t s;
+    udiv32_prepare(&s, d);
+    bench_begin(label, (void *)udiv32_apply);
+    for (i = 0; i < BENCH_N; i++)
+        sink32 = udiv32_apply(&s, rnd32());
+    bench_end();
+}
+
+static void bench_sdiv32(const char *label, long d) {
+    uint8_t i;
+    sdiv32_t s;
+    sdiv32_prepare(&s, d);
+    bench_begin(label, (void *)sdiv32_apply);
+    for (i = 0; i < BENCH_N; i++)
+        sink32 = (uint32_t)sdiv32_apply(&s, (long)rnd32());
+    bench_end();
+}
+
+/* ---------- decimal text ---------- */
+
+/* top fixes the digit count: avg / digits is the cost of one digit */
+
+static char nbuf[12];
+
+static void bench_utoa16(const char *label, uint16_t top) {
+    uint8_t i;
+    bench_begin(label, (void *)utoa16);
+    for (i = 0; i < BENCH_N; i++)
+        utoa16(rnd16() | top, nbuf);
+    bench_end();
+}
+
+static void bench_utoa32(const char *label, uint32_t top) {
+    uint8_t i;
+    bench_begin(label, (void *)utoa32);
+    for (i = 0; i < BENCH_N; i++)
+        utoa32(rnd32() | top, nbuf);
+    bench_end();
+}
+
+/* the strings come from utoa16 / utoa32, only the parser is timed */
+static void bench_atoi16(const char *label) {
+    uint8_t i;
+    bench_begin(label, (void *)atoi16);
+    for (i = 0; i < BENCH_N; i++) {
+        utoa16(rnd16() | 0x8000u, nbuf);
+        sink16 = (uint16_t)atoi16(nbuf);
+    }
+    bench_end();
+}
+
+static void bench_strtoul32(const char *label) {
+    uint8_t i;
+    bench_begin(label, (void *)strtoul32);
+    for (i = 0; i < BENCH_N; i++) {
+        utoa32(rnd32() | 0xC0000000UL, nbuf);
+        sink32 = strtoul32(nbuf, 0, 10);
+    }
+    bench_end();
+}
+
+static void bench_strtoul32_hex(const char *label) {
+    uint8_t i, j;
+    uint32_t x;
+    bench_begin(label, (void *)strtoul32);
+    for (i = 0; i < BENCH_N; i++) {
+        x = rnd32() | 0x10000000UL;
+        for (j = 8; j--; ) {
+            nbuf[j] = "0123456789abcdef"[(uint8_t)x & 0x0F];
+            x >>= 4;
+        }
+        nbuf[8] = 0;
+        sink32 = strtoul32(nbuf, 0, 16);
+    }
+    bench_end();
+}
+
+/* ---------- 64-bit integer ---------- */
+
+static void bench_mullonglong(const char *label, uint64_t amask, uint64_t bmask) {
+    uint8_t i;
+    uint64_t a, b;
+    bench_begin(label, (void *)_mullonglong);
+    for (i = 0; i < BENCH_N; i++) {
+        a = rnd64() & amask;
+        b = rnd64() & bmask;
+        sink64 = a * b;
+    }
+    bench_end();
+}
+
+static void bench_divulonglong(const char *label, uint64_t xmask, uint64_t ymask) {
+    uint8_t i;
+    uint64_t x, y;
+    bench_begin(label, (void *)_divulonglong);
+    for (i = 0; i < BENCH_N; i++) {
+        x = rnd64() & xmask;
+        y = rnd64() & ymask;
+        ((uint8_t *)&y)[0] |= 1;
+        sink64 = x / y;
+    }
+    bench_end();
+}
+
+static void bench_modulonglong(const char *label, uint64_t xmask, uint64_t ymask) {
+    uint8_t i;
+    uint64_t x, y;
+    bench_begin(label, (void *)_modulonglong);
+    for (i = 0; i < BENCH_N; i++) {
+        x = rnd64() & xmask;
+        y = rnd64() & ymask;
+        ((uint8_t *)&y)[0] |= 1;
+        sink64 = x % y;
+    }
+    bench_end();
+}
+
+static void bench_divslonglong(const char *label) {
+    uint8_t i;
+    uint64_t x, y;
+    bench_begin(label, (void *)_divslonglong);
+    for (i = 0; i < BENCH_N; i++) {
+        x = rnd64();
+        y = rnd64() & 0x800000FFFFFFFFFFULL;
+        ((uint8_t *)&y)[0] |= 1;
+        sink64 = (uint64_t)((int64_t)x / (int64_t)y);
+    }
+    bench_end();
+}
+
+/* ---------- variable shifts ---------- */
+
+/* cmask 0x18 draws 0, 8, 16 or 24, 0x1F any count below 32 */
+static void bench_rlulong(const char *label, uint8_t cmask) {
+    uint8_t i;
+    bench_begin(label, (void *)_rlulong);
+    for (i = 0; i < BENCH_N; i++)
+        sink32 = _rlulong(rnd32(), (char)(rnd16() & cmask));
+    bench_end();
+}
+
+static void bench_rrulong(const char *label, uint8_t cmask) {
+    uint8_t i;
+    bench_begin(label, (void *)_rrulong);
+    for (i = 0; i < BENCH_N; i++)
+        sink32 = _rrulong(rnd32(), (char)(rnd16() & cmask));
+    bench_end();
+}
+
+static void bench_rrslong(const char *label, uint8_t cmask) {
+    uint8_t i;
+    bench_begin(label, (void *)_rrslong);
+    for (i = 0; i < BENCH_N; i++)
+        sink32 = (uint32_t)_rrslong((long)rnd32(), (char)(rnd16() & cmask));
+    bench_end();
+}
+
+static void bench_rlulonglong(const char *label, uint8_t cmask) {
+    uint8_t i;
+    bench_begin(label, (void *)_rlulonglong);
+    for (i = 0; i < BENCH_N; i++)
+        sink64 = _rlulonglong(rnd64(), (char)(rnd16() & cmask));
+    bench_end();
+}
+
+static void bench_rrulonglong(const char *label, uint8_t cmask) {
+    uint8_t i;
+    bench_begin(label, (void *)_rrulonglong);
+    for (i = 0; i < BENCH_N; i++)
+        sink64 = _rrulonglong(rnd64(), (char)(rnd16() & cmask));
+    bench_end();
+}
+
+/* ---------- float arithmetic ---------- */
+
+/* espan: exponent spread of the operands; small spreads keep the
+   alignment shift short, large ones exercise the far path */
+static void bench_fsadd(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)__fsadd);
+    for (i = 0; i < BENCH_N; i++)
+        sinkf = rnd_f32(-8, espan, 1) + rnd_f32(-8, espan, 1);
+    bench_end();
+}
+
+static void bench_fssub(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)__fssub);
+    for (i = 0; i < BENCH_N; i++)
+        sinkf = rnd_f32(-8, espan, 1) - rnd_f32(-8, espan, 1);
+    bench_end();
+}
+
+/* a + (-a * (1 + tiny)): heavy cancellation, long renormalisation */
+static void bench_fsadd_cancel(const char *label) {
+    uint8_t i;
+    f32u_t a, b;
+    bench_begin(label, (void *)__fsadd);
+    for (i = 0; i < BENCH_N; i++) {
+        a.f = rnd_f32(0, 8, 1);
+        b.u = (a.u ^ 0x80000000UL) + (rnd16() & 0x00FF);
+        sinkf = a.f + b.f;
+    }
+    bench_end();
+}
+
+static void bench_fsmul(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)__fsmul);
+    for (i = 0; i < BENCH_N; i++)
+        sinkf = rnd_f32(-8, espan, 1) * rnd_f32(-8, espan, 1);
+    bench_end();
+}
+
+static void bench_fsdiv(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)__fsdiv);
+    for (i = 0; i < BENCH_N; i++)
+        sinkf = rnd_f32(-8, espan, 1) / rnd_f32(-8, espan, 1);
+    bench_end();
+}
+
+static void bench_fsfma(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)__fsfma);
+    for (i = 0; i < BENCH_N; i++)
+        sinkf = __fsfma(rnd_f32(-8, espan, 1), rnd_f32(-8, espan, 1),
+                        rnd_f32(-8, espan, 1));
+    bench_end();
+}
+
+/* ---------- square root ---------- */
+
+static void bench_isqrt16(const char *label) {
+    uint8_t i;
+    bench_begin(label, (void *)isqrt16);
+    for (i = 0; i < BENCH_N; i++) sink16 = isqrt16(rnd16());
+    bench_end();
+}
+
+static void bench_isqrt32(const char *label) {
+    uint8_t i;
+    bench_begin(label, (void *)isqrt32);
+    for (i = 0; i < BENCH_N; i++) sink16 = isqrt32(rnd32());
+    bench_end();
+}
+
+static void bench_fsinv(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)__fsinv);
+    for (i = 0; i < BENCH_N; i++) sinkf = __fsinv(rnd_f32(-8, espan, 1));
+    bench_end();
+}
+
+static void bench_fssqrt(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)__fssqrt);
+    for (i = 0; i < BENCH_N; i++) sinkf = __fssqrt(rnd_f32(-8, espan, 0));
+    bench_end();
+}
+
+/* ---------- elementary functions ---------- */
+
+static void bench_sinf(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)sinf);
+    for (i = 0; i < BENCH_N; i++) sinkf = sinf(rnd_f32(-4, espan, 1));
+    bench_end();
+}
+
+static void bench_cosf(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)cosf);
+    for (i = 0; i < BENCH_N; i++) sinkf = cosf(rnd_f32(-4, espan, 1));
+    bench_end();
+}
+
+static void bench_sincosf(const char *label, uint8_t espan) {
+    uint8_t i;
+    float s, c;
+    bench_begin(label, (void *)sincosf);
+    for (i = 0; i < BENCH_N; i++) {
+        sincosf(rnd_f32(-4, espan, 1), &s, &c);
+        sinkf = s + c;
+    }
+    bench_end();
+}
+
+static void bench_atan2f(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)atan2f);
+    for (i = 0; i < BENCH_N; i++)
+        sinkf = atan2f(rnd_f32(-8, espan, 1), rnd_f32(-8, espan, 1));
+    bench_end();
+}
+
+static void bench_expf(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)expf);
+    for (i = 0; i < BENCH_N; i++) sinkf = expf(rnd_f32(-4, espan, 1));
+    bench_end();
+}
+
+static void bench_logf(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)logf);
+    for (i = 0; i < BENCH_N; i++) sinkf = logf(rnd_f32(-8, espan, 0));
+    bench_end();
+}
+
+static void bench_fpacc_add(const char *label, uint8_t espan) {
+    uint8_t i;
+    fpacc_t acc;
+    fpacc_init(&acc);
+    bench_begin(label, (void *)fpacc_add);
+    for (i = 0; i < BENCH_N; i++)
+        fpacc_add(&acc, rnd_f32(-8, espan, 1));
+    bench_end();
+    sinkf = fpacc_result(&acc);
+}
+
+static void bench_fpacc_mul_add(const char *label, uint8_t espan) {
+    uint8_t i;
+    fpacc_t acc;
+    fpacc_init(&acc);
+    bench_begin(label, (void *)fpacc_mul_add);
+    for (i = 0; i < BENCH_N; i++)
+        fpacc_mul_add(&acc, rnd_f32(-8, espan, 1), rnd_f32(-8, espan, 1));
+    bench_end();
+    sinkf = fpacc_result(&acc);
+}
+
+/* ---------- array kernels: one call per BENCH_N elements ---------- */
+
+static float bx[BENCH_N], by[BENCH_N];
+
+static void fill_xy(uint8_t espan) {
+    uint8_t i;
+    for (i = 0; i < BENCH_N; i++) {
+        bx[i] = rnd_f32(-8, espan, 1);
+        by[i] = rnd_f32(-8, espan, 1);
+    }
+}
+
+static void bench_fs_dot(const char *label, uint8_t espan) {
+    fill_xy(espan);
+    bench_begin(label, (void *)fs_dot);
+    sinkf = fs_dot(bx, by, BENCH_N);
+    bench_end();
+}
+
+static void bench_fs_sum(const char *label, uint8_t espan) {
+    fill_xy(espan);
+    bench_begin(label, (void *)fs_sum);
+    sinkf = fs_sum(bx, BENCH_N);
+    bench_end();
+}
+
+static void bench_fs_scale(const char *label, uint8_t espan) {
+    fill_xy(espan);
+    bench_begin(label, (void *)fs_scale);
+    fs_scale(rnd_f32(-8, espan, 1), bx, BENCH_N);
+    bench_end();
+}
+
+static void bench_fs_axpy(const char *label, uint8_t espan) {
+    fill_xy(espan);
+    bench_begin(label, (void *)fs_axpy);
+    fs_axpy(rnd_f32(-8, espan, 1), bx, by, BENCH_N);
+    bench_end();
+}
+
+/* ---------- decimal conversion ---------- */
+
+static char dbuf[20];
+
+static void bench_ftoa(const char *label, uint8_t digits, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)ftoa);
+    for (i = 0; i < BENCH_N; i++)
+        ftoa(rnd_f32(-8, espan, 1), dbuf, digits);
+    bench_end();
+}
+
+/* the strings come from ftoa, only the strtof calls are timed */
+static void bench_strtof(const char *label, uint8_t digits, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)strtof);
+    for (i = 0; i < BENCH_N; i++) {
+        ftoa(rnd_f32(-8, espan, 1), dbuf, digits);
+        sinkf = strtof(dbuf, 0);
+    }
+    bench_end();
+}
+
+static void bench_fscmp(const char *label, uint8_t espan) {
+    uint8_t i;
+    bench_begin(label, (void *)__fscmp);
+    for (i = 0; i < BENCH_N; i++)
+        sink16 = (uint16_t)__fscmp(rnd_f32(-8, espan, 1), rnd_f32(-8, espan, 1));
+    bench_end();
+}
+
+static void bench_fslt(const char *label) {
+    uint8_t i;
+    bench_begin(label, (void *)__fslt);
+    for (i = 0; i < BENCH_N; i++)
+        sink16 = rnd_f32(-8, 16, 1) < rnd_f32(-8, 16, 1);
+    bench_end();
+}
+
+static void bench_fseq(const char *label) {
+    uint8_t i;
+    f32u_t a, b;
+    bench_begin(label, (void *)__fseq);
+    for (i = 0; i < BENCH_N; i++) {
+        a.f = rnd_f32(-8, 16, 1);
+        b.f = rnd_f32(-8, 16, 1);
+        if (i & 1) b.u = a.u;       /* half the pairs compare equal */
+        sink16 = a.f == b.f;
+    }
+    bench_end();
+}
+
+/* ---------- fixed point: compare with __fsmul / __fsdiv ---------- */
+
+/* 16.16 in +-256 and 8.8 in +-8, so products stay in range */
+static fx16_t rnd_fx16(void) { return (fx16_t)rnd32() >> 7; }
+static fx8_t  rnd_fx8(void)  { return (fx8_t)rnd16() >> 4; }
+
+static void bench_fx16(const char *label, fx16_t (*f)(fx16_t, fx16_t)) {
+    uint8_t i;
+    bench_begin(label, (void *)f);
+    for (i = 0; i < BENCH_N; i++)
+        sink32 = (uint32_t)f(rnd_fx16(), rnd_fx16() | 1);
+    bench_end();
+}
+
+static void bench_fx8(const char *label, fx8_t (*f)(fx8_t, fx8_t)) {
+    uint8_t i;
+    bench_begin(label, (void *)f);
+    for (i = 0; i < BENCH_N; i++)
+        sink16 = (uint16_t)f(rnd_fx8(), rnd_fx8() | 1);
+    bench_end();
+}
+
+static void bench_fx16_from_float(const char *label) {
+    uint8_t i;
+    bench_begin(label, (void *)fx16_from_float);
+    for (i = 0; i < BENCH_N; i++) sink32 = (uint32_t)fx16_from_float(rnd_f32(-8, 16, 1));
+    bench_end();
+}
+
+static void bench_fx16_to_float(const char *label) {
+    uint8_t i;
+    bench_begin(label, (void *)fx16_to_float);
+    for (i = 0; i < BENCH_N; i++) sinkf = fx16_to_float(rnd_fx16());
+    bench_end();
+}
+
+/* ---------- compact storage (fstore.h) ---------- */
+
+static void bench_fstore(void) {
+    uint8_t i;
+    static f24_t p;
+
+    bench_begin("fs2half     exp spread 16", (void *)fs2half);
+    for (i = 0; i < BENCH_N; i++) sink16 = fs2half(rnd_f32(-8, 16, 1));
+    bench_end();
+
+    bench_begin("half2fs     rand16", (void *)half2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = half2fs(rnd16());
+    bench_end();
+
+    bench_begin("fs2f24      exp spread 16", (void *)fs2f24);
+    for (i = 0; i < BENCH_N; i++) fs2f24(&p, rnd_f32(-8, 16, 1));
+    bench_end();
+
+    bench_begin("f242fs", (void *)f242fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = f242fs(&p);
+    bench_end();
+}
+
+/* ---------- banked calls ---------- */
+
+/* bank 1 calls bank 2, see bank.s; every call must leave the
+   caller's bank mapped */
+static uint8_t bank_check(void) {
+    bank_setup();
+    if (bank_call(2) != 2 || bank_mapped() != 0) return 0;
+    if (bank_call(1) != 3 || bank_mapped() != 0) return 0;
+    if (bank_call_desc() != 3 || bank_mapped() != 0) return 0;
+    bank_init(2);
+    if (bank_call(2) != 2 || bank_mapped() != 2) return 0;
+    if (bank_call(1) != 3 || bank_mapped() != 2) return 0;
+    bank_init(0);
+    return 1;
+}
+
+static void bench_bank(void) {
+    uint8_t i;
+
+    if (!bank_check()) {
+        cputs("FAIL banked calls\n");
+        return;
+    }
+
+    bank_init(2);
+    bench_begin("__sdcc_bcall_ehl mapped", (void *)__sdcc_bcall_ehl);
+    for (i = 0; i < BENCH_N; i++) sink16 = bank_call(2);
+    bench_end();
+
+    bank_init(0);
+    bench_begin("__sdcc_bcall_ehl switch", (void *)__sdcc_bcall_ehl);
+    for (i = 0; i < BENCH_N; i++) sink16 = bank_call(3);
+    bench_end();
+
+    bench_begin("__sdcc_bcall_ehl nested", (void *)__sdcc_bcall_ehl);
+    for (i = 0; i < BENCH_N; i++) sink16 = bank_call(1);
+    bench_end();
+}
+
+/* ---------- critical sections ---------- */
+
+/* only the outermost exit may enable interrupts, and only if the
+   outermost enter found them on */
+static uint8_t critical_check(void) {
+    uint8_t ok = 1;
+
+    irq_on();
+    critical_enter();
+    ok &= !irq_enabled();
+    critical_enter();
+    critical_exit();
+    ok &= !irq_enabled();
+    critical_exit();
+    ok &= irq_enabled();
+    irq_off();
+    critical_enter();
+    critical_exit();
+    ok &= !irq_enabled();
+    irq_on();
+    return ok;
+}
+
+/* z80sim takes an interrupt as the ld a,i in ___sdcc_critical ends;
+   the section must still find interrupts on. the nmos model reads
+   P/V as 0 there, which only CRITICAL_NMOS=on catches */
+static uint8_t critical_irq_check(uint8_t mode) {
+    uint8_t taken;
+
+    irq_on();
+    irq_arm(mode);
+    critical_enter();
+    taken = irq_taken();
+    critical_exit();
+    irq_arm(0);
+    return taken == 1 && irq_enabled();
+}
+
+static void bench_critical(void) {
+    uint8_t i;
+
+    if (!critical_check()) {
+        cputs("FAIL critical sections\n");
+        return;
+    }
+    if (!critical_irq_check(IRQ_INT)) {
+        cputs("FAIL critical section, interrupt in ld a,i\n");
+        return;
+    }
+#if CRITICAL_NMOS
+    if (!critical_irq_check(IRQ_INT | IRQ_NMOS)) {
+        cputs("FAIL critical section, nmos interrupt in ld a,i\n");
+        return;
+    }
+#endif
+
+    bench_begin("__sdcc_critical", (void *)_sdcc_critical);
+    for (i = 0; i < BENCH_N; i++) {
+        _sdcc_critical();
+        irq_on();
+    }
+    bench_end();
+
+    bench_begin("critical_enter outermost", (void *)critical_enter);
+    for (i = 0; i < BENCH_N; i++) {
+        critical_enter();
+        critical_exit();
+    }
+    bench_end();
+
+    bench_begin("critical_exit outermost", (void *)critical_exit);
+    for (i = 0; i < BENCH_N; i++) {
+        critical_enter();
+        critical_exit();
+    }
+    bench_end();
+
+    critical_enter();
+    bench_begin("critical_enter nested", (void *)critical_enter);
+    for (i = 0; i < BENCH_N; i++) {
+        critical_enter();
+        critical_exit();
+    }
+    bench_end();
+    critical_exit();
+}
+
+/* ---------- float <-> integer conversions ---------- */
+
+static void bench_fs2int(void) {
+    uint8_t i;
+
+    bench_begin("__fs2uchar  [0,256)", (void *)__fs2uchar);
+    for (i = 0; i < BENCH_N; i++) sink16 = (unsigned char)rnd_f32(0, 8, 0);
+    bench_end();
+
+    bench_begin("__fs2schar  (-128,128)", (void *)__fs2schar);
+    for (i = 0; i < BENCH_N; i++) sink16 = (uint16_t)(signed char)rnd_f32(0, 7, 1);
+    bench_end();
+
+    bench_begin("__fs2uint   [0,65536)", (void *)__fs2uint);
+    for (i = 0; i < BENCH_N; i++) sink16 = (unsigned int)rnd_f32(0, 16, 0);
+    bench_end();
+
+    bench_begin("__fs2sint   (-32768,32768)", (void *)__fs2sint);
+    for (i = 0; i < BENCH_N; i++) sink16 = (uint16_t)(int)rnd_f32(0, 15, 1);
+    bench_end();
+
+    bench_begin("__fs2ulong  [0,2^32)", (void *)__fs2ulong);
+    for (i = 0; i < BENCH_N; i++) sink32 = (unsigned long)rnd_f32(0, 32, 0);
+    bench_end();
+
+    bench_begin("__fs2slong  (-2^31,2^31)", (void *)__fs2slong);
+    for (i = 0; i < BENCH_N; i++) sink32 = (uint32_t)(long)rnd_f32(0, 31, 1);
+    bench_end();
+
+    bench_begin("__fs2ulonglong [0,2^32)", (void *)__fs2ulonglong);
+    for (i = 0; i < BENCH_N; i++) sink64 = (unsigned long long)rnd_f32(0, 32, 0);
+    bench_end();
+
+    bench_begin("__fs2ulonglong [0,2^64)", (void *)__fs2ulonglong);
+    for (i = 0; i < BENCH_N; i++) sink64 = (unsigned long long)rnd_f32(0, 64, 0);
+    bench_end();
+
+    bench_begin("__fs2slonglong (-2^63,2^63)", (void *)__fs2slonglong);
+    for (i = 0; i < BENCH_N; i++) sink64 = (uint64_t)(long long)rnd_f32(0, 63, 1);
+    bench_end();
+
+    bench_begin("__fs2sint   |x|<1", (void *)__fs2sint);
+    for (i = 0; i < BENCH_N; i++) sink16 = (uint16_t)(int)rnd_f32(-8, 8, 1);
+    bench_end();
+}
+
+static void bench_int2fs(void) {
+    uint8_t i;
+
+    bench_begin("__uchar2fs  rand8", (void *)__uchar2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = (float)(unsigned char)rnd16();
+    bench_end();
+
+    bench_begin("__schar2fs  rand8", (void *)__schar2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = (float)(signed char)rnd16();
+    bench_end();
+
+    bench_begin("__uint2fs   rand16", (void *)__uint2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = (float)(unsigned int)rnd16();
+    bench_end();
+
+    bench_begin("__sint2fs   rand16", (void *)__sint2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = (float)(int)rnd16();
+    bench_end();
+
+    bench_begin("__ulong2fs  rand16", (void *)__ulong2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = (float)(unsigned long)rnd16();
+    bench_end();
+
+    bench_begin("__ulong2fs  rand32", (void *)__ulong2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = (float)(unsigned long)rnd32();
+    bench_end();
+
+    bench_begin("__slong2fs  rand32", (void *)__slong2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = (float)(long)rnd32();
+    bench_end();
+
+    bench_begin("__ulonglong2fs rand32", (void *)__ulonglong2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = (float)(unsigned long long)rnd32();
+    bench_end();
+
+    bench_begin("__ulonglong2fs rand64", (void *)__ulonglong2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = (float)rnd64();
+    bench_end();
+
+    bench_begin("__slonglong2fs rand64", (void *)__slonglong2fs);
+    for (i = 0; i < BENCH_N; i++) sinkf = (float)(long long)rnd64();
+    bench_end();
+}
+
+int main(void) {
+    cputs("libsdcc-z80 benchmark, T-states per call\n");
+    cputs("helper      operands                calls      min      avg      max\n");
+
+    bench_mulint ("__mulint    rand8",  0x00FF);
+    bench_mulint ("__mulint    rand16", 0xFFFF);
+    bench_mulint_k("__mulint    rand16*10",   10);
+    bench_mulk    ("mul16_10    rand16",      mul16_10);
+    bench_mulint_k("__mulint    rand16*40",   40);
+    bench_mulk    ("mul16_40    rand16",      mul16_40);
+    bench_mulint_k("__mulint    rand16*320",  320);
+    bench_mulk    ("mul16_320   rand16",      mul16_320);
+    bench_mulint_k("__mulint    rand16*1000", 1000);
+    bench_mulk    ("mul16_1000  rand16",      mul16_1000);
+    bench_divuint("__divuint   rand16/rand8",  0xFFFF, 0x00FF);
+    bench_divuint("__divuint   rand16/rand16", 0xFFFF, 0xFFFF);
+    bench_moduint("__moduint   rand16/rand8",  0xFFFF, 0x00FF);
+    bench_divsint("__divsint   rand16/rand11");
+    bench_modsint("__modsint   rand16/rand11");
+
+    bench_mullong ("__mullong   rand16*rand16", 0x0000FFFFUL, 0x0000FFFFUL);
+    bench_mullong ("__mullong   rand32*rand8",  0xFFFFFFFFUL, 0x000000FFUL);
+    bench_mullong ("__mullong   rand32*rand32", 0xFFFFFFFFUL, 0xFFFFFFFFUL);
+    bench_divulong("__divulong  rand16/rand8",  0x0000FFFFUL, 0x000000FFUL);
+    bench_divulong("__divulong  rand32/rand8",  0xFFFFFFFFUL, 0x000000FFUL);
+    bench_divulong("__divulong  rand32/rand16", 0xFFFFFFFFUL, 0x0000FFFFUL);
+    bench_divulong("__divulong  rand32/rand32", 0xFFFFFFFFUL, 0xFFFFFFFFUL);
+    bench_modulong("__modulong  rand32/rand16", 0xFFFFFFFFUL, 0x0000FFFFUL);
+    bench_divslong("__divslong  rand32/rand25");
+    bench_modslong("__modslong  rand32/rand25");
+    bench_divulong_k("__divulong  rand32/10",      10UL);
+    bench_udiv32    ("udiv32_apply rand32/10",     10UL);
+    bench_divulong_k("__divulong  rand32/86400",   86400UL);
+    bench_udiv32    ("udiv32_apply rand32/86400",  86400UL);
+    bench_sdiv32    ("sdiv32_apply rand32/1000",   1000L);
+
+    bench_utoa16       ("utoa16      5 digits",  0x8000u);
+    bench_utoa16       ("utoa16      rand16",    0);
+    bench_utoa32       ("utoa32      10 digits", 0xC0000000UL);
+    bench_utoa32       ("utoa32      rand32",    0);
+    bench_atoi16       ("atoi16      5 digits");
+    bench_strtoul32    ("strtoul32   10 digits");
+    bench_strtoul32_hex("strtoul32   8 hex digits");
+    bench_isqrt16      ("isqrt16     rand16");
+    bench_isqrt32      ("isqrt32     rand32");
+
+    bench_mullonglong ("__mullonglong rand16*rand16", 0xFFFFULL, 0xFFFFULL);
+    bench_mullonglong ("__mullonglong rand32*rand32", 0xFFFFFFFFULL, 0xFFFFFFFFULL);
+    bench_mullonglong ("__mullonglong rand64*rand64", ~0ULL, ~0ULL);
+    bench_divulonglong("__divulonglong rand32/rand16", 0xFFFFFFFFULL, 0xFFFFULL);
+    bench_divulonglong("__divulonglong rand32/rand32", 0xFFFFFFFFULL, 0xFFFFFFFFULL);
+    bench_divulonglong("__divulonglong rand64/rand16", ~0ULL, 0xFFFFULL);
+    bench_divulonglong("__divulonglong rand64/rand40", ~0ULL, 0xFFFFFFFFFFULL);
+    bench_modulonglong("__modulonglong rand64/rand16", ~0ULL, 0xFFFFULL);
+    bench_divslonglong("__divslonglong rand64/rand41");
+
+    bench_rlulong    ("__rlulong   by 0/8/16/24", 0x18);
+    bench_rlulong    ("__rlulong   by rand5",     0x1F);
+    bench_rrulong    ("__rrulong   by 0/8/16/24", 0x18);
+    bench_rrulong    ("__rrulong   by rand5",     0x1F);
+    bench_rrslong    ("__rrslong   by rand5",     0x1F);
+    bench_rlulonglong("__rlulonglong by 8k",      0x38);
+    bench_rlulonglong("__rlulonglong by rand6",   0x3F);
+    bench_rrulonglong("__rrulonglong by rand6",   0x3F);
+
+    bench_fsadd("__fsadd     exp spread 2",  2);
+    bench_fsadd("__fsadd     exp spread 32", 32);
+    bench_fsadd_cancel("__fsadd     cancelling");
+    bench_fssub("__fssub     exp spread 2",  2);
+    bench_fsmul("__fsmul     exp spread 16", 16);
+    bench_fsdiv("__fsdiv     exp spread 16", 16);
+    bench_fsfma("__fsfma     exp spread 16", 16);
+    bench_fsinv ("__fsinv     exp spread 16", 16);
+    bench_fssqrt("__fssqrt    exp spread 16", 16);
+    bench_sinf  ("sinf        exp spread 8", 8);
+    bench_cosf  ("cosf        exp spread 8", 8);
+    bench_sincosf("sincosf     exp spread 8", 8);
+    bench_atan2f("atan2f      exp spread 16", 16);
+    bench_expf  ("expf        exp spread 10", 10);
+    bench_logf  ("logf        exp spread 16", 16);
+    bench_fpacc_add    ("fpacc_add   exp spread 16", 16);
+    bench_fpacc_mul_add("fpacc_mul_add exp spread 16", 16);
+    bench_fs_dot  ("fs_dot      64 elements", 16);
+    bench_fs_sum  ("fs_sum      64 elements", 16);
+    bench_fs_scale("fs_scale    64 elements", 16);
+    bench_fs_axpy ("fs_axpy     64 elements", 16);
+    bench_ftoa  ("ftoa        6 digits",  6, 32);
+    bench_ftoa  ("ftoa        9 digits",  9, 32);
+    bench_strtof("strtof      6 digits",  6, 32);
+    bench_strtof("strtof      9 digits",  9, 32);
+    bench_fscmp("__fscmp     exp spread 2",  2);
+    bench_fscmp("__fscmp     exp spread 32", 32);
+    bench_fslt ("__fslt      exp spread 16");
+    bench_fseq ("__fseq      equal/random");
+    bench_fx16("fx16_mul    +-256",     fx16_mul);
+    bench_fx16("fx16_mul_sat +-256",    fx16_mul_sat);
+    bench_fx16("fx16_div    +-256",     fx16_div);
+    bench_fx16("fx16_div_sat +-256",    fx16_div_sat);
+    bench_fx8 ("fx8_mul     +-8",       fx8_mul);
+    bench_fx8 ("fx8_div     +-8",       fx8_div);
+    bench_fx16_from_float("fx16_from_float exp spread 16");
+    bench_fx16_to_float  ("fx16_to_float +-256");
+    bench_fstore();
+    bench_bank();
+    bench_critical();
+
+    bench_fs2int();
+    bench_int2fs();
+
+    cputs("done\n");
+    return 0;
+}
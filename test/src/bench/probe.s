@@ -0,0 +1,50 @@
+        ;; probe.s - benchmark probe for the z80sim cycle counter
+        ;;
+        ;; talks to the simulator ports documented in test/sim/z80sim.c.
+        ;; on real hardware (or RunCPM) the port writes are harmless.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module probe
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _bench_begin
+        .globl  _bench_end
+
+        PROBE_CTRL      = 0xF0
+        PROBE_LABEL     = 0xF1
+        PROBE_TGT_LO    = 0xF2
+        PROBE_TGT_HI    = 0xF3
+
+        ;; _bench_begin(const char *label, void *target)
+        ;; inputs:  hl = zero terminated label, de = helper entry address
+        ;; outputs: simulator starts timing calls to target
+        ;; clobbers: af, hl
+_bench_begin:
+        ld      a,e
+        out     (PROBE_TGT_LO),a
+        ld      a,d
+        out     (PROBE_TGT_HI),a
+.label:
+        ld      a,(hl)
+        or      a
+        jr      z,.open
+        out     (PROBE_LABEL),a
+        inc     hl
+        jr      .label
+.open:
+        ld      a,#1
+        out     (PROBE_CTRL),a
+        ret
+
+        ;; _bench_end(void)
+        ;; inputs:  n/a
+        ;; outputs: simulator prints calls/min/avg/max for the open phase
+        ;; clobbers: af
+_bench_end:
+        xor     a
+        out     (PROBE_CTRL),a
+        ret
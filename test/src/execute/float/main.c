@@ -3,6 +3,15 @@
 
 #include <stdint.h>
 #include <io.h>
+#include <fma.h>
+#include <fpacc.h>
+#include <fsvec.h>
+#include <fconv.h>
+#include <sqrt.h>
+#include <recip.h>
+#include <fixed.h>
+#include <fstore.h>
+#include <fmath.h>
 
 /* ---------- tiny print helpers ---------- */
 
@@ -50,6 +59,8 @@ static  int16_t mk_s16( int16_t x){ volatile  int16_t t=x; return t; }
 static uint32_t mk_u32(uint32_t x){ volatile uint32_t t=x; return t; }
 /* SDCC "long" is 32-bit; keep both typedefs for clarity */
 static  int32_t mk_s32( int32_t x){ volatile  int32_t t=x; return t; }
+static uint64_t mk_u64(uint64_t x){ volatile uint64_t t=x; return t; }
+static  int64_t mk_s64( int64_t x){ volatile  int64_t t=x; return t; }
 
 /* ---------- f32 bit-cast helpers (no printf, compare by bits) ---------- */
 
@@ -70,6 +81,11 @@ static uint32_t f32_bits(float x) {
     return mk_u32(t.u);   /* volatile barrier on the extracted bits */
 }
 
+/* set by test/src/execute/Makefile from FLOAT_PROFILE */
+#ifndef FLOAT_IEEE
+#define FLOAT_IEEE 0
+#endif
+
 #define _DEBUG 0
 
 #if(_DEBUG)
@@ -307,6 +323,49 @@ static int test_fs2ulong_word_order_sentinel(void) {
     fail(name); return 0;
 }
 
+/* ---------- 64-bit (long long) conversions ---------- */
+
+static int test_fs2ulonglong(void) {
+    const char *name = "(unsigned long long) 2^40, 1.75f, -3.0f, 2^64";
+    unsigned long long a = (unsigned long long)mk_f32(mk_u32(0x53800000UL));
+    unsigned long long b = (unsigned long long)mk_f32(mk_u32(0x3FE00000UL));
+    unsigned long long c = (unsigned long long)mk_f32(mk_u32(0xC0400000UL));
+    unsigned long long d = (unsigned long long)mk_f32(mk_u32(0x5F800000UL));
+    if (a == mk_u64(0x10000000000ULL) && b == mk_u64(1ULL) &&
+        c == mk_u64(0ULL) && d == mk_u64(0xFFFFFFFFFFFFFFFFULL)) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+static int test_fs2slonglong(void) {
+    const char *name = "(long long) -2^40, -1.75f, -2^64 clamps";
+    long long a = (long long)mk_f32(mk_u32(0xD3800000UL));
+    long long b = (long long)mk_f32(mk_u32(0xBFE00000UL));
+    long long c = (long long)mk_f32(mk_u32(0xDF800000UL));
+    if (a == mk_s64(-1099511627776LL) && b == mk_s64(-1LL) &&
+        (uint64_t)c == mk_u64(0x8000000000000000ULL)) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_ulonglong2fs(void) {
+    const char *name = "(float)u64 rounds to nearest even above 2^32";
+    uint32_t a = f32_bits((float)mk_u64(0x123456789ABCDEF0ULL));
+    uint32_t b = f32_bits((float)mk_u64(0x8000008000000000ULL)); /* tie */
+    uint32_t c = f32_bits((float)mk_u64(0x8000008000000001ULL));
+    if (a == 0x5D91A2B4UL && b == 0x5F000000UL && c == 0x5F000001UL) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+static int test_slonglong2fs(void) {
+    const char *name = "(float)-2^40LL == 0xD3800000";
+    uint32_t got = f32_bits((float)mk_s64(-1099511627776LL));
+    if (got == 0xD3800000UL) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
 /* ---------- int to float conversions ---------- */
 static int test_uint2fs_zero(void) {
     const char *name = "(float)0u == +0.0f";
@@ -506,6 +565,17 @@ static int test_slong2fs_max_rounds_to_2p31(void) {
     fail(name); return 0;
 }
 
+static int test_slong2fs_zero_low_word(void) {
+    /* the negated magnitude carries out of the low word */
+    const char *name = "(float)-65536L and (float)-131072L, zero low word";
+    float a = (float)mk_s32(-65536L);
+    float b = (float)mk_s32((int32_t)0xFFFE0000UL);
+    if (f32_bits(a) == 0xC7800000UL && f32_bits(b) == 0xC8000000UL) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
 
 /* ---------- compares ---------- */
 static int test_f32_lt_true(void) {
@@ -553,6 +623,38 @@ static int test_f32_eq_false(void) {
     fail(name); return 0;
 }
 
+static int test_f32_lt_both_neg_lowbyte(void) {
+    const char *name = "f32 -1.0-eps < -1.0 is true (low byte, reversed)";
+    float a = mk_f32(mk_u32(0xBF800001UL));  /* -1.0 - epsilon */
+    float b = mk_f32(mk_u32(0xBF800000UL));  /* -1.0 */
+    int got = (a < b) + 2 * (b < a);
+    if (got == 1) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_f32_signed_zero_compare(void) {
+    const char *name = "f32 -0.0 == +0.0 and neither is less";
+    float a = mk_f32(mk_u32(0x80000000UL));  /* -0.0 */
+    float b = mk_f32(mk_u32(0x00000000UL));  /* +0.0 */
+    if ((a == b) && (b == a) && !(a < b) && !(b < a)) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_f32_eq_denorms(void) {
+#if FLOAT_IEEE
+    const char *name = "f32 two different denormals are not equal (ieee profile)";
+    int expected = 0;
+#else
+    const char *name = "f32 two different denormals are equal (denorms treated as 0)";
+    int expected = 1;
+#endif
+    float a = mk_f32(mk_u32(0x00400000UL));
+    float b = mk_f32(mk_u32(0x80000001UL));
+    int got = (a == b);
+    if (got == expected) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
 extern int __fscmp(float a, float b);
 
 static int test_f32_cmp_basic_neg1(void) {
@@ -655,11 +757,17 @@ static int test_f32_cmp_neg_zero_vs_pos_zero(void) {
 }
 
 static int test_f32_cmp_denorm_vs_zero(void) {
+#if FLOAT_IEEE
+    const char *name = "fscmp denormal vs 0.0 == +1 (ieee profile)";
+    int expected = 1;
+#else
     const char *name = "fscmp denormal vs 0.0 == 0 (denorms treated as 0)";
+    int expected = 0;
+#endif
     float a = mk_f32(mk_u32(0x00000001UL)); /* smallest denormal */
     float b = mk_f32(mk_u32(0x00000000UL)); /* +0.0 */
     int got = __fscmp(a, b);
-    if (got == 0) { ok(name); return 1; }
+    if (got == expected) { ok(name); return 1; }
     fail(name); return 0;
 }
 
@@ -994,6 +1102,704 @@ static int test_f32_divmul_roundtrip(void) {
     return 0;
 }
 
+/* ---------- rounding (FLOAT_ROUND build option) ---------- */
+
+/* set by test/src/execute/Makefile from FLOAT_ROUND */
+#ifndef FLOAT_ROUND_NEAREST
+#define FLOAT_ROUND_NEAREST 1
+#endif
+
+/* expect the nearest-even result or the truncated one, per build */
+static int round_check(const char *name, float got,
+                       uint32_t nearest, uint32_t trunc) {
+#if FLOAT_ROUND_NEAREST
+    uint32_t expected = nearest;
+#else
+    uint32_t expected = trunc;
+#endif
+    uint32_t gbits = f32_bits(got);
+    if (gbits == expected) { ok(name); return 1; }
+    fail(name);
+    cputs("  got: "); put_hex32(gbits); cputs("\n");
+    return 0;
+}
+
+static int test_f32_round_add_tie_even(void) {
+    /* 1 + 2^-24 is halfway, 1.0 is even: stays */
+    float a = mk_f32(0x3F800000UL), b = mk_f32(0x33800000UL);
+    return round_check("round add 1 + 2^-24 tie stays even", a + b,
+                       0x3F800000UL, 0x3F800000UL);
+}
+
+static int test_f32_round_add_tie_odd(void) {
+    /* (1 + 2^-23) + 2^-24 is halfway, LSB odd: rounds up */
+    float a = mk_f32(0x3F800001UL), b = mk_f32(0x33800000UL);
+    return round_check("round add (1+2^-23) + 2^-24 tie to even", a + b,
+                       0x3F800002UL, 0x3F800001UL);
+}
+
+static int test_f32_round_add_sticky(void) {
+    /* 2^-24 + 2^-30: just above half an ulp of 1.0 */
+    float a = mk_f32(0x3F800000UL), b = mk_f32(0x33820000UL);
+    return round_check("round add 1 + (2^-24 + 2^-30) sticky", a + b,
+                       0x3F800001UL, 0x3F800000UL);
+}
+
+static int test_f32_round_sub_tie(void) {
+    /* 1 - 2^-25 is halfway between 1-2^-24 (odd) and 1.0 (even) */
+    float a = mk_f32(0x3F800000UL), b = mk_f32(0x33000000UL);
+    return round_check("round sub 1 - 2^-25 tie to even", a - b,
+                       0x3F800000UL, 0x3F7FFFFFUL);
+}
+
+static int test_f32_round_sub_tiny(void) {
+    /* far below half an ulp: only the sticky bit remains of 2^-26 */
+    float a = mk_f32(0x3F800000UL), b = mk_f32(0x32800000UL);
+    return round_check("round sub 1 - 2^-26 sticky", a - b,
+                       0x3F800000UL, 0x3F7FFFFFUL);
+}
+
+static int test_f32_round_sub_one_ulp(void) {
+    /* operands one ulp apart: the difference lives in the guard bits */
+    float a = mk_f32(0x3F800000UL), b = mk_f32(0xBF7FFFFFUL);
+    float c = mk_f32(0x40000000UL), d = mk_f32(0x3FFFFFFFUL);
+    float e = mk_f32(0x4B000000UL), f = mk_f32(0xCAFFFFFFUL);
+    float g = mk_f32(0x01000000UL), h = mk_f32(0x00FFFFFFUL);
+    return round_check("round add 1 + -(1-2^-24) == 2^-24", a + b,
+                       0x33800000UL, 0x33800000UL)
+        && round_check("round sub 2 - (2-2^-23) == 2^-23", c - d,
+                       0x34000000UL, 0x34000000UL)
+        && round_check("round add 2^23 + -(2^23-0.5) == 0.5", e + f,
+                       0x3F000000UL, 0x3F000000UL)
+#if FLOAT_IEEE
+        && round_check("round sub 2^-125 - (2^-125-2^-149) == 2^-149", g - h,
+                       0x00000001UL, 0x00000001UL);
+#else
+        && round_check("round sub 2^-125 - (2^-125-2^-149) flushes", g - h,
+                       0x00000000UL, 0x00000000UL);
+#endif
+}
+
+static int test_f32_round_mul_tie(void) {
+    /* (1 + 2^-23) * 1.5 = 1.5 + 2^-23 + 2^-24: tie, LSB odd */
+    float a = mk_f32(0x3F800001UL), b = mk_f32(0x3FC00000UL);
+    return round_check("round mul (1+2^-23) * 1.5 tie to even", a * b,
+                       0x3FC00002UL, 0x3FC00001UL);
+}
+
+static int test_f32_round_mul_carry(void) {
+    /* product just below 2.0 rounds up into the next exponent */
+    float a = mk_f32(0x3F800008UL), b = mk_f32(0x3FFFFFF0UL);
+    return round_check("round mul carries into exponent", a * b,
+                       0x40000000UL, 0x3FFFFFFFUL);
+}
+
+static int test_f32_round_mul_tenth(void) {
+    float a = mk_f32(0x3DCCCCCDUL); /* ~0.1 */
+    return round_check("round mul 0.1 * 0.1", a * a,
+                       0x3C23D70BUL, 0x3C23D70AUL);
+}
+
+/* ---------- fused multiply-add (__fsfma) ---------- */
+
+static int test_f32_fma_exact(void) {
+    /* (1 + 2^-23) * (1 - 2^-23) - 1 == -2^-46: the product is not rounded */
+    float a = mk_f32(0x3F800001UL), b = mk_f32(0x3F7FFFFEUL);
+    float c = mk_f32(0xBF800000UL);
+    return round_check("fma (1+2^-23)(1-2^-23) - 1 == -2^-46",
+                       __fsfma(a, b, c), 0xA8800000UL, 0xA8800000UL);
+}
+
+static int test_f32_fma_small(void) {
+    float a = mk_f32(0x40000000UL), b = mk_f32(0x40400000UL);
+    float c = mk_f32(0x3F800000UL);
+    return round_check("fma 2 * 3 + 1 == 7", __fsfma(a, b, c),
+                       0x40E00000UL, 0x40E00000UL);
+}
+
+static int test_f32_fma_zero_addend(void) {
+    /* c == 0 rounds like the plain multiply */
+    float a = mk_f32(0x3F800001UL), b = mk_f32(0x3FC00000UL);
+    return round_check("fma (1+2^-23) * 1.5 + 0 tie to even",
+                       __fsfma(a, b, mk_f32(0)), 0x3FC00002UL, 0x3FC00001UL);
+}
+
+static int test_f32_fma_cancel(void) {
+    float a = mk_f32(0x40000000UL), b = mk_f32(0x40400000UL);
+    float c = mk_f32(0xC0C00000UL);
+    return round_check("fma 2 * 3 - 6 == +0", __fsfma(a, b, c),
+                       0x00000000UL, 0x00000000UL);
+}
+
+/* ---------- unpacked accumulator (fpacc.h) ---------- */
+
+static int test_f32_fpacc_tenths(void) {
+    /* ten 0.1f: chained float adds end at 1.0000001 */
+    fpacc_t acc;
+    uint8_t i;
+    fpacc_init(&acc);
+    for (i = 0; i < 10; i++) fpacc_add(&acc, mk_f32(0x3DCCCCCDUL));
+    return round_check("fpacc sum of ten 0.1 == 1.0", fpacc_result(&acc),
+                       0x3F800000UL, 0x3F800000UL);
+}
+
+static int test_f32_fpacc_big_small(void) {
+    /* 2^24 + 1 - 2^24: the 1 survives in the 32-bit mantissa */
+    fpacc_t acc;
+    fpacc_init(&acc);
+    fpacc_add(&acc, mk_f32(0x4B800000UL));
+    fpacc_add(&acc, mk_f32(0x3F800000UL));
+    fpacc_add(&acc, mk_f32(0xCB800000UL));
+    return round_check("fpacc 2^24 + 1 - 2^24 == 1", fpacc_result(&acc),
+                       0x3F800000UL, 0x3F800000UL);
+}
+
+static int test_f32_fpacc_mul_add(void) {
+    fpacc_t acc;
+    uint8_t i;
+    fpacc_init(&acc);
+    for (i = 0; i < 3; i++)
+        fpacc_mul_add(&acc, mk_f32(0x3FC00000UL), mk_f32(0x40000000UL));
+    return round_check("fpacc 3 * (1.5 * 2) == 9", fpacc_result(&acc),
+                       0x41100000UL, 0x41100000UL);
+}
+
+static int test_f32_fpacc_empty(void) {
+    fpacc_t acc;
+    fpacc_init(&acc);
+    return round_check("fpacc empty sum == +0", fpacc_result(&acc),
+                       0x00000000UL, 0x00000000UL);
+}
+
+/* ---------- array kernels (fsvec.h) ---------- */
+
+static int test_f32_fs_dot(void) {
+    static const uint32_t xb[4] = {
+        0x4B800000UL, 0xCB800000UL, 0x3FC00000UL, 0x3DCCCCCDUL
+    };
+    static const uint32_t yb[4] = {
+        0x3F800000UL, 0x3F800000UL, 0x40000000UL, 0x41200000UL
+    };
+    return round_check("fs_dot 2^24 - 2^24 + 1.5 * 2 + 0.1 * 10 == 4",
+                       fs_dot((const float *)xb, (const float *)yb, 4),
+                       0x40800000UL, 0x40800000UL);
+}
+
+static int test_f32_fs_sum(void) {
+    static const uint32_t xb[3] = { 0x4B800000UL, 0x3F800000UL, 0xCB800000UL };
+    return round_check("fs_sum 2^24 + 1 - 2^24 == 1",
+                       fs_sum((const float *)xb, 3), 0x3F800000UL, 0x3F800000UL);
+}
+
+static int test_f32_fs_sum_empty(void) {
+    static const uint32_t xb[1] = { 0x3F800000UL };
+    return round_check("fs_sum n == 0 is +0",
+                       fs_sum((const float *)xb, 0), 0x00000000UL, 0x00000000UL);
+}
+
+static int test_f32_fs_scale(void) {
+    static uint32_t xb[3] = { 0x3F800000UL, 0x3F800001UL, 0xC0400000UL };
+    fs_scale(mk_f32(0x3FC00000UL), (float *)xb, 2);
+    if (xb[2] != 0xC0400000UL) {            /* x[n] stays untouched */
+        fail("fs_scale stops at n");
+        return 0;
+    }
+    return round_check("fs_scale 1.5 * (1+2^-23) tie to even",
+                       mk_f32(xb[1]), 0x3FC00002UL, 0x3FC00001UL)
+        && round_check("fs_scale 1.5 * 1", mk_f32(xb[0]),
+                       0x3FC00000UL, 0x3FC00000UL);
+}
+
+static int test_f32_fs_axpy(void) {
+    static const uint32_t xb[2] = { 0x40400000UL, 0x3F800001UL };
+    static uint32_t yb[2] = { 0xC0C00000UL, 0xBF800000UL };
+    fs_axpy(mk_f32(0x40000000UL), (const float *)xb, (float *)yb, 2);
+    return round_check("fs_axpy 2 * 3 - 6 == +0", mk_f32(yb[0]),
+                       0x00000000UL, 0x00000000UL)
+        && round_check("fs_axpy 2 * (1+2^-23) - 1 single rounding",
+                       mk_f32(yb[1]), 0x3F800002UL, 0x3F800002UL);
+}
+
+/* ---------- square root (sqrt.h) ---------- */
+
+static int test_f32_sqrt_exact(void) {
+    return round_check("sqrt 0.25 == 0.5", __fssqrt(mk_f32(0x3E800000UL)),
+                       0x3F000000UL, 0x3F000000UL)
+        && round_check("sqrt 100 == 10", __fssqrt(mk_f32(0x42C80000UL)),
+                       0x41200000UL, 0x41200000UL);
+}
+
+static int test_f32_sqrt_round(void) {
+    return round_check("sqrt 2", __fssqrt(mk_f32(0x40000000UL)),
+                       0x3FB504F3UL, 0x3FB504F3UL)
+        && round_check("sqrt (2+2^-22) rounds up",
+                       __fssqrt(mk_f32(0x40000001UL)), 0x3FB504F4UL, 0x3FB504F3UL)
+        && round_check("sqrt (1+2^-22) rounds up",
+                       __fssqrt(mk_f32(0x3F800002UL)), 0x3F800001UL, 0x3F800000UL);
+}
+
+static int test_f32_sqrt_zero(void) {
+    return round_check("sqrt -0 == -0", __fssqrt(mk_f32(0x80000000UL)),
+                       0x80000000UL, 0x80000000UL);
+}
+
+/* ---------- reciprocal (recip.h) ---------- */
+
+static int test_f32_inv(void) {
+    return round_check("inv 0.5 == 2", __fsinv(mk_f32(0x3F000000UL)),
+                       0x40000000UL, 0x40000000UL)
+        && round_check("inv 3", __fsinv(mk_f32(0x40400000UL)),
+                       0x3EAAAAABUL, 0x3EAAAAAAUL)
+        && round_check("inv -10", __fsinv(mk_f32(0xC1200000UL)),
+                       0xBDCCCCCDUL, 0xBDCCCCCCUL);
+}
+
+/* the estimate lands within 4 units of a rounding boundary, the
+   exact check settles it (one case per direction) */
+static int test_f32_inv_exact_check(void) {
+    return round_check("inv 1.6548 exact check", __fsinv(mk_f32(0x3FD3D08AUL)),
+                       0x3F1AB38AUL, 0x3F1AB389UL)
+        && round_check("inv 1.0871 exact check", __fsinv(mk_f32(0x3F8B278AUL)),
+                       0x3F6B7AB7UL, 0x3F6B7AB7UL);
+}
+
+/* ---------- fixed point conversions (fixed.h) ---------- */
+
+static int test_fx_from_float(void) {
+    const char *name = "fx16/fx8_from_float round half away, saturate";
+    if (fx16_from_float(mk_f32(0x3FC00000UL)) == 0x00018000L &&   /* 1.5 */
+        fx16_from_float(mk_f32(0xC0100000UL)) == -0x00024000L &&  /* -2.25 */
+        fx16_from_float(mk_f32(0x37000000UL)) == 1L &&            /* 2^-17 */
+        fx16_from_float(mk_f32(0xB7000000UL)) == -1L &&
+        fx16_from_float(mk_f32(0x36800000UL)) == 0L &&            /* 2^-18 */
+        fx16_from_float(mk_f32(0x471C4000UL)) == FX16_MAX &&      /* 40000 */
+        fx16_from_float(mk_f32(0xC7000000UL)) == FX16_MIN &&      /* -32768 */
+        fx16_from_float(mk_f32(0x7F800000UL)) == FX16_MAX &&
+        fx8_from_float(mk_f32(0x3FC00000UL)) == 0x0180 &&
+        fx8_from_float(mk_f32(0x3B000000UL)) == 1 &&              /* 2^-9 */
+        fx8_from_float(mk_f32(0x43480000UL)) == FX8_MAX &&        /* 200 */
+        fx8_from_float(mk_f32(0xC3000000UL)) == FX8_MIN) {        /* -128 */
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+static int test_fx_from_float_nan(void) {
+    const char *name = "fx16/fx8_from_float NaN gives 0";
+    if (fx16_from_float(mk_f32(0x7FC00000UL)) == 0L &&
+        fx16_from_float(mk_f32(0xFF800001UL)) == 0L &&
+        fx8_from_float(mk_f32(0x7FC00000UL)) == 0 &&
+        fx8_from_float(mk_f32(0x7F800000UL)) == FX8_MAX &&
+        fx8_from_float(mk_f32(0xFF800000UL)) == FX8_MIN) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+static int test_fx_to_float(void) {
+    const char *name = "fx16/fx8_to_float";
+    if (f32_bits(fx16_to_float(mk_s32(0x00018000L))) == 0x3FC00000UL &&
+        f32_bits(fx16_to_float(mk_s32(-FX16_ONE))) == 0xBF800000UL &&
+        f32_bits(fx16_to_float(mk_s32(1L))) == 0x37800000UL &&
+        f32_bits(fx16_to_float(mk_s32(FX16_MAX))) == 0x47000000UL &&
+        f32_bits(fx16_to_float(mk_s32(0L))) == 0UL &&
+        f32_bits(fx8_to_float(mk_s16(-0x0240))) == 0xC0100000UL &&
+        f32_bits(fx8_to_float(mk_s16(FX8_MIN))) == 0xC3000000UL) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+/* ---------- compact storage (fstore.h) ---------- */
+
+static int half_check(const char *name, half_t got,
+                      half_t nearest, half_t trunc) {
+#if FLOAT_ROUND_NEAREST
+    half_t expected = nearest;
+#else
+    half_t expected = trunc;
+#endif
+    if (got == expected) { ok(name); return 1; }
+    fail(name);
+    cputs("  got: "); put_hex16(got); cputs("\n");
+    return 0;
+}
+
+static int test_f32_fs2half(void) {
+    return half_check("fs2half 1 == 0x3C00", fs2half(mk_f32(0x3F800000UL)),
+                      0x3C00, 0x3C00)
+        && half_check("fs2half -65504 == 0xFBFF", fs2half(mk_f32(0xC77FE000UL)),
+                      0xFBFF, 0xFBFF)
+        && half_check("fs2half 65520 tie to Inf", fs2half(mk_f32(0x477FF000UL)),
+                      0x7C00, 0x7BFF)
+        && half_check("fs2half 1+2^-11+2^-23", fs2half(mk_f32(0x3F801001UL)),
+                      0x3C01, 0x3C00)
+        && half_check("fs2half -0 == 0x8000", fs2half(mk_f32(0x80000000UL)),
+                      0x8000, 0x8000)
+#if FLOAT_IEEE
+        && half_check("fs2half 2^-24 is the smallest denormal",
+                      fs2half(mk_f32(0x33800000UL)), 0x0001, 0x0001);
+#else
+        && half_check("fs2half 2^-24 flushes to 0",
+                      fs2half(mk_f32(0x33800000UL)), 0x0000, 0x0000);
+#endif
+}
+
+static int test_f32_fs2half_min_normal(void) {
+    /* just below 2^-14: rounding decides before any flush */
+#if FLOAT_IEEE
+    const half_t below = 0x03FF;
+#else
+    const half_t below = 0x0000;
+#endif
+    return half_check("fs2half 2^-14 - 2^-38 rounds to 2^-14",
+                      fs2half(mk_f32(0x387FFFFFUL)), 0x0400, below)
+        && half_check("fs2half 2^-14 - 2^-26 rounds to 2^-14",
+                      fs2half(mk_f32(0x387FF000UL)), 0x0400, below)
+        && half_check("fs2half -(2^-14 - 2^-38) rounds to -2^-14",
+                      fs2half(mk_f32(0xB87FFFFFUL)), 0x8400, 0x8000 | below);
+}
+
+static int test_f32_half2fs(void) {
+    return round_check("half2fs 0x3555", half2fs(mk_u16(0x3555)),
+                       0x3EAAA000UL, 0x3EAAA000UL)
+        && round_check("half2fs 0xC000 == -2", half2fs(mk_u16(0xC000)),
+                       0xC0000000UL, 0xC0000000UL)
+        && round_check("half2fs 0x7BFF == 65504", half2fs(mk_u16(0x7BFF)),
+                       0x477FE000UL, 0x477FE000UL)
+        && round_check("half2fs 0x7C00 == Inf", half2fs(mk_u16(0x7C00)),
+                       0x7F800000UL, 0x7F800000UL)
+#if FLOAT_IEEE
+        && round_check("half2fs 0x0001 == 2^-24", half2fs(mk_u16(0x0001)),
+                       0x33800000UL, 0x33800000UL);
+#else
+        && round_check("half2fs denormal 0x0001 == 0", half2fs(mk_u16(0x0001)),
+                       0x00000000UL, 0x00000000UL);
+#endif
+}
+
+static int test_f32_f24(void) {
+    static f24_t p;
+    fs2f24(&p, mk_f32(0x3F800180UL));
+    if (!round_check("f24 0x3F800180 tie to even", f242fs(&p),
+                     0x3F800200UL, 0x3F800100UL))
+        return 0;
+    fs2f24(&p, mk_f32(0x40490FDBUL));
+    return round_check("f24 pi", f242fs(&p), 0x40491000UL, 0x40490F00UL);
+}
+
+static int test_f32_f24_array(void) {
+    static const uint32_t xb[4] = { 0x3F800000UL, 0x3F800180UL, 0xC0490FDBUL,
+                                    0x7F800001UL };
+    static f24_t p[5];
+#if FLOAT_IEEE
+    const uint8_t n = 4;
+#else
+    const uint8_t n = 3;
+#endif
+    p[n].b[0] = 0x5A;
+    fs2f24_array(p, (const float *)xb, n);
+    if (p[n].b[0] != 0x5A) {
+        fail("fs2f24_array wrote past n");
+        return 0;
+    }
+#if FLOAT_IEEE
+    if (f32_bits(f242fs(&p[3])) != 0x7FC00000UL) {
+        fail("fs2f24_array NaN stays a NaN");
+        return 0;
+    }
+#endif
+    return round_check("fs2f24_array 1", f242fs(&p[0]),
+                       0x3F800000UL, 0x3F800000UL)
+        && round_check("fs2f24_array tie to even", f242fs(&p[1]),
+                       0x3F800200UL, 0x3F800100UL)
+        && round_check("fs2f24_array -pi", f242fs(&p[2]),
+                       0xC0491000UL, 0xC0490F00UL);
+}
+
+/* ---------- elementary functions (fmath.h) ---------- */
+
+static int test_f32_sin_cos(void) {
+    return round_check("sin 0.5", sinf(mk_f32(0x3F000000UL)),
+                       0x3EF57744UL, 0x3EF57743UL)
+        && round_check("sin 100 (reduced)", sinf(mk_f32(0x42C80000UL)),
+                       0xBF01A12EUL, 0xBF01A12DUL)
+        && round_check("sin pi/6 == 0.5", sinf(mk_f32(0x3F060A92UL)),
+                       0x3F000000UL, 0x3F000000UL)
+        && round_check("cos 1", cosf(mk_f32(0x3F800000UL)),
+                       0x3F0A5140UL, 0x3F0A5140UL)
+        && round_check("cos -100 (reduced)", cosf(mk_f32(0xC2C80000UL)),
+                       0x3F5CC0EEUL, 0x3F5CC0EEUL);
+}
+
+static int test_f32_sincos(void) {
+    const char *name = "sincos == sin, cos";
+    float x = mk_f32(0xC0400000UL), s, c;
+    sincosf(x, &s, &c);
+    if (f32_bits(s) == f32_bits(sinf(x)) && f32_bits(c) == f32_bits(cosf(x))) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+static int test_f32_atan2(void) {
+    return round_check("atan2(1, 1) == pi/4", atan2f(mk_f32(0x3F800000UL),
+                       mk_f32(0x3F800000UL)), 0x3F490FDBUL, 0x3F490FDAUL)
+        && round_check("atan2(1, -1) == 3 pi/4", atan2f(mk_f32(0x3F800000UL),
+                       mk_f32(0xBF800000UL)), 0x4016CBE4UL, 0x4016CBE3UL)
+        && round_check("atan2(3, 4)", atan2f(mk_f32(0x40400000UL),
+                       mk_f32(0x40800000UL)), 0x3F24BC7DUL, 0x3F24BC7DUL)
+        && round_check("atan2(1, 1000) small ratio", atan2f(mk_f32(0x3F800000UL),
+                       mk_f32(0x447A0000UL)), 0x3A83126CUL, 0x3A83126BUL)
+        && round_check("atan2(0, -1) == pi", atan2f(mk_f32(0x00000000UL),
+                       mk_f32(0xBF800000UL)), 0x40490FDBUL, 0x40490FDBUL);
+}
+
+static int test_f32_exp(void) {
+    return round_check("exp 0 == 1", expf(mk_f32(0x00000000UL)),
+                       0x3F800000UL, 0x3F800000UL)
+        && round_check("exp 1 == e", expf(mk_f32(0x3F800000UL)),
+                       0x402DF854UL, 0x402DF854UL)
+        && round_check("exp -10", expf(mk_f32(0xC1200000UL)),
+                       0x383E6BCEUL, 0x383E6BCDUL)
+        && round_check("exp 88", expf(mk_f32(0x42B00000UL)),
+                       0x7EF882B7UL, 0x7EF882B6UL)
+        && round_check("exp 100 overflows to +Inf", expf(mk_f32(0x42C80000UL)),
+                       0x7F800000UL, 0x7F800000UL);
+}
+
+static int test_f32_log(void) {
+    return round_check("log 1 == +0", logf(mk_f32(0x3F800000UL)),
+                       0x00000000UL, 0x00000000UL)
+        && round_check("log 2 == ln 2", logf(mk_f32(0x40000000UL)),
+                       0x3F317218UL, 0x3F317217UL)
+        && round_check("log 10", logf(mk_f32(0x41200000UL)),
+                       0x40135D8EUL, 0x40135D8DUL)
+        && round_check("log 0.25", logf(mk_f32(0x3E800000UL)),
+                       0xBFB17218UL, 0xBFB17217UL)
+        && round_check("log (1 + 2^-7) near 1", logf(mk_f32(0x3F810000UL)),
+                       0x3BFF0153UL, 0x3BFF0153UL);
+}
+
+/* ---------- decimal conversion (fconv.h) ---------- */
+
+static int str_eq(const char *a, const char *b) {
+    while (*a && *a == *b) { a++; b++; }
+    return *a == *b;
+}
+
+static int ftoa_check(const char *name, uint32_t bits, uint8_t digits,
+                      const char *expected) {
+    char buf[20];
+    char *end = ftoa(mk_f32(bits), buf, digits);
+    if (str_eq(buf, expected) && *end == 0 && end[-1] != 0) {
+        ok(name); return 1;
+    }
+    fail(name);
+    cputs("  got: "); cputs(buf); cputs("\n");
+    return 0;
+}
+
+static int test_ftoa_basic(void) {
+    return ftoa_check("ftoa 1.25, 3 digits", 0x3FA00000UL, 3, "1.25e+00")
+        && ftoa_check("ftoa -2.5, 2 digits", 0xC0200000UL, 2, "-2.5e+00")
+        && ftoa_check("ftoa 123.456, 5 digits rounds",
+                      0x42F6E979UL, 5, "1.2346e+02")
+        && ftoa_check("ftoa 0, 4 digits", 0x00000000UL, 4, "0.000e+00");
+}
+
+static int test_ftoa_nine_digits(void) {
+    return ftoa_check("ftoa 1e10, 9 digits", 0x501502F9UL, 9, "1.00000000e+10")
+        && ftoa_check("ftoa 0.1f, 9 digits", 0x3DCCCCCDUL, 9, "1.00000001e-01");
+}
+
+static int test_strtof_basic(void) {
+    static const char s[] = "  -1.5e3x";
+    char *end;
+    float r = strtof(s, &end);
+    if (end != s + 8) { fail("strtof end past the exponent"); return 0; }
+    return round_check("strtof -1.5e3", r, 0xC4BB8000UL, 0xC4BB8000UL)
+        && round_check("strtof 0.1", strtof("0.1", 0),
+                       0x3DCCCCCDUL, 0x3DCCCCCCUL)
+        && round_check("strtof 1e39 overflows", strtof("1e39", 0),
+                       0x7F800000UL, 0x7F800000UL);
+}
+
+static int test_strtof_no_digits(void) {
+    static const char s[] = " e5";
+    char *end;
+    float r = strtof(s, &end);
+    if (end != s) { fail("strtof no digits leaves end at s"); return 0; }
+    return round_check("strtof no digits is +0", r, 0x00000000UL, 0x00000000UL);
+}
+
+#if FLOAT_ROUND_NEAREST
+static int test_fconv_roundtrip(void) {
+    const char *name = "ftoa 9 digits -> strtof round trip";
+    static const uint32_t xb[6] = {
+        0x3DCCCCCDUL, 0x40490FDBUL, 0xC2F6E979UL,
+        0x7F7FFFFFUL, 0x00800000UL, 0x4B7FFFFFUL
+    };
+    char buf[20];
+    uint8_t i;
+    for (i = 0; i < 6; i++) {
+        ftoa(mk_f32(xb[i]), buf, 9);
+        if (f32_bits(strtof(buf, 0)) != xb[i]) {
+            fail(name);
+            cputs("  at: "); cputs(buf); cputs("\n");
+            return 0;
+        }
+    }
+    ok(name); return 1;
+}
+#endif
+
+#if FLOAT_IEEE
+/* ---------- special values (FLOAT_PROFILE=ieee) ---------- */
+
+static int ieee_check(const char *name, float got, uint32_t expected) {
+    uint32_t gbits = f32_bits(got);
+    if (gbits == expected) { ok(name); return 1; }
+    fail(name);
+    cputs("  got: "); put_hex32(gbits); cputs("\n");
+    return 0;
+}
+
+static int is_nan_bits(float x) {
+    uint32_t u = f32_bits(x);
+    return (u & 0x7F800000UL) == 0x7F800000UL && (u & 0x007FFFFFUL) != 0;
+}
+
+static int test_ieee_inf_mul(void) {
+    float a = mk_f32(0x7F800000UL), b = mk_f32(0x40000000UL);
+    return ieee_check("ieee Inf * 2 == Inf", a * b, 0x7F800000UL);
+}
+
+static int test_ieee_zero_mul_inf(void) {
+    const char *name = "ieee 0 * Inf is NaN";
+    float z = mk_f32(0x00000000UL), n = mk_f32(0x80000000UL);
+    float i = mk_f32(0x7F800000UL), m = mk_f32(0xFF800000UL);
+    if (is_nan_bits(z * i) && is_nan_bits(n * i) && is_nan_bits(z * m)) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+static int test_ieee_inf_mul_zero(void) {
+    const char *name = "ieee Inf * 0 is NaN";
+    float z = mk_f32(0x00000000UL), n = mk_f32(0x80000000UL);
+    float i = mk_f32(0x7F800000UL), m = mk_f32(0xFF800000UL);
+    if (is_nan_bits(i * z) && is_nan_bits(m * n)) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_ieee_div_zero(void) {
+    float a = mk_f32(0xBF800000UL), b = mk_f32(0x00000000UL);
+    return ieee_check("ieee -1 / 0 == -Inf", a / b, 0xFF800000UL);
+}
+
+static int test_ieee_overflow(void) {
+    float a = mk_f32(0x7F000000UL), b = mk_f32(0x40000000UL);
+    return ieee_check("ieee 2^127 * 2 overflows to Inf", a * b, 0x7F800000UL);
+}
+
+static int test_ieee_zero_div_zero(void) {
+    const char *name = "ieee 0 / 0 is NaN";
+    float a = mk_f32(0x00000000UL);
+    if (is_nan_bits(a / a)) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_ieee_inf_sub_inf(void) {
+    const char *name = "ieee Inf - Inf is NaN";
+    float a = mk_f32(0x7F800000UL);
+    if (is_nan_bits(a - a)) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_ieee_nan_compare(void) {
+    const char *name = "ieee NaN is unordered (==, < both false)";
+    float n = mk_f32(0x7FC00000UL), one = mk_f32(0x3F800000UL);
+    if (!(n == n) && !(n < one) && !(one < n)) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_ieee_nan_to_long(void) {
+    const char *name = "ieee (long)NaN == 0";
+    float n = mk_f32(0x7FC00000UL);
+    if ((long)n == 0) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_ieee_denorm_add(void) {
+    float a = mk_f32(0x00000001UL); /* 2^-149 */
+    return ieee_check("ieee 2^-149 + 2^-149 == 2^-148", a + a, 0x00000002UL);
+}
+
+static int test_ieee_denorm_mul(void) {
+    float a = mk_f32(0x00800000UL), b = mk_f32(0x3F000000UL);
+    return ieee_check("ieee 2^-126 * 0.5 is denormal", a * b, 0x00400000UL);
+}
+
+static int test_ieee_denorm_div(void) {
+    float a = mk_f32(0x00400000UL), b = mk_f32(0x3F000000UL);
+    return ieee_check("ieee 2^-127 / 0.5 == 2^-126", a / b, 0x00800000UL);
+}
+
+static int test_ieee_denorm_positive(void) {
+    const char *name = "ieee 0 < smallest denormal";
+    float z = mk_f32(0x00000000UL), d = mk_f32(0x00000001UL);
+    if (z < d) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_ieee_sqrt(void) {
+    return ieee_check("ieee sqrt -1 is NaN", __fssqrt(mk_f32(0xBF800000UL)),
+                      0x7FC00000UL)
+        && ieee_check("ieee sqrt +Inf is +Inf", __fssqrt(mk_f32(0x7F800000UL)),
+                      0x7F800000UL)
+        && ieee_check("ieee sqrt smallest denormal",
+                      __fssqrt(mk_f32(0x00000001UL)), 0x1A3504F3UL);
+}
+
+static int test_ieee_inv(void) {
+    return ieee_check("ieee inv +0 == +Inf", __fsinv(mk_f32(0x00000000UL)),
+                      0x7F800000UL)
+        && ieee_check("ieee inv -Inf == -0", __fsinv(mk_f32(0xFF800000UL)),
+                      0x80000000UL)
+        && ieee_check("ieee inv 2^127 is denormal",
+                      __fsinv(mk_f32(0x7F000000UL)), 0x00400000UL)
+        && ieee_check("ieee inv smallest denormal is +Inf",
+                      __fsinv(mk_f32(0x00000001UL)), 0x7F800000UL);
+}
+
+static int test_ieee_fmath(void) {
+    return ieee_check("ieee sin +Inf is NaN", sinf(mk_f32(0x7F800000UL)),
+                      0x7FC00000UL)
+        && ieee_check("ieee atan2(+Inf, -Inf) == 3 pi/4",
+                      atan2f(mk_f32(0x7F800000UL), mk_f32(0xFF800000UL)),
+                      0x4016CBE4UL)
+        && ieee_check("ieee exp -Inf == +0", expf(mk_f32(0xFF800000UL)),
+                      0x00000000UL)
+        && ieee_check("ieee log -0 == -Inf", logf(mk_f32(0x80000000UL)),
+                      0xFF800000UL)
+        && ieee_check("ieee log -1 is NaN", logf(mk_f32(0xBF800000UL)),
+                      0x7FC00000UL);
+}
+
+static int test_ieee_fconv_specials(void) {
+    const char *name = "ieee ftoa/strtof inf and nan";
+    char buf[12];
+    if (f32_bits(strtof("-Infinity", 0)) != 0xFF800000UL ||
+        f32_bits(strtof("nan", 0)) != 0x7FC00000UL) { fail(name); return 0; }
+    ftoa(mk_f32(0xFF800000UL), buf, 9);
+    if (!str_eq(buf, "-inf")) { fail(name); return 0; }
+    ftoa(mk_f32(0x7FC00000UL), buf, 9);
+    if (!str_eq(buf, "nan")) { fail(name); return 0; }
+    ok(name); return 1;
+}
+#endif
+
 /* =========================================================================
  * Bug A: __sitof diagnostic — (float)(int) wrong for most non-zero ints
  *
@@ -1706,6 +2512,10 @@ void main(void){
     total++; passed += test_fs2ulong_neg_zero();
     total++; passed += test_fs2ulong_clamp_2p32();
     total++; passed += test_fs2ulong_word_order_sentinel();
+    total++; passed += test_fs2ulonglong();
+    total++; passed += test_fs2slonglong();
+    total++; passed += test_ulonglong2fs();
+    total++; passed += test_slonglong2fs();
     total++; passed += test_uint2fs_zero();
     total++; passed += test_uint2fs_one();
     total++; passed += test_uint2fs_32768();
@@ -1729,6 +2539,7 @@ void main(void){
     total++; passed += test_slong2fs_neg_one();
     total++; passed += test_slong2fs_min();
     total++; passed += test_slong2fs_max_rounds_to_2p31();
+    total++; passed += test_slong2fs_zero_low_word();
     total++; passed += test_f32_cmp_basic_neg1();
     total++; passed += test_f32_cmp_basic_zero();
     total++; passed += test_f32_cmp_basic_pos1();
@@ -1748,6 +2559,9 @@ void main(void){
     total++; passed += test_f32_eq_false();
     total++; passed += test_f32_lt_true();
     total++; passed += test_f32_eq_true();
+    total++; passed += test_f32_lt_both_neg_lowbyte();
+    total++; passed += test_f32_signed_zero_compare();
+    total++; passed += test_f32_eq_denorms();
     total++; passed += test_f32_mul_basic_1();
     total++; passed += test_f32_mul_basic_2();
     total++; passed += test_f32_mul_identity();
@@ -1780,6 +2594,90 @@ void main(void){
     total++; passed += test_f32_muldiv_roundtrip();
     total++; passed += test_f32_divmul_roundtrip();
 
+    /* --- rounding mode --- */
+    total++; passed += test_f32_round_add_tie_even();
+    total++; passed += test_f32_round_add_tie_odd();
+    total++; passed += test_f32_round_add_sticky();
+    total++; passed += test_f32_round_sub_tie();
+    total++; passed += test_f32_round_sub_tiny();
+    total++; passed += test_f32_round_sub_one_ulp();
+    total++; passed += test_f32_round_mul_tie();
+    total++; passed += test_f32_round_mul_carry();
+    total++; passed += test_f32_round_mul_tenth();
+
+    /* --- fused multiply-add --- */
+    total++; passed += test_f32_fma_exact();
+    total++; passed += test_f32_fma_small();
+    total++; passed += test_f32_fma_zero_addend();
+    total++; passed += test_f32_fma_cancel();
+
+    /* --- unpacked accumulator --- */
+    total++; passed += test_f32_fpacc_tenths();
+    total++; passed += test_f32_fpacc_big_small();
+    total++; passed += test_f32_fpacc_mul_add();
+    total++; passed += test_f32_fpacc_empty();
+    total++; passed += test_f32_fs_dot();
+    total++; passed += test_f32_fs_sum();
+    total++; passed += test_f32_fs_sum_empty();
+    total++; passed += test_f32_fs_scale();
+    total++; passed += test_f32_fs_axpy();
+
+    /* --- square root --- */
+    total++; passed += test_f32_sqrt_exact();
+    total++; passed += test_f32_sqrt_round();
+    total++; passed += test_f32_sqrt_zero();
+    total++; passed += test_f32_inv();
+    total++; passed += test_f32_inv_exact_check();
+
+    /* --- fixed point conversions --- */
+    total++; passed += test_fx_from_float();
+    total++; passed += test_fx_from_float_nan();
+    total++; passed += test_fx_to_float();
+
+    /* --- compact storage --- */
+    total++; passed += test_f32_fs2half();
+    total++; passed += test_f32_fs2half_min_normal();
+    total++; passed += test_f32_half2fs();
+    total++; passed += test_f32_f24();
+    total++; passed += test_f32_f24_array();
+
+    /* --- elementary functions --- */
+    total++; passed += test_f32_sin_cos();
+    total++; passed += test_f32_sincos();
+    total++; passed += test_f32_atan2();
+    total++; passed += test_f32_exp();
+    total++; passed += test_f32_log();
+
+    /* --- decimal conversion --- */
+    total++; passed += test_ftoa_basic();
+    total++; passed += test_ftoa_nine_digits();
+    total++; passed += test_strtof_basic();
+    total++; passed += test_strtof_no_digits();
+#if FLOAT_ROUND_NEAREST
+    total++; passed += test_fconv_roundtrip();
+#endif
+
+#if FLOAT_IEEE
+    /* --- special values (FLOAT_PROFILE=ieee) --- */
+    total++; passed += test_ieee_inf_mul();
+    total++; passed += test_ieee_zero_mul_inf();
+    total++; passed += test_ieee_inf_mul_zero();
+    total++; passed += test_ieee_div_zero();
+    total++; passed += test_ieee_overflow();
+    total++; passed += test_ieee_zero_div_zero();
+    total++; passed += test_ieee_inf_sub_inf();
+    total++; passed += test_ieee_nan_compare();
+    total++; passed += test_ieee_nan_to_long();
+    total++; passed += test_ieee_denorm_add();
+    total++; passed += test_ieee_denorm_mul();
+    total++; passed += test_ieee_denorm_div();
+    total++; passed += test_ieee_denorm_positive();
+    total++; passed += test_ieee_sqrt();
+    total++; passed += test_ieee_inv();
+    total++; passed += test_ieee_fmath();
+    total++; passed += test_ieee_fconv_specials();
+#endif
+
     /* --- Bug A: __sitof (int->float) diagnostic --- */
     total++; passed += test_sitof_pos_pow2();
     total++; passed += test_sitof_mixed();
@@ -0,0 +1,75 @@
+        ;; bank.s - banked call fixture for the execute suite
+        ;;
+        ;; RunCPM has no bank window, so this module gives the library
+        ;; a bank port and the routines read the bank that is mapped
+        ;; from the shadow __bank_cur instead. leaf returns the shadow,
+        ;; nested calls leaf in bank 2 through the inline descriptor
+        ;; and returns its result only if its own bank came back.
+        ;;
+        ;; gpl-2.0-or-later (see: LICENSE)
+        ;; copyright (c) 2026 tomaz stih
+
+        .module bank
+        .optsdcc -mz80 sdcccall(1)
+
+        .area   _CODE
+
+        .globl  _bank_call
+        .globl  _bank_call_nested
+        .globl  _bank_mapped
+        .globl  __bank_cur
+        .globl  ___sdcc_bcall_ehl
+        .globl  __sdcc_banked_call
+
+        ;; a port RunCPM ignores, for the library helpers
+        .globl  __bank_port
+        .globl  __bank_mask
+
+        __bank_port == 0x00F8
+        __bank_mask == 0x07
+
+        ;; _bank_call(uint8_t bank)
+        ;; inputs:  a = bank
+        ;; outputs: a = shadow seen by the routine in that bank
+        ;; clobbers: af, bc, de, hl
+_bank_call:
+        ld      e,a
+        ld      hl,#leaf
+        jp      ___sdcc_bcall_ehl
+
+        ;; _bank_call_nested(void)
+        ;; inputs:  n/a
+        ;; outputs: a = shadow seen in bank 2 when called from bank 1,
+        ;;          0 if bank 1 was not mapped again after the call
+        ;; clobbers: af, bc, de, hl
+_bank_call_nested:
+        ld      e,#1
+        ld      hl,#nested
+        jp      ___sdcc_bcall_ehl
+
+        ;; _bank_mapped(void)
+        ;; inputs:  n/a
+        ;; outputs: a = shadow
+        ;; clobbers: af
+_bank_mapped:
+        ld      a,(__bank_cur)
+        ret
+
+nested:
+        ld      a,(__bank_cur)
+        push    af
+        call    __sdcc_banked_call
+        .dw     leaf
+        .dw     2
+        pop     bc                      ; b = shadow on entry
+        ld      c,a
+        ld      a,(__bank_cur)
+        cp      b
+        ld      a,c
+        ret     z
+        xor     a
+        ret
+
+leaf:
+        ld      a,(__bank_cur)
+        ret
@@ -3,6 +3,26 @@
 
 #include <stdint.h>
 #include <io.h>
+#include <divmod.h>
+#include <fastdiv.h>
+#include <mulk.h>
+#include <numconv.h>
+#include <sqrt.h>
+#include <fixed.h>
+#include <bank.h>
+
+/* shift helpers, called directly: sdcc inlines most constant shifts */
+extern unsigned long _rlulong(unsigned long x, char s);
+extern unsigned long _rrulong(unsigned long x, char s);
+extern long          _rrslong(long x, char s);
+extern unsigned long long _rlulonglong(unsigned long long x, char s);
+extern unsigned long long _rrulonglong(unsigned long long x, char s);
+extern long long     _rrslonglong(long long x, char s);
+
+/* bank.s: banked calls in flat memory, the bank comes from the shadow */
+extern uint8_t       bank_call(uint8_t bank);
+extern uint8_t       bank_call_nested(void);
+extern uint8_t       bank_mapped(void);
 
 
 /* ---------- tiny print helpers ---------- */
@@ -33,6 +53,8 @@ static  int16_t mk_s16( int16_t x){ volatile  int16_t t=x; return t; }
 static uint32_t mk_u32(uint32_t x){ volatile uint32_t t=x; return t; }
 /* SDCC “long” is 32-bit; keep both typedefs for clarity */
 static  int32_t mk_s32( int32_t x){ volatile  int32_t t=x; return t; }
+static uint64_t mk_u64(uint64_t x){ volatile uint64_t t=x; return t; }
+static  int64_t mk_s64( int64_t x){ volatile  int64_t t=x; return t; }
 
 /* status lines */
 static void ok  (const char *name){ cputs("ok  ");  cputs(name); cputs("\n"); }
@@ -108,6 +130,20 @@ static int test_s8s8_mul(void){
     if (r == (int16_t)35) { ok(name); return 1; } fail(name); return 0;
 }
 
+static int test_s8s8_mul_min(void){
+    const char *name="s8 -128 * s8 -128 == 16384";
+    int8_t a = mk_s8((int8_t)-128);
+    int8_t b = mk_s8((int8_t)-128);
+    int16_t r = (int16_t)(a * b);
+    if (r == (int16_t)16384) { ok(name); return 1; } fail(name); return 0;
+}
+
+static int test_u16_mul_max(void){
+    const char *name="u16 0xFFFF*0xFFFF==1";
+    uint16_t a=mk_u16(0xFFFFu), b=mk_u16(0xFFFFu), r=(uint16_t)(a*b);
+    if(r==1u){ ok(name); return 1; } fail(name); return 0;
+}
+
 static int test_s16_div(void){
     const char *name="s16 -30000/1000==-30";
     int16_t a=mk_s16(-30000), b=mk_s16(1000), r=(int16_t)(a/b);
@@ -655,6 +691,439 @@ static int test_s32_mod_large_neg(void) {
     fail(name); return 0;
 }
 
+static int test_u32_divmod_big_divisor(void) {
+    const char *n1 = "u32 0xF0000000/0x80000001 == 1, rem 0x6FFFFFFF";
+    const char *n2 = "u32 0x7FFFFFFF/0x80000000 == 0, rem 0x7FFFFFFF";
+    uint32_t a = mk_u32(0xF0000000UL), b = mk_u32(0x80000001UL);
+    uint32_t c = mk_u32(0x7FFFFFFFUL), d = mk_u32(0x80000000UL);
+    int okall = 1;
+    if (a / b == 1u && a % b == 0x6FFFFFFFUL) ok(n1); else { fail(n1); okall = 0; }
+    if (c / d == 0u && c % d == 0x7FFFFFFFUL) ok(n2); else { fail(n2); okall = 0; }
+    return okall;
+}
+
+static int test_u32_divmod_full(void) {
+    const char *name = "u32 0xDEADBEEF/0x12345 == 0xC3B6, rem 0x11CE1";
+    uint32_t a = mk_u32(0xDEADBEEFUL), b = mk_u32(0x12345UL);
+    if (a / b == 0xC3B6UL && a % b == 0x11CE1UL) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_u32_divmod_small_dividend(void) {
+    const char *name = "u32 0x00012345/0x00010001 == 1, rem 0x2344";
+    uint32_t a = mk_u32(0x00012345UL), b = mk_u32(0x00010001UL);
+    if (a / b == 1u && a % b == 0x2344UL) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_s32_divmod_min_by_big(void) {
+    const char *name = "s32 -2147483648 / -2147483647 == 1, rem -1";
+    int32_t a = mk_s32((int32_t)0x80000000UL), b = mk_s32(-2147483647L);
+    if (a / b == 1 && a % b == -1) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_uldivmod(void) {
+    const char *name = "uldivmod 0xDEADBEEF,0x12345 == 0xC3B6, rem 0x11CE1";
+    unsigned long r;
+    uint32_t q = uldivmod(mk_u32(0xDEADBEEFUL), mk_u32(0x12345UL), &r);
+    if (q == 0xC3B6UL && r == 0x11CE1UL) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_ldivmod_neg(void) {
+    const char *name = "ldivmod -100000,7 == -14285, rem -5";
+    long r;
+    int32_t q = ldivmod(mk_s32(-100000L), mk_s32(7L), &r);
+    if (q == -14285L && r == -5L) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_mul16_const(void) {
+    const char *name = "mul16_k matches x * k for k = 3 .. 1000";
+    static const uint16_t xs[4] = { 0x0001u, 0x1234u, 0x8001u, 0xFFFFu };
+    uint8_t i;
+    for (i = 0; i < 4; i++) {
+        uint16_t x = mk_u16(xs[i]);
+        if (mul16_3(x)    != (uint16_t)(x * 3u)   ||
+            mul16_5(x)    != (uint16_t)(x * 5u)   ||
+            mul16_6(x)    != (uint16_t)(x * 6u)   ||
+            mul16_10(x)   != (uint16_t)(x * 10u)  ||
+            mul16_12(x)   != (uint16_t)(x * 12u)  ||
+            mul16_24(x)   != (uint16_t)(x * 24u)  ||
+            mul16_40(x)   != (uint16_t)(x * 40u)  ||
+            mul16_80(x)   != (uint16_t)(x * 80u)  ||
+            mul16_100(x)  != (uint16_t)(x * 100u) ||
+            mul16_160(x)  != (uint16_t)(x * 160u) ||
+            mul16_320(x)  != (uint16_t)(x * 320u) ||
+            mul16_1000(x) != (uint16_t)(x * 1000u)) {
+            fail(name);
+            cputs("  x: "); put_hex16(x); cputs("\n");
+            return 0;
+        }
+    }
+    ok(name); return 1;
+}
+
+static int test_mul16_const_signed(void) {
+    const char *name = "mul16_320(-3) == -960, mul16_1000(-7) == -7000";
+    int16_t a = mk_s16(-3), b = mk_s16(-7);
+    if ((int16_t)mul16_320((uint16_t)a) == -960 &&
+        (int16_t)mul16_1000((uint16_t)b) == -7000) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_udiv32_apply(void) {
+    const char *name = "udiv32_apply matches x / d";
+    static const uint32_t ds[5] = { 3UL, 10UL, 86400UL, 0x10000UL, 0xFFFFFFFFUL };
+    static const uint32_t xs[4] = { 0UL, 12345UL, 0xDEADBEEFUL, 0xFFFFFFFFUL };
+    udiv32_t s;
+    uint8_t i, j;
+    for (i = 0; i < 5; i++) {
+        udiv32_prepare(&s, mk_u32(ds[i]));
+        for (j = 0; j < 4; j++) {
+            uint32_t x = mk_u32(xs[j]);
+            if (udiv32_apply(&s, x) != x / ds[i]) {
+                fail(name);
+                cputs("  d: "); put_hex32(ds[i]);
+                cputs(" x: "); put_hex32(x); cputs("\n");
+                return 0;
+            }
+        }
+    }
+    ok(name); return 1;
+}
+
+static int test_sdiv32_apply(void) {
+    const char *name = "sdiv32_apply matches x / d (toward zero)";
+    static const int32_t ds[5] = { -1L, 7L, -1000L, 65536L, -2147483647L };
+    static const int32_t xs[4] = { -2147483647L, -5L, 99999L, 2147483647L };
+    sdiv32_t s;
+    uint8_t i, j;
+    for (i = 0; i < 5; i++) {
+        sdiv32_prepare(&s, mk_s32(ds[i]));
+        for (j = 0; j < 4; j++) {
+            int32_t x = mk_s32(xs[j]);
+            if (sdiv32_apply(&s, x) != x / ds[i]) {
+                fail(name);
+                cputs("  d: "); put_hex32((uint32_t)ds[i]);
+                cputs(" x: "); put_hex32((uint32_t)x); cputs("\n");
+                return 0;
+            }
+        }
+    }
+    ok(name); return 1;
+}
+
+static int test_div_array(void) {
+    const char *name = "udiv32/sdiv32_array divide n elements in place";
+    uint32_t u[3] = { 1000UL, 0xFFFFFFFFUL, 7UL };
+    int32_t v[3] = { -1000000L, 999L, 5L };
+    udiv32_t su;
+    sdiv32_t ss;
+    udiv32_prepare(&su, mk_u32(10UL));
+    udiv32_array(&su, u, 2);
+    sdiv32_prepare(&ss, mk_s32(-7L));
+    sdiv32_array(&ss, v, 2);
+    if (u[0] == 100UL && u[1] == 429496729UL && u[2] == 7UL &&
+        v[0] == 142857L && v[1] == -142L && v[2] == 5L) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+/* ---------- decimal text (numconv.h) ---------- */
+
+static int str_eq(const char *a, const char *b) {
+    while (*a && *a == *b) { a++; b++; }
+    return *a == *b;
+}
+
+static int test_utoa16_itoa(void) {
+    const char *name = "utoa16/itoa match the decimal text";
+    static const uint16_t xs[6] = { 0u, 7u, 10u, 999u, 1000u, 65535u };
+    static const char *const us[6] = { "0", "7", "10", "999", "1000", "65535" };
+    char buf[8];
+    char *end;
+    uint8_t i;
+    for (i = 0; i < 6; i++) {
+        end = utoa16(mk_u16(xs[i]), buf);
+        if (!str_eq(buf, us[i]) || *end != 0 || end[-1] == 0) {
+            fail(name); cputs("  got: "); cputs(buf); cputs("\n");
+            return 0;
+        }
+    }
+    itoa(mk_s16((int16_t)-32768), buf);
+    if (!str_eq(buf, "-32768")) { fail(name); return 0; }
+    itoa(mk_s16(-1), buf);
+    if (!str_eq(buf, "-1")) { fail(name); return 0; }
+    ok(name); return 1;
+}
+
+static int test_utoa32(void) {
+    const char *name = "utoa32 matches the decimal text";
+    static const uint32_t xs[5] = {
+        0UL, 65535UL, 65536UL, 1000000000UL, 4294967295UL
+    };
+    static const char *const us[5] = {
+        "0", "65535", "65536", "1000000000", "4294967295"
+    };
+    char buf[12];
+    char *end;
+    uint8_t i;
+    for (i = 0; i < 5; i++) {
+        end = utoa32(mk_u32(xs[i]), buf);
+        if (!str_eq(buf, us[i]) || *end != 0 || end[-1] == 0) {
+            fail(name); cputs("  got: "); cputs(buf); cputs("\n");
+            return 0;
+        }
+    }
+    ok(name); return 1;
+}
+
+static int test_atoi16(void) {
+    const char *name = "atoi16 sign, white space and wrap";
+    if (atoi16(" \t-123") == -123 && atoi16("+42x") == 42 &&
+        atoi16("65535") == -1 && atoi16("abc") == 0) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_strtoul32(void) {
+    const char *name = "strtoul32 decimal, hex, overflow and end";
+    static const char hex[] = "0xDEADbeef!";
+    static const char bare[] = "0x";
+    static const char none[] = " z";
+    char *end;
+    if (strtoul32("4294967295", 0, 10) != 0xFFFFFFFFUL ||
+        strtoul32("4294967296", 0, 10) != 0xFFFFFFFFUL ||
+        strtoul32("-1", 0, 10) != 0xFFFFFFFFUL ||
+        strtoul32("ffff", 0, 16) != 0xFFFFUL ||
+        strtoul32("017", 0, 0) != 17UL) { fail(name); return 0; }
+    if (strtoul32(hex, &end, 0) != 0xDEADBEEFUL || end != hex + 10) {
+        fail(name); return 0;
+    }
+    if (strtoul32(bare, &end, 16) != 0UL || end != bare + 1) {
+        fail(name); return 0;                   /* the 0 only */
+    }
+    if (strtoul32(none, &end, 10) != 0UL || end != none) {
+        fail(name); return 0;
+    }
+    ok(name); return 1;
+}
+
+static int test_numconv_roundtrip(void) {
+    const char *name = "utoa32 -> strtoul32 round trip";
+    uint32_t x = 1UL;
+    char buf[12];
+    uint8_t i;
+    for (i = 0; i < 32; i++) {
+        x = x * 1664525UL + 1013904223UL;
+        utoa32(x, buf);
+        if (strtoul32(buf, 0, 10) != x) {
+            fail(name); cputs("  at: "); cputs(buf); cputs("\n");
+            return 0;
+        }
+    }
+    ok(name); return 1;
+}
+
+/* ---------- integer square root (sqrt.h) ---------- */
+
+static int test_isqrt16(void) {
+    const char *name = "isqrt16 floor(sqrt(x))";
+    if (isqrt16(mk_u16(0u)) == 0 && isqrt16(mk_u16(3u)) == 1 &&
+        isqrt16(mk_u16(4u)) == 2 && isqrt16(mk_u16(65024u)) == 254 &&
+        isqrt16(mk_u16(65025u)) == 255 && isqrt16(mk_u16(65535u)) == 255) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+static int test_isqrt32(void) {
+    const char *name = "isqrt32 floor(sqrt(x))";
+    if (isqrt32(mk_u32(0UL)) == 0u && isqrt32(mk_u32(999999UL)) == 999u &&
+        isqrt32(mk_u32(1000000UL)) == 1000u &&
+        isqrt32(mk_u32(4294836224UL)) == 65534u &&
+        isqrt32(mk_u32(4294836225UL)) == 65535u &&
+        isqrt32(mk_u32(0xFFFFFFFFUL)) == 65535u) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+/* ---------- fixed point (fixed.h) ---------- */
+
+static int test_fx16_mul(void) {
+    const char *name = "fx16_mul 1.5*-2.25, floor, wrap and clamp";
+    if (fx16_mul(mk_s32(0x00018000L), mk_s32(-0x00024000L)) == -0x00036000L &&
+        fx16_mul(mk_s32(1L), mk_s32(-1L)) == -1L &&
+        fx16_mul(mk_s32(1L), mk_s32(1L)) == 0L &&
+        fx16_mul(mk_s32(FX16_INT(256)), mk_s32(FX16_INT(256))) == 0L &&
+        fx16_mul_sat(mk_s32(FX16_INT(256)), mk_s32(FX16_INT(256))) == FX16_MAX &&
+        fx16_mul_sat(mk_s32(FX16_INT(-256)), mk_s32(FX16_INT(256))) == FX16_MIN &&
+        fx16_mul_sat(mk_s32(FX16_INT(-128)), mk_s32(FX16_INT(256))) == FX16_MIN &&
+        fx16_mul_sat(mk_s32(0x00018000L), mk_s32(-0x00024000L)) == -0x00036000L) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+static int test_fx16_div(void) {
+    const char *name = "fx16_div 1/3, toward zero, wrap and clamp, / 0";
+    if (fx16_div(mk_s32(FX16_ONE), mk_s32(FX16_INT(3))) == 0x5555L &&
+        fx16_div(mk_s32(-FX16_ONE), mk_s32(FX16_INT(3))) == -0x5555L &&
+        fx16_div(mk_s32(FX16_INT(7)), mk_s32(FX16_ONE / 2)) == FX16_INT(14) &&
+        fx16_div(mk_s32(FX16_INT(20000)), mk_s32(FX16_ONE / 2)) == (long)0x9C400000UL &&
+        fx16_div_sat(mk_s32(FX16_INT(20000)), mk_s32(FX16_ONE / 2)) == FX16_MAX &&
+        fx16_div_sat(mk_s32(FX16_MIN), mk_s32(FX16_ONE)) == FX16_MIN &&
+        fx16_div_sat(mk_s32(FX16_MIN), mk_s32(-FX16_ONE)) == FX16_MAX &&
+        fx16_div(mk_s32(-5L), mk_s32(0L)) == FX16_MIN) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+static int test_fx8_mul_div(void) {
+    const char *name = "fx8_mul/fx8_div 1.5*-2.25, 1/3, wrap and clamp";
+    if (fx8_mul(mk_s16(0x0180), mk_s16(-0x0240)) == -0x0360 &&
+        fx8_mul(mk_s16(1), mk_s16(-1)) == -1 &&
+        fx8_mul(mk_s16(FX8_INT(16)), mk_s16(FX8_INT(16))) == 0 &&
+        fx8_mul_sat(mk_s16(FX8_INT(16)), mk_s16(FX8_INT(16))) == FX8_MAX &&
+        fx8_mul_sat(mk_s16(FX8_INT(-16)), mk_s16(FX8_INT(16))) == FX8_MIN &&
+        fx8_div(mk_s16(FX8_ONE), mk_s16(FX8_INT(3))) == 0x55 &&
+        fx8_div(mk_s16(-FX8_ONE), mk_s16(FX8_INT(3))) == -0x55 &&
+        fx8_div(mk_s16(FX8_INT(100)), mk_s16(FX8_ONE / 2)) == (int)0xC800u &&
+        fx8_div_sat(mk_s16(FX8_INT(100)), mk_s16(FX8_ONE / 2)) == FX8_MAX &&
+        fx8_div(mk_s16(-5), mk_s16(0)) == FX8_MIN) {
+        ok(name); return 1;
+    }
+    fail(name); return 0;
+}
+
+/* ---------- u64 / s64 (long long) ---------- */
+
+static int test_u64_mul(void) {
+    const char *n1 = "u64 100000*300000 == 30000000000";
+    const char *n2 = "u64 0x123456789ABCDEF0*0x0FEDCBA987654321 low 64";
+    int okall = 1;
+    if (mk_u64(100000ULL) * mk_u64(300000ULL) == 30000000000ULL) ok(n1);
+    else { fail(n1); okall = 0; }
+    if (mk_u64(0x123456789ABCDEF0ULL) * mk_u64(0x0FEDCBA987654321ULL) ==
+        0x2236D88FE5618CF0ULL) ok(n2);
+    else { fail(n2); okall = 0; }
+    return okall;
+}
+
+static int test_u64_divmod(void) {
+    const char *n1 = "u64 0xFEDCBA9876543210 / 0x12345 (word path)";
+    const char *n2 = "u64 0xFEDCBA9876543210 / 0x123456789AB (bit path)";
+    const char *n3 = "u64 0xFEDCBA9876543210 / 0x8000000000000001";
+    const char *n4 = "u64 1000000 / 3 (32-bit path)";
+    uint64_t x = mk_u64(0xFEDCBA9876543210ULL);
+    uint64_t y;
+    int okall = 1;
+    y = mk_u64(0x12345ULL);
+    if (x / y == 0xE0004FA01C4DULL && x % y == 0x10A4FULL) ok(n1);
+    else { fail(n1); okall = 0; }
+    y = mk_u64(0x123456789ABULL);
+    if (x / y == 0xE00000ULL && x % y == 0xB43210ULL) ok(n2);
+    else { fail(n2); okall = 0; }
+    y = mk_u64(0x8000000000000001ULL);
+    if (x / y == 1ULL && x % y == 0x7EDCBA987654320FULL) ok(n3);
+    else { fail(n3); okall = 0; }
+    if (mk_u64(1000000ULL) / mk_u64(3ULL) == 333333ULL &&
+        mk_u64(1000000ULL) % mk_u64(3ULL) == 1ULL) ok(n4);
+    else { fail(n4); okall = 0; }
+    return okall;
+}
+
+static int test_s64_divmod(void) {
+    const char *name = "s64 -1000000000000 / 7 == -142857142857, rem -1";
+    int64_t a = mk_s64(-1000000000000LL), b = mk_s64(7LL);
+    if (a / b == -142857142857LL && a % b == -1LL &&
+        a / -b == 142857142857LL && a % -b == -1LL) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_s32_mul_narrow(void) {
+    const char *name = "s32 mul -300*-200, -1*65535, 65535*65535, -32768*32767";
+    if (mk_s32(-300L) * mk_s32(-200L) == 60000L &&
+        mk_s32(-1L) * mk_s32(65535L) == -65535L &&
+        mk_u32(65535UL) * mk_u32(65535UL) == 0xFFFE0001UL &&
+        mk_s32(-32768L) * mk_s32(32767L) == -1073709056L) { ok(name); return 1; }
+    fail(name); return 0;
+}
+
+static int test_u32_var_shift(void) {
+    const char *name = "u32 variable shifts by 0, 8, 13, 24, 31, 32";
+    static const char cnt[6] = { 0, 8, 13, 24, 31, 32 };
+    static const uint32_t want[6][3] = {   /* <<, >> unsigned, >> signed */
+        { 0x89ABCDEFUL, 0x89ABCDEFUL, 0x89ABCDEFUL },
+        { 0xABCDEF00UL, 0x0089ABCDUL, 0xFF89ABCDUL },
+        { 0x79BDE000UL, 0x00044D5EUL, 0xFFFC4D5EUL },
+        { 0xEF000000UL, 0x00000089UL, 0xFFFFFF89UL },
+        { 0x80000000UL, 0x00000001UL, 0xFFFFFFFFUL },
+        { 0x00000000UL, 0x00000000UL, 0xFFFFFFFFUL }
+    };
+    uint32_t x = mk_u32(0x89ABCDEFUL);
+    uint8_t i;
+    for (i = 0; i < 6; i++) {
+        char n = cnt[i];
+        if (_rlulong(x, n) != want[i][0] || _rrulong(x, n) != want[i][1] ||
+            (uint32_t)_rrslong((int32_t)x, n) != want[i][2]) {
+            fail(name);
+            cputs("  n: "); put_hex16((uint16_t)n); cputs("\n");
+            return 0;
+        }
+    }
+    ok(name); return 1;
+}
+
+static int test_u64_var_shift(void) {
+    const char *name = "u64 variable shifts by 0, 8, 21, 40, 63, 64";
+    static const char cnt[6] = { 0, 8, 21, 40, 63, 64 };
+    static const uint64_t want[6][3] = {   /* <<, >> unsigned, >> signed */
+        { 0xFEDCBA9876543210ULL, 0xFEDCBA9876543210ULL, 0xFEDCBA9876543210ULL },
+        { 0xDCBA987654321000ULL, 0x00FEDCBA98765432ULL, 0xFFFEDCBA98765432ULL },
+        { 0x530ECA8642000000ULL, 0x000007F6E5D4C3B2ULL, 0xFFFFFFF6E5D4C3B2ULL },
+        { 0x5432100000000000ULL, 0x0000000000FEDCBAULL, 0xFFFFFFFFFFFEDCBAULL },
+        { 0x0000000000000000ULL, 0x0000000000000001ULL, 0xFFFFFFFFFFFFFFFFULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0xFFFFFFFFFFFFFFFFULL }
+    };
+    uint64_t x = mk_u64(0xFEDCBA9876543210ULL);
+    uint8_t i;
+    for (i = 0; i < 6; i++) {
+        char n = cnt[i];
+        if (_rlulonglong(x, n) != want[i][0] ||
+            _rrulonglong(x, n) != want[i][1] ||
+            (uint64_t)_rrslonglong((int64_t)x, n) != want[i][2]) {
+            fail(name);
+            cputs("  n: "); put_hex16((uint16_t)n); cputs("\n");
+            return 0;
+        }
+    }
+    ok(name); return 1;
+}
+
+/* ---------- banked calls ---------- */
+
+/* bank.s gives the helpers port 0xF8 with bank bits 0..2; the bits
+   outside the mask must survive every switch */
+static int test_banked_call(void) {
+    const char *n1 = "banked call switches and restores the bank";
+    const char *n2 = "banked call into the mapped bank";
+    const char *n3 = "nested banked call restores the caller bank";
+    int okall = 1;
+    bank_init(0x10);
+    if (bank_call(3) == 0x13 && bank_mapped() == 0x10) ok(n1);
+    else { fail(n1); okall = 0; }
+    bank_init(0x12);
+    if (bank_call(2) == 0x12 && bank_mapped() == 0x12) ok(n2);
+    else { fail(n2); okall = 0; }
+    bank_init(0x10);
+    if (bank_call_nested() == 0x12 && bank_mapped() == 0x10) ok(n3);
+    else { fail(n3); okall = 0; }
+    bank_init(0);
+    return okall;
+}
 
 /* ---------- main ---------- */
 
@@ -677,6 +1146,8 @@ void main(void){
     total++; passed += test_u8s8_mul();
     total++; passed += test_s8u8_mul();
     total++; passed += test_s8s8_mul();
+    total++; passed += test_s8s8_mul_min();
+    total++; passed += test_u16_mul_max();
     total++; passed += test_s16_div();
     total++; passed += test_s16_mod();
     total++; passed += test_u16_shl();
@@ -746,6 +1217,34 @@ void main(void){
     total++; passed += test_u16_mul_promote_u32();
     total++; passed += test_u32_shr_31();
     total++; passed += test_s32_mod_large_neg(); 
+    total++; passed += test_u32_divmod_big_divisor();
+    total++; passed += test_u32_divmod_full();
+    total++; passed += test_u32_divmod_small_dividend();
+    total++; passed += test_s32_divmod_min_by_big();
+    total++; passed += test_uldivmod();
+    total++; passed += test_ldivmod_neg();
+    total++; passed += test_mul16_const();
+    total++; passed += test_mul16_const_signed();
+    total++; passed += test_udiv32_apply();
+    total++; passed += test_sdiv32_apply();
+    total++; passed += test_div_array();
+    total++; passed += test_utoa16_itoa();
+    total++; passed += test_utoa32();
+    total++; passed += test_atoi16();
+    total++; passed += test_strtoul32();
+    total++; passed += test_numconv_roundtrip();
+    total++; passed += test_isqrt16();
+    total++; passed += test_isqrt32();
+    total++; passed += test_fx16_mul();
+    total++; passed += test_fx16_div();
+    total++; passed += test_fx8_mul_div();
+    total++; passed += test_u64_mul();
+    total++; passed += test_u64_divmod();
+    total++; passed += test_s64_divmod();
+    total++; passed += test_s32_mul_narrow();
+    total++; passed += test_u32_var_shift();
+    total++; passed += test_u64_var_shift();
+    total++; passed += test_banked_call();
 
     cputs("Summary: ");
     put_hex16((uint16_t)passed);